@@ -102,6 +102,23 @@ namespace nd4j {
             }
         }
 
+        /**
+         * Defines number of NUMA nodes thread pool and allocations should respect: 1 disables NUMA awareness,
+         * values above 1 split cores into given number of nodes, which allows to simulate topology
+         */
+        const char* numa_nodes = std::getenv("SD_NUMA_NODES");
+        if (numa_nodes != nullptr) {
+            try {
+                std::string t(numa_nodes);
+                int val = std::stoi(t);
+                _numaNodes.store(val);
+            } catch (std::invalid_argument &e) {
+                // just do nothing
+            } catch (std::out_of_range &e) {
+                // still do nothing
+            }
+        }
+
         if (_maxMasterThreads.load() > _maxThreads.load()) {
             nd4j_printf("Warning! MAX_MASTER_THREADS > MAX_THREADS, tuning them down to match each other\n","");
             _maxMasterThreads.store(_maxThreads.load());
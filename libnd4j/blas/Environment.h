@@ -41,11 +41,16 @@ namespace nd4j{
         std::atomic<nd4j::DataType> _dataType;
         std::atomic<bool> _precBoost;
         std::atomic<bool> _useMKLDNN{true};
+        std::atomic<bool> _useTiledConvolutions{true};
+        std::atomic<bool> _useGraphMemoryPlanner{false};
         std::atomic<bool> _allowHelpers{true};
 
         std::atomic<int> _maxThreads;
         std::atomic<int> _maxMasterThreads;
 
+        // 0 means topology is detected from the system, 1 disables NUMA awareness, anything above forces given number of nodes
+        std::atomic<int> _numaNodes{0};
+
         // these fields hold defaults
         std::atomic<int64_t> _maxTotalPrimaryMemory{-1};
         std::atomic<int64_t> _maxTotalSpecialMemory{-1};
@@ -98,6 +103,11 @@ namespace nd4j{
         int maxMasterThreads();
         void setMaxMasterThreads(int max);
 
+        /**
+         * Number of NUMA nodes requested via SD_NUMA_NODES, 0 if topology should be detected
+         */
+        int numaNodes() { return _numaNodes.load(); }
+
         /*
          * Legacy memory limits API, still used in new API as simplified version
          */
@@ -125,6 +135,19 @@ namespace nd4j{
         bool isUseMKLDNN() { return _useMKLDNN.load(); }
         void setUseMKLDNN(bool useMKLDNN) { _useMKLDNN.store(useMKLDNN); }
 
+        /**
+         * If true, generic conv2d/conv2d_bp process output in tiles instead of materializing full im2col buffer
+         */
+        bool isUseTiledConvolutions() { return _useTiledConvolutions.load(); }
+        void setUseTiledConvolutions(bool useTiled) { _useTiledConvolutions.store(useTiled); }
+
+        /**
+         * If true, GraphExecutioner releases intermediate arrays as soon as they're dead, and places them into shared arena
+         * according to MemoryPlan. Intermediate results aren't available in VariableSpace after execution in this mode
+         */
+        bool isUseGraphMemoryPlanner() { return _useGraphMemoryPlanner.load(); }
+        void setUseGraphMemoryPlanner(bool usePlanner) { _useGraphMemoryPlanner.store(usePlanner); }
+
         nd4j::DataType defaultFloatDataType();
         void setDefaultFloatDataType(nd4j::DataType dtype);
 
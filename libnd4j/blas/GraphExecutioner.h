@@ -71,6 +71,15 @@ namespace nd4j {
 
         static Graph *importFromFlatBuffers(const char *filename);
 
+        /**
+        * This method imports Graph from given FlatBuffers file
+        *
+        * @param filename path to FlatBuffers file
+        * @param memoryMapped if TRUE, file is memory-mapped and constant arrays point directly into mapping
+        *                     whenever byte order and alignment allow, instead of being copied
+        */
+        static Graph *importFromFlatBuffers(const char *filename, bool memoryMapped);
+
         static Graph *importFromFlatPointer(Nd4jPointer ptr);
     };
 
@@ -658,6 +658,29 @@ static void execTransformBool(nd4j::LaunchContext  *lc,
         BUILD_SINGLE_SELECTOR(zType, nd4j::SpecialMethods, ::decodeBitmapGeneric(dx, N, dz, zShapeInfo), FLOAT_TYPES);
     }
 
+    inline static void encodeThresholdP1(void *dx, Nd4jLong *xShapeInfo, Nd4jLong N, int *dz, float threshold) {
+        auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
+
+        BUILD_SINGLE_SELECTOR(xType, nd4j::SpecialMethods, ::encodeThresholdP1Generic(dx, N, dz, threshold), FLOAT_TYPES);
+    }
+
+    /**
+     * Exclusive prefix sum over per-block counters produced by encodeThresholdP1: dz[b] = sum(dx[1..b])
+     */
+    static void encodeThresholdP2Int(int *dx, Nd4jLong N, int *dz);
+
+    inline static void encodeThresholdP3(void *dx, Nd4jLong *xShapeInfo, int *offsets, Nd4jLong N, int *dz) {
+        auto xType = nd4j::ArrayOptions::dataType(xShapeInfo);
+
+        BUILD_SINGLE_SELECTOR(xType, nd4j::SpecialMethods, ::encodeThresholdP3Generic(dx, offsets, N, dz), FLOAT_TYPES);
+    }
+
+    inline static void decodeThreshold(void *dx, Nd4jLong N, void *dz, Nd4jLong *zShapeInfo) {
+        auto zType = nd4j::ArrayOptions::dataType(zShapeInfo);
+
+        BUILD_SINGLE_SELECTOR(zType, nd4j::SpecialMethods, ::decodeThresholdGeneric(dx, N, dz), FLOAT_TYPES);
+    }
+
 };
 
 
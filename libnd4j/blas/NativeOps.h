@@ -77,6 +77,7 @@ bool verbose = false;
 #include <graph/ResultWrapper.h>
 #include <DebugInfo.h>
 #include <memory/MemoryCounter.h>
+#include <memory/Workspace.h>
 
 typedef nd4j::InteropDataBuffer OpaqueDataBuffer;
 
@@ -663,6 +664,26 @@ ND4J_EXPORT int getDeviceMajor(int deviceId);
  */
 ND4J_EXPORT Nd4jLong getCachedMemory(int deviceId);
 
+/**
+ * These methods return statistics of constant shapeInfo and TAD caches: hits, misses and memory used by cached buffers
+ */
+ND4J_EXPORT Nd4jLong getShapeCacheHits();
+ND4J_EXPORT Nd4jLong getShapeCacheMisses();
+ND4J_EXPORT Nd4jLong getShapeCacheMemory();
+ND4J_EXPORT Nd4jLong getTadCacheHits();
+ND4J_EXPORT Nd4jLong getTadCacheMisses();
+ND4J_EXPORT Nd4jLong getTadCacheMemory();
+
+/**
+ * These methods return usage statistics of given Workspace: high-water mark of memory used within single cycle,
+ * number of allocations, number of spills, and number of spills served from memory recycled from previous cycle
+ */
+ND4J_EXPORT Nd4jLong getWorkspacePeakUsage(Nd4jPointer workspace);
+ND4J_EXPORT Nd4jLong getWorkspaceNumberOfAllocations(Nd4jPointer workspace);
+ND4J_EXPORT Nd4jLong getWorkspaceNumberOfSpills(Nd4jPointer workspace);
+ND4J_EXPORT Nd4jLong getWorkspaceNumberOfRecycledSpills(Nd4jPointer workspace);
+ND4J_EXPORT void resetWorkspaceStats(Nd4jPointer workspace);
+
 /**
  *
  * @param ptrToDeviceId
@@ -1275,8 +1296,9 @@ static Nd4jPointer numpyFromFile(std::string path) {
 ////// NPZ //////
 
 static void* mapFromNpzFile(std::string path){
+    // members point into memory-mapped file, which is released once map and all arrays taken from it are deleted
     cnpy::npz_t* mapPtr = new cnpy::npz_t();
-    cnpy::npz_t map = cnpy::npzLoad(path);
+    cnpy::npz_t map = cnpy::npzMap(path);
     mapPtr->insert(map.begin(), map.end());
     return reinterpret_cast<void*>(mapPtr);
 }
@@ -1625,6 +1647,22 @@ ND4J_EXPORT void deleteRandomGenerator(OpaqueRandomGenerator* ptr);
 ND4J_EXPORT const char* runLightBenchmarkSuit(bool printOut);
 ND4J_EXPORT const char* runFullBenchmarkSuit(bool printOut);
 
+/**
+ * Per-op latency statistics, keyed by op and input shapes. Collection is enabled by default.
+ * Returned JSON should be released with deleteCharArray
+ */
+ND4J_EXPORT void setOpStatisticsEnabled(bool reallyEnable);
+ND4J_EXPORT void resetOpStatistics();
+ND4J_EXPORT const char* getOpStatistics();
+
+/**
+ * Execution timeline in Chrome trace_event format, recorded between startTracing and stopTracing.
+ * Returned JSON should be released with deleteCharArray
+ */
+ND4J_EXPORT void startTracing();
+ND4J_EXPORT void stopTracing();
+ND4J_EXPORT const char* exportTrace();
+
 typedef nd4j::LaunchContext OpaqueLaunchContext;
 
 ND4J_EXPORT OpaqueLaunchContext* defaultLaunchContext();
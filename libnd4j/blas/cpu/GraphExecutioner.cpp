@@ -50,11 +50,14 @@
 #include <helpers/ShapeUtils.h>
 #include <Status.h>
 #include <deque>
+#include <atomic>
+#include <execution/Threads.h>
 #include <graph/ResultWrapper.h>
 #include <graph/ExecutionResult.h>
 #include <exceptions/graph_execution_exception.h>
 #include <exceptions/no_results_exception.h>
 #include <graph/FlatUtils.h>
+#include <helpers/MappedFile.h>
 
 namespace nd4j{
 namespace graph {
@@ -199,6 +202,136 @@ namespace graph {
 }
 
 
+/**
+ * This method releases arrays which aren't used after given onion layer, according to memory plan
+ */
+static void releaseDeadTensors(MemoryPlan *plan, int layer, VariableSpace *variableSpace) {
+    // variables of shared graph behind VariableProxy are never released here, only session-local ones
+    auto local = variableSpace->localSpace();
+
+    for (auto id : plan->releasedAfter(layer)) {
+        if (!local->hasVariable(id))
+            continue;
+
+        auto var = local->getVariable(id);
+        if (!var->hasNDArray())
+            continue;
+
+        auto array = var->getNDArray();
+
+        // arrays borrowed from other variables (i.e. in-place ops) are released along with their owner
+        if (var->isRemovable()) {
+            plan->recordSize(id, array->lengthOf() * array->sizeOfT());
+            delete array;
+        }
+
+        var->setNDArray(nullptr);
+    }
+}
+
+/**
+ * This class detaches memory plan from VariableSpace once execution is over, on any path
+ */
+class MemoryPlanGuard {
+private:
+    VariableSpace *_variableSpace;
+public:
+    explicit MemoryPlanGuard(VariableSpace *variableSpace) : _variableSpace(variableSpace) { }
+    ~MemoryPlanGuard() { _variableSpace->setMemoryPlan(nullptr); }
+};
+
+/**
+ * This method returns true if graph has no control flow, so nodes of the same onion layer are independent,
+ * and none of them touches FlowPath during execution
+ */
+static bool isDataflowGraph(Graph *graph) {
+    for (auto &layer : *graph->getOnion())
+        for (auto node : *layer.second)
+            if (node->opType() == OpType_LOGIC || node->hasGraphEmbedded() || node->isDivergencePoint())
+                return false;
+
+    return true;
+}
+
+/**
+ * This class restores threads limit of the calling thread, even if node execution throws
+ */
+class ThreadsLimitGuard {
+private:
+    int _previous;
+public:
+    explicit ThreadsLimitGuard(int limit) : _previous(samediff::Threads::threadsLimit()) { samediff::Threads::setThreadsLimit(limit); }
+    ~ThreadsLimitGuard() { samediff::Threads::setThreadsLimit(_previous); }
+};
+
+/**
+ * This method checks if any in-place node of the layer overwrites an input which is also consumed by another node of the same layer.
+ * Such a layer can't be executed concurrently, since other consumers would race with the in-place write
+ */
+static bool hasInplaceConflicts(std::vector<Node*> &nodes) {
+    for (auto node : nodes) {
+        if (!node->hasBlockAttached() || !node->getContextPrototype()->isInplace())
+            continue;
+
+        for (auto &input : *node->input()) {
+            for (auto other : nodes) {
+                if (other == node)
+                    continue;
+
+                for (auto &otherInput : *other->input())
+                    if (otherInput == input)
+                        return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ * This method executes nodes of single onion layer concurrently, each node limited to intraOp threads.
+ * FlowPath isn't thread-safe, so all bookkeeping is done by calling thread, before and after execution
+ */
+static Nd4jStatus executeLayerConcurrently(Graph *graph, std::vector<Node*> &nodes, VariableSpace *variableSpace, FlowPath *flowPath, int interOp, int intraOp) {
+    auto numNodes = static_cast<int>(nodes.size());
+    for (auto node : nodes)
+        flowPath->markNodeActive(node->id(), true);
+
+    std::vector<Nd4jStatus> statuses(numNodes, Status::OK());
+    std::vector<Nd4jLong> times(numNodes, 0L);
+    std::atomic<int> next(0);
+
+    auto numThreads = nd4j::math::nd4j_min<int>(interOp, numNodes);
+    auto limit = intraOp > 0 ? intraOp : nd4j::math::nd4j_max<int>(1, Environment::getInstance()->maxMasterThreads() / numThreads);
+
+    // nodes are picked dynamically, so one heavy node doesn't hold the others
+    auto func = PRAGMA_THREADS_DO {
+        ThreadsLimitGuard guard(limit);
+
+        for (int e = next++; e < numNodes; e = next++) {
+            auto timeStart = std::chrono::system_clock::now();
+
+            statuses[e] = GraphExecutioner::executeFlatNode(graph, nodes[e], variableSpace);
+
+            auto timeEnd = std::chrono::system_clock::now();
+            times[e] = std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count();
+        }
+    };
+
+    samediff::Threads::parallel_do(func, numThreads);
+
+    for (int e = 0; e < numNodes; e++) {
+        flowPath->setOuterTime(nodes[e]->id(), times[e]);
+
+        if (statuses[e] != Status::OK())
+            return statuses[e];
+
+        flowPath->markExecuted(nodes[e]->id(), true);
+    }
+
+    return Status::OK();
+}
+
 /**
  * This method executes given Graph instance, and returns error code.
  *
@@ -227,6 +360,14 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
         }
     }
 
+    // with memory planner enabled, intermediate arrays are released right after their last use
+    MemoryPlan *memoryPlan = nullptr;
+    if (Environment::getInstance()->isUseGraphMemoryPlanner() && graph->memoryPlan()->isPlannable()) {
+        memoryPlan = graph->memoryPlan();
+        __variableSpace->setMemoryPlan(memoryPlan);
+    }
+    MemoryPlanGuard planGuard(__variableSpace);
+
     // optionally saving graph build time
     if (Environment::getInstance()->isProfiling())
         flowPath->profile()->setBuildTime(GraphProfile::relativeTime(tb0));
@@ -235,6 +376,11 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
 
     bool pe = graph->getExecutorConfiguration()->_executionMode == ExecutionMode_AUTO;
 
+    // independent nodes of the same layer can be executed concurrently, if there's no control flow in this graph
+    auto interOp = graph->getExecutorConfiguration()->_interOpThreads;
+    auto intraOp = graph->getExecutorConfiguration()->_intraOpThreads;
+    bool concurrentLayers = interOp > 1 && !Environment::getInstance()->isProfiling() && isDataflowGraph(graph);
+
 
     // basically if at some point code diverges, code branch might be _DISABLED_, and all nodes within that branch will be disabled as well
 
@@ -249,6 +395,19 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
     for (int l = 0; l < (int) graph->getOnion()->size(); l++) {
         int layerSize = graph->getOnion()->count(l) == 1 ? graph->getOnion()->at(l)->size() : 0;
 
+        if (concurrentLayers && layerSize > 1 && !hasInplaceConflicts(*graph->getOnion()->at(l))) {
+            auto status = executeLayerConcurrently(graph, *graph->getOnion()->at(l), __variableSpace, flowPath, interOp, intraOp);
+            if (status != Status::OK())
+                return status;
+
+            exec_counter += layerSize;
+
+            if (memoryPlan != nullptr)
+                releaseDeadTensors(memoryPlan, l, __variableSpace);
+
+            continue;
+        }
+
         int n = 0;
 // this omp block will probably never be the case
         for (; n < layerSize; n++) {
@@ -478,6 +637,9 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
             // if node was executed - tag it as active
             flowPath->markExecuted(node->id(), true);
         }
+
+        if (memoryPlan != nullptr)
+            releaseDeadTensors(memoryPlan, l, __variableSpace);
     }
 
     // optionally saving execution time
@@ -487,6 +649,10 @@ Nd4jStatus GraphExecutioner::execute(Graph *graph, VariableSpace* variableSpace)
         //flowPath->profile().printOut();
     }
 
+    // sizes of all intermediate arrays are known now, so arena can be used for next runs
+    if (memoryPlan != nullptr)
+        memoryPlan->finalize();
+
     // saving memory footprint for current run
     if (__variableSpace->launchContext()->getWorkspace() != nullptr) {
         auto m = __variableSpace->launchContext()->getWorkspace()->getAllocatedSize();
@@ -831,18 +997,22 @@ uint8_t* readFlatBuffers(const char * filename) {
 
     nd4j_debug("File length: %i\n", fileLen);
 
-    uint8_t * data = new uint8_t[fileLen];
-
     FILE *in = fopen(filename, "rb");
-    int cnt = 0;
-    int b = 0;
-    while (cnt < fileLen) {
-        b += fread(data + cnt, 1, 1, in);
-
-        cnt++;
+    if (in == nullptr) {
+        nd4j_printf("File [%s] can't be opened. Please check path and permissions\n", filename);
+        throw std::runtime_error("File can't be opened");
     }
+
+    uint8_t * data = new uint8_t[fileLen];
+    auto cnt = fread(data, 1, static_cast<size_t>(fileLen), in);
     fclose(in);
 
+    if (cnt != static_cast<size_t>(fileLen)) {
+        delete[] data;
+        nd4j_printf("File [%s]: read %lld bytes out of %lld\n", filename, (long long) cnt, (long long) fileLen);
+        throw std::runtime_error("Failed to read file");
+    }
+
     return data;
 }
 
@@ -890,9 +1060,21 @@ flatbuffers::Offset<FlatResult> GraphExecutioner::execute(Graph *graph, flatbuff
         *   PLEASE NOTE: This method is mostly suited for tests and debugging/profiling
         */
         Graph* GraphExecutioner::importFromFlatBuffers(const char *filename) {
-            auto data = readFlatBuffers(filename);
-            auto restoredGraph = importFromFlatPointer(reinterpret_cast<Nd4jPointer>(data));
-            delete[] data;
+            return importFromFlatBuffers(filename, false);
+        }
+
+        Graph* GraphExecutioner::importFromFlatBuffers(const char *filename, bool memoryMapped) {
+            if (!memoryMapped) {
+                auto data = readFlatBuffers(filename);
+                auto restoredGraph = importFromFlatPointer(reinterpret_cast<Nd4jPointer>(data));
+                delete[] data;
+                return restoredGraph;
+            }
+
+            // arrays created while parsing point into mapping, so graph shares ownership of it
+            auto file = std::make_shared<MappedFile>(filename);
+            auto restoredGraph = importFromFlatPointer(reinterpret_cast<Nd4jPointer>(file->data()));
+            restoredGraph->attachMappedFile(file);
             return restoredGraph;
         }
 
@@ -698,21 +698,40 @@ template ND4J_EXPORT NDArray NDArrayFactory::create(int16_t* buffer, const char
           if (size < 0)
               throw std::runtime_error("File doesn't exit");
 
-          auto pNPY = reinterpret_cast<char*>(::numpyFromFile(std::string(fileName)));
-
-          auto nBuffer = reinterpret_cast<void*>(::dataPointForNumpy(pNPY));
-          auto shape = reinterpret_cast<Nd4jLong *>(::shapeBufferForNumpy(pNPY));
-
-          auto length = shape::length(shape);
-          int8_t *buffer = nullptr;
-          nd4j::memory::Workspace *workspace = nullptr;
-          auto byteLen = length * DataTypeUtils::sizeOfElement(ArrayOptions::dataType(shape));
-
-          ALLOCATE(buffer, workspace, byteLen, int8_t);
-          memcpy(buffer, nBuffer, byteLen);
-
-          free(pNPY);
-
-          return NDArray(buffer, shape, LaunchContext::defaultContext(), true);
+          // file is memory-mapped, so only pages actually touched are ever read
+          auto arr = cnpy::npyMap(std::string(fileName));
+          auto dtype = cnpy::dataTypeFromHeader(reinterpret_cast<char *>(arr.mapping->data()));
+          auto order = arr.fortranOrder ? 'f' : 'c';
+
+          // scalar is stored with () shape, which is parsed as {0}, just like empty (0,) shape
+          const bool isScalar = arr.isScalar;
+
+          std::vector<Nd4jLong> shapeOf(arr.shape.begin(), arr.shape.end());
+          bool isEmpty = false;
+          for (auto v: shapeOf)
+              if (v == 0)
+                  isEmpty = true;
+
+          if (isEmpty && !isScalar) {
+              auto shapeInfo = nd4j::ShapeBuilders::emptyShapeInfo(dtype, order, shapeOf);
+              NDArray result(nullptr, shapeInfo, LaunchContext::defaultContext(), false);
+              delete[] shapeInfo;
+              return result;
+          }
+
+          auto descriptor = isScalar ? ShapeDescriptor::scalarDescriptor(dtype) : ShapeDescriptor(dtype, order, shapeOf);
+          auto byteLen = (isScalar ? 1 : shape::prodLong(shapeOf.data(), shapeOf.size())) * DataTypeUtils::sizeOfElement(dtype);
+
+          // wrap mapped data in place, DataBuffer deleter keeps mapping alive for as long as array (or its views) exist
+          if (Environment::getInstance()->isCPU() && reinterpret_cast<uintptr_t>(arr.data) % DataTypeUtils::sizeOfElement(dtype) == 0) {
+              auto mapping = arr.mapping;
+              std::shared_ptr<DataBuffer> buffer(new DataBuffer(arr.data, byteLen, dtype, false), [mapping](DataBuffer* b) { delete b; });
+
+              return NDArray(buffer, descriptor, LaunchContext::defaultContext());
+          }
+
+          // misaligned data can't be used in place, so it's copied once
+          auto buffer = std::make_shared<DataBuffer>(arr.data, dtype, byteLen);
+          return NDArray(buffer, descriptor, LaunchContext::defaultContext());
       }
 }
@@ -1341,9 +1341,47 @@ void NativeOpExecutioner::execRandom(nd4j::LaunchContext  *lc,
     rng->rewindH(shape::length(hZShapeInfo));
 }
 
+////////////////////////////////////////////////////////////////////////
+// exclusive prefix sum done in 3 steps: per-chunk sums, serial scan over chunk sums, per-chunk local scan
+void NativeOpExecutioner::encodeThresholdP2Int(int *hX, Nd4jLong N, int *dz) {
+    auto x = hX + 1;
+
+    const int numChunks = samediff::ThreadsHelper::numberOfThreads(nd4j::Environment::getInstance()->maxMasterThreads(), N);
+    const Nd4jLong span = N / numChunks + (N % numChunks ? 1 : 0);
+
+    std::vector<int> sums(numChunks + 1, 0);
 
+    auto funcSums = PRAGMA_THREADS_FOR {
+        for (auto c = start; c < stop; c++) {
+            const auto cStart = c * span;
+            const auto cStop = nd4j::math::nd4j_min<Nd4jLong>(cStart + span, N);
 
+            int sum = 0;
+            PRAGMA_OMP_SIMD_ARGS(reduction(+:sum))
+            for (Nd4jLong e = cStart; e < cStop; e++)
+                sum += x[e];
+
+            sums[c + 1] = sum;
+        }
+    };
 
+    samediff::Threads::parallel_for(funcSums, 0, numChunks, 1, numChunks);
 
+    for (int c = 1; c <= numChunks; c++)
+        sums[c] += sums[c - 1];
 
+    auto funcScan = PRAGMA_THREADS_FOR {
+        for (auto c = start; c < stop; c++) {
+            const auto cStart = c * span;
+            const auto cStop = nd4j::math::nd4j_min<Nd4jLong>(cStart + span, N);
 
+            int sum = sums[c];
+            for (Nd4jLong e = cStart; e < cStop; e++) {
+                dz[e] = sum;
+                sum += x[e];
+            }
+        }
+    };
+
+    samediff::Threads::parallel_for(funcScan, 0, numChunks, 1, numChunks);
+}
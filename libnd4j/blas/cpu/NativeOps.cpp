@@ -75,6 +75,8 @@ bool experimentalSupport = false;
 #include <performance/benchmarking/BenchmarkSuit.h>
 #include <performance/benchmarking/FullBenchmarkSuit.h>
 #include <performance/benchmarking/LightBenchmarkSuit.h>
+#include <graph/profiling/OpStatistics.h>
+#include <graph/profiling/TraceRecorder.h>
 #include <execution/Threads.h>
 
 #ifdef CPU_FEATURES
@@ -1439,23 +1441,41 @@ void enableP2P(bool enable) {
 
 
 void encodeThresholdP1(Nd4jPointer *extraPointers, void *hX, Nd4jLong *hXShapeInfo, Nd4jLong N, int *dz, float threshold) {
-    // TODO: to be implemented
+    try {
+        NativeOpExecutioner::encodeThresholdP1(hX, hXShapeInfo, N, dz, threshold);
+    } catch (std::exception &e) {
+        nd4j::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+        nd4j::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+    }
 }
 
-
 void encodeThresholdP2Int(Nd4jPointer *extraPointers, int *hX, Nd4jLong N, int *dz) {
-    // TODO: to be implemented
+    try {
+        if (N > 0)
+            NativeOpExecutioner::encodeThresholdP2Int(hX, N, dz);
+    } catch (std::exception &e) {
+        nd4j::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+        nd4j::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+    }
 }
 
 
 void encodeThresholdP3(Nd4jPointer *extraPointers, void *hX, Nd4jLong *hXShapeInfo, int *offsets, Nd4jLong N, int *dz){
-    // offsets won't be used here
-
-    // TODO: to be implemented
+    try {
+        NativeOpExecutioner::encodeThresholdP3(hX, hXShapeInfo, offsets, N, dz);
+    } catch (std::exception &e) {
+        nd4j::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+        nd4j::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+    }
 }
 
 void decodeThreshold(Nd4jPointer *extraPointers, void *hX, Nd4jLong N, void *dz, Nd4jLong *hZShapeInfo){
-    // TODO: to be implemented
+    try {
+        NativeOpExecutioner::decodeThreshold(hX, N, dz, hZShapeInfo);
+    } catch (std::exception &e) {
+        nd4j::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+        nd4j::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+    }
 }
 
 bool isP2PAvailable() {
@@ -2185,47 +2205,66 @@ int registerGraph(Nd4jPointer *extraPointers, Nd4jLong graphId, Nd4jPointer flat
 }
 
 static VariablesSet* executeStoredGraphT(Nd4jPointer *extraPointers, Nd4jLong graphId, Nd4jPointer *inputBuffers, Nd4jPointer *inputShapes, int* inputIndices, int numInputs) {
-    auto graph = nd4j::graph::GraphHolder::getInstance()->cloneGraph(graphId);
-    auto varSpace = graph->getVariableSpace();
+    auto holder = nd4j::graph::GraphHolder::getInstance();
+    holder->lockRead(graphId);
 
-    std::vector<nd4j::NDArray*> handles;
+    nd4j::graph::Graph *graph = nullptr;
+    nd4j::graph::VariablesSet *varSet = nullptr;
+    Nd4jStatus hZ;
+    try {
+        graph = holder->checkoutSession(graphId);
+        auto varSpace = graph->getVariableSpace();
 
-    for (int e = 0; e < numInputs; e++) {
-        auto idx = inputIndices[e];
+        for (int e = 0; e < numInputs; e++) {
+            auto idx = inputIndices[e];
 
-        // we'll delete this array later, together with cloned VariableSpace
-        auto array = new nd4j::NDArray(inputBuffers[e], reinterpret_cast<Nd4jLong *>(inputShapes[e]));
-        handles.emplace_back(array);
+            // we'll delete this array later, together with session-local VariableSpace
+            auto array = new nd4j::NDArray(inputBuffers[e], reinterpret_cast<Nd4jLong *>(inputShapes[e]));
 
-        if (varSpace->hasVariable(idx)) {
-            auto var = varSpace->getVariable(idx);
-            if (var->hasNDArray())
-                delete var->getNDArray();
+            // variables of the shared graph are never touched, session-local copy shadows them instead
+            auto local = varSpace->localSpace();
+            if (local->hasVariable(idx)) {
+                auto var = local->getVariable(idx);
+                if (var->hasNDArray())
+                    delete var->getNDArray();
 
-            var->setNDArray(array);
-        } else
-            varSpace->putVariable(idx, array);
-    }
+                var->setNDArray(array);
+            } else
+                varSpace->putVariable(idx, array);
+        }
 
-    auto hZ = nd4j::graph::GraphExecutioner::execute(graph, varSpace);
-    auto varSet = new nd4j::graph::VariablesSet(hZ);
+        hZ = nd4j::graph::GraphExecutioner::execute(graph, varSpace);
+        varSet = new nd4j::graph::VariablesSet(hZ);
 
-    if (hZ == ND4J_STATUS_OK) {
-        // pull back results, and provide them
-        auto outputs = graph->fetchOutputs();
-        for (int e = 0; e < outputs->size(); e++) {
-            // we're only getting variable ID/Index from original grap. values will be taken from cloned workspace
-            std::pair<int, int> varId(outputs->at(e)->id(), outputs->at(e)->index());
+        if (hZ == ND4J_STATUS_OK) {
+            // pull back results, and provide them
+            auto outputs = graph->fetchOutputs();
+            for (int e = 0; e < outputs->size(); e++) {
+                // we're only getting variable ID/Index from original grap. values will be taken from cloned workspace
+                std::pair<int, int> varId(outputs->at(e)->id(), outputs->at(e)->index());
 
-            auto var = varSpace->getVariable(varId);
+                auto var = varSpace->getVariable(varId);
 
-            varSet->push_back(var->clone());
-        }
+                varSet->push_back(var->clone());
+            }
 
-        delete outputs;
+            delete outputs;
+        }
+    } catch (...) {
+        // session state is unknown after failure, so we don't return it to the pool
+        delete varSet;
+        delete graph;
+        holder->unlockRead(graphId);
+        throw;
     }
 
-    delete graph;
+    // session goes back to the pool only after successful run, input arrays are released together with session-local variables
+    if (hZ == ND4J_STATUS_OK)
+        holder->releaseSession(graphId, graph);
+    else
+        delete graph;
+
+    holder->unlockRead(graphId);
 
     return varSet;
 }
@@ -2979,10 +3018,98 @@ const char* runLightBenchmarkSuit(bool printOut) {
     }
 }
 
+static const char* stringAsChars(const std::string &result) {
+    auto chars = new char[result.length() + 1];
+    std::memcpy(chars, result.data(), result.length());
+    chars[result.length()] = (char) 0x0;
+
+    return chars;
+}
+
+void setOpStatisticsEnabled(bool reallyEnable) {
+    nd4j::graph::OpStatistics::getInstance()->setEnabled(reallyEnable);
+}
+
+void resetOpStatistics() {
+    nd4j::graph::OpStatistics::getInstance()->reset();
+}
+
+const char* getOpStatistics() {
+    try {
+        return stringAsChars(nd4j::graph::OpStatistics::getInstance()->asJson());
+    } catch (std::exception &e) {
+        nd4j::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+        nd4j::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+        return nullptr;
+    }
+}
+
+void startTracing() {
+    nd4j::graph::TraceRecorder::getInstance()->start();
+}
+
+void stopTracing() {
+    nd4j::graph::TraceRecorder::getInstance()->stop();
+}
+
+const char* exportTrace() {
+    try {
+        return stringAsChars(nd4j::graph::TraceRecorder::getInstance()->asJson());
+    } catch (std::exception &e) {
+        nd4j::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+        nd4j::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+        return nullptr;
+    }
+}
+
 Nd4jLong getCachedMemory(int deviceId) {
     return nd4j::ConstantHelper::getInstance()->getCachedAmount(deviceId);
 }
 
+Nd4jLong getShapeCacheHits() {
+    return nd4j::ConstantShapeHelper::getInstance()->cacheHits();
+}
+
+Nd4jLong getShapeCacheMisses() {
+    return nd4j::ConstantShapeHelper::getInstance()->cacheMisses();
+}
+
+Nd4jLong getShapeCacheMemory() {
+    return nd4j::ConstantShapeHelper::getInstance()->cachedBytes();
+}
+
+Nd4jLong getTadCacheHits() {
+    return nd4j::ConstantTadHelper::getInstance()->cacheHits();
+}
+
+Nd4jLong getTadCacheMisses() {
+    return nd4j::ConstantTadHelper::getInstance()->cacheMisses();
+}
+
+Nd4jLong getTadCacheMemory() {
+    return nd4j::ConstantTadHelper::getInstance()->cachedBytes();
+}
+
+Nd4jLong getWorkspacePeakUsage(Nd4jPointer workspace) {
+    return reinterpret_cast<nd4j::memory::Workspace*>(workspace)->getPeakUsage();
+}
+
+Nd4jLong getWorkspaceNumberOfAllocations(Nd4jPointer workspace) {
+    return reinterpret_cast<nd4j::memory::Workspace*>(workspace)->getNumberOfAllocations();
+}
+
+Nd4jLong getWorkspaceNumberOfSpills(Nd4jPointer workspace) {
+    return reinterpret_cast<nd4j::memory::Workspace*>(workspace)->getNumberOfSpills();
+}
+
+Nd4jLong getWorkspaceNumberOfRecycledSpills(Nd4jPointer workspace) {
+    return reinterpret_cast<nd4j::memory::Workspace*>(workspace)->getNumberOfRecycledSpills();
+}
+
+void resetWorkspaceStats(Nd4jPointer workspace) {
+    reinterpret_cast<nd4j::memory::Workspace*>(workspace)->resetStats();
+}
+
 const char* runFullBenchmarkSuit(bool printOut) {
     try {
         nd4j::FullBenchmarkSuit suit;
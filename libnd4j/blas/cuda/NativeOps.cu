@@ -52,6 +52,8 @@ using namespace nd4j;
 #include <loops/special_kernels.h>
 #include <performance/benchmarking/FullBenchmarkSuit.h>
 #include <performance/benchmarking/LightBenchmarkSuit.h>
+#include <graph/profiling/OpStatistics.h>
+#include <graph/profiling/TraceRecorder.h>
 
 cudaDeviceProp *deviceProperties;
 cudaFuncAttributes *funcAttributes = new cudaFuncAttributes[64];
@@ -3723,10 +3725,98 @@ const char* runFullBenchmarkSuit(bool printOut) {
     }
 }
 
+static const char* stringAsChars(const std::string &result) {
+    auto chars = new char[result.length() + 1];
+    std::memcpy(chars, result.data(), result.length());
+    chars[result.length()] = (char) 0x0;
+
+    return chars;
+}
+
+void setOpStatisticsEnabled(bool reallyEnable) {
+    nd4j::graph::OpStatistics::getInstance()->setEnabled(reallyEnable);
+}
+
+void resetOpStatistics() {
+    nd4j::graph::OpStatistics::getInstance()->reset();
+}
+
+const char* getOpStatistics() {
+    try {
+        return stringAsChars(nd4j::graph::OpStatistics::getInstance()->asJson());
+    } catch (std::exception &e) {
+        nd4j::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+        nd4j::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+        return nullptr;
+    }
+}
+
+void startTracing() {
+    nd4j::graph::TraceRecorder::getInstance()->start();
+}
+
+void stopTracing() {
+    nd4j::graph::TraceRecorder::getInstance()->stop();
+}
+
+const char* exportTrace() {
+    try {
+        return stringAsChars(nd4j::graph::TraceRecorder::getInstance()->asJson());
+    } catch (std::exception &e) {
+        nd4j::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+        nd4j::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+        return nullptr;
+    }
+}
+
 Nd4jLong getCachedMemory(int deviceId) {
     return nd4j::ConstantHelper::getInstance()->getCachedAmount(deviceId);
 }
 
+Nd4jLong getShapeCacheHits() {
+    return nd4j::ConstantShapeHelper::getInstance()->cacheHits();
+}
+
+Nd4jLong getShapeCacheMisses() {
+    return nd4j::ConstantShapeHelper::getInstance()->cacheMisses();
+}
+
+Nd4jLong getShapeCacheMemory() {
+    return nd4j::ConstantShapeHelper::getInstance()->cachedBytes();
+}
+
+Nd4jLong getTadCacheHits() {
+    return nd4j::ConstantTadHelper::getInstance()->cacheHits();
+}
+
+Nd4jLong getTadCacheMisses() {
+    return nd4j::ConstantTadHelper::getInstance()->cacheMisses();
+}
+
+Nd4jLong getTadCacheMemory() {
+    return nd4j::ConstantTadHelper::getInstance()->cachedBytes();
+}
+
+Nd4jLong getWorkspacePeakUsage(Nd4jPointer workspace) {
+    return reinterpret_cast<nd4j::memory::Workspace*>(workspace)->getPeakUsage();
+}
+
+Nd4jLong getWorkspaceNumberOfAllocations(Nd4jPointer workspace) {
+    return reinterpret_cast<nd4j::memory::Workspace*>(workspace)->getNumberOfAllocations();
+}
+
+Nd4jLong getWorkspaceNumberOfSpills(Nd4jPointer workspace) {
+    return reinterpret_cast<nd4j::memory::Workspace*>(workspace)->getNumberOfSpills();
+}
+
+Nd4jLong getWorkspaceNumberOfRecycledSpills(Nd4jPointer workspace) {
+    return reinterpret_cast<nd4j::memory::Workspace*>(workspace)->getNumberOfRecycledSpills();
+}
+
+void resetWorkspaceStats(Nd4jPointer workspace) {
+    reinterpret_cast<nd4j::memory::Workspace*>(workspace)->resetStats();
+}
+
 nd4j::LaunchContext* defaultLaunchContext() {
     return LaunchContext::defaultContext();
 }
@@ -78,6 +78,9 @@ class ND4J_EXPORT ShapeDescriptor {
         // less than operator
         bool operator<(const ShapeDescriptor &other) const;
 
+        // hash code, used to pick cache shard
+        Nd4jULong hash() const;
+
         Nd4jLong* toShapeInfo() const;
 
 
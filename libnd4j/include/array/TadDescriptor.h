@@ -51,6 +51,9 @@ namespace nd4j {
         // less than operator
         bool operator<(const TadDescriptor &other) const;
 
+        // hash code, used to pick cache shard
+        Nd4jULong hash() const;
+
         std::vector<int>& axis();
         ShapeDescriptor& originalShape();
         bool areUnitiesinShape() const;
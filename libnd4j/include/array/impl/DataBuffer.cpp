@@ -23,6 +23,8 @@
 #include <helpers/logger.h>
 #include <array/DataTypeUtils.h>
 #include <execution/AffinityManager.h>
+#include <execution/NumaTopology.h>
+#include <memory/MemoryTracker.h>
 #include <memory/MemoryCounter.h>
 #include <exceptions/allocation_exception.h>
 
@@ -248,7 +250,17 @@ namespace nd4j {
                 }
             }
 
-            ALLOCATE(_primaryBuffer, _workspace, getLenInBytes(), int8_t);
+            if (_workspace == nullptr && Environment::getInstance()->isCPU() && samediff::NumaTopology::getInstance()->isNumaAware()) {
+                // on NUMA systems pages are placed on the node of the thread touching them first, so zeroing is spread over nodes
+                auto buffer = new int8_t[getLenInBytes()];
+#ifndef _RELEASE
+                nd4j::memory::MemoryTracker::getInstance()->countIn(nd4j::memory::MemoryType::HOST, buffer, getLenInBytes());
+#endif
+                samediff::NumaTopology::firstTouch(buffer, getLenInBytes());
+                _primaryBuffer = buffer;
+            } else {
+                ALLOCATE(_primaryBuffer, _workspace, getLenInBytes(), int8_t);
+            }
             _isOwnerPrimary = true;
 
             // count in towards current deviceId if we're not in workspace mode
@@ -54,6 +54,22 @@ bool ShapeDescriptor::operator<(const ShapeDescriptor& other) const {
     return std::tie(_empty, _rank, _dataType, _ews, _order, _shape, _strides) < std::tie(other._empty, other._rank, other._dataType, other._ews, other._order, other._shape, other._strides);
 }
 
+//////////////////////////////////////////////////////////////////////////
+Nd4jULong ShapeDescriptor::hash() const {
+    auto h = static_cast<Nd4jULong>(_rank) * 31 + static_cast<Nd4jULong>(_dataType);
+    h = h * 31 + static_cast<Nd4jULong>(_ews);
+    h = h * 31 + static_cast<Nd4jULong>(_order);
+    h = h * 31 + (_empty ? 1 : 0);
+
+    for (auto v: _shape)
+        h = h * 31 + static_cast<Nd4jULong>(v);
+
+    for (auto v: _strides)
+        h = h * 31 + static_cast<Nd4jULong>(v);
+
+    return h;
+}
+
 Nd4jLong* ShapeDescriptor::toShapeInfo() const {
     if (_empty) {
         if (_rank == 0)
@@ -61,6 +61,15 @@ namespace nd4j {
         return std::tie(_originalShape, _axis, _unitiesInShape) < std::tie(other._originalShape, other._axis, other._unitiesInShape);
     }
 
+    Nd4jULong TadDescriptor::hash() const {
+        auto h = _originalShape.hash();
+
+        for (auto v: _axis)
+            h = h * 31 + static_cast<Nd4jULong>(v);
+
+        return h * 31 + (_unitiesInShape ? 1 : 0);
+    }
+
     std::vector<int>& TadDescriptor::axis() {
         return _axis;
     }
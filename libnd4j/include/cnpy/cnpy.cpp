@@ -242,6 +242,16 @@ void cnpy::parseNpyHeaderStr(std::string header,
                              unsigned int *&shape,
                              unsigned int &ndims,
                              bool &fortranOrder) {
+    bool isScalar;
+    cnpy::parseNpyHeaderStr(header, wordSize, shape, ndims, fortranOrder, isScalar);
+}
+
+void cnpy::parseNpyHeaderStr(std::string header,
+                             unsigned int &wordSize,
+                             unsigned int *&shape,
+                             unsigned int &ndims,
+                             bool &fortranOrder,
+                             bool &isScalar) {
 
 
     int loc1, loc2;
@@ -255,7 +265,11 @@ void cnpy::parseNpyHeaderStr(std::string header,
     loc1 = header.find("(");
     loc2 = header.find(")");
     std::string str_shape = header.substr(loc1 + 1,loc2 - loc1 - 1);
-    if(str_shape[str_shape.size() - 1] == ',') ndims = 1;
+
+    // () is scalar, it keeps {0} shape for compatibility
+    isScalar = str_shape.find_first_not_of(' ') == std::string::npos;
+    if(isScalar) ndims = 1;
+    else if(str_shape[str_shape.size() - 1] == ',') ndims = 1;
     else ndims = std::count(str_shape.begin(),str_shape.end(),',')+1;
 
     shape = new unsigned int[ndims];
@@ -299,6 +313,16 @@ void cnpy::parseNpyHeader(FILE *fp,
                           unsigned int *&shape,
                           unsigned int &ndims,
                           bool &fortranOrder) {
+    bool isScalar;
+    cnpy::parseNpyHeader(fp, wordSize, shape, ndims, fortranOrder, isScalar);
+}
+
+void cnpy::parseNpyHeader(FILE *fp,
+                          unsigned int &wordSize,
+                          unsigned int *&shape,
+                          unsigned int &ndims,
+                          bool &fortranOrder,
+                          bool &isScalar) {
     char buffer[256];
     size_t res = fread(buffer,sizeof(char),11,fp);
     if(res != 11)
@@ -309,7 +333,8 @@ void cnpy::parseNpyHeader(FILE *fp,
                             wordSize,
                             shape,
                             ndims,
-                            fortranOrder);
+                            fortranOrder,
+                            isScalar);
 }
 
 
@@ -355,16 +380,19 @@ void cnpy::parseZipFooter(FILE* fp,
 cnpy::NpyArray cnpy::loadNpyFromFile(FILE *fp) {
     unsigned int *shape;
     unsigned int ndims, wordSize;
-    bool fortranOrder;
-    cnpy::parseNpyHeader(fp,wordSize,shape,ndims,fortranOrder);
+    bool fortranOrder, isScalar;
+    cnpy::parseNpyHeader(fp,wordSize,shape,ndims,fortranOrder,isScalar);
     unsigned long long size = 1; //long long so no overflow when multiplying by word_size
-    for(unsigned int i = 0;i < ndims;i++) size *= shape[i];
+    if(!isScalar)
+        for(unsigned int i = 0;i < ndims;i++) size *= shape[i];
 
     cnpy::NpyArray arr;
     arr.wordSize = wordSize;
     arr.shape = std::vector<unsigned int>(shape,shape + ndims);
+    delete[] shape;
     arr.data = new char[size * wordSize];
     arr.fortranOrder = fortranOrder;
+    arr.isScalar = isScalar;
     size_t nread = fread(arr.data,wordSize,size,fp);
     if(nread != size)
         throw std::runtime_error("load_the_npy_file: failed fread");
@@ -406,12 +434,13 @@ cnpy::NpyArray cnpy::loadNpyFromHeader(char *data) {
     data += 11;
     unsigned int *shape;
     unsigned int ndims, wordSize;
-    bool fortranOrder;
+    bool fortranOrder, isScalar;
     cnpy::parseNpyHeaderStr(std::string(data),
                             wordSize,
                             shape,
                             ndims,
-                            fortranOrder);
+                            fortranOrder,
+                            isScalar);
     //the "real" data starts after the \n
     char currChar = data[0];
     int count = 0;
@@ -425,8 +454,6 @@ cnpy::NpyArray cnpy::loadNpyFromHeader(char *data) {
     data++;
     count++;
 
-    unsigned long long size = 1; //long long so no overflow when multiplying by word_size
-    for(unsigned int i = 0; i < ndims; i++) size *= shape[i];
     char *cursor = data;
     cnpy::NpyArray arr;
     arr.wordSize = wordSize;
@@ -434,6 +461,7 @@ cnpy::NpyArray cnpy::loadNpyFromHeader(char *data) {
     delete[] shape;
     arr.data = cursor;
     arr.fortranOrder = fortranOrder;
+    arr.isScalar = isScalar;
     return arr;
 }
 
@@ -603,6 +631,196 @@ cnpy::NpyArray cnpy::npyLoad(std::string fname) {
 }
 
 
+/**
+ * Reads little-endian value of given type from possibly unaligned location
+ */
+template <typename T>
+static T readLittleEndian(const char *ptr) {
+    T value;
+    memcpy(&value, ptr, sizeof(T));
+    return value;
+}
+
+/**
+ * Parses npy file located at [start, start + length) in place: data pointer of result points into the same memory
+ * @param start beginning of npy file, magic string included
+ * @param length number of bytes available
+ * @param mapping mapping start belongs to
+ * @return
+ */
+static cnpy::NpyArray parseMappedNpy(char *start, unsigned long long length, std::shared_ptr<nd4j::MappedFile> mapping) {
+    if (length < 10 || start[0] != (char) 0x93 || std::string(start + 1, 5) != "NUMPY")
+        throw std::runtime_error("npy_map: data doesn't look like a NumPy file");
+
+    // version 1.0 has 2-byte header length, versions 2.0 and 3.0 have 4-byte header length
+    const auto major = start[6];
+    unsigned long long headerStart, headerLength;
+    if (major == 1) {
+        headerStart = 10;
+        headerLength = readLittleEndian<unsigned short>(start + 8);
+    } else if (major == 2 || major == 3) {
+        if (length < 12)
+            throw std::runtime_error("npy_map: truncated NumPy header");
+
+        headerStart = 12;
+        headerLength = readLittleEndian<unsigned int>(start + 8);
+    } else
+        throw std::runtime_error("npy_map: unsupported NumPy format version");
+
+    if (headerStart + headerLength > length)
+        throw std::runtime_error("npy_map: truncated NumPy header");
+
+    unsigned int *shape;
+    unsigned int ndims, wordSize;
+    bool fortranOrder, isScalar;
+    cnpy::parseNpyHeaderStr(std::string(start + headerStart, headerLength), wordSize, shape, ndims, fortranOrder, isScalar);
+
+    unsigned long long size = 1;
+    if (!isScalar)
+        for (unsigned int i = 0; i < ndims; i++)
+            size *= shape[i];
+
+    cnpy::NpyArray arr;
+    arr.wordSize = wordSize;
+    arr.shape = std::vector<unsigned int>(shape, shape + ndims);
+    arr.fortranOrder = fortranOrder;
+    arr.isScalar = isScalar;
+    arr.data = start + headerStart + headerLength;
+    arr.mapping = mapping;
+    delete[] shape;
+
+    if (headerStart + headerLength + size * wordSize > length)
+        throw std::runtime_error("npy_map: file is shorter than array it declares");
+
+    return arr;
+}
+
+/**
+ * Memory-maps numpy array from the given file
+ * @param fname the fully qualified path for the file
+ * @return the NpArray for this file, backed by mapping
+ */
+cnpy::NpyArray cnpy::npyMap(std::string fname) {
+    auto mapping = std::make_shared<nd4j::MappedFile>(fname.c_str());
+    return parseMappedNpy(reinterpret_cast<char *>(mapping->data()), mapping->length(), mapping);
+}
+
+/**
+ * Memory-maps the numpy z archive. Entries are located through zip central directory (zip64 included),
+ * so member sizes don't have to be present in local headers
+ * @param fname the fully qualified path
+ * @return the arrays, backed by mapping
+ */
+cnpy::npz_t cnpy::npzMap(std::string fname) {
+    auto mapping = std::make_shared<nd4j::MappedFile>(fname.c_str());
+    auto base = reinterpret_cast<char *>(mapping->data());
+    unsigned long long length = mapping->length();
+
+    const unsigned int EOCD = 0x06054b50;
+    const unsigned int EOCD64 = 0x06064b50;
+    const unsigned int EOCD64_LOCATOR = 0x07064b50;
+    const unsigned int CENTRAL = 0x02014b50;
+    const unsigned int LOCAL = 0x04034b50;
+
+    if (length < 22)
+        throw std::runtime_error("npz_map: file is too short to be zip archive");
+
+    // end of central directory record is followed by variable-length comment, so we scan backwards
+    long long eocd = -1;
+    const long long lowest = length >= 22 + 65535 ? (long long) length - 22 - 65535 : 0;
+    for (long long e = (long long) length - 22; e >= lowest; e--) {
+        if (readLittleEndian<unsigned int>(base + e) == EOCD) {
+            eocd = e;
+            break;
+        }
+    }
+
+    if (eocd < 0)
+        throw std::runtime_error("npz_map: end of central directory wasn't found");
+
+    unsigned long long entries = readLittleEndian<unsigned short>(base + eocd + 10);
+    unsigned long long directory = readLittleEndian<unsigned int>(base + eocd + 16);
+
+    if (entries == 0xFFFF || directory == 0xFFFFFFFF) {
+        if (eocd < 20 || readLittleEndian<unsigned int>(base + eocd - 20) != EOCD64_LOCATOR)
+            throw std::runtime_error("npz_map: zip64 locator wasn't found");
+
+        auto eocd64 = readLittleEndian<unsigned long long>(base + eocd - 20 + 8);
+        if (eocd64 + 56 > length || readLittleEndian<unsigned int>(base + eocd64) != EOCD64)
+            throw std::runtime_error("npz_map: broken zip64 end of central directory");
+
+        entries = readLittleEndian<unsigned long long>(base + eocd64 + 32);
+        directory = readLittleEndian<unsigned long long>(base + eocd64 + 48);
+    }
+
+    cnpy::npz_t arrays;
+    auto cursor = directory;
+    for (unsigned long long e = 0; e < entries; e++) {
+        if (cursor + 46 > length || readLittleEndian<unsigned int>(base + cursor) != CENTRAL)
+            throw std::runtime_error("npz_map: broken central directory");
+
+        auto method = readLittleEndian<unsigned short>(base + cursor + 10);
+        unsigned long long compressedSize = readLittleEndian<unsigned int>(base + cursor + 20);
+        unsigned long long uncompressedSize = readLittleEndian<unsigned int>(base + cursor + 24);
+        auto nameLength = readLittleEndian<unsigned short>(base + cursor + 28);
+        auto extraLength = readLittleEndian<unsigned short>(base + cursor + 30);
+        auto commentLength = readLittleEndian<unsigned short>(base + cursor + 32);
+        unsigned long long localOffset = readLittleEndian<unsigned int>(base + cursor + 42);
+
+        if (cursor + 46 + nameLength + extraLength > length)
+            throw std::runtime_error("npz_map: broken central directory");
+
+        std::string varname(base + cursor + 46, nameLength);
+
+        // zip64 extended information holds only those fields, that are saturated in the record itself
+        auto extra = cursor + 46 + nameLength;
+        auto extraEnd = extra + extraLength;
+        while (extra + 4 <= extraEnd) {
+            auto id = readLittleEndian<unsigned short>(base + extra);
+            auto size = readLittleEndian<unsigned short>(base + extra + 2);
+            if (id == 0x0001) {
+                auto field = extra + 4;
+                if (uncompressedSize == 0xFFFFFFFF && field + 8 <= extraEnd) {
+                    uncompressedSize = readLittleEndian<unsigned long long>(base + field);
+                    field += 8;
+                }
+
+                if (compressedSize == 0xFFFFFFFF && field + 8 <= extraEnd) {
+                    compressedSize = readLittleEndian<unsigned long long>(base + field);
+                    field += 8;
+                }
+
+                if (localOffset == 0xFFFFFFFF && field + 8 <= extraEnd)
+                    localOffset = readLittleEndian<unsigned long long>(base + field);
+            }
+            extra += 4 + size;
+        }
+
+        cursor += 46 + nameLength + extraLength + commentLength;
+
+        //erase the lagging .npy
+        if (varname.size() >= 4 && varname.compare(varname.size() - 4, 4, ".npy") == 0)
+            varname.resize(varname.size() - 4);
+
+        if (method != 0) {
+            printf("npz_map: Error! Variable %s in %s is compressed, only stored members can be mapped\n", varname.c_str(), fname.c_str());
+            throw std::runtime_error("npz_map: compressed members aren't supported");
+        }
+
+        if (localOffset + 30 > length || readLittleEndian<unsigned int>(base + localOffset) != LOCAL)
+            throw std::runtime_error("npz_map: broken local header");
+
+        auto data = localOffset + 30 + readLittleEndian<unsigned short>(base + localOffset + 26) + readLittleEndian<unsigned short>(base + localOffset + 28);
+        if (data + compressedSize > length)
+            throw std::runtime_error("npz_map: member exceeds archive");
+
+        arrays[varname] = parseMappedNpy(base + data, compressedSize, mapping);
+    }
+
+    return arrays;
+}
+
+
 /**
      * Save the numpy array
      * @tparam T
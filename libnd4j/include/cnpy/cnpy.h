@@ -49,9 +49,11 @@
 #include <string>
 #include <fstream>
 #include <streambuf>
+#include <memory>
 #include <op_boilerplate.h>
 #include <dll.h>
 #include <array/DataType.h>
+#include <helpers/MappedFile.h>
 
 
 namespace cnpy {
@@ -64,8 +66,16 @@ namespace cnpy {
         std::vector<unsigned int> shape;
         unsigned int wordSize;
         bool fortranOrder;
+
+        // set if header declares () shape. shape is {0} for scalars, same as for (0,), so this flag tells them apart
+        bool isScalar = false;
+
+        // set if data points into memory-mapped file, mapping stays alive as long as any copy of this struct
+        std::shared_ptr<nd4j::MappedFile> mapping;
+
         void destruct() {
-            delete[] data;
+            if (mapping == nullptr)
+                delete[] data;
         }
     };
 
@@ -132,6 +142,17 @@ namespace cnpy {
                         unsigned int &ndims,
                         bool &fortranOrder);
 
+    /**
+     * Same as above
+     * @param isScalar set to true if header declares () shape
+     */
+    ND4J_EXPORT void parseNpyHeader(FILE *fp,
+                        unsigned int &wordSize,
+                        unsigned int *&shape,
+                        unsigned int &ndims,
+                        bool &fortranOrder,
+                        bool &isScalar);
+
     /**
     * Parse the numpy header from
     * the given file
@@ -193,6 +214,17 @@ namespace cnpy {
                            unsigned int &ndims,
                            bool &fortranOrder);
 
+    /**
+     * Same as above
+     * @param isScalar set to true if header declares () shape, shape is {0} then
+     */
+    ND4J_EXPORT void parseNpyHeaderStr(std::string header,
+                           unsigned int &wordSize,
+                           unsigned int *&shape,
+                           unsigned int &ndims,
+                           bool &fortranOrder,
+                           bool &isScalar);
+
 
     /**
      *
@@ -238,6 +270,22 @@ namespace cnpy {
 
     ND4J_EXPORT npz_t npzLoad(std::string fname);
 
+    /**
+     * Memory-maps the given .npy file. Returned array points directly into mapping,
+     * so nothing is read until pages are actually touched
+     * @param fname the fully qualified path
+     * @return the array, backed by mapping
+     */
+    ND4J_EXPORT NpyArray npyMap(std::string fname);
+
+    /**
+     * Memory-maps the given .npz file. Stored (uncompressed) members point directly into mapping,
+     * compressed members aren't supported and cause std::runtime_error
+     * @param fname the fully qualified path
+     * @return the arrays, backed by mapping
+     */
+    ND4J_EXPORT npz_t npzMap(std::string fname);
+
     ND4J_EXPORT nd4j::DataType dataTypeFromHeader(char *data);
 /**
 * Parse the numpy header from
@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// NUMA layout of the host, used for thread pinning and node-local allocations
+//
+
+#ifndef SAMEDIFF_NUMATOPOLOGY_H
+#define SAMEDIFF_NUMATOPOLOGY_H
+
+#include <dll.h>
+#include <pointercast.h>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace samediff {
+    /**
+     * Description of NUMA nodes available to the thread pool: which cpus belong to which node.
+     *
+     * Topology is read from /sys/devices/system/node on Linux. SD_NUMA_NODES env var allows to disable NUMA awareness (1),
+     * or to split cores into given number of simulated nodes (> 1), in which case threads aren't pinned.
+     *
+     * Parallel regions are partitioned over nodes in contiguous blocks of chunks: chunk c out of N goes to nodeOfChunk(c, N).
+     * Large buffers are first-touched using the same partitioning, so pages end up on the node that'll process them.
+     */
+    class ND4J_EXPORT NumaTopology {
+    private:
+        static NumaTopology* _INSTANCE;
+
+        // cpu ids per node
+        std::vector<std::vector<int>> _nodes;
+
+        // true if topology was read from the system, so threads can be bound to the nodes
+        bool _detected = false;
+
+        void split(int numNodes, int numCpus);
+    public:
+        /**
+         * This constructor detects topology of the current system
+         */
+        NumaTopology();
+
+        /**
+         * This constructor creates simulated topology: numCpus are split evenly into numNodes nodes
+         */
+        NumaTopology(int numNodes, int numCpus);
+
+        ~NumaTopology() = default;
+
+        static NumaTopology* getInstance();
+
+        int numberOfNodes() const;
+        bool isNumaAware() const;
+        bool isDetected() const;
+
+        const std::vector<int>& cpusOfNode(int node) const;
+
+        /**
+         * This method returns node the given cpu belongs to, or 0 for unknown cpus
+         */
+        int nodeOfCpu(int cpu) const;
+
+        /**
+         * This method returns node responsible for the given chunk, when numChunks chunks are spread over nodes
+         */
+        int nodeOfChunk(int64_t chunk, int64_t numChunks) const;
+
+        /**
+         * This method returns first chunk of the given node, nodes own [firstChunk(n), firstChunk(n + 1))
+         */
+        int64_t firstChunk(int node, int64_t numChunks) const;
+
+        /**
+         * This method binds calling thread to the cpus of the given node. Does nothing for simulated topology
+         * @return true if thread was bound
+         */
+        bool bindCurrentThread(int node) const;
+
+        /**
+         * This method zeroes buffer. If topology has more than one node and buffer is large enough, pages are zeroed by pool threads,
+         * using the same partitioning parallel_for uses, so each page is placed on the node that'll process it
+         */
+        static void firstTouch(void *buffer, size_t numBytes);
+    };
+}
+
+#endif //SAMEDIFF_NUMATOPOLOGY_H
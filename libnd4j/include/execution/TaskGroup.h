@@ -0,0 +1,73 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Single parallel region, split into chunks executed by the work-stealing pool
+//
+
+#ifndef SAMEDIFF_TASKGROUP_H
+#define SAMEDIFF_TASKGROUP_H
+
+#include <functional>
+#include <openmp_pragmas.h>
+#include <dll.h>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+namespace samediff {
+    /**
+     * This class describes single parallel region: function is executed once for each chunk in [0, numChunks),
+     * chunk id is passed to the function as thread_id, so per-thread buffers indexed by thread_id stay valid
+     */
+    class ND4J_EXPORT TaskGroup {
+    private:
+        FUNC_DO _function;
+        uint64_t _numChunks;
+
+        std::atomic<int64_t> _pending;
+        std::atomic<bool> _failed;
+        std::exception_ptr _exception;
+
+        bool _done = false;
+        std::mutex _mutex;
+        std::condition_variable _condition;
+    public:
+        TaskGroup(FUNC_DO function, uint64_t numChunks);
+        ~TaskGroup() = default;
+
+        uint64_t numChunks() const;
+
+        /**
+         * This method executes given chunk, exceptions are captured and re-thrown in waiting thread
+         */
+        void run(uint64_t chunk);
+
+        /**
+         * This method returns true if all chunks were executed
+         */
+        bool finished() const;
+
+        /**
+         * This method blocks until all chunks are executed, and re-throws first exception thrown by any chunk
+         */
+        void wait();
+    };
+}
+
+#endif //SAMEDIFF_TASKGROUP_H
@@ -21,29 +21,52 @@
 #ifndef SAMEDIFF_THREADPOOL_H
 #define SAMEDIFF_THREADPOOL_H
 
-#include <list>
 #include <vector>
 #include <thread>
 #include <atomic>
 #include <mutex>
-#include <execution/BlockingQueue.h>
-#include <execution/CallableWithArguments.h>
-#include <execution/CallableInterface.h>
-#include <execution/Ticket.h>
-#include <queue>
+#include <condition_variable>
+#include <execution/TaskGroup.h>
+#include <execution/WorkDeque.h>
+#include <execution/NumaTopology.h>
 
 namespace samediff {
+    /**
+     * Work-stealing thread pool: each worker owns a queue of tasks, idle workers steal halves of ranges from other workers,
+     * and thread that submitted a task group executes chunks of that group while waiting for its completion.
+     * Nested parallel regions submitted from worker threads go to that worker's own queue, so they're never serialized
+     * just because all threads are busy.
+     *
+     * On NUMA systems workers are grouped per node and bound to cpus of their node. Chunks of a region are spread over nodes
+     * in contiguous blocks (see NumaTopology), and idle workers steal from their own node before going to remote ones.
+     */
     class ND4J_EXPORT ThreadPool {
     private:
         static ThreadPool* _INSTANCE;
 
         std::vector<std::thread*> _threads;
-        std::vector<BlockingQueue<CallableWithArguments*>*> _queues;
-        std::vector<CallableInterface*> _interfaces;
+        std::vector<WorkDeque*> _deques;
+
+        // node of each worker, and workers of each node
+        std::vector<int> _workerNodes;
+        std::vector<std::vector<int>> _nodeWorkers;
+
+        // number of chunks sitting in queues, workers sleep only when it's 0
+        std::atomic<int64_t> _queued{0};
+        std::atomic<uint32_t> _counter{0};
+        std::atomic<int64_t> _stolen{0};
+        std::atomic<bool> _stopping{false};
 
         std::mutex _lock;
-        std::atomic<int> _available;
-        std::queue<Ticket*> _tickets;
+        std::condition_variable _condition;
+
+        void workerLoop(int workerId);
+
+        bool acquire(int workerId, Task &task);
+        bool steal(int workerId, const std::vector<int> &victims, Task &task);
+        bool acquire(int workerId, TaskGroup *group, Task &task);
+        void execute(int workerId, Task &task);
+        void wakeUp(int64_t numChunks);
     protected:
         ThreadPool();
         ~ThreadPool();
@@ -51,21 +74,37 @@ namespace samediff {
         static ThreadPool* getInstance();
 
         /**
-         * This method returns list of pointers to threads ONLY if num_threads of threads were available upon request, returning empty list otherwise
-         * @param num_threads
-         * @return
+         * This method executes all chunks of the group, and blocks until they are finished
+         * Calling thread takes part in execution
          */
-        Ticket* tryAcquire(int num_threads);
+        void execute(TaskGroup &group);
 
         /**
-         * This method marks specified number of threads as released, and available for use
-         * @param num_threads
+         * This method returns number of worker threads
          */
-        void release(int num_threads = 1);
+        int numberOfWorkers() const;
 
-        void release(Ticket *ticket);
+        /**
+         * This method returns number of NUMA nodes workers are spread over
+         */
+        int numberOfNodes() const;
+
+        /**
+         * This method returns NUMA node of the given worker
+         */
+        int nodeOfWorker(int workerId) const;
+
+        /**
+         * This method returns id of worker for calling thread, or -1 if it's not a pool thread
+         */
+        static int currentWorker();
+
+        /**
+         * This method returns number of ranges stolen by workers since pool creation
+         */
+        int64_t stolenTasks() const;
     };
 }
 
 
-#endif //DEV_TESTS_THREADPOOL_H
+#endif //SAMEDIFF_THREADPOOL_H
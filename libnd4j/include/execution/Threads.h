@@ -96,6 +96,19 @@ namespace samediff {
 
     class ND4J_EXPORT Threads {
     public:
+        /**
+         * This method caps number of threads parallel regions started from the calling thread may use.
+         * Used to split cores between ops executed concurrently
+         *
+         * @param numThreads - max number of threads, 0 removes the cap
+         */
+        static void setThreadsLimit(int numThreads);
+
+        /**
+         * This method returns cap for the calling thread, 0 if there's none
+         */
+        static int threadsLimit();
+
         /**
          * This function executes 1 dimensional loop for a given number of threads
          * PLEASE NOTE: this function can use smaller number of threads than requested.
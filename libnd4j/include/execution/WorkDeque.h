@@ -0,0 +1,74 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Per-worker task queue of the work-stealing pool
+//
+
+#ifndef SAMEDIFF_WORKDEQUE_H
+#define SAMEDIFF_WORKDEQUE_H
+
+#include <execution/TaskGroup.h>
+#include <deque>
+#include <mutex>
+
+namespace samediff {
+    /**
+     * Range of chunks [start, stop) of some TaskGroup
+     */
+    struct Task {
+        TaskGroup *group = nullptr;
+        int64_t start = 0;
+        int64_t stop = 0;
+    };
+
+    /**
+     * Per-worker queue of tasks. Owner pushes and pops from the back, thieves take from the front,
+     * splitting ranges in halves, so large ranges spread across idle workers quickly
+     */
+    class ND4J_EXPORT WorkDeque {
+    private:
+        std::deque<Task> _tasks;
+        std::mutex _mutex;
+    public:
+        WorkDeque() = default;
+        ~WorkDeque() = default;
+
+        void push(const Task &task);
+
+        /**
+         * This method pops single chunk from the back of the queue, rest of the range stays in the queue
+         * @return true if chunk was acquired
+         */
+        bool pop(Task &task);
+
+        /**
+         * This method takes upper half of the front range, or whole range if it has single chunk
+         * @return true if anything was stolen
+         */
+        bool steal(Task &task);
+
+        /**
+         * This method takes single chunk of the given group, if this queue holds any
+         * @return true if chunk was acquired
+         */
+        bool take(TaskGroup *group, Task &task);
+
+        bool empty();
+    };
+}
+
+#endif //SAMEDIFF_WORKDEQUE_H
@@ -0,0 +1,237 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// NUMA layout discovery from sysfs, or simulated nodes requested via Environment
+//
+
+#include <execution/NumaTopology.h>
+#include <execution/Threads.h>
+#include <Environment.h>
+#include <helpers/logger.h>
+#include <thread>
+#include <mutex>
+#include <cstring>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <cstdio>
+
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <pthread.h>
+#include <sched.h>
+#include <dirent.h>
+#define SD_NUMA_LINUX
+#endif
+
+// buffers below this size are zeroed by calling thread
+#define NUMA_FIRST_TOUCH_THRESHOLD (4L * 1024L * 1024L)
+
+namespace samediff {
+
+#ifdef SD_NUMA_LINUX
+    // parses cpulist format, i.e. "0-7,16-23"
+    static std::vector<int> parseCpuList(const std::string &list) {
+        std::vector<int> result;
+        size_t pos = 0;
+        while (pos < list.size()) {
+            auto end = list.find(',', pos);
+            if (end == std::string::npos)
+                end = list.size();
+
+            auto token = list.substr(pos, end - pos);
+            pos = end + 1;
+
+            if (token.empty() || token[0] == '\n')
+                continue;
+
+            try {
+                auto dash = token.find('-');
+                if (dash == std::string::npos) {
+                    result.emplace_back(std::stoi(token));
+                } else {
+                    auto first = std::stoi(token.substr(0, dash));
+                    auto last = std::stoi(token.substr(dash + 1));
+                    for (int e = first; e <= last; e++)
+                        result.emplace_back(e);
+                }
+            } catch (std::exception &e) {
+                // malformed token, skipping it
+            }
+        }
+
+        return result;
+    }
+#endif
+
+    NumaTopology::NumaTopology() {
+        auto numCpus = static_cast<int>(std::thread::hardware_concurrency());
+        if (numCpus < 1)
+            numCpus = 1;
+
+        auto requested = nd4j::Environment::getInstance()->numaNodes();
+        if (requested > 0) {
+            // simulated nodes are never bound to cpus, so pool size is allowed to define number of "cpus" here
+            split(requested, std::max(numCpus, nd4j::Environment::getInstance()->maxThreads()));
+            return;
+        }
+
+#ifdef SD_NUMA_LINUX
+        auto dir = opendir("/sys/devices/system/node");
+        if (dir != nullptr) {
+            std::vector<int> ids;
+            struct dirent *entry;
+            while ((entry = readdir(dir)) != nullptr) {
+                int id;
+                if (sscanf(entry->d_name, "node%d", &id) == 1)
+                    ids.emplace_back(id);
+            }
+            closedir(dir);
+
+            std::sort(ids.begin(), ids.end());
+            for (auto id : ids) {
+                std::ifstream file("/sys/devices/system/node/node" + std::to_string(id) + "/cpulist");
+                std::string list;
+                if (!file.good() || !std::getline(file, list))
+                    continue;
+
+                // memory-only nodes have no cpus, there's nothing to schedule there
+                auto cpus = parseCpuList(list);
+                if (!cpus.empty())
+                    _nodes.emplace_back(cpus);
+            }
+        }
+
+        if (!_nodes.empty()) {
+            _detected = true;
+            return;
+        }
+#endif
+
+        split(1, numCpus);
+    }
+
+    NumaTopology::NumaTopology(int numNodes, int numCpus) {
+        split(numNodes, numCpus);
+    }
+
+    void NumaTopology::split(int numNodes, int numCpus) {
+        if (numCpus < 1)
+            numCpus = 1;
+
+        if (numNodes < 1)
+            numNodes = 1;
+
+        if (numNodes > numCpus)
+            numNodes = numCpus;
+
+        _nodes.clear();
+        _nodes.resize(numNodes);
+        for (int e = 0; e < numCpus; e++)
+            _nodes[static_cast<int64_t>(e) * numNodes / numCpus].emplace_back(e);
+
+        _detected = false;
+    }
+
+    static std::mutex _lmutex;
+
+    NumaTopology* NumaTopology::getInstance() {
+        std::unique_lock<std::mutex> lock(_lmutex);
+        if (!_INSTANCE)
+            _INSTANCE = new NumaTopology();
+
+        return _INSTANCE;
+    }
+
+    int NumaTopology::numberOfNodes() const {
+        return static_cast<int>(_nodes.size());
+    }
+
+    bool NumaTopology::isNumaAware() const {
+        return _nodes.size() > 1;
+    }
+
+    bool NumaTopology::isDetected() const {
+        return _detected;
+    }
+
+    const std::vector<int>& NumaTopology::cpusOfNode(int node) const {
+        return _nodes.at(node);
+    }
+
+    int NumaTopology::nodeOfCpu(int cpu) const {
+        for (size_t n = 0; n < _nodes.size(); n++)
+            for (auto c : _nodes[n])
+                if (c == cpu)
+                    return static_cast<int>(n);
+
+        return 0;
+    }
+
+    int NumaTopology::nodeOfChunk(int64_t chunk, int64_t numChunks) const {
+        if (numChunks < 1)
+            return 0;
+
+        // inverse of firstChunk(): largest node with firstChunk(node) <= chunk
+        return static_cast<int>(((chunk + 1) * numberOfNodes() - 1) / numChunks);
+    }
+
+    int64_t NumaTopology::firstChunk(int node, int64_t numChunks) const {
+        return static_cast<int64_t>(node) * numChunks / numberOfNodes();
+    }
+
+    bool NumaTopology::bindCurrentThread(int node) const {
+#ifdef SD_NUMA_LINUX
+        if (!_detected || node < 0 || node >= numberOfNodes())
+            return false;
+
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        for (auto c : _nodes[node])
+            if (c < CPU_SETSIZE)
+                CPU_SET(c, &cpuset);
+
+        auto rc = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+        if (rc != 0) {
+            nd4j_printf("Failed to bind thread to NUMA node %i\n", node);
+            return false;
+        }
+
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void NumaTopology::firstTouch(void *buffer, size_t numBytes) {
+        if (buffer == nullptr || numBytes == 0)
+            return;
+
+        if (numBytes < NUMA_FIRST_TOUCH_THRESHOLD || !getInstance()->isNumaAware()) {
+            memset(buffer, 0, numBytes);
+            return;
+        }
+
+        auto bytes = reinterpret_cast<int8_t *>(buffer);
+        auto func = PRAGMA_THREADS_FOR {
+            memset(bytes + start, 0, stop - start);
+        };
+
+        Threads::parallel_for(func, 0, static_cast<int64_t>(numBytes));
+    }
+
+    NumaTopology* NumaTopology::_INSTANCE = 0;
+}
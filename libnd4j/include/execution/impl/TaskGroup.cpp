@@ -0,0 +1,67 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// TaskGroup implementation
+//
+
+#include <execution/TaskGroup.h>
+
+namespace samediff {
+    TaskGroup::TaskGroup(FUNC_DO function, uint64_t numChunks) : _function(std::move(function)), _numChunks(numChunks), _pending(numChunks), _failed(false) {
+        //
+    }
+
+    uint64_t TaskGroup::numChunks() const {
+        return _numChunks;
+    }
+
+    void TaskGroup::run(uint64_t chunk) {
+        // once something failed, remaining chunks are just skipped
+        if (!_failed.load()) {
+            try {
+                _function(chunk, _numChunks);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (!_failed.load()) {
+                    _exception = std::current_exception();
+                    _failed = true;
+                }
+            }
+        }
+
+        // last chunk wakes up waiting thread. notification happens under lock, so group can't be destroyed before it's done
+        if (_pending.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _done = true;
+            _condition.notify_all();
+        }
+    }
+
+    bool TaskGroup::finished() const {
+        return _pending.load() == 0;
+    }
+
+    void TaskGroup::wait() {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _condition.wait(lock, [&] { return _done; });
+        }
+
+        if (_failed.load())
+            std::rethrow_exception(_exception);
+    }
+}
@@ -19,115 +19,53 @@
 //
 
 #include <execution/ThreadPool.h>
+#include <Environment.h>
 #include <stdexcept>
+#include <algorithm>
 #include <helpers/logger.h>
 
-#if defined(_WIN32) || defined(_WIN64)
-//#include <windows.h>
-#endif
-
 namespace samediff {
 
-    // this function executed once per thread, it polls functions from queue, and executes them via wrapper
-    static void executionLoop_(int thread_id, BlockingQueue<CallableWithArguments*> *queue) {
-        while (true) {
-            // this method blocks until there's something within queue
-            auto c = queue->poll();
-            //nd4j_printf("ThreadPool: starting thread %i\n", c->threadId());
-            switch (c->dimensions()) {
-                case 0: {
-                        c->function_do()(c->threadId(), c->numThreads());
-                        c->finish();
-                    }
-                    break;
-                case 1: {
-                        auto args = c->arguments();
-                        c->function_1d()(c->threadId(), args[0], args[1], args[2]);
-                        c->finish();
-                    }
-                    break;
-                case 2: {
-                        auto args = c->arguments();
-                        c->function_2d()(c->threadId(), args[0], args[1], args[2], args[3], args[4], args[5]);
-                        c->finish();
-                        //nd4j_printf("ThreadPool: finished thread %i\n", c->threadId());
-                    }
-                    break;
-                case 3: {
-                        auto args = c->arguments();
-                        c->function_3d()(c->threadId(), args[0], args[1], args[2], args[3], args[4], args[5], args[6], args[7], args[8]);
-                        c->finish();
-                    }
-                    break;
-                default:
-                    throw std::runtime_error("Don't know what to do with provided Callable");
-            }
-        }
-    }
+    // id of the worker for pool threads, -1 for everyone else
+    static thread_local int _workerId = -1;
 
-    static void executionLoopWithInterface_(int thread_id, CallableInterface *c) {
-        while (true) {
-            // blocking here until there's something to do
-            c->waitForTask();
+    ThreadPool::ThreadPool() {
+        auto numThreads = nd4j::Environment::getInstance()->maxThreads();
 
-            // execute whatever we have
-            c->execute();
-        }
-    }
+        _deques.resize(numThreads);
+        _threads.resize(numThreads);
 
-    ThreadPool::ThreadPool() {
-        // TODO: number of threads must reflect number of cores for UMA system. In case of NUMA it should be per-device pool
-        // FIXME: on mobile phones this feature must NOT be used
-        _available = nd4j::Environment::getInstance()->maxThreads();
-
-        _queues.resize(_available.load());
-        _threads.resize(_available.load());
-        _interfaces.resize(_available.load());
-
-        // creating threads here
-        for (int e = 0; e < _available.load(); e++) {
-            _queues[e] = new BlockingQueue<CallableWithArguments*>(2);
-            _interfaces[e] = new CallableInterface();
-            _threads[e] = new std::thread(executionLoopWithInterface_, e, _interfaces[e]);
-            _tickets.push(new Ticket());
-            // _threads[e] = new std::thread(executionLoop_, e, _queues[e]);
-
-            // TODO: add other platforms here as well
-            // now we must set affinity, and it's going to be platform-specific thing
-#ifdef LINUX_BUILD
-            cpu_set_t cpuset;
-            CPU_ZERO(&cpuset);
-            CPU_SET(e, &cpuset);
-            int rc = pthread_setaffinity_np(_threads[e]->native_handle(), sizeof(cpu_set_t), &cpuset);
-            if (rc != 0)
-                throw std::runtime_error("Failed to set pthread affinity");
-#endif
-            /*
-#if defined(_WIN32) || defined(_WIN64)
-            // we can't set affinity to more than 64 cores
-            if (e <= 64) {
-                auto mask = (static_cast<DWORD_PTR>(1) << e);
-                auto result = SetThreadAffinityMask(_threads[e]->native_handle(), mask);
-                if (!result)
-                    throw std::runtime_error("Failed to set pthread affinity");
-            }
+        // workers are split over nodes in contiguous groups, every node gets at least one worker if there are enough of them
+        auto topology = NumaTopology::getInstance();
+        auto numNodes = std::max(1, std::min(topology->numberOfNodes(), numThreads));
+        _workerNodes.resize(numThreads);
+        _nodeWorkers.resize(numNodes);
 
-            // that's fine. no need for time_critical here
-            SetThreadPriority(_threads[e]->native_handle(), THREAD_PRIORITY_HIGHEST);
-#endif
-             */
+        for (int e = 0; e < numThreads; e++) {
+            _deques[e] = new WorkDeque();
+            _workerNodes[e] = static_cast<int>(static_cast<int64_t>(e) * numNodes / numThreads);
+            _nodeWorkers[_workerNodes[e]].emplace_back(e);
         }
+
+        // creating threads here, once all queues are in place
+        for (int e = 0; e < numThreads; e++)
+            _threads[e] = new std::thread(&ThreadPool::workerLoop, this, e);
     }
 
     ThreadPool::~ThreadPool() {
-        // TODO: implement this one properly
-        for (int e = 0; e < _queues.size(); e++) {
-            // stop each and every thread
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            _stopping = true;
+        }
+        _condition.notify_all();
 
-            // release queue and thread
-            //delete _queues[e];
-            //delete _threads[e];
+        for (auto t : _threads) {
+            t->join();
+            delete t;
         }
+
+        for (auto d : _deques)
+            delete d;
     }
 
     static std::mutex _lmutex;
@@ -140,55 +78,173 @@ namespace samediff {
         return _INSTANCE;
     }
 
-    void ThreadPool::release(int numThreads) {
-        _available += numThreads;
+    int ThreadPool::numberOfWorkers() const {
+        return static_cast<int>(_threads.size());
     }
 
-    Ticket* ThreadPool::tryAcquire(int numThreads) {
-        //std::vector<BlockingQueue<CallableWithArguments*>*> queues;
+    int ThreadPool::currentWorker() {
+        return _workerId;
+    }
 
-        Ticket *t = nullptr;
-        // we check for threads availability first
-        bool threaded = false;
-        {
-            // we lock before checking availability
-            std::unique_lock<std::mutex> lock(_lock);
-            if (_available >= numThreads) {
-                threaded = true;
-                _available -= numThreads;
-
-                // getting a ticket from the queue
-                t = _tickets.front();
-                _tickets.pop();
-
-                // ticket must contain information about number of threads for the current session
-                t->acquiredThreads(numThreads);
-
-                // filling ticket with executable interfaces
-                for (int e = 0, i = 0; e < _queues.size() && i < numThreads; e++) {
-                    if (_interfaces[e]->available()) {
-                        t->attach(i++, _interfaces[e]);
-                        _interfaces[e]->markUnavailable();
-                    }
-                }
+    int ThreadPool::numberOfNodes() const {
+        return static_cast<int>(_nodeWorkers.size());
+    }
+
+    int ThreadPool::nodeOfWorker(int workerId) const {
+        return _workerNodes.at(workerId);
+    }
+
+    int64_t ThreadPool::stolenTasks() const {
+        return _stolen.load();
+    }
+
+    void ThreadPool::wakeUp(int64_t numChunks) {
+        // taking the lock here guarantees that worker checking _queued before going to sleep won't miss this notification
+        { std::lock_guard<std::mutex> lock(_lock); }
+
+        if (numChunks >= (int64_t) _threads.size())
+            _condition.notify_all();
+        else
+            for (int64_t e = 0; e < numChunks; e++)
+                _condition.notify_one();
+    }
+
+    bool ThreadPool::steal(int workerId, const std::vector<int> &victims, Task &task) {
+        // starting from different victims to spread contention
+        auto numVictims = victims.size();
+        auto offset = _counter++;
+        for (size_t e = 0; e < numVictims; e++) {
+            auto victim = victims[(offset + e) % numVictims];
+            if (victim == workerId)
+                continue;
+
+            if (_deques[victim]->steal(task)) {
+                _queued -= task.stop - task.start;
+                _stolen++;
+                return true;
             }
         }
 
-        // we either dispatch tasks to threads, or run single-threaded
-        if (threaded) {
-            return t;
-        } else {
-            // if there's no threads available - return nullptr
-            return nullptr;
+        return false;
+    }
+
+    bool ThreadPool::acquire(int workerId, Task &task) {
+        // own queue first
+        if (workerId >= 0 && _deques[workerId]->pop(task)) {
+            _queued--;
+            return true;
         }
+
+        // then workers of the same node, their chunks are backed by local memory
+        auto node = workerId >= 0 ? _workerNodes[workerId] : 0;
+        if (steal(workerId, _nodeWorkers[node], task))
+            return true;
+
+        // and remote nodes only after that
+        for (size_t n = 1; n < _nodeWorkers.size(); n++)
+            if (steal(workerId, _nodeWorkers[(node + n) % _nodeWorkers.size()], task))
+                return true;
+
+        return false;
     }
 
-    void ThreadPool::release(samediff::Ticket *ticket) {
-        // returning ticket back to the queue
-        std::unique_lock<std::mutex> lock(_lock);
-        _tickets.push(ticket);
+    bool ThreadPool::acquire(int workerId, TaskGroup *group, Task &task) {
+        auto numDeques = _deques.size();
+        auto first = workerId >= 0 ? workerId : 0;
+
+        for (size_t e = 0; e < numDeques; e++) {
+            if (_deques[(first + e) % numDeques]->take(group, task)) {
+                _queued--;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void ThreadPool::execute(int workerId, Task &task) {
+        // if we've got more than one chunk - the rest goes to our own queue, so it's available for stealing
+        if (task.stop - task.start > 1 && workerId >= 0) {
+            Task rest;
+            rest.group = task.group;
+            rest.start = task.start + 1;
+            rest.stop = task.stop;
+
+            _deques[workerId]->push(rest);
+            _queued += rest.stop - rest.start;
+            wakeUp(rest.stop - rest.start);
+        }
+
+        task.group->run(task.start);
+    }
+
+    void ThreadPool::workerLoop(int workerId) {
+        _workerId = workerId;
+
+        if (_nodeWorkers.size() > 1)
+            NumaTopology::getInstance()->bindCurrentThread(_workerNodes[workerId]);
+
+        Task task;
+        while (true) {
+            if (acquire(workerId, task)) {
+                execute(workerId, task);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(_lock);
+            _condition.wait(lock, [&] { return _queued.load() > 0 || _stopping.load(); });
+
+            if (_stopping.load())
+                return;
+        }
     }
 
+    void ThreadPool::execute(TaskGroup &group) {
+        auto numChunks = static_cast<int64_t>(group.numChunks());
+        if (numChunks == 0)
+            return;
+
+        auto workerId = currentWorker();
+
+        Task task;
+        task.group = &group;
+
+        auto numNodes = static_cast<int64_t>(_nodeWorkers.size());
+        if (workerId < 0 && numNodes > 1 && numChunks >= numNodes) {
+            // external requests are split over nodes in contiguous blocks, so each part of the data is processed on its own node
+            // same partitioning as NumaTopology::firstChunk()
+            auto offset = _counter++;
+            for (int n = 0; n < numNodes; n++) {
+                auto &workers = _nodeWorkers[n];
+
+                task.start = n * numChunks / numNodes;
+                task.stop = (n + 1) * numChunks / numNodes;
+                if (task.start >= task.stop)
+                    continue;
+
+                _deques[workers[offset % workers.size()]]->push(task);
+            }
+        } else {
+            // nested regions go to the worker's own queue, external requests are spread over workers
+            auto target = workerId >= 0 ? workerId : static_cast<int>(_counter++ % _deques.size());
+
+            task.start = 0;
+            task.stop = numChunks;
+            _deques[target]->push(task);
+        }
+
+        _queued += numChunks;
+
+        // one chunk will be executed by this thread
+        wakeUp(numChunks - 1);
+
+        // helping: we're executing chunks of our own group until there's nothing left in queues
+        while (acquire(workerId, &group, task))
+            task.group->run(task.start);
+
+        // some chunks might still be executed by other threads
+        group.wait();
+    }
 
     ThreadPool* ThreadPool::_INSTANCE = 0;
 }
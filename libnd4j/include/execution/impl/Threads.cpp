@@ -28,6 +28,22 @@
 
 namespace samediff {
 
+    // per-thread cap for the number of threads used by parallel regions, 0 means no cap
+    static thread_local int _threadsLimit = 0;
+
+    template <typename T>
+    static FORCEINLINE T limitThreads(T numThreads) {
+        return _threadsLimit > 0 && numThreads > static_cast<T>(_threadsLimit) ? static_cast<T>(_threadsLimit) : numThreads;
+    }
+
+    void Threads::setThreadsLimit(int numThreads) {
+        _threadsLimit = numThreads < 0 ? 0 : numThreads;
+    }
+
+    int Threads::threadsLimit() {
+        return _threadsLimit;
+    }
+
     int ThreadsHelper::numberOfThreads(int maxThreads, uint64_t numberOfElements) {
         // let's see how many threads we actually need first
         auto optimalThreads = nd4j::math::nd4j_max<uint64_t>(1, numberOfElements / 1024);
@@ -340,6 +356,8 @@ namespace samediff {
     }
 
     int Threads::parallel_tad(FUNC_1D function, int64_t start, int64_t stop, int64_t increment, uint32_t numThreads) {
+        numThreads = limitThreads(numThreads);
+
         if (start > stop)
             throw std::runtime_error("Threads::parallel_for got start > stop");
 
@@ -357,38 +375,28 @@ namespace samediff {
             return 1;
         }
 
-        auto ticket = ThreadPool::getInstance()->tryAcquire(numThreads);
-        if (ticket != nullptr) {
-            // if we got our threads - we'll run our jobs here
-            auto span = delta / numThreads;
-
-            for (uint32_t e = 0; e < numThreads; e++) {
-                auto start_ = span * e + start;
-                auto stop_  = start_ + span;
+        auto span = delta / numThreads;
 
-                // last thread will process tail
-                if (e == numThreads - 1)
-                    stop_ = stop;
+        TaskGroup group(PRAGMA_THREADS_DO {
+            auto start_ = span * thread_id + start;
+            auto stop_  = start_ + span;
 
-                // putting the task into the queue for a given thread
-                ticket->enqueue(e, numThreads, function, start_, stop_, increment);
-            }
+            // last thread will process tail
+            if (thread_id == numThreads - 1)
+                stop_ = stop;
 
-            // block and wait till all threads finished the job
-            ticket->waitAndRelease();
+            function(thread_id, start_, stop_, increment);
+        }, numThreads);
 
-            // we tell that parallelism request succeeded
-            return numThreads;
-        } else {
-            // if there were no threads available - we'll execute function right within current thread
-            function(0, start, stop, increment);
+        // block and wait till all chunks are finished, calling thread takes part in execution
+        ThreadPool::getInstance()->execute(group);
 
-            // we tell that parallelism request declined
-            return 1;
-        }
+        return numThreads;
     }
 
     int Threads::parallel_for(FUNC_1D function, int64_t start, int64_t stop, int64_t increment, uint32_t numThreads) {
+        numThreads = limitThreads(numThreads);
+
         if (start > stop)
             throw std::runtime_error("Threads::parallel_for got start > stop");
 
@@ -408,6 +416,8 @@ namespace samediff {
     }
 
     int Threads::parallel_for(FUNC_2D function, int64_t startX, int64_t stopX, int64_t incX, int64_t startY, int64_t stopY, int64_t incY, uint64_t numThreads, bool debug) {
+        numThreads = limitThreads(numThreads);
+
         if (startX > stopX)
             throw std::runtime_error("Threads::parallel_for got startX > stopX");
 
@@ -449,32 +459,24 @@ namespace samediff {
             // but we still mimic multithreaded execution
             return numThreads;
         } else {
-            auto ticket = ThreadPool::getInstance()->tryAcquire(numThreads);
-            if (ticket != nullptr) {
-
-                for (int e = 0; e < numThreads; e++) {
-                    auto threadId = numThreads - e - 1;
-                    auto span = Span2::build(splitLoop, threadId, numThreads, startX, stopX, incX, startY, stopY, incY);
+            TaskGroup group(PRAGMA_THREADS_DO {
+                auto threadId = numThreads - thread_id - 1;
+                auto span = Span2::build(splitLoop, threadId, numThreads, startX, stopX, incX, startY, stopY, incY);
 
-                    ticket->enqueue(e, numThreads, function, span.startX(), span.stopX(), span.incX(), span.startY(), span.stopY(), span.incY());
-                }
+                function(thread_id, span.startX(), span.stopX(), span.incX(), span.startY(), span.stopY(), span.incY());
+            }, numThreads);
 
-                // block until all threads finish their job
-                ticket->waitAndRelease();
+            // block until all chunks are finished
+            ThreadPool::getInstance()->execute(group);
 
-                return numThreads;
-            } else {
-                // if there were no threads available - we'll execute function right within current thread
-                function(0, startX, stopX, incX, startY, stopY, incY);
-
-                // we tell that parallelism request declined
-                return 1;
-            }
-        };
+            return numThreads;
+        }
     }
 
 
     int Threads::parallel_for(FUNC_3D function, int64_t startX, int64_t stopX, int64_t incX, int64_t startY, int64_t stopY, int64_t incY, int64_t startZ, int64_t stopZ, int64_t incZ, uint64_t numThreads) {
+        numThreads = limitThreads(numThreads);
+
         if (startX > stopX)
             throw std::runtime_error("Threads::parallel_for got startX > stopX");
 
@@ -499,58 +501,38 @@ namespace samediff {
             return 1;
         }
 
-        auto ticket = ThreadPool::getInstance()->tryAcquire(numThreads);
-        if (ticket != nullptr) {
-            auto splitLoop = ThreadsHelper::pickLoop3d(numThreads, itersX, itersY, itersZ);
-
-            for (int e = 0; e < numThreads; e++) {
-                auto thread_id = numThreads - e - 1;
-                auto span = Span3::build(splitLoop, thread_id, numThreads, startX, stopX, incX, startY, stopY, incY, startZ, stopZ, incZ);
+        auto splitLoop = ThreadsHelper::pickLoop3d(numThreads, itersX, itersY, itersZ);
 
-                ticket->enqueue(e, numThreads, function, span.startX(), span.stopX(), span.incX(), span.startY(), span.stopY(), span.incY(), span.startZ(), span.stopZ(), span.incZ());
-            }
+        TaskGroup group(PRAGMA_THREADS_DO {
+            auto threadId = numThreads - thread_id - 1;
+            auto span = Span3::build(splitLoop, threadId, numThreads, startX, stopX, incX, startY, stopY, incY, startZ, stopZ, incZ);
 
-            // block until we're done
-            ticket->waitAndRelease();
+            function(thread_id, span.startX(), span.stopX(), span.incX(), span.startY(), span.stopY(), span.incY(), span.startZ(), span.stopZ(), span.incZ());
+        }, numThreads);
 
-            // we tell that parallelism request succeeded
-            return numThreads;
-        } else {
-            // if there were no threads available - we'll execute function right within current thread
-            function(0, startX, stopX, incX, startY, stopY, incY, startZ, stopZ, incZ);
-
-            // we tell that parallelism request declined
-            return 1;
-        }
+        // block until we're done
+        ThreadPool::getInstance()->execute(group);
 
+        return numThreads;
     }
 
     int Threads::parallel_do(FUNC_DO function, uint64_t numThreads) {
-        auto ticket = ThreadPool::getInstance()->tryAcquire(numThreads - 1);
-        if (ticket != nullptr) {
+        numThreads = limitThreads(numThreads);
 
-            // submit tasks one by one
-            for (uint64_t e = 0; e < numThreads - 1; e++)
-                ticket->enqueue(e, numThreads, function);
-
-            function(numThreads - 1, numThreads);
-
-            ticket->waitAndRelease();
-
-            return numThreads;
-        } else {
-            // if there's no threads available - we'll execute function sequentially one by one
-            for (uint64_t e = 0; e < numThreads; e++)
-                function(e, numThreads);
-
-            return numThreads;
+        if (numThreads == 1) {
+            function(0, 1);
+            return 1;
         }
 
+        TaskGroup group(function, numThreads);
+        ThreadPool::getInstance()->execute(group);
 
         return numThreads;
     }
 
     int64_t Threads::parallel_long(FUNC_RL function, FUNC_AL aggregator, int64_t start, int64_t stop, int64_t increment, uint64_t numThreads) {
+        numThreads = limitThreads(numThreads);
+
         if (start > stop)
             throw std::runtime_error("Threads::parallel_long got start > stop");
 
@@ -565,26 +547,19 @@ namespace samediff {
         if (numThreads == 1)
             return function(0, start, stop, increment);
 
-        auto ticket = ThreadPool::getInstance()->tryAcquire(numThreads - 1);
-        if (ticket == nullptr)
-            return function(0, start, stop, increment);
-
         // create temporary array
         int64_t intermediatery[256];
         auto span = delta / numThreads;
 
         // execute threads in parallel
-        for (uint32_t e = 0; e < numThreads; e++) {
-            auto start_ = span * e + start;
-            auto stop_ = span * (e + 1) + start;
+        TaskGroup group(PRAGMA_THREADS_DO {
+            auto start_ = span * thread_id + start;
+            auto stop_ = thread_id == numThreads - 1 ? stop : span * (thread_id + 1) + start;
 
-            if (e == numThreads - 1)
-                intermediatery[e] = function(e, start_, stop, increment);
-            else
-                ticket->enqueue(e, numThreads, &intermediatery[e], function, start_, stop_, increment);
-        }
+            intermediatery[thread_id] = function(thread_id, start_, stop_, increment);
+        }, numThreads);
 
-        ticket->waitAndRelease();
+        ThreadPool::getInstance()->execute(group);
 
         // aggregate results in single thread
         for (uint64_t e = 1; e < numThreads; e++)
@@ -595,6 +570,8 @@ namespace samediff {
     }
 
     double Threads::parallel_double(FUNC_RD function, FUNC_AD aggregator, int64_t start, int64_t stop, int64_t increment, uint64_t numThreads) {
+        numThreads = limitThreads(numThreads);
+
         if (start > stop)
             throw std::runtime_error("Threads::parallel_long got start > stop");
 
@@ -609,26 +586,19 @@ namespace samediff {
         if (numThreads == 1)
             return function(0, start, stop, increment);
 
-        auto ticket = ThreadPool::getInstance()->tryAcquire(numThreads - 1);
-        if (ticket == nullptr)
-            return function(0, start, stop, increment);
-
         // create temporary array
         double intermediatery[256];
         auto span = delta / numThreads;
 
         // execute threads in parallel
-        for (uint32_t e = 0; e < numThreads; e++) {
-            auto start_ = span * e + start;
-            auto stop_ = span * (e + 1) + start;
+        TaskGroup group(PRAGMA_THREADS_DO {
+            auto start_ = span * thread_id + start;
+            auto stop_ = thread_id == numThreads - 1 ? stop : span * (thread_id + 1) + start;
 
-            if (e == numThreads - 1)
-                intermediatery[e] = function(e, start_, stop, increment);
-            else
-                ticket->enqueue(e, numThreads, &intermediatery[e], function, start_, stop_, increment);
-        }
+            intermediatery[thread_id] = function(thread_id, start_, stop_, increment);
+        }, numThreads);
 
-        ticket->waitAndRelease();
+        ThreadPool::getInstance()->execute(group);
 
         // aggregate results in single thread
         for (uint64_t e = 1; e < numThreads; e++)
@@ -640,6 +610,8 @@ namespace samediff {
 
 
     int  Threads::parallel_aligned_increment(FUNC_1D function, int64_t start, int64_t stop, int64_t increment, size_t type_size , uint32_t req_numThreads) {
+        req_numThreads = limitThreads(req_numThreads);
+
         if (start > stop)
             throw std::runtime_error("Threads::parallel_for got start > stop");
         auto num_elements = (stop - start);
@@ -668,55 +640,44 @@ namespace samediff {
         numThreads = static_cast<int>(std::ceil((double)delta / spand));
         auto span  = static_cast<Nd4jLong>(spand);
 
-        auto ticket = samediff::ThreadPool::getInstance()->tryAcquire(numThreads);
-        if (ticket != nullptr) {
-            //tail_add is additional value of the last part
-            //it could be negative or positive
-            //we will spread that value across
-            auto tail_add = delta - numThreads * span;
-            Nd4jLong begin = 0;
-            Nd4jLong end = 0;
-
-            //we will try enqueu bigger parts first
-            decltype(span) span1, span2;
-            int last = 0;
-            if (tail_add >= 0) {
-                //for span == 1  , tail_add is  0 
-                last = tail_add;
-                span1 = span + 1;
-                span2 = span;
-            }
-            else {
-                last = numThreads + tail_add;// -std::abs(tail_add);
-                span1 = span;
-                span2 = span - 1;
-            }
-            for (int i = 0; i < last; i++) {
-                end = begin + span1 * increment;
-                // putting the task into the queue for a given thread
-                ticket->enqueue(i, numThreads, function, begin, end, increment);
-                begin = end;
-            }
-            for (int i = last; i < numThreads - 1; i++) {
-                end = begin + span2 * increment;
-                // putting the task into the queue for a given thread
-                ticket->enqueue(i, numThreads, function, begin, end, increment);
-                begin = end;
-            }
-            //for last one enqueue last offset as stop
-            //we need it in case our ((stop-start) % increment ) > 0
-            ticket->enqueue(numThreads - 1, numThreads, function, begin, stop, increment);
-            // block and wait till all threads finished the job
-            ticket->waitAndRelease();
-            // we tell that parallelism request succeeded
-            return numThreads;
+        //tail_add is additional value of the last part
+        //it could be negative or positive
+        //we will spread that value across
+        auto tail_add = delta - numThreads * span;
+
+        //we will try enqueu bigger parts first
+        decltype(span) span1, span2;
+        int last = 0;
+        if (tail_add >= 0) {
+            //for span == 1  , tail_add is  0
+            last = tail_add;
+            span1 = span + 1;
+            span2 = span;
         }
         else {
-            // if there were no threads available - we'll execute function right within current thread
-            function(0, start, stop, increment);
-            // we tell that parallelism request declined
-            return 1;
+            last = numThreads + tail_add;// -std::abs(tail_add);
+            span1 = span;
+            span2 = span - 1;
         }
+
+        TaskGroup group(PRAGMA_THREADS_DO {
+            // first `last` parts have span1 length, the rest have span2 length
+            Nd4jLong begin = thread_id < last ? thread_id * span1 * increment : (last * span1 + (thread_id - last) * span2) * increment;
+            Nd4jLong end = thread_id < last ? begin + span1 * increment : begin + span2 * increment;
+
+            //for last one we use stop
+            //we need it in case our ((stop-start) % increment ) > 0
+            if (thread_id == numThreads - 1)
+                end = stop;
+
+            function(thread_id, begin, end, increment);
+        }, numThreads);
+
+        // block and wait till all threads finished the job
+        ThreadPool::getInstance()->execute(group);
+
+        // we tell that parallelism request succeeded
+        return numThreads;
     }
 
 
@@ -0,0 +1,92 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// WorkDeque implementation
+//
+
+#include <execution/WorkDeque.h>
+
+namespace samediff {
+    void WorkDeque::push(const Task &task) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks.emplace_back(task);
+    }
+
+    bool WorkDeque::pop(Task &task) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_tasks.empty())
+            return false;
+
+        auto &back = _tasks.back();
+        task.group = back.group;
+        task.start = back.start;
+        task.stop = back.start + 1;
+
+        if (back.stop - back.start > 1)
+            back.start++;
+        else
+            _tasks.pop_back();
+
+        return true;
+    }
+
+    bool WorkDeque::steal(Task &task) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_tasks.empty())
+            return false;
+
+        auto &front = _tasks.front();
+        if (front.stop - front.start > 1) {
+            auto mid = front.start + (front.stop - front.start) / 2;
+            task.group = front.group;
+            task.start = mid;
+            task.stop = front.stop;
+            front.stop = mid;
+        } else {
+            task = front;
+            _tasks.pop_front();
+        }
+
+        return true;
+    }
+
+    bool WorkDeque::take(TaskGroup *group, Task &task) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto it = _tasks.begin(); it != _tasks.end(); ++it) {
+            if (it->group != group)
+                continue;
+
+            task.group = group;
+            task.start = it->start;
+            task.stop = it->start + 1;
+
+            if (it->stop - it->start > 1)
+                it->start++;
+            else
+                _tasks.erase(it);
+
+            return true;
+        }
+
+        return false;
+    }
+
+    bool WorkDeque::empty() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _tasks.empty();
+    }
+}
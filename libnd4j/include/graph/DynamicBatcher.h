@@ -0,0 +1,147 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Merges concurrent requests to the same graph into a single batched execution
+//
+
+#ifndef LIBND4J_DYNAMIC_BATCHER_H
+#define LIBND4J_DYNAMIC_BATCHER_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <graph/Variable.h>
+#include <graph/profiling/LatencyHistogram.h>
+#include <vector>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <condition_variable>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * Server-side dynamic batching of inference requests.
+         *
+         * Requests for the same graph arriving within the latency window are concatenated along dimension 0,
+         * executed as single batch within one GraphHolder session, and results are split back along dimension 0.
+         * There's no dedicated thread: the first waiting caller becomes the leader, collects the batch and executes it
+         * on behalf of the others.
+         *
+         * Requests are batched together only if they have the same inputs, with the same data types and shapes apart from
+         * dimension 0. If any graph output doesn't keep batch dimension, the batch is executed request by request instead,
+         * and later requests for that graph aren't batched at all.
+         *
+         * Leadership is released as soon as the batch is formed, so batches of the same graph run concurrently on
+         * separate pooled sessions.
+         */
+        class ND4J_EXPORT DynamicBatcher {
+        private:
+            struct Pending {
+                const std::vector<Variable*> *inputs = nullptr;
+                std::vector<Variable*> outputs;
+                std::exception_ptr error;
+
+                // set once request is picked into a batch, and once that batch is executed
+                bool taken = false;
+                bool done = false;
+
+                // size of dimension 0 shared by all inputs, or -1 if request can't be batched
+                Nd4jLong rows = -1;
+                std::chrono::time_point<std::chrono::steady_clock> enqueued;
+            };
+
+            struct Queue {
+                std::deque<Pending*> pending;
+
+                // set while somebody collects the next batch, batch execution itself happens without it
+                bool leader = false;
+
+                // cleared once outputs of the graph turned out not splittable along dimension 0
+                bool batchable = true;
+            };
+
+            std::map<Nd4jLong, Queue> _queues;
+            std::mutex _mutex;
+            std::condition_variable _condition;
+
+            // latency window, in microseconds. 0 disables batching
+            std::atomic<Nd4jLong> _window{0};
+
+            // max number of rows within single batch
+            std::atomic<Nd4jLong> _maxBatchSize{64};
+
+            std::atomic<Nd4jLong> _batches{0};
+            std::atomic<Nd4jLong> _requests{0};
+
+            // time spent by request waiting for the batch, time spent on concatenation and split, and graph execution time
+            LatencyHistogram _queueing;
+            LatencyHistogram _batching;
+            LatencyHistogram _execution;
+
+            void lead(Nd4jLong graphId, Queue &queue, std::unique_lock<std::mutex> &lock);
+            void executeBatch(Nd4jLong graphId, std::vector<Pending*> &batch);
+            std::vector<Variable*> executeSession(Nd4jLong graphId, const std::vector<Variable*> &inputs, bool cloneInputs);
+
+            static Nd4jLong rowsOf(const std::vector<Variable*> &inputs);
+            static bool isCompatible(const Pending *a, const Pending *b);
+        public:
+            DynamicBatcher() = default;
+            ~DynamicBatcher() = default;
+
+            /**
+             * This method executes graph registered in GraphHolder with given inputs, possibly batched together with concurrent
+             * requests for the same graph. Inputs remain owned by caller, returned variables are owned by caller
+             */
+            std::vector<Variable*> execute(Nd4jLong graphId, const std::vector<Variable*> &inputs);
+
+            /**
+             * These methods control latency window, in microseconds. Window of 0 disables batching
+             */
+            void setWindow(Nd4jLong microseconds);
+            Nd4jLong window() const;
+
+            /**
+             * These methods control max number of rows (i.e. sum of dimension 0 of all requests) within single batch
+             */
+            void setMaxBatchSize(Nd4jLong rows);
+            Nd4jLong maxBatchSize() const;
+
+            bool isEnabled() const;
+
+            /**
+             * This method drops what's known about given graph, i.e. once it's replaced or removed from GraphHolder
+             */
+            void forgetGraph(Nd4jLong graphId);
+
+            Nd4jLong numberOfBatches() const;
+            Nd4jLong numberOfRequests() const;
+
+            LatencyHistogram& queueingTime();
+            LatencyHistogram& batchingTime();
+            LatencyHistogram& executionTime();
+
+            void resetStats();
+
+            void printOut();
+        };
+    }
+}
+
+#endif //LIBND4J_DYNAMIC_BATCHER_H
@@ -37,6 +37,12 @@ namespace nd4j {
             Nd4jLong _footprintBackward = 0L;
             Direction _direction = Direction_FORWARD_ONLY;
 
+            // number of nodes of single onion layer executed concurrently, values below 2 mean sequential execution
+            int _interOpThreads = 0;
+
+            // number of threads each concurrently executed node may use, 0 means cores are split evenly between nodes
+            int _intraOpThreads = 0;
+
             explicit ExecutorConfiguration(const nd4j::graph::FlatConfiguration *conf = nullptr);
             ~ExecutorConfiguration() = default;
             
@@ -34,6 +34,9 @@
 #include <graph/generated/graph_generated.h>
 #include <graph/generated/config_generated.h>
 #include <graph/ExecutorConfiguration.h>
+#include <graph/MemoryPlan.h>
+#include <helpers/MappedFile.h>
+#include <memory>
 #include <ops/declarable/OpDescriptor.h>
 
 namespace nd4j {
@@ -59,6 +62,10 @@ namespace nd4j {
             std::mutex _mutexPreprocessing;
             std::atomic<bool> _built;
 
+            // memory plan is built lazily, on first execution with planner enabled
+            MemoryPlan* _memoryPlan = nullptr;
+            std::mutex _mutexPlan;
+
             std::vector<int> _output;
             std::vector<int> _autos;
 
@@ -66,6 +73,9 @@ namespace nd4j {
             std::map<int, Scope*> _mappedScopes;
             std::vector<Scope*> _scopes;
 
+            // memory-mapped file this graph was imported from, constant arrays might point into it
+            std::shared_ptr<MappedFile> _mappedFile;
+
 ////////////////////////////////////////
             Nd4jStatus validateNode(nd4j::graph::Node *node);
 
@@ -132,6 +142,12 @@ namespace nd4j {
              */
             std::map<int, nd4j::graph::Node*> *getMapped();
 
+            /**
+             * This method returns memory plan for this graph, building it if necessary.
+             * Graph must be built before this call
+             */
+            MemoryPlan* memoryPlan();
+
             /**
              * This method returns outputs of this graph
              * @return
@@ -221,6 +237,15 @@ namespace nd4j {
 
             void replaceState(VariableSpace *state, ExecutorConfiguration *configuration);
 
+            /**
+             * This method attaches memory-mapped file to this Graph, so mapping stays alive as long as arrays created on top of it
+             */
+            void attachMappedFile(std::shared_ptr<MappedFile> file);
+
+            FORCEINLINE std::shared_ptr<MappedFile> mappedFile() {
+                return _mappedFile;
+            }
+
             FORCEINLINE std::vector<int>* nodes() {
                 return _nodes;
             }
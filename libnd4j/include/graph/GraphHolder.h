@@ -21,7 +21,9 @@
 #include <helpers/logger.h>
 #include <pointercast.h>
 #include <unordered_map>
+#include <mutex>
 #include <graph/Graph.h>
+#include <graph/DynamicBatcher.h>
 #include <helpers/SimpleReadWriteLock.h>
 #include <exceptions/unknown_graph_exception.h>
 
@@ -34,8 +36,18 @@ namespace nd4j {
 
             std::map<Nd4jLong, SimpleReadWriteLock> _locks;
 
+            // idle execution sessions, i.e. proxied graph clones ready for reuse
+            std::map<Nd4jLong, std::vector<Graph *>> _sessions;
+            std::mutex _sessionsLock;
+            int _maxSessions = 16;
+
+            // optional server-side batching of concurrent inference requests
+            DynamicBatcher _batcher;
+
             GraphHolder() = default;
             ~GraphHolder() = default;
+
+            void purgeSessions(Nd4jLong graphId);
         public:
             static GraphHolder* getInstance();
 
@@ -45,6 +57,28 @@ namespace nd4j {
 
             Graph* pullGraph(Nd4jLong graphId);
 
+            /**
+             * This method returns execution session for given graph: either pooled one, or freshly cloned if pool is empty
+             * PLEASE NOTE: session must be returned via releaseSession() once execution is finished
+             */
+            Graph* checkoutSession(Nd4jLong graphId);
+
+            /**
+             * This method resets session state and puts it back to the pool, or deletes it if pool is full
+             */
+            void releaseSession(Nd4jLong graphId, Graph *session);
+
+            /**
+             * These methods control max number of idle sessions kept per graph
+             */
+            void setMaxSessions(int numSessions);
+            int maxSessions();
+
+            /**
+             * This method returns number of idle sessions pooled for given graph
+             */
+            int numberOfSessions(Nd4jLong graphId);
+
             void forgetGraph(Nd4jLong graphId);
 
             void dropGraph(Nd4jLong graphId);
@@ -55,8 +89,16 @@ namespace nd4j {
 
             bool hasGraphAny(Nd4jLong graphId);
 
+            /**
+             * This method executes inference request, batched together with concurrent requests if batching is enabled
+             */
             flatbuffers::Offset<FlatResult> execute(Nd4jLong graphId, flatbuffers::FlatBufferBuilder &builder, const FlatInferenceRequest* request);
 
+            /**
+             * This method returns dynamic batcher used for inference requests. Batching is disabled by default
+             */
+            DynamicBatcher& batcher();
+
             void replaceGraph(Nd4jLong graphId, Graph *graph);
 
             /////////////////////////////
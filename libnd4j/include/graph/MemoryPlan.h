@@ -0,0 +1,165 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Liveness-based static memory plan for Graph execution
+//
+
+#ifndef LIBND4J_MEMORYPLAN_H
+#define LIBND4J_MEMORYPLAN_H
+
+#include <dll.h>
+#include <pointercast.h>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <atomic>
+
+namespace nd4j {
+    namespace graph {
+        class Graph;
+
+        /**
+         * Static memory plan for Graph execution.
+         *
+         * Lifetime of every intermediate tensor is expressed in onion layers: tensor is born in the layer of its producer,
+         * and dies after the last layer that consumes it. GraphExecutioner releases dead tensors after each layer,
+         * so peak memory is bounded by the widest frontier instead of sum of all activations.
+         *
+         * Once sizes of all tensors are known (i.e. after the first execution), tensors are assigned to offsets within
+         * single arena, tensors with non-overlapping lifetimes sharing the same memory. Outputs of elementwise legacy ops
+         * reuse the buffer of the input that dies at this op, so such ops work in place.
+         *
+         * Graphs with logic ops, embedded graphs or scopes aren't planned, as well as graph outputs.
+         */
+        class ND4J_EXPORT MemoryPlan {
+        public:
+            struct Tensor {
+                std::pair<int, int> id;
+
+                // first and last onion layer this tensor is alive at
+                int first = 0;
+                int last = 0;
+
+                // node ids consuming this tensor
+                std::vector<int> consumers;
+
+                // index of tensor this one shares NDArray with (in-place nodes), or own index
+                int owner = -1;
+
+                // index of tensor this one takes memory from (elementwise ops), or own index
+                int reuse = -1;
+
+                // tensor must be kept alive after execution, i.e. it's output of the graph
+                bool pinned = false;
+
+                Nd4jLong bytes = 0;
+                Nd4jLong offset = -1;
+            };
+
+        private:
+            std::vector<Tensor> _tensors;
+            std::map<std::pair<int, int>, int> _index;
+
+            // tensors which should be released after given layer
+            std::map<int, std::vector<std::pair<int, int>>> _releases;
+            std::vector<std::pair<int, int>> _empty;
+
+            bool _plannable = false;
+            std::atomic<bool> _finalized{false};
+
+            Nd4jLong _arenaSize = 0;
+            Nd4jLong _totalSize = 0;
+
+            std::mutex _mutex;
+
+            int addTensor(const std::pair<int, int> &id, int layer);
+            int root(int index) const;
+        public:
+            explicit MemoryPlan(Graph *graph);
+            ~MemoryPlan() = default;
+
+            /**
+             * This method returns true if this graph can be executed with this plan
+             */
+            bool isPlannable() const;
+
+            /**
+             * This method returns true once offsets were assigned
+             */
+            bool isFinalized() const;
+
+            /**
+             * This method returns tensors which aren't used after given onion layer
+             */
+            const std::vector<std::pair<int, int>>& releasedAfter(int layer) const;
+
+            /**
+             * This method saves size of the tensor observed during execution. Ignored after finalization
+             */
+            void recordSize(const std::pair<int, int> &id, Nd4jLong bytes);
+
+            /**
+             * This method assigns arena offsets to all tensors with known sizes
+             */
+            void finalize();
+
+            /**
+             * This method returns offset of the given tensor within arena, or -1 if tensor isn't placed there
+             */
+            Nd4jLong offsetOf(const std::pair<int, int> &id) const;
+
+            /**
+             * This method returns number of bytes reserved for the given tensor within arena
+             */
+            Nd4jLong bytesOf(const std::pair<int, int> &id) const;
+
+            /**
+             * This method returns true if given tensor takes memory of its input, so that memory must not be cleared on allocation
+             */
+            bool overwritesInput(const std::pair<int, int> &id) const;
+
+            /**
+             * This method returns true if given tensor takes memory of its input, and stores id of that input into given pair
+             */
+            bool reusedInput(const std::pair<int, int> &id, std::pair<int, int> &input) const;
+
+            /**
+             * This method returns size of the arena, in bytes
+             */
+            Nd4jLong arenaSize() const;
+
+            /**
+             * This method returns total size of all planned tensors, i.e. memory they'd use without reuse
+             */
+            Nd4jLong totalSize() const;
+
+            /**
+             * This method returns number of tensors covered by this plan
+             */
+            int numberOfTensors() const;
+
+            /**
+             * This method places given tensors into arena: tensors are processed from largest to smallest,
+             * and each gets the lowest offset not used by already placed tensors with overlapping lifetimes
+             * @return arena size
+             */
+            static Nd4jLong assignOffsets(std::vector<Tensor> &tensors, Nd4jLong alignment = 64);
+        };
+    }
+}
+
+#endif //LIBND4J_MEMORYPLAN_H
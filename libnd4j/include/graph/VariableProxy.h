@@ -84,6 +84,17 @@ namespace nd4j {
             virtual nd4j::graph::Stash* getStash();
             virtual void setFlowPath(FlowPath* timers);
             virtual FlowPath* flowPath();
+
+            virtual void setMemoryPlan(MemoryPlan* plan);
+            virtual MemoryPlan* memoryPlan();
+            virtual NDArray* allocatePlanned(std::pair<int,int>& pair, Nd4jLong* shapeInfo, LaunchContext* context);
+            virtual VariableSpace* localSpace();
+
+            /**
+             * This method drops all session-local variables, so proxy can be reused for the next execution.
+             * Arena and output arrays of session-local space are kept for that execution
+             */
+            virtual void reset();
         };
     }
 }
\ No newline at end of file
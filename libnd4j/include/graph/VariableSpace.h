@@ -34,6 +34,7 @@
 #include <memory/Workspace.h>
 #include <graph/Stash.h>
 #include <graph/FlowPath.h>
+#include <graph/MemoryPlan.h>
 
 
 namespace nd4j {
@@ -59,7 +60,8 @@ namespace nd4j {
 
             int _auto_counter = -1;
 
-            std::mutex _varmap;
+            // guards maps above, recursive since lookups call each other
+            std::recursive_mutex _varmap;
 
             std::map<int, nd4j::graph::Variable*> _temporary;
 
@@ -67,6 +69,18 @@ namespace nd4j {
 
             FlowPath* _flow = nullptr;
 
+            // arena used by MemoryPlan, it's allocated once plan is finalized and kept for subsequent executions
+            MemoryPlan* _memoryPlan = nullptr;
+            int8_t* _arena = nullptr;
+            Nd4jLong _arenaSize = 0;
+
+            // output arrays of previous execution, kept by reset() so next execution can reuse them
+            std::map<std::pair<int, int>, NDArray*> _retained;
+
+            bool holdsInput(std::pair<int,int>& pair, int8_t* ptr, Nd4jLong* shapeInfo);
+            NDArray* allocateArena(std::pair<int,int>& pair, Nd4jLong* shapeInfo, LaunchContext* context);
+            NDArray* claimRetained(std::pair<int,int>& pair, Nd4jLong* shapeInfo);
+
         public:
             VariableSpace();
             virtual ~VariableSpace();
@@ -135,6 +149,31 @@ namespace nd4j {
 
             virtual void setFlowPath(FlowPath* timers);
             virtual FlowPath* flowPath();
+
+            /**
+             * This method attaches memory plan to this VariableSpace, outputs of planned nodes will be placed into arena
+             * @param plan - plan to use, or nullptr to stop using arena
+             */
+            virtual void setMemoryPlan(MemoryPlan* plan);
+            virtual MemoryPlan* memoryPlan();
+
+            /**
+             * This method creates array for the given node output within arena, if memory plan has place for it,
+             * or hands out array of the same shape this output had during previous execution
+             * @return zeroed NDArray, or nullptr if this output should be allocated as usual
+             */
+            virtual NDArray* allocatePlanned(std::pair<int,int>& pair, Nd4jLong* shapeInfo, LaunchContext* context);
+
+            /**
+             * This method returns VariableSpace that actually owns variables stored here, i.e. session-local part of VariableProxy
+             */
+            virtual VariableSpace* localSpace();
+
+            /**
+             * This method drops all variables, so this VariableSpace can be reused for the next execution.
+             * Arena is kept, and node output arrays are retained for reuse by allocatePlanned()
+             */
+            virtual void reset();
         };
     }
 }
@@ -276,12 +276,13 @@ namespace nd4j {
 
         void Context::pushNDArrayToVariableSpace(std::pair<int, int> &pair, NDArray *array, bool removable) {
             if (_variableSpace != nullptr) {
-                if (!_variableSpace->hasVariable(pair)) {
+                auto local = _variableSpace->localSpace();
+                if (!local->hasVariable(pair)) {
                     auto var = new Variable(array, nullptr, pair.first, pair.second);
                     _variableSpace->putVariable(pair, var);
                     var->markRemovable(removable);
                 } else {
-                    auto var = _variableSpace->getVariable(pair);
+                    auto var = local->getVariable(pair);
                     if (var->hasNDArray()) {
                         if (var->getNDArray() != array) {
                             if (var->isRemovable() && var->hasNDArray())
@@ -304,12 +305,13 @@ namespace nd4j {
         }
 
         void Context::pushNDArrayListToVariableSpace(std::pair<int, int>& pair, NDArrayList* list, bool track) {
-            if (!_variableSpace->hasVariable(pair)) {
+            auto local = _variableSpace->localSpace();
+            if (!local->hasVariable(pair)) {
                 auto var = new Variable(nullptr, nullptr, pair.first, pair.second);
                 var->setNDArrayList(list);
                 _variableSpace->putVariable(pair, var);
             } else {
-                auto var = _variableSpace->getVariable(pair);
+                auto var = local->getVariable(pair);
                 var->setNDArrayList(list);
             }
 
@@ -323,12 +325,14 @@ namespace nd4j {
             if (_variableSpace == nullptr)
                 throw std::runtime_error("Context::ensureVariable VariableSpace is NULL!");
 
-            if (!_variableSpace->hasVariable(pair)) {
+            // node outputs belong to session-local space, shared graph behind VariableProxy is never written to
+            auto local = _variableSpace->localSpace();
+            if (!local->hasVariable(pair)) {
                 auto var = new Variable(nullptr, nullptr, this->nodeId(), idx);
                 _variableSpace->putVariable(pair, var);
                 return var;
             } else {
-                return _variableSpace->getVariable(pair);
+                return local->getVariable(pair);
             }
         }
 
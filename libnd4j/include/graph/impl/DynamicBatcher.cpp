@@ -0,0 +1,420 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// DynamicBatcher implementation
+//
+
+#include <graph/DynamicBatcher.h>
+#include <graph/GraphHolder.h>
+#include <GraphExecutioner.h>
+#include <exceptions/graph_execution_exception.h>
+#include <exceptions/no_results_exception.h>
+#include <exceptions/unknown_graph_exception.h>
+#include <helpers/logger.h>
+
+namespace nd4j {
+    namespace graph {
+        static Nd4jLong microsSince(const std::chrono::time_point<std::chrono::steady_clock> &start) {
+            return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        Nd4jLong DynamicBatcher::rowsOf(const std::vector<Variable*> &inputs) {
+            Nd4jLong rows = -1;
+            for (auto v: inputs) {
+                auto array = v->getNDArray();
+                if (array == nullptr || array->isEmpty() || array->isS() || array->rankOf() < 1)
+                    return -1;
+
+                if (rows < 0)
+                    rows = array->sizeAt(0);
+                else if (rows != array->sizeAt(0))
+                    return -1;
+            }
+
+            return rows;
+        }
+
+        bool DynamicBatcher::isCompatible(const Pending *a, const Pending *b) {
+            if (a->rows <= 0 || b->rows <= 0 || a->inputs->size() != b->inputs->size())
+                return false;
+
+            for (size_t e = 0; e < a->inputs->size(); e++) {
+                auto x = a->inputs->at(e);
+                auto y = b->inputs->at(e);
+                if (x->id() != y->id() || x->index() != y->index() || *x->getName() != *y->getName())
+                    return false;
+
+                auto xa = x->getNDArray();
+                auto ya = y->getNDArray();
+                if (xa->dataType() != ya->dataType() || xa->rankOf() != ya->rankOf())
+                    return false;
+
+                for (int d = 1; d < xa->rankOf(); d++)
+                    if (xa->sizeAt(d) != ya->sizeAt(d))
+                        return false;
+            }
+
+            return true;
+        }
+
+        std::vector<Variable*> DynamicBatcher::execute(Nd4jLong graphId, const std::vector<Variable*> &inputs) {
+            if (!GraphHolder::getInstance()->hasGraph(graphId))
+                throw unknown_graph_exception(graphId);
+
+            _requests++;
+
+            if (!isEnabled()) {
+                _batches++;
+                auto start = std::chrono::steady_clock::now();
+                auto result = executeSession(graphId, inputs, true);
+                _execution.record(microsSince(start));
+                return result;
+            }
+
+            Pending request;
+            request.inputs = &inputs;
+            request.rows = rowsOf(inputs);
+            request.enqueued = std::chrono::steady_clock::now();
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            auto &queue = _queues[graphId];
+
+            // outputs of this graph were already found not splittable, so there's nothing to batch
+            if (!queue.batchable) {
+                lock.unlock();
+
+                _batches++;
+                auto start = std::chrono::steady_clock::now();
+                auto result = executeSession(graphId, inputs, true);
+                _execution.record(microsSince(start));
+                return result;
+            }
+
+            queue.pending.emplace_back(&request);
+
+            // current leader might be waiting for the batch to fill up
+            _condition.notify_all();
+
+            // only requests still waiting for a batch lead, so nobody executes batch of others while own one is done
+            while (!request.done) {
+                if (!queue.leader && !request.taken) {
+                    queue.leader = true;
+                    lead(graphId, queue, lock);
+                } else
+                    _condition.wait(lock);
+            }
+
+            lock.unlock();
+
+            if (request.error)
+                std::rethrow_exception(request.error);
+
+            return request.outputs;
+        }
+
+        void DynamicBatcher::lead(Nd4jLong graphId, Queue &queue, std::unique_lock<std::mutex> &lock) {
+            auto deadline = queue.pending.front()->enqueued + std::chrono::microseconds(_window.load());
+            auto maxRows = _maxBatchSize.load();
+
+            _condition.wait_until(lock, deadline, [&] {
+                Nd4jLong rows = 0;
+                for (auto p: queue.pending)
+                    rows += p->rows > 0 ? p->rows : maxRows;
+
+                return rows >= maxRows;
+            });
+
+            // the oldest request defines the batch, incompatible requests are left for the next leader
+            std::vector<Pending*> batch;
+            auto front = queue.pending.front();
+            Nd4jLong rows = 0;
+            for (auto it = queue.pending.begin(); it != queue.pending.end(); ) {
+                auto p = *it;
+                if (p == front || (queue.batchable && isCompatible(front, p) && rows + p->rows <= maxRows)) {
+                    batch.emplace_back(p);
+                    p->taken = true;
+                    rows += p->rows;
+                    it = queue.pending.erase(it);
+                } else
+                    ++it;
+            }
+
+            for (auto p: batch)
+                _queueing.record(microsSince(p->enqueued));
+
+            // batch is formed, so next leader can collect the next one and run it on another session in parallel
+            queue.leader = false;
+            _condition.notify_all();
+
+            lock.unlock();
+
+            try {
+                executeBatch(graphId, batch);
+            } catch (...) {
+                for (auto p: batch)
+                    p->error = std::current_exception();
+            }
+
+            lock.lock();
+
+            for (auto p: batch)
+                p->done = true;
+
+            _condition.notify_all();
+        }
+
+        void DynamicBatcher::executeBatch(Nd4jLong graphId, std::vector<Pending*> &batch) {
+            _batches++;
+
+            if (batch.size() == 1) {
+                auto start = std::chrono::steady_clock::now();
+                batch[0]->outputs = executeSession(graphId, *batch[0]->inputs, true);
+                _execution.record(microsSince(start));
+                return;
+            }
+
+            // concatenating inputs along dimension 0
+            auto start = std::chrono::steady_clock::now();
+
+            Nd4jLong total = 0;
+            for (auto p: batch)
+                total += p->rows;
+
+            std::vector<Variable*> merged;
+            auto first = batch[0]->inputs;
+            try {
+                for (size_t e = 0; e < first->size(); e++) {
+                    auto variable = first->at(e);
+                    auto array = variable->getNDArray();
+
+                    auto shape = array->getShapeAsVector();
+                    shape[0] = total;
+
+                    auto result = new NDArray('c', shape, array->dataType(), array->getContext());
+                    merged.emplace_back(new Variable(result, variable->getName()->c_str(), variable->id(), variable->index()));
+
+                    std::vector<Nd4jLong> idx(2 * shape.size(), 0);
+
+                    Nd4jLong offset = 0;
+                    for (auto p: batch) {
+                        idx[0] = offset;
+                        idx[1] = offset + p->rows;
+                        (*result)(idx, true).assign(p->inputs->at(e)->getNDArray());
+                        offset += p->rows;
+                    }
+                }
+            } catch (...) {
+                for (auto v: merged)
+                    delete v;
+
+                throw;
+            }
+
+            auto batching = microsSince(start);
+
+            // merged inputs are consumed by executeSession, even if it throws
+            start = std::chrono::steady_clock::now();
+            auto outputs = executeSession(graphId, merged, false);
+            _execution.record(microsSince(start));
+
+            // results can be split only if every output keeps batch dimension
+            bool splittable = true;
+            for (auto v: outputs) {
+                auto array = v->getNDArray();
+                if (array == nullptr || array->isEmpty() || array->isS() || array->rankOf() < 1 || array->sizeAt(0) != total)
+                    splittable = false;
+            }
+
+            if (!splittable) {
+                for (auto v: outputs)
+                    delete v;
+
+                _batching.record(batching);
+
+                // this won't change for the graph, so later requests go straight to executeSession
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _queues[graphId].batchable = false;
+                }
+
+                nd4j_debug("DynamicBatcher: outputs of graph [%lld] can't be split, executing requests one by one\n", graphId);
+                for (auto p: batch) {
+                    try {
+                        start = std::chrono::steady_clock::now();
+                        p->outputs = executeSession(graphId, *p->inputs, true);
+                        _execution.record(microsSince(start));
+                    } catch (...) {
+                        p->error = std::current_exception();
+                    }
+                }
+
+                return;
+            }
+
+            // splitting results back along dimension 0
+            start = std::chrono::steady_clock::now();
+            try {
+                for (auto v: outputs) {
+                    auto array = v->getNDArray();
+                    std::vector<Nd4jLong> idx(2 * array->rankOf(), 0);
+
+                    Nd4jLong offset = 0;
+                    for (auto p: batch) {
+                        idx[0] = offset;
+                        idx[1] = offset + p->rows;
+
+                        auto slice = new NDArray((*array)(idx, true).dup(array->ordering()));
+                        p->outputs.emplace_back(new Variable(slice, v->getName()->c_str(), v->id(), v->index()));
+                        offset += p->rows;
+                    }
+                }
+            } catch (...) {
+                for (auto p: batch) {
+                    for (auto v: p->outputs)
+                        delete v;
+
+                    p->outputs.clear();
+                }
+
+                for (auto v: outputs)
+                    delete v;
+
+                throw;
+            }
+
+            for (auto v: outputs)
+                delete v;
+
+            _batching.record(batching + microsSince(start));
+        }
+
+        std::vector<Variable*> DynamicBatcher::executeSession(Nd4jLong graphId, const std::vector<Variable*> &inputs, bool cloneInputs) {
+            auto holder = GraphHolder::getInstance();
+            holder->lockRead(graphId);
+
+            Graph *session = nullptr;
+            std::vector<Variable*> result;
+
+            // number of inputs already owned by session
+            size_t passed = 0;
+            try {
+                session = holder->checkoutSession(graphId);
+
+                // variable space takes ownership of the inputs
+                for (auto v: inputs) {
+                    session->getVariableSpace()->replaceVariable(cloneInputs ? v->clone() : v);
+                    passed++;
+                }
+
+                auto status = GraphExecutioner::execute(session);
+                if (status != nd4j::Status::OK())
+                    throw graph_execution_exception(graphId);
+
+                auto outputs = session->fetchOutputs();
+                for (auto v: *outputs)
+                    result.emplace_back(v->clone());
+
+                delete outputs;
+
+                if (result.empty())
+                    throw no_results_exception(graphId);
+            } catch (...) {
+                for (auto v: result)
+                    delete v;
+
+                // inputs that weren't passed to the session yet are still ours
+                if (!cloneInputs)
+                    for (size_t e = passed; e < inputs.size(); e++)
+                        delete inputs[e];
+
+                // session state is unknown after failure, so we don't return it to the pool
+                delete session;
+                holder->unlockRead(graphId);
+                throw;
+            }
+
+            holder->releaseSession(graphId, session);
+            holder->unlockRead(graphId);
+
+            return result;
+        }
+
+        void DynamicBatcher::setWindow(Nd4jLong microseconds) {
+            _window = microseconds < 0 ? 0 : microseconds;
+        }
+
+        Nd4jLong DynamicBatcher::window() const {
+            return _window.load();
+        }
+
+        void DynamicBatcher::setMaxBatchSize(Nd4jLong rows) {
+            _maxBatchSize = rows < 1 ? 1 : rows;
+        }
+
+        Nd4jLong DynamicBatcher::maxBatchSize() const {
+            return _maxBatchSize.load();
+        }
+
+        bool DynamicBatcher::isEnabled() const {
+            return _window.load() > 0;
+        }
+
+        void DynamicBatcher::forgetGraph(Nd4jLong graphId) {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            // queue itself stays, concurrent requests might still reference it
+            auto it = _queues.find(graphId);
+            if (it != _queues.end())
+                it->second.batchable = true;
+        }
+
+        Nd4jLong DynamicBatcher::numberOfBatches() const {
+            return _batches.load();
+        }
+
+        Nd4jLong DynamicBatcher::numberOfRequests() const {
+            return _requests.load();
+        }
+
+        LatencyHistogram& DynamicBatcher::queueingTime() {
+            return _queueing;
+        }
+
+        LatencyHistogram& DynamicBatcher::batchingTime() {
+            return _batching;
+        }
+
+        LatencyHistogram& DynamicBatcher::executionTime() {
+            return _execution;
+        }
+
+        void DynamicBatcher::resetStats() {
+            _batches = 0;
+            _requests = 0;
+            _queueing.reset();
+            _batching.reset();
+            _execution.reset();
+        }
+
+        void DynamicBatcher::printOut() {
+            nd4j_printf("DynamicBatcher: window: %lld us; max batch: %lld; requests: %lld; batches: %lld;\n", window(), maxBatchSize(), numberOfRequests(), numberOfBatches());
+            _queueing.printOut("Queueing, us");
+            _batching.printOut("Batching, us");
+            _execution.printOut("Execution, us");
+        }
+    }
+}
@@ -48,6 +48,8 @@ namespace nd4j {
             clone->_direction = _direction;
             clone->_footprintForward = _footprintForward;
             clone->_footprintBackward = _footprintBackward;
+            clone->_interOpThreads = _interOpThreads;
+            clone->_intraOpThreads = _intraOpThreads;
 
             return clone;
         };
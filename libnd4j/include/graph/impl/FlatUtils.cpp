@@ -24,6 +24,9 @@
 #include <array/DataTypeUtils.h>
 #include <array/ByteOrderUtils.h>
 #include <NDArrayFactory.h>
+#include <helpers/MappedFile.h>
+#include <helpers/BitwiseUtils.h>
+#include <Environment.h>
 
 
 namespace nd4j {
@@ -92,9 +95,25 @@ namespace nd4j {
             }
 
 
-            auto newBuffer = new int8_t[length * DataTypeUtils::sizeOf(dtype)];
+            auto rawBuffer = (void *)flatArray->buffer()->data();
+            auto byteLength = length * DataTypeUtils::sizeOf(dtype);
+            auto byteOrder = ByteOrderUtils::fromFlatByteOrder(flatArray->byteOrder());
 
-            BUILD_SINGLE_SELECTOR(dtype, DataTypeConversions, ::convertType(newBuffer, (void *)flatArray->buffer()->data(), dtype, ByteOrderUtils::fromFlatByteOrder(flatArray->byteOrder()),  length), LIBND4J_TYPES);
+            // FlatBuffer lives in memory-mapped file: use its bytes in place if byte order and alignment allow
+            if (Environment::getInstance()->isCPU() && byteOrder == BitwiseUtils::asByteOrder()
+                && reinterpret_cast<uintptr_t>(rawBuffer) % DataTypeUtils::sizeOf(dtype) == 0
+                && flatArray->buffer()->size() >= byteLength && MappedFile::isMapped(rawBuffer, byteLength)) {
+
+                auto buffer = std::make_shared<DataBuffer>(rawBuffer, byteLength, dtype, false);
+                auto array = new NDArray(buffer, ShapeDescriptor(newShape), nd4j::LaunchContext::defaultContext());
+
+                delete[] newShape;
+                return array;
+            }
+
+            auto newBuffer = new int8_t[byteLength];
+
+            BUILD_SINGLE_SELECTOR(dtype, DataTypeConversions, ::convertType(newBuffer, rawBuffer, dtype, byteOrder, length), LIBND4J_TYPES);
 
             auto array = new NDArray(newBuffer, newShape, nd4j::LaunchContext::defaultContext(), true);
 
@@ -249,6 +249,14 @@ namespace nd4j {
             return res;
         }
 
+        MemoryPlan* Graph::memoryPlan() {
+            std::lock_guard<std::mutex> lock(_mutexPlan);
+            if (_memoryPlan == nullptr)
+                _memoryPlan = new MemoryPlan(this);
+
+            return _memoryPlan;
+        }
+
         std::map<int, Node *> * Graph::getMapped() {
             return _mapped;
         }
@@ -299,6 +307,7 @@ namespace nd4j {
             for (auto v: _scopes)
                 delete v;
 
+            delete _memoryPlan;
             delete _mapped;
             delete _nodes;
             delete _variableSpace;
@@ -309,6 +318,13 @@ namespace nd4j {
         void Graph::addNode(Node *node) {
             _built.store(false);
 
+            // structure changes, so old plan isn't valid anymore
+            {
+                std::lock_guard<std::mutex> lock(_mutexPlan);
+                delete _memoryPlan;
+                _memoryPlan = nullptr;
+            }
+
             if (node->opType() == OpType_LOGIC) {
                 // nd4j_debug("Adding LogicOp [%i]\n", node->opNum());
                 // SCOPE
@@ -1292,8 +1308,13 @@ namespace nd4j {
             _configuration = configuration;
         }
 
+        void Graph::attachMappedFile(std::shared_ptr<MappedFile> file) {
+            _mappedFile = file;
+        }
+
         Graph* Graph::cloneWithProxy() {
             auto clone = new Graph();
+            clone->_mappedFile = _mappedFile;
 
             clone->replaceState(new VariableProxy(this->_variableSpace), this->_configuration->clone());
 
@@ -1345,6 +1366,7 @@ namespace nd4j {
 
         Graph* Graph::clone() {
             auto clone = new Graph();
+            clone->_mappedFile = _mappedFile;
 
             clone->replaceState(this->_variableSpace->clone(), this->_configuration->clone());
 
@@ -19,7 +19,9 @@
 //
 
 #include <graph/GraphHolder.h>
+#include <graph/VariableProxy.h>
 #include <GraphExecutioner.h>
+#include <graph/ExecutionResult.h>
 #include <exceptions/graph_exists_exception.h>
 #include <exceptions/graph_execution_exception.h>
 
@@ -64,9 +66,88 @@ namespace nd4j {
             return graph;
         }
 
+        Graph* GraphHolder::checkoutSession(Nd4jLong graphId) {
+            {
+                std::lock_guard<std::mutex> lock(_sessionsLock);
+
+                auto it = _sessions.find(graphId);
+                if (it != _sessions.end() && !it->second.empty()) {
+                    auto session = it->second.back();
+                    it->second.pop_back();
+                    return session;
+                }
+            }
+
+            // pool is empty, so we'll have to build new session
+            return cloneGraph(graphId);
+        }
+
+        void GraphHolder::releaseSession(Nd4jLong graphId, Graph *session) {
+            if (session == nullptr)
+                return;
+
+            // session-local variables are dropped here, output arrays, nodes and context prototypes are preserved for the next run
+            auto proxy = dynamic_cast<VariableProxy*>(session->getVariableSpace());
+            if (proxy != nullptr) {
+                proxy->reset();
+
+                std::lock_guard<std::mutex> lock(_sessionsLock);
+
+                // graph could be forgotten while this session was running, no pool entry should be created for it then
+                if (hasGraph(graphId)) {
+                    auto it = _sessions.find(graphId);
+                    if (it == _sessions.end())
+                        it = _sessions.emplace(graphId, std::vector<Graph*>()).first;
+
+                    if (it->second.size() < (size_t) _maxSessions) {
+                        it->second.emplace_back(session);
+                        return;
+                    }
+                }
+            }
+
+            delete session;
+        }
+
+        void GraphHolder::purgeSessions(Nd4jLong graphId) {
+            std::vector<Graph*> sessions;
+            {
+                std::lock_guard<std::mutex> lock(_sessionsLock);
+
+                auto it = _sessions.find(graphId);
+                if (it == _sessions.end())
+                    return;
+
+                sessions.swap(it->second);
+                _sessions.erase(it);
+            }
+
+            for (auto v: sessions)
+                delete v;
+        }
+
+        void GraphHolder::setMaxSessions(int numSessions) {
+            _maxSessions = numSessions < 0 ? 0 : numSessions;
+        }
+
+        int GraphHolder::maxSessions() {
+            return _maxSessions;
+        }
+
+        int GraphHolder::numberOfSessions(Nd4jLong graphId) {
+            std::lock_guard<std::mutex> lock(_sessionsLock);
+
+            auto it = _sessions.find(graphId);
+            return it == _sessions.end() ? 0 : (int) it->second.size();
+        }
+
         void GraphHolder::forgetGraph(Nd4jLong graphId) {
-            if (this->hasGraph(graphId))
+            if (this->hasGraph(graphId)) {
+                // sessions are referencing original graph, so they can't outlive it
+                purgeSessions(graphId);
+                _batcher.forgetGraph(graphId);
                 _graphF.erase(graphId);
+            }
         }
 
         void GraphHolder::dropGraph(Nd4jLong graphId) {
@@ -104,6 +185,8 @@ namespace nd4j {
 
             this->lockWrite(graphId);
 
+            purgeSessions(graphId);
+            _batcher.forgetGraph(graphId);
             _graphF[graphId] = graph;
 
             this->unlockWrite(graphId);
@@ -116,17 +199,62 @@ namespace nd4j {
             if (!hasGraph(graphId))
                 throw unknown_graph_exception(graphId);
 
+            if (_batcher.isEnabled()) {
+                std::vector<Variable*> inputs;
+                if (request != nullptr && request->variables() != nullptr)
+                    for (int e = 0; e < (int) request->variables()->size(); e++)
+                        inputs.emplace_back(new Variable(request->variables()->Get(e)));
+
+                std::vector<Variable*> outputs;
+                try {
+                    outputs = _batcher.execute(graphId, inputs);
+                } catch (std::exception &e) {
+                    for (auto v: inputs)
+                        delete v;
+
+                    throw;
+                }
+
+                ExecutionResult result;
+                for (auto v: outputs)
+                    result.emplace_back(v);
+
+                auto res = result.asFlatResult(builder);
+
+                for (auto v: inputs)
+                    delete v;
+
+                for (auto v: outputs)
+                    delete v;
+
+                return res;
+            }
+
             lockRead(graphId);
 
-            auto graph = cloneGraph(graphId);
-            auto res = GraphExecutioner::execute(graph, builder, request);
-            delete graph;
+            auto graph = checkoutSession(graphId);
+
+            flatbuffers::Offset<FlatResult> res;
+            try {
+                res = GraphExecutioner::execute(graph, builder, request);
+            } catch (std::exception &e) {
+                // session state is unknown after failure, so we don't return it to the pool
+                delete graph;
+                unlockRead(graphId);
+                throw;
+            }
+
+            releaseSession(graphId, graph);
 
             unlockRead(graphId);
 
             return res;
         }
 
+        DynamicBatcher& GraphHolder::batcher() {
+            return _batcher;
+        }
+
         GraphHolder* GraphHolder::_INSTANCE = 0;
     }
 }
@@ -0,0 +1,342 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// MemoryPlan construction: tensor lifetimes over onion layers and buffer reuse
+//
+
+#include <graph/MemoryPlan.h>
+#include <graph/Graph.h>
+#include <graph/Node.h>
+#include <algorithm>
+#include <set>
+
+namespace nd4j {
+    namespace graph {
+
+        // legacy ops which read and write each element once, at the same index, so output can overwrite input
+        static bool isElementwise(OpType opType) {
+            switch (opType) {
+                case OpType_TRANSFORM_FLOAT:
+                case OpType_TRANSFORM_SAME:
+                case OpType_TRANSFORM_BOOL:
+                case OpType_TRANSFORM_STRICT:
+                case OpType_TRANSFORM_ANY:
+                case OpType_SCALAR:
+                case OpType_SCALAR_BOOL:
+                case OpType_PAIRWISE:
+                case OpType_PAIRWISE_BOOL:
+                    return true;
+                default:
+                    return false;
+            }
+        }
+
+        int MemoryPlan::addTensor(const std::pair<int, int> &id, int layer) {
+            auto it = _index.find(id);
+            if (it != _index.end())
+                return it->second;
+
+            Tensor tensor;
+            tensor.id = id;
+            tensor.first = layer;
+            tensor.last = layer;
+            tensor.owner = static_cast<int>(_tensors.size());
+            tensor.reuse = tensor.owner;
+
+            _index[id] = tensor.owner;
+            _tensors.emplace_back(tensor);
+
+            return tensor.owner;
+        }
+
+        int MemoryPlan::root(int index) const {
+            while (_tensors[index].owner != index)
+                index = _tensors[index].owner;
+
+            return index;
+        }
+
+        MemoryPlan::MemoryPlan(Graph *graph) {
+            if (graph->getExecutorConfiguration()->_outputMode == OutputMode_VARIABLE_SPACE || !graph->scopes()->empty())
+                return;
+
+            auto onion = graph->getOnion();
+            std::map<int, int> layerOf;
+            std::vector<Node*> nodes;
+
+            // std::map keeps layers ordered, so nodes are visited in execution order
+            for (auto &layer : *onion) {
+                for (auto node : *layer.second) {
+                    if (node->opType() == OpType_LOGIC || node->hasGraphEmbedded())
+                        return;
+
+                    layerOf[node->id()] = layer.first;
+                    nodes.emplace_back(node);
+                }
+            }
+
+            std::set<int> outputs(graph->output()->begin(), graph->output()->end());
+
+            // first output of every node, plus every output consumed by other nodes
+            for (auto node : nodes)
+                addTensor(std::pair<int, int>(node->id(), 0), layerOf[node->id()]);
+
+            for (auto node : nodes) {
+                for (auto &input : *node->input()) {
+                    if (layerOf.count(input.first) == 0)
+                        continue;
+
+                    auto &tensor = _tensors[addTensor(input, layerOf[input.first])];
+                    tensor.last = std::max(tensor.last, layerOf[node->id()]);
+                    tensor.consumers.emplace_back(node->id());
+                }
+            }
+
+            for (auto &tensor : _tensors)
+                tensor.pinned = outputs.count(tensor.id.first) > 0;
+
+            // in-place nodes return their inputs as outputs, so both share single NDArray, owned by input
+            for (auto node : nodes) {
+                if (!node->getContextPrototype()->isInplace())
+                    continue;
+
+                for (int e = 0; e < (int) node->input()->size(); e++) {
+                    std::pair<int, int> id(node->id(), e);
+                    auto input = node->input()->at(e);
+                    if (_index.count(id) == 0 || _index.count(input) == 0)
+                        continue;
+
+                    _tensors[_index[id]].owner = _index[input];
+                }
+            }
+
+            // owner has to outlive all its aliases, and can't be released if any of them is graph output
+            for (int e = 0; e < (int) _tensors.size(); e++) {
+                auto r = root(e);
+                if (r == e)
+                    continue;
+
+                _tensors[r].last = std::max(_tensors[r].last, _tensors[e].last);
+                _tensors[r].pinned = _tensors[r].pinned || _tensors[e].pinned;
+            }
+
+            for (int e = 0; e < (int) _tensors.size(); e++) {
+                auto r = root(e);
+                _tensors[e].pinned = _tensors[r].pinned;
+            }
+
+            // elementwise op may write its output over the input, if that op is the only reader of the input in its layer
+            for (auto node : nodes) {
+                if (node->getContextPrototype()->isInplace() || !isElementwise(node->opType()) || node->input()->empty())
+                    continue;
+
+                std::pair<int, int> id(node->id(), 0);
+                auto input = node->input()->at(0);
+                if (_index.count(input) == 0)
+                    continue;
+
+                auto t = _index[id];
+                auto i = _index[input];
+                auto &candidate = _tensors[i];
+                if (candidate.pinned || _tensors[t].pinned || candidate.owner != i || candidate.last != layerOf[node->id()])
+                    continue;
+
+                bool exclusive = true;
+                for (auto c : candidate.consumers)
+                    if (c != node->id() && layerOf[c] == candidate.last)
+                        exclusive = false;
+
+                if (exclusive)
+                    _tensors[t].reuse = i;
+            }
+
+            for (auto &tensor : _tensors)
+                if (!tensor.pinned)
+                    _releases[tensor.last].emplace_back(tensor.id);
+
+            _plannable = true;
+        }
+
+        bool MemoryPlan::isPlannable() const {
+            return _plannable;
+        }
+
+        bool MemoryPlan::isFinalized() const {
+            return _finalized.load();
+        }
+
+        const std::vector<std::pair<int, int>>& MemoryPlan::releasedAfter(int layer) const {
+            auto it = _releases.find(layer);
+            return it == _releases.end() ? _empty : it->second;
+        }
+
+        void MemoryPlan::recordSize(const std::pair<int, int> &id, Nd4jLong bytes) {
+            if (_finalized.load())
+                return;
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = _index.find(id);
+            if (it == _index.end())
+                return;
+
+            auto &tensor = _tensors[it->second];
+            tensor.bytes = std::max(tensor.bytes, bytes);
+        }
+
+        void MemoryPlan::finalize() {
+            if (!_plannable || _finalized.load())
+                return;
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_finalized.load())
+                return;
+
+            // reuse is possible only if input is big enough, otherwise output gets its own memory
+            for (int e = 0; e < (int) _tensors.size(); e++) {
+                auto &tensor = _tensors[e];
+                if (tensor.reuse != e && _tensors[tensor.reuse].bytes != tensor.bytes)
+                    tensor.reuse = e;
+            }
+
+            // tensors sharing memory form single slot, alive from the first member's birth till the last member's death
+            std::vector<Tensor> slots;
+            std::vector<int> slotOf(_tensors.size(), -1);
+            _totalSize = 0;
+
+            // inputs are born in earlier layers than their consumers, so slot of reused tensor always exists already
+            std::vector<int> order(_tensors.size());
+            for (int e = 0; e < (int) order.size(); e++)
+                order[e] = e;
+
+            std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return _tensors[a].first < _tensors[b].first; });
+
+            for (auto e : order) {
+                auto &tensor = _tensors[e];
+                if (tensor.pinned || tensor.owner != e || tensor.bytes <= 0)
+                    continue;
+
+                _totalSize += tensor.bytes;
+
+                auto source = tensor.reuse;
+                if (source != e && slotOf[source] >= 0) {
+                    auto &slot = slots[slotOf[source]];
+                    slot.last = std::max(slot.last, tensor.last);
+                    slotOf[e] = slotOf[source];
+                } else {
+                    tensor.reuse = e;
+                    slotOf[e] = static_cast<int>(slots.size());
+                    slots.emplace_back(tensor);
+                }
+            }
+
+            _arenaSize = assignOffsets(slots);
+
+            for (int e = 0; e < (int) _tensors.size(); e++) {
+                if (slotOf[e] >= 0) {
+                    _tensors[e].offset = slots[slotOf[e]].offset;
+                    _tensors[e].bytes = slots[slotOf[e]].bytes;
+                }
+            }
+
+            _finalized = true;
+        }
+
+        Nd4jLong MemoryPlan::assignOffsets(std::vector<Tensor> &tensors, Nd4jLong alignment) {
+            std::vector<int> order(tensors.size());
+            for (int e = 0; e < (int) order.size(); e++)
+                order[e] = e;
+
+            std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return tensors[a].bytes > tensors[b].bytes; });
+
+            Nd4jLong arenaSize = 0;
+            std::vector<int> placed;
+            for (auto e : order) {
+                auto &tensor = tensors[e];
+                auto bytes = (tensor.bytes + alignment - 1) / alignment * alignment;
+
+                // regions occupied by tensors alive at the same time, ordered by offset
+                std::vector<std::pair<Nd4jLong, Nd4jLong>> busy;
+                for (auto p : placed) {
+                    auto &other = tensors[p];
+                    if (other.first <= tensor.last && tensor.first <= other.last)
+                        busy.emplace_back(other.offset, other.offset + other.bytes);
+                }
+                std::sort(busy.begin(), busy.end());
+
+                // lowest gap that fits
+                Nd4jLong offset = 0;
+                for (auto &region : busy) {
+                    if (region.first - offset >= bytes)
+                        break;
+
+                    offset = std::max(offset, (region.second + alignment - 1) / alignment * alignment);
+                }
+
+                tensor.offset = offset;
+                tensor.bytes = bytes;
+                placed.emplace_back(e);
+                arenaSize = std::max(arenaSize, offset + bytes);
+            }
+
+            return arenaSize;
+        }
+
+        Nd4jLong MemoryPlan::offsetOf(const std::pair<int, int> &id) const {
+            if (!_finalized.load())
+                return -1;
+
+            auto it = _index.find(id);
+            return it == _index.end() ? -1 : _tensors[it->second].offset;
+        }
+
+        Nd4jLong MemoryPlan::bytesOf(const std::pair<int, int> &id) const {
+            if (!_finalized.load())
+                return 0;
+
+            auto it = _index.find(id);
+            return it == _index.end() || _tensors[it->second].offset < 0 ? 0 : _tensors[it->second].bytes;
+        }
+
+        bool MemoryPlan::overwritesInput(const std::pair<int, int> &id) const {
+            if (!_finalized.load())
+                return false;
+
+            auto it = _index.find(id);
+            return it != _index.end() && _tensors[it->second].offset >= 0 && _tensors[it->second].reuse != it->second;
+        }
+
+        bool MemoryPlan::reusedInput(const std::pair<int, int> &id, std::pair<int, int> &input) const {
+            if (!overwritesInput(id))
+                return false;
+
+            input = _tensors[_tensors[_index.at(id)].reuse].id;
+            return true;
+        }
+
+        Nd4jLong MemoryPlan::arenaSize() const {
+            return _arenaSize;
+        }
+
+        Nd4jLong MemoryPlan::totalSize() const {
+            return _totalSize;
+        }
+
+        int MemoryPlan::numberOfTensors() const {
+            return static_cast<int>(_tensors.size());
+        }
+    }
+}
@@ -37,6 +37,15 @@ namespace nd4j {
             delete _current;
         }
 
+
+        void VariableProxy::reset() {
+            _current->reset();
+        }
+
+        VariableSpace* VariableProxy::localSpace() {
+            return _current;
+        }
+
         
         int VariableProxy::numberOfPlaceholders() {
             return _backed->numberOfPlaceholders();
@@ -224,6 +233,21 @@ namespace nd4j {
             return _current->flowPath();
         }
 
+
+        void VariableProxy::setMemoryPlan(MemoryPlan* plan) {
+            _current->setMemoryPlan(plan);
+        }
+
+
+        MemoryPlan* VariableProxy::memoryPlan() {
+            return _current->memoryPlan();
+        }
+
+
+        NDArray* VariableProxy::allocatePlanned(std::pair<int,int>& pair, Nd4jLong* shapeInfo, LaunchContext* context) {
+            return _current->allocatePlanned(pair, shapeInfo, context);
+        }
+
         
         void VariableProxy::putOutputVariable(Variable *variable) {
             _current->putOutputVariable(variable);
@@ -20,6 +20,11 @@
 
 #include <graph/VariableSpace.h>
 #include <NativeOps.h>
+#include <array/DataTypeUtils.h>
+#include <array/ShapeDescriptor.h>
+#include <Environment.h>
+#include <cstring>
+#include <set>
 
 namespace nd4j {
     namespace graph {
@@ -66,6 +71,8 @@ namespace nd4j {
 
         
         void nd4j::graph::VariableSpace::injectVariable(std::pair<int, int> &pair, Variable* variable) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
+
             if (pair.second == 0) {
                 if (pair.first < 0)
                     this->_variables[pair.first] = variable;
@@ -86,14 +93,17 @@ namespace nd4j {
         }
 
         int nd4j::graph::VariableSpace ::numberOfPlaceholders() {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
             return _placeholders.size();
         }
 
         bool nd4j::graph::VariableSpace::hasVariable(std::string *symbol) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
             return _symbolic.count(*symbol) == 1;
         }
 
         nd4j::graph::Variable * nd4j::graph::VariableSpace::getVariable(std::string *symbol) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
             return _symbolic.at(*symbol);
         }
 
@@ -132,6 +142,7 @@ namespace nd4j {
         }
 
         nd4j::graph::Variable * nd4j::graph::VariableSpace::getVariable(std::pair<int, int>& pair) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
 //            if (pair.first == 0)
 //                throw "0 requested";
 
@@ -152,10 +163,12 @@ namespace nd4j {
         }
 
         bool nd4j::graph::VariableSpace::hasVariable(int id) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
             return _variables.count(id) == 1 || _temporary.count(id) == 1;
         }
 
         bool nd4j::graph::VariableSpace::hasVariable(std::pair<int,int>& id) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
             return _paired.count(id) > 0;
         }
 
@@ -226,15 +239,14 @@ namespace nd4j {
         }
 
         void nd4j::graph::VariableSpace::silentPutVariable(std::pair<int,int>& pair, Variable *variable) {
-            _varmap.lock();
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
 
             //std::pair<std::pair<int, int>, nd4j::graph::Variable *> p(pair, variable);
             _paired[pair] = variable;
-
-            _varmap.unlock();
         }
 
         void nd4j::graph::VariableSpace::putVariable(std::pair<int,int>& pair, Variable *variable) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
             silentPutVariable(pair, variable);
 
             if (variable->isPlaceholder())
@@ -248,19 +260,17 @@ namespace nd4j {
                     _symbolic[*(variable->getName())] = variable;
                 }
 
-                _varmap.lock();
-
                 _handles->push_back(variable);
-
-                _varmap.unlock();
             }
         }
 
         void VariableSpace::trackList(nd4j::NDArrayList* list) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
             _lists.emplace_back(list);
         }
 
         void nd4j::graph::VariableSpace::putVariable(int id, Variable *variable) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
             // we don't want to add variables more then once
             if (_variables.count(id) > 0 || _temporary.count(id) > 0) {
                 auto local = id < 0 ? _variables.at(id) : _temporary.at(id);
@@ -276,8 +286,6 @@ namespace nd4j {
                 return;
             }
 
-            _varmap.lock();
-
             _handles->emplace_back(variable);
 
             if (_auto_counter >= id)
@@ -303,8 +311,6 @@ namespace nd4j {
                 _temporary[id] = variable;
             }
 
-            _varmap.unlock();
-
             std::pair<int,int> pair(id, 0);
             if (!hasVariable(pair)) {
                 this->silentPutVariable(pair, variable);
@@ -335,6 +341,7 @@ namespace nd4j {
         }
 
         nd4j::graph::Variable * nd4j::graph::VariableSpace::getVariable(int id) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
 //            _varmap.lock();
 
             if (id < 0) {
@@ -378,6 +385,67 @@ namespace nd4j {
                 delete p;
 
             _lists.clear();
+
+            for (auto &v: _retained)
+                delete v.second;
+
+            delete[] _arena;
+        }
+
+        VariableSpace* VariableSpace::localSpace() {
+            return this;
+        }
+
+        void VariableSpace::reset() {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
+
+            // arrays nobody claimed during last execution won't be needed anymore
+            for (auto &v: _retained)
+                delete v.second;
+
+            _retained.clear();
+
+            std::set<NDArray*> retained;
+            for (auto p: *_handles) {
+                // only node outputs are retained, inputs and placeholders are provided anew for each execution
+                if (p->variableType() == VariableType::NDARRAY && p->hasNDArray() && p->id() > 0) {
+                    auto array = p->getNDArray();
+                    auto buffer = reinterpret_cast<int8_t*>(array->getBuffer());
+                    auto inArena = _arena != nullptr && buffer >= _arena && buffer < _arena + _arenaSize;
+
+                    if (retained.count(array) > 0) {
+                        p->setNDArray(nullptr);
+                    } else if (p->isRemovable() && !p->isReadOnly() && !inArena) {
+                        std::pair<int, int> pair(p->id(), p->index());
+                        if (_retained.count(pair) == 0) {
+                            _retained[pair] = array;
+                            retained.insert(array);
+                            p->setNDArray(nullptr);
+                        }
+                    }
+                }
+
+                delete p;
+            }
+
+            _handles->clear();
+
+            for (auto p: _lists)
+                delete p;
+
+            _lists.clear();
+
+            _paired.clear();
+            _symbolic.clear();
+            _variables.clear();
+            _external.clear();
+            _internal.clear();
+            _placeholders.clear();
+            _temporary.clear();
+            _stash.clear();
+
+            _auto_counter = -1;
+            _flow = nullptr;
         }
 
         VariableSpace& VariableSpace::operator=(const VariableSpace& other) {
@@ -454,6 +522,86 @@ namespace nd4j {
             return _flow;
         }
 
+        void VariableSpace::setMemoryPlan(MemoryPlan* plan) {
+            _memoryPlan = plan;
+
+            // arena is host memory, so other backends keep allocating outputs the usual way
+            if (!Environment::getInstance()->isCPU())
+                return;
+
+            // arrays of interrupted executions might still point to existing arena, so it's never reallocated
+            if (plan != nullptr && plan->isFinalized() && _arena == nullptr && plan->arenaSize() > 0) {
+                _arena = new int8_t[plan->arenaSize()];
+                _arenaSize = plan->arenaSize();
+            }
+        }
+
+        MemoryPlan* VariableSpace::memoryPlan() {
+            return _memoryPlan;
+        }
+
+        bool VariableSpace::holdsInput(std::pair<int,int>& pair, int8_t* ptr, Nd4jLong* shapeInfo) {
+            std::pair<int,int> input;
+            if (!_memoryPlan->reusedInput(pair, input) || !hasVariable(input))
+                return false;
+
+            auto variable = getVariable(input);
+            if (!variable->hasNDArray())
+                return false;
+
+            auto array = variable->getNDArray();
+            return array->getBuffer() == ptr && array->dataType() == ArrayOptions::dataType(shapeInfo) && shape::haveSameShapeAndStrides(array->getShapeInfo(), shapeInfo);
+        }
+
+        NDArray* VariableSpace::allocatePlanned(std::pair<int,int>& pair, Nd4jLong* shapeInfo, LaunchContext* context) {
+            if (shape::isEmpty(shapeInfo) || DataTypeUtils::isS(ArrayOptions::dataType(shapeInfo)))
+                return nullptr;
+
+            auto array = allocateArena(pair, shapeInfo, context);
+            if (array == nullptr)
+                array = claimRetained(pair, shapeInfo);
+
+            return array;
+        }
+
+        NDArray* VariableSpace::allocateArena(std::pair<int,int>& pair, Nd4jLong* shapeInfo, LaunchContext* context) {
+            if (_memoryPlan == nullptr || _arena == nullptr)
+                return nullptr;
+
+            auto dtype = ArrayOptions::dataType(shapeInfo);
+            auto offset = _memoryPlan->offsetOf(pair);
+            auto bytes = shape::length(shapeInfo) * DataTypeUtils::sizeOfElement(dtype);
+            if (offset < 0 || bytes <= 0 || bytes > _memoryPlan->bytesOf(pair) || offset + bytes > _arenaSize)
+                return nullptr;
+
+            // outputs are expected to be zeroed, unless they overwrite live input of the same shape in place
+            auto ptr = _arena + offset;
+            if (!holdsInput(pair, ptr, shapeInfo))
+                memset(ptr, 0, bytes);
+
+            auto buffer = std::make_shared<DataBuffer>(ptr, bytes, dtype, false, nullptr);
+            return new NDArray(buffer, ShapeDescriptor(shapeInfo), context);
+        }
+
+        NDArray* VariableSpace::claimRetained(std::pair<int,int>& pair, Nd4jLong* shapeInfo) {
+            std::lock_guard<std::recursive_mutex> lock(_varmap);
+
+            auto it = _retained.find(pair);
+            if (it == _retained.end())
+                return nullptr;
+
+            auto array = it->second;
+            _retained.erase(it);
+
+            if (array->dataType() != ArrayOptions::dataType(shapeInfo) || !shape::haveSameShapeAndStrides(array->getShapeInfo(), shapeInfo)) {
+                delete array;
+                return nullptr;
+            }
+
+            array->nullify();
+            return array;
+        }
+
         VariableSpace::VariableSpace() {
             _handles = new std::vector<Variable *>;
         }
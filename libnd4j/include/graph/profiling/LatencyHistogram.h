@@ -0,0 +1,82 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Lock-free latency histogram with power-of-two buckets
+//
+
+#ifndef LIBND4J_LATENCY_HISTOGRAM_H
+#define LIBND4J_LATENCY_HISTOGRAM_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <atomic>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * Lock-free histogram of latencies with power-of-two buckets: bucket 0 holds zeros,
+         * bucket b holds values within [2^(b-1), 2^b). Units are up to the caller.
+         */
+        class ND4J_EXPORT LatencyHistogram {
+        public:
+            static const int NUM_BUCKETS = 48;
+
+        private:
+            std::atomic<Nd4jLong> _buckets[NUM_BUCKETS];
+            std::atomic<Nd4jLong> _count;
+            std::atomic<Nd4jLong> _sum;
+            std::atomic<Nd4jLong> _max;
+
+        public:
+            LatencyHistogram();
+            ~LatencyHistogram() = default;
+
+            /**
+             * This method adds single observation to the histogram
+             */
+            void record(Nd4jLong value);
+
+            /**
+             * This method adds all observations of other histogram to this one
+             */
+            void merge(const LatencyHistogram &other);
+
+            void reset();
+
+            Nd4jLong count() const;
+            Nd4jLong sum() const;
+            Nd4jLong max() const;
+            Nd4jLong mean() const;
+
+            /**
+             * This method returns number of observations within given bucket
+             */
+            Nd4jLong bucket(int index) const;
+
+            /**
+             * This method returns upper bound of the bucket containing given percentile, i.e. 0.5 for median
+             */
+            Nd4jLong percentile(double p) const;
+
+            static int bucketOf(Nd4jLong value);
+
+            void printOut(const char *name) const;
+        };
+    }
+}
+
+#endif
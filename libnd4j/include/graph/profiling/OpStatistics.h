@@ -0,0 +1,132 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Per-op latency statistics, keyed by op and input shapes
+//
+
+#ifndef LIBND4J_OP_STATISTICS_H
+#define LIBND4J_OP_STATISTICS_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <graph/profiling/LatencyHistogram.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * Process-wide latency statistics of custom ops, aggregated over all executions.
+         * Statistics are keyed by op hash and signature of input shapes, so the same op
+         * applied to differently shaped inputs gets its own histograms.
+         *
+         * Lookups and inserts are lock-free: entries live in fixed-size open addressing table.
+         * Probing is bounded, so cost of observation doesn't grow as table fills up: signature
+         * that can't get its own entry is folded into "other shapes" entry of its op.
+         */
+        class ND4J_EXPORT OpStatistics {
+        public:
+            static const int TABLE_SIZE = 4096;
+            static const int MAX_PROBES = 16;
+
+            // signature of the entry that aggregates all shapes of an op which didn't fit into the table
+            static const Nd4jLong OTHER_SHAPES = -1;
+
+            class ND4J_EXPORT Entry {
+            public:
+                Nd4jLong opHash;
+                Nd4jLong signature;
+                std::string opName;
+                std::string shapes;
+
+                // time spent in op itself, nanoseconds
+                LatencyHistogram execution;
+
+                // time spent in shape function, nanoseconds
+                LatencyHistogram shapeFunction;
+
+                Entry(Nd4jLong opHash, Nd4jLong signature, const std::string &opName, const std::string &shapes);
+                ~Entry() = default;
+            };
+
+        private:
+            static OpStatistics *_INSTANCE;
+
+            std::atomic<Entry*> _table[TABLE_SIZE];
+            std::atomic<bool> _enabled;
+            std::atomic<Nd4jLong> _overflows;
+
+            // entries removed from the table by reset(), concurrent observers might still hold them
+            std::vector<Entry*> _retired;
+            std::mutex _retiredLock;
+
+            OpStatistics();
+            ~OpStatistics();
+
+            Entry* find(Nd4jLong opHash, Nd4jLong signature, const std::string &opName, int numShapes, const Nd4jLong * const *shapes);
+            Entry* entry(Nd4jLong opHash, Nd4jLong signature, const std::string &opName, int numShapes, const Nd4jLong * const *shapes);
+
+        public:
+            static OpStatistics* getInstance();
+
+            bool isEnabled() const;
+            void setEnabled(bool reallyEnabled);
+
+            /**
+             * This method returns signature of given input shapes: rank, dimensions and data type of each one.
+             * OTHER_SHAPES is never returned
+             */
+            static Nd4jLong signatureOf(int numShapes, const Nd4jLong * const *shapes);
+
+            /**
+             * These methods record single observation, shapes are only used if this is the first observation for given signature
+             */
+            void recordExecution(Nd4jLong opHash, const std::string &opName, Nd4jLong signature, int numShapes, const Nd4jLong * const *shapes, Nd4jLong nanos);
+            void recordShapeFunction(Nd4jLong opHash, const std::string &opName, Nd4jLong signature, int numShapes, const Nd4jLong * const *shapes, Nd4jLong nanos);
+
+            /**
+             * This method returns entry for given op hash and signature, or nullptr if nothing was recorded yet
+             */
+            Entry* lookup(Nd4jLong opHash, Nd4jLong signature) const;
+
+            Nd4jLong numberOfEntries() const;
+
+            /**
+             * This method returns number of observations that didn't get entry of their own signature,
+             * i.e. were folded into "other shapes" entry or dropped, because table was full
+             */
+            Nd4jLong numberOfOverflows() const;
+
+            /**
+             * This method empties the table. Removed entries are kept alive till process exit, since
+             * pointers returned by lookup() and concurrent observations might still refer to them
+             */
+            void reset();
+
+            /**
+             * This method returns all statistics as JSON array, one object per op and signature
+             */
+            std::string asJson() const;
+
+            void printOut() const;
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,113 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Op execution trace recorder, exported in Chrome trace event format
+//
+
+#ifndef LIBND4J_TRACE_RECORDER_H
+#define LIBND4J_TRACE_RECORDER_H
+
+#include <pointercast.h>
+#include <dll.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace nd4j {
+    namespace graph {
+        /**
+         * Recorder of execution timeline, exported in Chrome trace_event format (chrome://tracing, Perfetto).
+         * Every thread writes into its own buffer, so recording doesn't contend between threads.
+         * Nothing is recorded unless tracing was started.
+         */
+        class ND4J_EXPORT TraceRecorder {
+        public:
+            typedef std::chrono::steady_clock clock;
+
+            struct Event {
+                std::string name;
+                const char *category;
+                // 'X' for complete event, 'i' for instant one
+                char phase;
+                // nanoseconds since tracing start
+                Nd4jLong timestamp;
+                Nd4jLong duration;
+                // optional numeric argument, i.e. number of bytes
+                const char *argName;
+                Nd4jLong argValue;
+            };
+
+            struct ThreadBuffer {
+                int tid;
+                std::mutex mutex;
+                std::vector<Event> events;
+            };
+
+        private:
+            static TraceRecorder *_INSTANCE;
+
+            std::atomic<bool> _active;
+            // nanoseconds since clock epoch
+            std::atomic<Nd4jLong> _start;
+
+            std::mutex _mutex;
+            std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+
+            TraceRecorder();
+            ~TraceRecorder() = default;
+
+            ThreadBuffer* threadBuffer();
+            Nd4jLong sinceStart(clock::time_point point) const;
+            void record(Event &&event);
+
+        public:
+            static TraceRecorder* getInstance();
+
+            inline bool isActive() const {
+                return _active.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * This method drops previously recorded events and starts recording
+             */
+            void start();
+            void stop();
+
+            /**
+             * This method records span of work done by current thread
+             */
+            void span(const std::string &name, const char *category, clock::time_point start, clock::time_point end, const char *argName = nullptr, Nd4jLong argValue = 0);
+
+            /**
+             * This method records instant event for current thread
+             */
+            void instant(const std::string &name, const char *category, const char *argName = nullptr, Nd4jLong argValue = 0);
+
+            Nd4jLong numberOfEvents();
+
+            /**
+             * This method returns recorded events as Chrome trace_event JSON
+             */
+            std::string asJson();
+        };
+    }
+}
+
+#endif
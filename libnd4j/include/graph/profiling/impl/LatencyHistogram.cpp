@@ -0,0 +1,120 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// LatencyHistogram implementation
+//
+
+#include <graph/profiling/LatencyHistogram.h>
+#include <helpers/logger.h>
+
+namespace nd4j {
+    namespace graph {
+        LatencyHistogram::LatencyHistogram() {
+            reset();
+        }
+
+        int LatencyHistogram::bucketOf(Nd4jLong value) {
+            int b = 0;
+            while (value > 0 && b < NUM_BUCKETS - 1) {
+                value >>= 1;
+                b++;
+            }
+
+            return b;
+        }
+
+        void LatencyHistogram::record(Nd4jLong value) {
+            if (value < 0)
+                value = 0;
+
+            _buckets[bucketOf(value)]++;
+            _count++;
+            _sum += value;
+
+            auto current = _max.load();
+            while (value > current && !_max.compare_exchange_weak(current, value));
+        }
+
+        void LatencyHistogram::merge(const LatencyHistogram &other) {
+            for (int e = 0; e < NUM_BUCKETS; e++)
+                _buckets[e] += other._buckets[e].load();
+
+            _count += other._count.load();
+            _sum += other._sum.load();
+
+            auto value = other._max.load();
+            auto current = _max.load();
+            while (value > current && !_max.compare_exchange_weak(current, value));
+        }
+
+        void LatencyHistogram::reset() {
+            for (int e = 0; e < NUM_BUCKETS; e++)
+                _buckets[e] = 0;
+
+            _count = 0;
+            _sum = 0;
+            _max = 0;
+        }
+
+        Nd4jLong LatencyHistogram::count() const {
+            return _count.load();
+        }
+
+        Nd4jLong LatencyHistogram::sum() const {
+            return _sum.load();
+        }
+
+        Nd4jLong LatencyHistogram::max() const {
+            return _max.load();
+        }
+
+        Nd4jLong LatencyHistogram::mean() const {
+            auto cnt = _count.load();
+            return cnt > 0 ? _sum.load() / cnt : 0;
+        }
+
+        Nd4jLong LatencyHistogram::bucket(int index) const {
+            return index >= 0 && index < NUM_BUCKETS ? _buckets[index].load() : 0;
+        }
+
+        Nd4jLong LatencyHistogram::percentile(double p) const {
+            auto cnt = _count.load();
+            if (cnt == 0)
+                return 0;
+
+            auto target = static_cast<Nd4jLong>(p * cnt);
+            if (target >= cnt)
+                target = cnt - 1;
+
+            Nd4jLong seen = 0;
+            for (int e = 0; e < NUM_BUCKETS; e++) {
+                seen += _buckets[e].load();
+                if (seen > target) {
+                    // largest observation is better estimate than the bucket bound for the last bucket in use
+                    Nd4jLong bound = e == 0 ? 0 : (static_cast<Nd4jLong>(1) << e) - 1;
+                    return bound < _max.load() ? bound : _max.load();
+                }
+            }
+
+            return _max.load();
+        }
+
+        void LatencyHistogram::printOut(const char *name) const {
+            nd4j_printf("%s: count: %lld; mean: %lld; p50: %lld; p90: %lld; p99: %lld; max: %lld;\n", name, count(), mean(), percentile(0.5), percentile(0.9), percentile(0.99), max());
+        }
+    }
+}
@@ -0,0 +1,268 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// OpStatistics implementation
+//
+
+#include <graph/profiling/OpStatistics.h>
+#include <array/ArrayOptions.h>
+#include <array/DataTypeUtils.h>
+#include <helpers/logger.h>
+#include <helpers/shape.h>
+#include <sstream>
+
+namespace nd4j {
+    namespace graph {
+        static Nd4jLong fnvMix(uint64_t hash, uint64_t value) {
+            for (int e = 0; e < 8; e++) {
+                hash ^= (value >> (e * 8)) & 0xFF;
+                hash *= 1099511628211ULL;
+            }
+
+            return hash;
+        }
+
+        static void histogramJson(std::ostringstream &os, const LatencyHistogram &histogram) {
+            os << "{\"count\":" << histogram.count() << ",\"meanNs\":" << histogram.mean();
+            os << ",\"p50Ns\":" << histogram.percentile(0.5) << ",\"p90Ns\":" << histogram.percentile(0.9);
+            os << ",\"p99Ns\":" << histogram.percentile(0.99) << ",\"maxNs\":" << histogram.max();
+
+            // trailing empty buckets are skipped
+            int last = LatencyHistogram::NUM_BUCKETS - 1;
+            while (last >= 0 && histogram.bucket(last) == 0)
+                last--;
+
+            os << ",\"buckets\":[";
+            for (int e = 0; e <= last; e++)
+                os << (e > 0 ? "," : "") << histogram.bucket(e);
+            os << "]}";
+        }
+
+        OpStatistics::Entry::Entry(Nd4jLong opHash, Nd4jLong signature, const std::string &opName, const std::string &shapes) {
+            this->opHash = opHash;
+            this->signature = signature;
+            this->opName = opName;
+            this->shapes = shapes;
+        }
+
+        OpStatistics::OpStatistics() {
+            for (int e = 0; e < TABLE_SIZE; e++)
+                _table[e] = nullptr;
+
+            _enabled = true;
+            _overflows = 0;
+        }
+
+        OpStatistics::~OpStatistics() {
+            for (int e = 0; e < TABLE_SIZE; e++)
+                delete _table[e].load();
+
+            for (auto entry: _retired)
+                delete entry;
+        }
+
+        OpStatistics* OpStatistics::getInstance() {
+            if (_INSTANCE == 0)
+                _INSTANCE = new OpStatistics();
+
+            return _INSTANCE;
+        }
+
+        bool OpStatistics::isEnabled() const {
+            return _enabled.load(std::memory_order_relaxed);
+        }
+
+        void OpStatistics::setEnabled(bool reallyEnabled) {
+            _enabled = reallyEnabled;
+        }
+
+        Nd4jLong OpStatistics::signatureOf(int numShapes, const Nd4jLong * const *shapes) {
+            uint64_t hash = 14695981039346656037ULL;
+
+            for (int e = 0; e < numShapes; e++) {
+                auto shapeInfo = shapes[e];
+                if (shapeInfo == nullptr) {
+                    hash = fnvMix(hash, static_cast<uint64_t>(-1));
+                    continue;
+                }
+
+                auto rank = shape::rank(shapeInfo);
+                hash = fnvMix(hash, rank);
+                for (int d = 0; d < rank; d++)
+                    hash = fnvMix(hash, shape::shapeOf(const_cast<Nd4jLong*>(shapeInfo))[d]);
+
+                hash = fnvMix(hash, static_cast<uint64_t>(ArrayOptions::dataType(shapeInfo)));
+            }
+
+            auto signature = static_cast<Nd4jLong>(hash);
+            return signature == OTHER_SHAPES ? signature - 1 : signature;
+        }
+
+        OpStatistics::Entry* OpStatistics::lookup(Nd4jLong opHash, Nd4jLong signature) const {
+            auto start = static_cast<uint64_t>(fnvMix(static_cast<uint64_t>(opHash), static_cast<uint64_t>(signature)));
+
+            for (int e = 0; e < MAX_PROBES; e++) {
+                auto entry = _table[(start + e) & (TABLE_SIZE - 1)].load(std::memory_order_acquire);
+                if (entry == nullptr)
+                    return nullptr;
+
+                if (entry->opHash == opHash && entry->signature == signature)
+                    return entry;
+            }
+
+            return nullptr;
+        }
+
+        OpStatistics::Entry* OpStatistics::entry(Nd4jLong opHash, Nd4jLong signature, const std::string &opName, int numShapes, const Nd4jLong * const *shapes) {
+            auto entry = find(opHash, signature, opName, numShapes, shapes);
+            if (entry != nullptr)
+                return entry;
+
+            _overflows++;
+            return find(opHash, OTHER_SHAPES, opName, 0, nullptr);
+        }
+
+        OpStatistics::Entry* OpStatistics::find(Nd4jLong opHash, Nd4jLong signature, const std::string &opName, int numShapes, const Nd4jLong * const *shapes) {
+            auto start = static_cast<uint64_t>(fnvMix(static_cast<uint64_t>(opHash), static_cast<uint64_t>(signature)));
+            Entry *created = nullptr;
+
+            for (int e = 0; e < MAX_PROBES; e++) {
+                auto &slot = _table[(start + e) & (TABLE_SIZE - 1)];
+                auto entry = slot.load(std::memory_order_acquire);
+
+                if (entry == nullptr) {
+                    if (created == nullptr) {
+                        std::string description = signature == OTHER_SHAPES ? "other" : "";
+                        for (int s = 0; s < numShapes; s++) {
+                            if (s > 0)
+                                description += ";";
+
+                            if (shapes[s] == nullptr) {
+                                description += "null";
+                                continue;
+                            }
+
+                            description += "[";
+                            auto rank = shape::rank(shapes[s]);
+                            for (int d = 0; d < rank; d++) {
+                                if (d > 0)
+                                    description += ",";
+                                description += std::to_string(shape::shapeOf(const_cast<Nd4jLong*>(shapes[s]))[d]);
+                            }
+                            description += "]:" + DataTypeUtils::asString(ArrayOptions::dataType(shapes[s]));
+                        }
+
+                        created = new Entry(opHash, signature, opName, description);
+                    }
+
+                    if (slot.compare_exchange_strong(entry, created, std::memory_order_acq_rel))
+                        return created;
+
+                    // someone else took this slot, entry now holds the winner
+                }
+
+                if (entry->opHash == opHash && entry->signature == signature) {
+                    delete created;
+                    return entry;
+                }
+            }
+
+            delete created;
+            return nullptr;
+        }
+
+        void OpStatistics::recordExecution(Nd4jLong opHash, const std::string &opName, Nd4jLong signature, int numShapes, const Nd4jLong * const *shapes, Nd4jLong nanos) {
+            auto entry = this->entry(opHash, signature, opName, numShapes, shapes);
+            if (entry != nullptr)
+                entry->execution.record(nanos);
+        }
+
+        void OpStatistics::recordShapeFunction(Nd4jLong opHash, const std::string &opName, Nd4jLong signature, int numShapes, const Nd4jLong * const *shapes, Nd4jLong nanos) {
+            auto entry = this->entry(opHash, signature, opName, numShapes, shapes);
+            if (entry != nullptr)
+                entry->shapeFunction.record(nanos);
+        }
+
+        Nd4jLong OpStatistics::numberOfEntries() const {
+            Nd4jLong cnt = 0;
+            for (int e = 0; e < TABLE_SIZE; e++)
+                if (_table[e].load() != nullptr)
+                    cnt++;
+
+            return cnt;
+        }
+
+        Nd4jLong OpStatistics::numberOfOverflows() const {
+            return _overflows.load();
+        }
+
+        void OpStatistics::reset() {
+            std::lock_guard<std::mutex> lock(_retiredLock);
+
+            for (int e = 0; e < TABLE_SIZE; e++) {
+                auto entry = _table[e].exchange(nullptr, std::memory_order_acq_rel);
+                if (entry != nullptr)
+                    _retired.emplace_back(entry);
+            }
+
+            _overflows = 0;
+        }
+
+        std::string OpStatistics::asJson() const {
+            std::ostringstream os;
+            os << "[";
+
+            bool first = true;
+            for (int e = 0; e < TABLE_SIZE; e++) {
+                auto entry = _table[e].load();
+                if (entry == nullptr || (entry->execution.count() == 0 && entry->shapeFunction.count() == 0))
+                    continue;
+
+                if (!first)
+                    os << ",";
+                first = false;
+
+                // op names and shape descriptions never contain characters that need escaping
+                os << "{\"op\":\"" << entry->opName << "\",\"hash\":" << entry->opHash << ",\"signature\":" << entry->signature;
+                os << ",\"shapes\":\"" << entry->shapes << "\",\"execution\":";
+                histogramJson(os, entry->execution);
+                os << ",\"shapeFunction\":";
+                histogramJson(os, entry->shapeFunction);
+                os << "}";
+            }
+
+            os << "]";
+            return os.str();
+        }
+
+        void OpStatistics::printOut() const {
+            for (int e = 0; e < TABLE_SIZE; e++) {
+                auto entry = _table[e].load();
+                if (entry == nullptr || entry->execution.count() == 0)
+                    continue;
+
+                auto name = entry->opName + " " + entry->shapes;
+                entry->execution.printOut(name.c_str());
+            }
+        }
+
+        const int OpStatistics::MAX_PROBES;
+        const Nd4jLong OpStatistics::OTHER_SHAPES;
+
+        OpStatistics* OpStatistics::_INSTANCE = 0;
+    }
+}
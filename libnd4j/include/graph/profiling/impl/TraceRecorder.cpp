@@ -0,0 +1,160 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// TraceRecorder implementation and Chrome trace JSON export
+//
+
+#include <graph/profiling/TraceRecorder.h>
+#include <cstdio>
+#include <sstream>
+
+namespace nd4j {
+    namespace graph {
+        // buffers are owned by recorder and never released, so cached pointer stays valid for thread lifetime
+        static thread_local TraceRecorder::ThreadBuffer *_threadBuffer = nullptr;
+
+        static std::string microseconds(Nd4jLong nanos) {
+            char buffer[32];
+            snprintf(buffer, sizeof(buffer), "%lld.%03lld", (long long) (nanos / 1000), (long long) (nanos % 1000));
+            return std::string(buffer);
+        }
+
+        TraceRecorder::TraceRecorder() {
+            _active = false;
+            _start = 0;
+        }
+
+        TraceRecorder* TraceRecorder::getInstance() {
+            if (_INSTANCE == 0)
+                _INSTANCE = new TraceRecorder();
+
+            return _INSTANCE;
+        }
+
+        TraceRecorder::ThreadBuffer* TraceRecorder::threadBuffer() {
+            if (_threadBuffer == nullptr) {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto buffer = new ThreadBuffer();
+                buffer->tid = static_cast<int>(_buffers.size());
+                _buffers.emplace_back(buffer);
+                _threadBuffer = buffer;
+            }
+
+            return _threadBuffer;
+        }
+
+        Nd4jLong TraceRecorder::sinceStart(clock::time_point point) const {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(point.time_since_epoch()).count() - _start.load();
+        }
+
+        void TraceRecorder::record(Event &&event) {
+            auto buffer = threadBuffer();
+
+            // this lock is only contended while trace is exported
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+            buffer->events.emplace_back(std::move(event));
+        }
+
+        void TraceRecorder::start() {
+            _active = false;
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                for (auto &buffer:_buffers) {
+                    std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+                    buffer->events.clear();
+                }
+            }
+
+            _start = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now().time_since_epoch()).count();
+            _active = true;
+        }
+
+        void TraceRecorder::stop() {
+            _active = false;
+        }
+
+        void TraceRecorder::span(const std::string &name, const char *category, clock::time_point start, clock::time_point end, const char *argName, Nd4jLong argValue) {
+            if (!isActive())
+                return;
+
+            auto timestamp = sinceStart(start);
+            record(Event{name, category, 'X', timestamp, sinceStart(end) - timestamp, argName, argValue});
+        }
+
+        void TraceRecorder::instant(const std::string &name, const char *category, const char *argName, Nd4jLong argValue) {
+            if (!isActive())
+                return;
+
+            record(Event{name, category, 'i', sinceStart(clock::now()), 0, argName, argValue});
+        }
+
+        Nd4jLong TraceRecorder::numberOfEvents() {
+            std::lock_guard<std::mutex> lock(_mutex);
+
+            Nd4jLong cnt = 0;
+            for (auto &buffer:_buffers) {
+                std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+                cnt += buffer->events.size();
+            }
+
+            return cnt;
+        }
+
+        std::string TraceRecorder::asJson() {
+            std::lock_guard<std::mutex> lock(_mutex);
+            std::ostringstream os;
+
+            os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+            bool first = true;
+            for (auto &buffer:_buffers) {
+                std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+                if (buffer->events.empty())
+                    continue;
+
+                if (!first)
+                    os << ",";
+                first = false;
+
+                os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid << ",\"args\":{\"name\":\"thread " << buffer->tid << "\"}}";
+
+                for (auto &event:buffer->events) {
+                    os << ",{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category << "\",\"ph\":\"" << event.phase << "\"";
+                    os << ",\"ts\":" << microseconds(event.timestamp);
+
+                    if (event.phase == 'X')
+                        os << ",\"dur\":" << microseconds(event.duration);
+                    else
+                        os << ",\"s\":\"t\"";
+
+                    os << ",\"pid\":1,\"tid\":" << buffer->tid;
+
+                    if (event.argName != nullptr)
+                        os << ",\"args\":{\"" << event.argName << "\":" << event.argValue << "}";
+
+                    os << "}";
+                }
+            }
+
+            os << "]}";
+            return os.str();
+        }
+
+        TraceRecorder* TraceRecorder::_INSTANCE = 0;
+    }
+}
@@ -30,6 +30,7 @@
 #include <helpers/benchmark/DeclarableBenchmark.h>
 #include <helpers/benchmark/MatrixBenchmark.h>
 #include <helpers/benchmark/BroadcastBenchmark.h>
+#include <helpers/benchmark/EncodingBenchmark.h>
 #include <ops/declarable/DeclarableOp.h>
 #include <graph/Context.h>
 #include <NDArray.h>
@@ -25,6 +25,7 @@
 #include <pointercast.h>
 #include <map>
 #include <mutex>
+#include <atomic>
 #include <vector>
 #include <ShapeDescriptor.h>
 #include <array/ConstantDataBuffer.h>
@@ -37,9 +38,21 @@ namespace nd4j {
     private:
         static ConstantShapeHelper *_INSTANCE;
 
-        std::mutex _mutex;
+        // number of independently locked cache shards per device, must be power of 2
+        static const int _numShards = 32;
+
+        // cache is split into shards by descriptor hash: entry for device D lives at [D * _numShards + shard]
+        std::mutex _mutex[_numShards];
         std::vector<std::map<ShapeDescriptor, ConstantDataBuffer>> _cache;
 
+        std::atomic<Nd4jLong> _cacheHits{0};
+        std::atomic<Nd4jLong> _cacheMisses{0};
+        std::atomic<Nd4jLong> _cachedBytes{0};
+
+        FORCEINLINE int shardForDescriptor(const ShapeDescriptor &descriptor) {
+            return static_cast<int>(descriptor.hash() & (_numShards - 1));
+        }
+
 
         ConstantShapeHelper();
     public:
@@ -69,18 +82,22 @@ namespace nd4j {
 
 
         /**
-         * This method returns number of cached TAD shapes/offsets on specific device
+         * This method returns number of cached shapeInfo buffers on specific device
          * @return
          */
         FORCEINLINE int cachedEntriesForDevice(int deviceId) {
-            if (deviceId > _cache.size())
+            if (deviceId >= _cache.size() / _numShards)
                 throw std::runtime_error("deviceId > number of actual devices");
 
-            return _cache[deviceId].size();
+            int total = 0;
+            for (int e = 0; e < _numShards; e++)
+                total += _cache[deviceId * _numShards + e].size();
+
+            return total;
         }
 
         /**
-         * This method returns total number of cached TAD shapes/offsets on all devices
+         * This method returns total number of cached shapeInfo buffers on all devices
          * @return
          */
         FORCEINLINE int totalCachedEntries() {
@@ -91,6 +108,21 @@ namespace nd4j {
 
             return total;
         }
+
+        /**
+         * These methods return cache statistics: number of lookups served from cache, number of lookups that required new entry, and total size of cached buffers in bytes
+         */
+        FORCEINLINE Nd4jLong cacheHits() {
+            return _cacheHits.load();
+        }
+
+        FORCEINLINE Nd4jLong cacheMisses() {
+            return _cacheMisses.load();
+        }
+
+        FORCEINLINE Nd4jLong cachedBytes() {
+            return _cachedBytes.load();
+        }
     };
 }
 
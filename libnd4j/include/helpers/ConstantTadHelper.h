@@ -28,6 +28,7 @@
 #include <map>
 #include <vector>
 #include <mutex>
+#include <atomic>
 #include <array/ShapeDescriptor.h>
 #include <array/TadDescriptor.h>
 #include <array/TadPack.h>
@@ -37,9 +38,21 @@ namespace nd4j {
     private:
         static ConstantTadHelper *_INSTANCE;
 
-        std::mutex _mutex;
+        // number of independently locked cache shards per device, must be power of 2
+        static const int _numShards = 32;
+
+        // cache is split into shards by descriptor hash: entry for device D lives at [D * _numShards + shard]
+        std::mutex _mutex[_numShards];
         std::vector<std::map<TadDescriptor, TadPack>> _cache;
 
+        std::atomic<Nd4jLong> _cacheHits{0};
+        std::atomic<Nd4jLong> _cacheMisses{0};
+        std::atomic<Nd4jLong> _cachedBytes{0};
+
+        FORCEINLINE int shardForDescriptor(const TadDescriptor &descriptor) {
+            return static_cast<int>(descriptor.hash() & (_numShards - 1));
+        }
+
         ConstantTadHelper();
     public:
         ~ConstantTadHelper() = default;
@@ -65,10 +78,14 @@ namespace nd4j {
          * @return
          */
         FORCEINLINE int cachedEntriesForDevice(int deviceId) {
-            if (deviceId > _cache.size())
+            if (deviceId >= _cache.size() / _numShards)
                 throw std::runtime_error("deviceId > number of actual devices");
 
-            return _cache[deviceId].size();
+            int total = 0;
+            for (int e = 0; e < _numShards; e++)
+                total += _cache[deviceId * _numShards + e].size();
+
+            return total;
         }
 
         /**
@@ -83,6 +100,21 @@ namespace nd4j {
 
             return total;
         }
+
+        /**
+         * These methods return cache statistics: number of lookups served from cache, number of lookups that required new entry, and total size of cached buffers in bytes
+         */
+        FORCEINLINE Nd4jLong cacheHits() {
+            return _cacheHits.load();
+        }
+
+        FORCEINLINE Nd4jLong cacheMisses() {
+            return _cacheMisses.load();
+        }
+
+        FORCEINLINE Nd4jLong cachedBytes() {
+            return _cachedBytes.load();
+        }
     };
 }
 
@@ -0,0 +1,70 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Read-only memory mapping of a whole file
+//
+
+#ifndef LIBND4J_MAPPEDFILE_H
+#define LIBND4J_MAPPEDFILE_H
+
+#include <dll.h>
+#include <pointercast.h>
+#include <cstdint>
+#include <string>
+
+namespace nd4j {
+
+    /**
+     * This class maps given file into memory as private copy-on-write mapping.
+     *
+     * Pages aren't copied until somebody writes into them, so untouched data (i.e. model weights)
+     * is shared through page cache across all processes mapping the same file.
+     *
+     * Every live mapping is registered, so consumers of raw pointers (i.e. FlatUtils) are able to
+     * check if the data they see belongs to a mapping, and use it in place instead of copying.
+     *
+     * PLEASE NOTE: whoever creates arrays on top of mapped memory must keep MappedFile alive for their lifetime
+     */
+    class ND4J_EXPORT MappedFile {
+    private:
+        std::string _fileName;
+        uint8_t* _data = nullptr;
+        Nd4jLong _length = 0;
+        intptr_t _handle = -1;
+
+    public:
+        /**
+         * @param fileName file to be mapped, std::runtime_error is thrown if it can't be opened or mapped
+         */
+        explicit MappedFile(const char* fileName);
+        ~MappedFile();
+
+        MappedFile(const MappedFile& other) = delete;
+        MappedFile& operator=(const MappedFile& other) = delete;
+
+        uint8_t* data() const;
+        Nd4jLong length() const;
+        const std::string& fileName() const;
+
+        /**
+         * This method returns TRUE if [pointer, pointer + length) belongs to any live mapping
+         */
+        static bool isMapped(const void* pointer, Nd4jLong length);
+    };
+}
+
+#endif //LIBND4J_MAPPEDFILE_H
@@ -0,0 +1,451 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Radix and merge sort engine for CPU sort ops
+//
+
+#ifndef LIBND4J_PARALLELSORT_H
+#define LIBND4J_PARALLELSORT_H
+
+#include <pointercast.h>
+#include <op_boilerplate.h>
+#include <helpers/shape.h>
+#include <execution/Threads.h>
+#include <Environment.h>
+#include <type_traits>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <memory>
+
+namespace nd4j {
+
+    /**
+     * Sort engine used by sort/sortTad/sortByKey/sortByValue on CPU.
+     *
+     * Integral and IEEE floating point keys are sorted with LSD radix sort over their order-preserving unsigned images
+     * (sign bit flipped for signed integers, all bits flipped for negative floats), one byte per pass,
+     * passes with a single populated bucket are skipped. Other key types (float16, bfloat16) go through merge sort:
+     * chunks are sorted independently, then merged pairwise, every merge split between threads along merge path.
+     *
+     * All indexing is 64-bit, parallelism comes from samediff::Threads, so calls are subject to its thread limits.
+     */
+    class ParallelSort {
+    private:
+        // arrays up to this length are sorted by a single std::stable_sort call
+        static const Nd4jLong SMALL_LENGTH = 1024;
+
+        // minimal number of elements per thread
+        static const Nd4jLong CHUNK_LENGTH = 65536;
+
+        // keys without radix representation never get here, so any type fits
+        template <size_t N> struct UnsignedOf { typedef uint64_t type; };
+
+        template <typename K>
+        struct Radix {
+            static const bool enabled = std::is_integral<K>::value || std::is_floating_point<K>::value;
+            typedef typename UnsignedOf<sizeof(K)>::type U;
+            static const U signBit = static_cast<U>(static_cast<U>(1) << (sizeof(U) * 8 - 1));
+
+            static FORCEINLINE U encode(const K& key, const bool descending) {
+                U u;
+                std::memcpy(&u, &key, sizeof(U));
+
+                if (std::is_floating_point<K>::value)
+                    u = (u & signBit) ? static_cast<U>(~u) : static_cast<U>(u | signBit);
+                else if (std::is_signed<K>::value)
+                    u = static_cast<U>(u ^ signBit);
+
+                return descending ? static_cast<U>(~u) : u;
+            }
+
+            static FORCEINLINE K decode(U u, const bool descending) {
+                if (descending)
+                    u = static_cast<U>(~u);
+
+                if (std::is_floating_point<K>::value)
+                    u = (u & signBit) ? static_cast<U>(u ^ signBit) : static_cast<U>(~u);
+                else if (std::is_signed<K>::value)
+                    u = static_cast<U>(u ^ signBit);
+
+                K key;
+                std::memcpy(&key, &u, sizeof(U));
+                return key;
+            }
+        };
+
+        static FORCEINLINE Nd4jLong offsetOf(const Nd4jLong *shapeInfo, const Nd4jLong ews, const Nd4jLong index) {
+            return ews >= 1 ? index * ews : shape::getIndexOffset(index, shapeInfo);
+        }
+
+        static FORCEINLINE int numberOfChunks(const Nd4jLong length, const int numThreads) {
+            return static_cast<int>(std::max<Nd4jLong>(1, std::min<Nd4jLong>(numThreads, length / CHUNK_LENGTH)));
+        }
+
+        template <typename FUNC>
+        static void forEachChunk(const FUNC &func, const int numChunks) {
+            if (numChunks == 1) {
+                func(0);
+                return;
+            }
+
+            // parallel_tad keeps one chunk per thread, while parallel_for would serialize short loops
+            auto f = PRAGMA_THREADS_FOR {
+                for (auto c = start; c < stop; c += increment)
+                    func(static_cast<int>(c));
+            };
+
+            samediff::Threads::parallel_tad(f, 0, numChunks, 1, numChunks);
+        }
+
+        template <typename U, typename V>
+        static void radixSort(U *keys, V *values, const Nd4jLong length, const int numThreads);
+
+        template <typename E, typename LESS>
+        static void mergeSort(E *data, const Nd4jLong length, const LESS &less, const int numThreads);
+
+        template <typename K, typename V>
+        static void sortRadix(K *x, const Nd4jLong *xShapeInfo, V *y, const Nd4jLong *yShapeInfo, const bool descending, const int numThreads);
+
+        template <typename K, typename V>
+        static void sortMerge(K *x, const Nd4jLong *xShapeInfo, V *y, const Nd4jLong *yShapeInfo, const bool descending, const int numThreads);
+
+        template <typename K>
+        static void sortMerge(K *x, const Nd4jLong *xShapeInfo, const bool descending, const int numThreads);
+
+    public:
+        /**
+         * This method sorts array described by given shapeInfo in place
+         *
+         * @param numThreads - max number of threads to use, 1 means sorting within calling thread
+         */
+        template <typename K>
+        static void sort(K *x, const Nd4jLong *xShapeInfo, const bool descending, const int numThreads = nd4j::Environment::getInstance()->maxMasterThreads());
+
+        /**
+         * This method sorts keys array x in place, and applies the same permutation to values array y
+         *
+         * @param numThreads - max number of threads to use, 1 means sorting within calling thread
+         */
+        template <typename K, typename V>
+        static void sortByKey(K *x, const Nd4jLong *xShapeInfo, V *y, const Nd4jLong *yShapeInfo, const bool descending, const int numThreads = nd4j::Environment::getInstance()->maxMasterThreads());
+    };
+
+    template <> struct ParallelSort::UnsignedOf<1> { typedef uint8_t type; };
+    template <> struct ParallelSort::UnsignedOf<2> { typedef uint16_t type; };
+    template <> struct ParallelSort::UnsignedOf<4> { typedef uint32_t type; };
+    template <> struct ParallelSort::UnsignedOf<8> { typedef uint64_t type; };
+
+    //////////////////////////////////////////////////////////////////////////
+    template <typename U, typename V>
+    void ParallelSort::radixSort(U *keys, V *values, const Nd4jLong length, const int numThreads) {
+        const int numChunks = numberOfChunks(length, numThreads);
+        const Nd4jLong span = length / numChunks;
+
+        // plain buffers, since std::vector<bool> has no data()
+        std::unique_ptr<U[]> tmpKeys(new U[length]);
+        std::unique_ptr<V[]> tmpValues(values != nullptr ? new V[length] : nullptr);
+
+        U *src = keys, *dst = tmpKeys.get();
+        V *srcV = values, *dstV = tmpValues.get();
+
+        // per chunk histograms, turned into per chunk scatter positions before each scatter
+        std::vector<Nd4jLong> counts(static_cast<size_t>(numChunks) * 256);
+
+        for (size_t pass = 0; pass < sizeof(U); pass++) {
+            const int shift = static_cast<int>(pass * 8);
+
+            std::fill(counts.begin(), counts.end(), 0);
+
+            forEachChunk([&](int c) {
+                auto cnt = counts.data() + c * 256;
+                auto stop = c == numChunks - 1 ? length : span * (c + 1);
+                for (Nd4jLong e = span * c; e < stop; e++)
+                    cnt[(src[e] >> shift) & 0xFF]++;
+            }, numChunks);
+
+            // digit is the same for all elements, pass wouldn't change anything
+            bool trivial = false;
+            for (int d = 0; d < 256 && !trivial; d++) {
+                Nd4jLong total = 0;
+                for (int c = 0; c < numChunks; c++)
+                    total += counts[c * 256 + d];
+
+                trivial = total == length;
+            }
+
+            if (trivial)
+                continue;
+
+            // buckets are laid out by digit, then by chunk, so scatter is stable
+            Nd4jLong position = 0;
+            for (int d = 0; d < 256; d++) {
+                for (int c = 0; c < numChunks; c++) {
+                    auto cnt = counts[c * 256 + d];
+                    counts[c * 256 + d] = position;
+                    position += cnt;
+                }
+            }
+
+            forEachChunk([&](int c) {
+                auto pos = counts.data() + c * 256;
+                auto stop = c == numChunks - 1 ? length : span * (c + 1);
+                for (Nd4jLong e = span * c; e < stop; e++) {
+                    auto p = pos[(src[e] >> shift) & 0xFF]++;
+                    dst[p] = src[e];
+                    if (srcV != nullptr)
+                        dstV[p] = srcV[e];
+                }
+            }, numChunks);
+
+            std::swap(src, dst);
+            std::swap(srcV, dstV);
+        }
+
+        if (src != keys) {
+            forEachChunk([&](int c) {
+                auto stop = c == numChunks - 1 ? length : span * (c + 1);
+                std::copy(src + span * c, src + stop, keys + span * c);
+                if (values != nullptr)
+                    std::copy(srcV + span * c, srcV + stop, values + span * c);
+            }, numChunks);
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    template <typename E, typename LESS>
+    void ParallelSort::mergeSort(E *data, const Nd4jLong length, const LESS &less, const int numThreads) {
+        const int numChunks = length <= SMALL_LENGTH ? 1 : numberOfChunks(length, numThreads);
+        if (numChunks == 1) {
+            std::stable_sort(data, data + length, less);
+            return;
+        }
+
+        const Nd4jLong span = length / numChunks;
+
+        // run boundaries, last one is always length
+        std::vector<Nd4jLong> runs(numChunks + 1);
+        for (int c = 0; c < numChunks; c++)
+            runs[c] = span * c;
+        runs[numChunks] = length;
+
+        forEachChunk([&](int c) {
+            std::stable_sort(data + runs[c], data + runs[c + 1], less);
+        }, numChunks);
+
+        std::unique_ptr<E[]> tmp(new E[length]);
+        E *src = data, *dst = tmp.get();
+
+        // every round merges adjacent runs, output of each merge is split into pieces of equal size,
+        // and every piece finds its sources in both runs via binary search along merge path
+        struct Piece {
+            Nd4jLong a, aEnd, b, bEnd, out;
+        };
+
+        while (runs.size() > 2) {
+            std::vector<Nd4jLong> merged;
+            std::vector<Piece> pieces;
+            const Nd4jLong pieceLength = length / numThreads > SMALL_LENGTH ? length / numThreads : SMALL_LENGTH;
+
+            for (size_t r = 0; r + 1 < runs.size(); r += 2) {
+                merged.emplace_back(runs[r]);
+
+                // odd run left, it's just copied
+                if (r + 2 >= runs.size()) {
+                    pieces.push_back({runs[r], runs[r + 1], runs[r + 1], runs[r + 1], runs[r]});
+                    continue;
+                }
+
+                const E *A = src + runs[r];
+                const E *B = src + runs[r + 1];
+                const Nd4jLong m = runs[r + 1] - runs[r];
+                const Nd4jLong l = runs[r + 2] - runs[r + 1];
+
+                // number of elements of A among first k elements of merged output, ties taken from A
+                auto coRank = [&](Nd4jLong k) -> Nd4jLong {
+                    Nd4jLong lo = std::max<Nd4jLong>(0, k - l), hi = std::min<Nd4jLong>(k, m);
+                    while (lo < hi) {
+                        auto i = lo + (hi - lo) / 2;
+                        auto j = k - i;
+                        if (j > 0 && i < m && !less(B[j - 1], A[i]))
+                            lo = i + 1;
+                        else
+                            hi = i;
+                    }
+                    return lo;
+                };
+
+                Nd4jLong prevI = 0, prevK = 0;
+                for (Nd4jLong k = pieceLength; ; k += pieceLength) {
+                    auto kk = std::min<Nd4jLong>(k, m + l);
+                    auto i = coRank(kk);
+                    pieces.push_back({runs[r] + prevI, runs[r] + i, runs[r + 1] + (prevK - prevI), runs[r + 1] + (kk - i), runs[r] + prevK});
+                    prevI = i;
+                    prevK = kk;
+
+                    if (kk == m + l)
+                        break;
+                }
+            }
+            merged.emplace_back(length);
+
+            auto func = PRAGMA_THREADS_FOR {
+                for (auto p = start; p < stop; p += increment) {
+                    auto &piece = pieces[p];
+                    std::merge(src + piece.a, src + piece.aEnd, src + piece.b, src + piece.bEnd, dst + piece.out, less);
+                }
+            };
+
+            samediff::Threads::parallel_tad(func, 0, static_cast<int64_t>(pieces.size()), 1, numThreads);
+
+            std::swap(src, dst);
+            runs.swap(merged);
+        }
+
+        if (src != data)
+            std::copy(src, src + length, data);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    template <typename K, typename V>
+    void ParallelSort::sortRadix(K *x, const Nd4jLong *xShapeInfo, V *y, const Nd4jLong *yShapeInfo, const bool descending, const int numThreads) {
+        typedef typename Radix<K>::U U;
+
+        const Nd4jLong length = shape::length(xShapeInfo);
+        const Nd4jLong xEws = shape::elementWiseStride(xShapeInfo);
+        const Nd4jLong yEws = y != nullptr ? shape::elementWiseStride(yShapeInfo) : 1;
+        const int numChunks = numberOfChunks(length, numThreads);
+        const Nd4jLong span = length / numChunks;
+
+        std::unique_ptr<U[]> keys(new U[length]);
+        std::unique_ptr<V[]> values(y != nullptr ? new V[length] : nullptr);
+
+        forEachChunk([&](int c) {
+            auto stop = c == numChunks - 1 ? length : span * (c + 1);
+            for (Nd4jLong e = span * c; e < stop; e++) {
+                keys[e] = Radix<K>::encode(x[offsetOf(xShapeInfo, xEws, e)], descending);
+                if (y != nullptr)
+                    values[e] = y[offsetOf(yShapeInfo, yEws, e)];
+            }
+        }, numChunks);
+
+        radixSort<U, V>(keys.get(), values.get(), length, numThreads);
+
+        forEachChunk([&](int c) {
+            auto stop = c == numChunks - 1 ? length : span * (c + 1);
+            for (Nd4jLong e = span * c; e < stop; e++) {
+                x[offsetOf(xShapeInfo, xEws, e)] = Radix<K>::decode(keys[e], descending);
+                if (y != nullptr)
+                    y[offsetOf(yShapeInfo, yEws, e)] = values[e];
+            }
+        }, numChunks);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    template <typename K, typename V>
+    void ParallelSort::sortMerge(K *x, const Nd4jLong *xShapeInfo, V *y, const Nd4jLong *yShapeInfo, const bool descending, const int numThreads) {
+        const Nd4jLong length = shape::length(xShapeInfo);
+        const Nd4jLong xEws = shape::elementWiseStride(xShapeInfo);
+        const Nd4jLong yEws = shape::elementWiseStride(yShapeInfo);
+        const int numChunks = numberOfChunks(length, numThreads);
+        const Nd4jLong span = length / numChunks;
+
+        std::unique_ptr<std::pair<K, V>[]> pairs(new std::pair<K, V>[length]);
+
+        forEachChunk([&](int c) {
+            auto stop = c == numChunks - 1 ? length : span * (c + 1);
+            for (Nd4jLong e = span * c; e < stop; e++)
+                pairs[e] = std::pair<K, V>(x[offsetOf(xShapeInfo, xEws, e)], y[offsetOf(yShapeInfo, yEws, e)]);
+        }, numChunks);
+
+        if (descending)
+            mergeSort(pairs.get(), length, [](const std::pair<K, V> &a, const std::pair<K, V> &b) { return b.first < a.first; }, numThreads);
+        else
+            mergeSort(pairs.get(), length, [](const std::pair<K, V> &a, const std::pair<K, V> &b) { return a.first < b.first; }, numThreads);
+
+        forEachChunk([&](int c) {
+            auto stop = c == numChunks - 1 ? length : span * (c + 1);
+            for (Nd4jLong e = span * c; e < stop; e++) {
+                x[offsetOf(xShapeInfo, xEws, e)] = pairs[e].first;
+                y[offsetOf(yShapeInfo, yEws, e)] = pairs[e].second;
+            }
+        }, numChunks);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    template <typename K>
+    void ParallelSort::sortMerge(K *x, const Nd4jLong *xShapeInfo, const bool descending, const int numThreads) {
+        const Nd4jLong length = shape::length(xShapeInfo);
+        const Nd4jLong xEws = shape::elementWiseStride(xShapeInfo);
+        const int numChunks = numberOfChunks(length, numThreads);
+        const Nd4jLong span = length / numChunks;
+
+        // contiguous arrays are sorted in place
+        std::unique_ptr<K[]> buffer(xEws == 1 ? nullptr : new K[length]);
+        K *data = xEws == 1 ? x : buffer.get();
+
+        if (xEws != 1) {
+            forEachChunk([&](int c) {
+                auto stop = c == numChunks - 1 ? length : span * (c + 1);
+                for (Nd4jLong e = span * c; e < stop; e++)
+                    data[e] = x[offsetOf(xShapeInfo, xEws, e)];
+            }, numChunks);
+        }
+
+        if (descending)
+            mergeSort(data, length, [](const K &a, const K &b) { return b < a; }, numThreads);
+        else
+            mergeSort(data, length, [](const K &a, const K &b) { return a < b; }, numThreads);
+
+        if (xEws != 1) {
+            forEachChunk([&](int c) {
+                auto stop = c == numChunks - 1 ? length : span * (c + 1);
+                for (Nd4jLong e = span * c; e < stop; e++)
+                    x[offsetOf(xShapeInfo, xEws, e)] = data[e];
+            }, numChunks);
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    template <typename K>
+    void ParallelSort::sort(K *x, const Nd4jLong *xShapeInfo, const bool descending, const int numThreads) {
+        if (shape::length(xShapeInfo) < 2)
+            return;
+
+        if (Radix<K>::enabled && shape::length(xShapeInfo) > SMALL_LENGTH)
+            sortRadix<K, int8_t>(x, xShapeInfo, nullptr, nullptr, descending, numThreads);
+        else
+            sortMerge<K>(x, xShapeInfo, descending, numThreads);
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    template <typename K, typename V>
+    void ParallelSort::sortByKey(K *x, const Nd4jLong *xShapeInfo, V *y, const Nd4jLong *yShapeInfo, const bool descending, const int numThreads) {
+        if (shape::length(xShapeInfo) < 2)
+            return;
+
+        if (Radix<K>::enabled && shape::length(xShapeInfo) > SMALL_LENGTH)
+            sortRadix<K, V>(x, xShapeInfo, y, yShapeInfo, descending, numThreads);
+        else
+            sortMerge<K, V>(x, xShapeInfo, y, yShapeInfo, descending, numThreads);
+    }
+}
+
+#endif //LIBND4J_PARALLELSORT_H
@@ -0,0 +1,152 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Per-thread partial results for scalar reductions
+//
+
+#ifndef LIBND4J_REDUCTIONPARTIALS_H
+#define LIBND4J_REDUCTIONPARTIALS_H
+
+#include <op_boilerplate.h>
+#include <pointercast.h>
+#include <new>
+#include <cstdlib>
+#include <cstdint>
+#include <stdexcept>
+
+namespace nd4j {
+
+    /**
+     * Storage for per-thread partial results of a scalar reduction.
+     *
+     * Every thread owns its own cache line(s), so threads updating their
+     * accumulators never invalidate each other's lines, and the number of
+     * threads isn't limited by a fixed-size stack array.
+     */
+    template <typename T>
+    class ReductionPartials {
+    public:
+        static const int CACHE_LINE = 64;
+
+    private:
+        int8_t* _allocation = nullptr;
+        int8_t* _aligned = nullptr;
+        int _numThreads;
+        int _width;
+        size_t _stride;
+
+    public:
+        /**
+         * @param numThreads number of threads that'll take part in reduction
+         * @param initial value every slot is initialized with
+         * @param width number of values each thread owns (i.e. extra params of reduce3 ops)
+         */
+        ReductionPartials(int numThreads, const T& initial, int width = 1) : _numThreads(numThreads < 1 ? 1 : numThreads), _width(width < 1 ? 1 : width) {
+            _stride = ((_width * sizeof(T) + CACHE_LINE - 1) / CACHE_LINE) * CACHE_LINE;
+
+            _allocation = reinterpret_cast<int8_t*>(std::malloc(_stride * _numThreads + CACHE_LINE));
+            if (_allocation == nullptr)
+                throw std::bad_alloc();
+
+            auto address = reinterpret_cast<uintptr_t>(_allocation);
+            _aligned = _allocation + (CACHE_LINE - address % CACHE_LINE) % CACHE_LINE;
+
+            for (int t = 0; t < _numThreads; t++) {
+                auto row = this->row(t);
+                for (int e = 0; e < _width; e++)
+                    new (row + e) T(initial);
+            }
+        }
+
+        ~ReductionPartials() {
+            std::free(_allocation);
+        }
+
+        ReductionPartials(const ReductionPartials&) = delete;
+        ReductionPartials& operator=(const ReductionPartials&) = delete;
+
+        FORCEINLINE T& operator[](int thread) {
+            return *row(thread);
+        }
+
+        FORCEINLINE T* row(int thread) {
+            return reinterpret_cast<T*>(_aligned + _stride * thread);
+        }
+
+        FORCEINLINE int numThreads() const {
+            return _numThreads;
+        }
+    };
+
+    /**
+     * Reduces elements [start, stop) in fixed-size blocks. Each block is accumulated
+     * into LANES independent accumulators which are folded pairwise at the end of
+     * block, and block results are combined pairwise as well (binary carry stack),
+     * so the compiler gets independent dependency chains to vectorize and rounding
+     * error grows logarithmically with length instead of linearly.
+     *
+     * @param starting neutral value of the reduction
+     * @param load functor returning op result for element i
+     * @param merge functor merging two partial results
+     */
+    template <typename Z, typename Load, typename Merge>
+    FORCEINLINE Z blockedReduce(Nd4jLong start, Nd4jLong stop, const Z& starting, const Load& load, const Merge& merge) {
+        const int LANES = 8;
+        const Nd4jLong BLOCK = 4096;
+
+        // 64 levels of carry stack are enough for any Nd4jLong number of blocks
+        Z carry[64];
+        int depth = 0;
+        Nd4jLong blocks = 0;
+
+        for (Nd4jLong b = start; b < stop; b += BLOCK) {
+            const Nd4jLong e = b + BLOCK < stop ? b + BLOCK : stop;
+
+            Z acc[LANES];
+            for (int l = 0; l < LANES; l++)
+                acc[l] = starting;
+
+            auto i = b;
+            for (; i + LANES <= e; i += LANES) {
+                PRAGMA_OMP_SIMD
+                for (int l = 0; l < LANES; l++)
+                    acc[l] = merge(acc[l], load(i + l));
+            }
+
+            for (; i < e; i++)
+                acc[0] = merge(acc[0], load(i));
+
+            for (int w = LANES / 2; w > 0; w /= 2)
+                for (int l = 0; l < w; l++)
+                    acc[l] = merge(acc[l], acc[l + w]);
+
+            Z value = acc[0];
+            for (auto c = ++blocks; (c & 1) == 0; c >>= 1)
+                value = merge(carry[--depth], value);
+
+            carry[depth++] = value;
+        }
+
+        Z result = starting;
+        while (depth > 0)
+            result = merge(result, carry[--depth]);
+
+        return result;
+    }
+}
+
+#endif //LIBND4J_REDUCTIONPARTIALS_H
@@ -0,0 +1,485 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Hash-based parallel engine behind unique, listdiff and multiUnique
+//
+
+#ifndef LIBND4J_UNIQUEENGINE_H
+#define LIBND4J_UNIQUEENGINE_H
+
+#include <pointercast.h>
+#include <op_boilerplate.h>
+#include <helpers/shape.h>
+#include <execution/Threads.h>
+#include <Environment.h>
+#include <types/float16.h>
+#include <types/bfloat16.h>
+#include <type_traits>
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+
+namespace nd4j {
+
+    /**
+     * Hash based engine used by unique/unique_with_counts, listdiff and multiUnique.
+     *
+     * Input is split into contiguous chunks, and every chunk is deduplicated with its own open addressing table.
+     * Chunk-local uniques are merged into hash partitions, one partition per thread, and finally ranked by position
+     * of their first occurrence, so results are identical to single sequential pass over the input.
+     *
+     * Floating point keys are compared by value: 0.0 and -0.0 are the same key, while NaN never matches anything,
+     * so every NaN is unique value of its own, same as in TF.
+     */
+    class UniqueEngine {
+    public:
+        /**
+         * Open addressing table with linear probing. Ids are assigned in order of insertion,
+         * and per-id key, hash, number of occurrences and position of first occurrence are kept.
+         */
+        template <typename T>
+        class Table {
+        private:
+            // hash is kept next to id, so probing doesn't touch keys of other entries; zero id marks empty slot
+            struct Slot {
+                uint64_t hash;
+                Nd4jLong id;
+            };
+
+            std::vector<Slot> _slots;
+            uint64_t _mask;
+
+            void grow();
+
+        public:
+            std::vector<T> keys;
+            std::vector<uint64_t> hashes;
+            std::vector<Nd4jLong> counts;
+            std::vector<Nd4jLong> first;
+
+            explicit Table(Nd4jLong capacity = 1024);
+
+            /**
+             * This method returns id of given key, key is added to the table if it wasn't there yet. NaN is always added
+             */
+            Nd4jLong insert(const T &key, const uint64_t hash, const Nd4jLong position, const Nd4jLong count = 1);
+
+            /**
+             * This method returns id of given key, or -1 if there's no such key
+             */
+            Nd4jLong find(const T &key, const uint64_t hash) const;
+
+            FORCEINLINE Nd4jLong size() const {
+                return static_cast<Nd4jLong>(keys.size());
+            }
+        };
+
+    private:
+        // minimal number of elements per thread
+        static const Nd4jLong CHUNK_LENGTH = 65536;
+
+        static FORCEINLINE double asDouble(const float16 &key) { return static_cast<float>(key); }
+        static FORCEINLINE double asDouble(const bfloat16 &key) { return static_cast<float>(key); }
+
+        template <typename T>
+        static FORCEINLINE double asDouble(const T &key) { return static_cast<double>(key); }
+
+        template <typename T>
+        static FORCEINLINE uint64_t bitsOf(const T &key, std::true_type) {
+            return static_cast<uint64_t>(key);
+        }
+
+        template <typename T>
+        static FORCEINLINE uint64_t bitsOf(const T &key, std::false_type) {
+            auto d = asDouble(key);
+
+            // -0.0 is folded into 0.0
+            if (d == 0.0)
+                return 0ULL;
+
+            uint64_t u;
+            std::memcpy(&u, &d, sizeof(u));
+            return u;
+        }
+
+        template <typename T>
+        static FORCEINLINE bool equals(const T &a, const T &b, std::true_type) {
+            return a == b;
+        }
+
+        template <typename T>
+        static FORCEINLINE bool equals(const T &a, const T &b, std::false_type) {
+            // NaN isn't equal to anything, itself included
+            return asDouble(a) == asDouble(b);
+        }
+
+        static FORCEINLINE Nd4jLong offsetOf(const Nd4jLong *shapeInfo, const Nd4jLong ews, const Nd4jLong index) {
+            return ews >= 1 ? index * ews : shape::getIndexOffset(index, shapeInfo);
+        }
+
+        // elements are visited in logical c order, so direct strides are only usable for c-ordered arrays
+        static FORCEINLINE Nd4jLong strideOf(const Nd4jLong *shapeInfo) {
+            return shape::order(shapeInfo) == 'c' || shape::isVector(shapeInfo) ? shape::elementWiseStride(shapeInfo) : 0;
+        }
+
+        static FORCEINLINE int numberOfChunks(const Nd4jLong length, const int numThreads) {
+            return static_cast<int>(std::max<Nd4jLong>(1, std::min<Nd4jLong>(numThreads, length / CHUNK_LENGTH)));
+        }
+
+        // table slots are taken from low bits of the hash, partitions from high ones
+        static FORCEINLINE int partitionOf(const uint64_t hash, const int numPartitions) {
+            return static_cast<int>(((hash >> 32) * static_cast<uint64_t>(numPartitions)) >> 32);
+        }
+
+        template <typename FUNC>
+        static void forEachChunk(const FUNC &func, const int numChunks) {
+            if (numChunks == 1) {
+                func(0);
+                return;
+            }
+
+            // parallel_tad keeps one chunk per thread, while parallel_for would serialize short loops
+            auto f = PRAGMA_THREADS_FOR {
+                for (auto c = start; c < stop; c += increment)
+                    func(static_cast<int>(c));
+            };
+
+            samediff::Threads::parallel_tad(f, 0, numChunks, 1, numChunks);
+        }
+
+    public:
+        template <typename T>
+        static FORCEINLINE uint64_t hashOf(const T &key) {
+            // splitmix64 finalizer
+            auto h = bitsOf(key, std::integral_constant<bool, std::is_integral<T>::value>());
+            h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+            return h ^ (h >> 31);
+        }
+
+        template <typename T>
+        static FORCEINLINE bool equals(const T &a, const T &b) {
+            return equals(a, b, std::integral_constant<bool, std::is_integral<T>::value>());
+        }
+
+        /**
+         * This method finds unique values of array described by given shapeInfo
+         *
+         * @param values - optional, unique values in order of their first occurrence
+         * @param indices - optional, buffer of input length, receives index within values for every input element
+         * @param counts - optional, number of occurrences of every unique value
+         * @param numThreads - max number of threads to use, 1 means calling thread only
+         * @return number of unique values
+         */
+        template <typename T>
+        static Nd4jLong unique(const T *x, const Nd4jLong *xShapeInfo, std::vector<T> *values, Nd4jLong *indices, std::vector<Nd4jLong> *counts, const int numThreads = nd4j::Environment::getInstance()->maxMasterThreads());
+
+        /**
+         * This method finds elements of x which are absent in y, keeping their order
+         *
+         * @param values - optional, elements of x absent in y
+         * @param positions - optional, positions of these elements within x
+         * @return number of such elements
+         */
+        template <typename T>
+        static Nd4jLong difference(const T *x, const Nd4jLong *xShapeInfo, const T *y, const Nd4jLong *yShapeInfo, std::vector<T> *values, std::vector<Nd4jLong> *positions, const int numThreads = nd4j::Environment::getInstance()->maxMasterThreads());
+    };
+
+    //////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    UniqueEngine::Table<T>::Table(Nd4jLong capacity) {
+        Nd4jLong size = 16;
+        while (size < capacity)
+            size <<= 1;
+
+        _slots.resize(size, Slot{0, 0});
+        _mask = static_cast<uint64_t>(size - 1);
+    }
+
+    template <typename T>
+    void UniqueEngine::Table<T>::grow() {
+        std::vector<Slot> slots(_slots.size() * 2, Slot{0, 0});
+        _mask = static_cast<uint64_t>(slots.size() - 1);
+
+        for (const auto &slot: _slots) {
+            if (slot.id == 0)
+                continue;
+
+            auto s = slot.hash & _mask;
+            while (slots[s].id != 0)
+                s = (s + 1) & _mask;
+
+            slots[s] = slot;
+        }
+
+        _slots.swap(slots);
+    }
+
+    template <typename T>
+    Nd4jLong UniqueEngine::Table<T>::insert(const T &key, const uint64_t hash, const Nd4jLong position, const Nd4jLong count) {
+        // NaN can't be found later anyway, so it gets new id without taking a slot
+        if (!UniqueEngine::equals<T>(key, key)) {
+            auto id = size();
+            keys.emplace_back(key);
+            hashes.emplace_back(hash);
+            counts.emplace_back(count);
+            first.emplace_back(position);
+            return id;
+        }
+
+        auto s = hash & _mask;
+        while (true) {
+            const auto &slot = _slots[s];
+            if (slot.id == 0)
+                break;
+
+            auto id = slot.id - 1;
+            if (slot.hash == hash && UniqueEngine::equals<T>(keys[id], key)) {
+                counts[id] += count;
+                return id;
+            }
+
+            s = (s + 1) & _mask;
+        }
+
+        auto id = size();
+        keys.emplace_back(key);
+        hashes.emplace_back(hash);
+        counts.emplace_back(count);
+        first.emplace_back(position);
+        _slots[s] = Slot{hash, id + 1};
+
+        // load factor is kept at or below 1/2
+        if (static_cast<uint64_t>(size()) * 2 > _mask + 1)
+            grow();
+
+        return id;
+    }
+
+    template <typename T>
+    Nd4jLong UniqueEngine::Table<T>::find(const T &key, const uint64_t hash) const {
+        auto s = hash & _mask;
+        while (true) {
+            const auto &slot = _slots[s];
+            if (slot.id == 0)
+                return -1;
+
+            auto id = slot.id - 1;
+            if (slot.hash == hash && UniqueEngine::equals<T>(keys[id], key))
+                return id;
+
+            s = (s + 1) & _mask;
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    Nd4jLong UniqueEngine::unique(const T *x, const Nd4jLong *xShapeInfo, std::vector<T> *values, Nd4jLong *indices, std::vector<Nd4jLong> *counts, const int numThreads) {
+        const Nd4jLong length = shape::length(xShapeInfo);
+        const Nd4jLong ews = strideOf(xShapeInfo);
+
+        if (values != nullptr)
+            values->clear();
+
+        if (counts != nullptr)
+            counts->clear();
+
+        if (length == 0)
+            return 0;
+
+        const int numChunks = numberOfChunks(length, numThreads);
+        const Nd4jLong span = length / numChunks;
+
+        // pass 1: every chunk is deduplicated on its own, indices temporarily hold chunk-local ids
+        std::vector<Table<T>> tables(numChunks);
+        forEachChunk([&](int c) {
+            auto start = c * span;
+            auto stop = c == numChunks - 1 ? length : start + span;
+            auto &table = tables[c];
+
+            for (auto e = start; e < stop; e++) {
+                const T key = x[offsetOf(xShapeInfo, ews, e)];
+                auto id = table.insert(key, hashOf(key), e);
+
+                if (indices != nullptr)
+                    indices[e] = id;
+            }
+        }, numChunks);
+
+        if (numChunks == 1) {
+            auto &table = tables[0];
+            auto total = table.size();
+
+            if (values != nullptr)
+                values->swap(table.keys);
+
+            if (counts != nullptr)
+                counts->swap(table.counts);
+
+            return total;
+        }
+
+        // pass 2: chunk-local uniques are merged into hash partitions. Chunks are visited in order,
+        // so every partition keeps its keys ordered by first occurrence
+        const int numPartitions = numChunks;
+        std::vector<Table<T>> partitions(numPartitions);
+        std::vector<std::vector<Nd4jLong>> mapping(numChunks);
+        for (int c = 0; c < numChunks; c++)
+            mapping[c].resize(tables[c].size());
+
+        forEachChunk([&](int q) {
+            auto &partition = partitions[q];
+
+            for (int c = 0; c < numChunks; c++) {
+                auto &table = tables[c];
+
+                for (Nd4jLong l = 0; l < table.size(); l++) {
+                    auto hash = table.hashes[l];
+                    if (partitionOf(hash, numPartitions) == q)
+                        mapping[c][l] = partition.insert(table.keys[l], hash, table.first[l], table.counts[l]);
+                }
+            }
+        }, numPartitions);
+
+        // pass 3: partitions are merged by position of first occurrence, which gives final rank of every key
+        Nd4jLong total = 0;
+        std::vector<std::vector<Nd4jLong>> ranks(numPartitions);
+        for (int q = 0; q < numPartitions; q++) {
+            ranks[q].resize(partitions[q].size());
+            total += partitions[q].size();
+        }
+
+        if (values != nullptr)
+            values->reserve(total);
+
+        if (counts != nullptr)
+            counts->reserve(total);
+
+        typedef std::pair<Nd4jLong, int> Head;
+        std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heads;
+        std::vector<Nd4jLong> cursors(numPartitions, 0);
+
+        for (int q = 0; q < numPartitions; q++)
+            if (partitions[q].size() > 0)
+                heads.push(Head(partitions[q].first[0], q));
+
+        Nd4jLong rank = 0;
+        while (!heads.empty()) {
+            auto q = heads.top().second;
+            heads.pop();
+
+            auto &partition = partitions[q];
+            auto k = cursors[q]++;
+            ranks[q][k] = rank++;
+
+            if (values != nullptr)
+                values->emplace_back(partition.keys[k]);
+
+            if (counts != nullptr)
+                counts->emplace_back(partition.counts[k]);
+
+            if (cursors[q] < partition.size())
+                heads.push(Head(partition.first[cursors[q]], q));
+        }
+
+        // pass 4: chunk-local ids are replaced with final ranks
+        if (indices != nullptr) {
+            forEachChunk([&](int c) {
+                auto &table = tables[c];
+                auto &map = mapping[c];
+
+                for (Nd4jLong l = 0; l < table.size(); l++)
+                    map[l] = ranks[partitionOf(table.hashes[l], numPartitions)][map[l]];
+
+                auto start = c * span;
+                auto stop = c == numChunks - 1 ? length : start + span;
+                for (auto e = start; e < stop; e++)
+                    indices[e] = map[indices[e]];
+            }, numChunks);
+        }
+
+        return total;
+    }
+
+    //////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    Nd4jLong UniqueEngine::difference(const T *x, const Nd4jLong *xShapeInfo, const T *y, const Nd4jLong *yShapeInfo, std::vector<T> *values, std::vector<Nd4jLong> *positions, const int numThreads) {
+        const Nd4jLong xLength = shape::length(xShapeInfo);
+        const Nd4jLong yLength = shape::length(yShapeInfo);
+        const Nd4jLong xEws = strideOf(xShapeInfo);
+        const Nd4jLong yEws = strideOf(yShapeInfo);
+
+        if (values != nullptr)
+            values->clear();
+
+        if (positions != nullptr)
+            positions->clear();
+
+        Table<T> table(2 * yLength);
+        for (Nd4jLong e = 0; e < yLength; e++) {
+            const T key = y[offsetOf(yShapeInfo, yEws, e)];
+            table.insert(key, hashOf(key), e);
+        }
+
+        if (xLength == 0)
+            return 0;
+
+        const int numChunks = numberOfChunks(xLength, numThreads);
+        const Nd4jLong span = xLength / numChunks;
+
+        // table is only read from here, so all chunks share it
+        std::vector<std::vector<Nd4jLong>> kept(numChunks);
+        forEachChunk([&](int c) {
+            auto start = c * span;
+            auto stop = c == numChunks - 1 ? xLength : start + span;
+
+            for (auto e = start; e < stop; e++) {
+                const T key = x[offsetOf(xShapeInfo, xEws, e)];
+                if (table.find(key, hashOf(key)) < 0)
+                    kept[c].emplace_back(e);
+            }
+        }, numChunks);
+
+        Nd4jLong total = 0;
+        for (int c = 0; c < numChunks; c++)
+            total += kept[c].size();
+
+        if (values != nullptr)
+            values->reserve(total);
+
+        if (positions != nullptr)
+            positions->reserve(total);
+
+        for (int c = 0; c < numChunks; c++) {
+            for (auto e: kept[c]) {
+                if (values != nullptr)
+                    values->emplace_back(x[offsetOf(xShapeInfo, xEws, e)]);
+
+                if (positions != nullptr)
+                    positions->emplace_back(e);
+            }
+        }
+
+        return total;
+    }
+}
+
+#endif //LIBND4J_UNIQUEENGINE_H
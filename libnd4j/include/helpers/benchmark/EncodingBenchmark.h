@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Threshold and bitmap encoding benchmark
+//
+
+#include "../OpBenchmark.h"
+
+#ifndef DEV_TESTS_ENCODINGBENCHMARK_H
+#define DEV_TESTS_ENCODINGBENCHMARK_H
+
+namespace nd4j {
+    /**
+     * This benchmark covers gradients compression: threshold encoding (P1 -> P2 -> P3) vs bitmap encoding
+     * X holds original values, Z is the residual array that gets encoded. X is copied into Z before each encoding,
+     * so every iteration sees the same sparsity.
+     */
+    class ND4J_EXPORT EncodingBenchmark : public OpBenchmark {
+    private:
+        bool _threshold = true;
+        float _value = 1e-3f;
+        std::vector<int> _blocks;
+        std::vector<int> _offsets;
+        std::vector<int> _encoded;
+    public:
+        EncodingBenchmark() : OpBenchmark() {
+            //
+        }
+
+        EncodingBenchmark(bool threshold, float value, std::string testName, NDArray *x, NDArray *z) : OpBenchmark(testName, x, z) {
+            _threshold = threshold;
+            _value = value;
+
+            auto N = _x->lengthOf();
+            auto numBlocks = N / THRESHOLD_BLOCK_SIZE + (N % THRESHOLD_BLOCK_SIZE ? 1 : 0);
+
+            _blocks.resize(numBlocks + 1);
+            _offsets.resize(numBlocks);
+
+            // threshold encoding stores 1 int per element in worst case, bitmap stores 16 elements per int
+            _encoded.resize(_threshold ? N + 4 : N / 16 + 5);
+        }
+
+        ~EncodingBenchmark(){
+            delete _x;
+            delete _z;
+        }
+
+        void executeOnce() override {
+            _z->assign(_x);
+
+            auto N = _z->lengthOf();
+
+            if (_threshold) {
+                NativeOpExecutioner::encodeThresholdP1(_z->buffer(), _z->shapeInfo(), N, _blocks.data(), _value);
+                NativeOpExecutioner::encodeThresholdP2Int(_blocks.data(), _offsets.size(), _offsets.data());
+
+                FloatBits2 fb;
+                fb.f_ = _value;
+                _encoded[0] = _blocks[0];
+                _encoded[1] = static_cast<int>(N);
+                _encoded[2] = fb.i_;
+
+                NativeOpExecutioner::encodeThresholdP3(_z->buffer(), _z->shapeInfo(), _offsets.data(), N, _encoded.data());
+            } else {
+                NativeOpExecutioner::encodeBitmap(_z->buffer(), _z->shapeInfo(), N, _encoded.data(), _value);
+            }
+        }
+
+        std::string axis() override {
+            return "N/A";
+        }
+
+        std::string inplace() override {
+            return "true";
+        }
+
+        std::string orders() override {
+            std::string result;
+            result += _z->ordering();
+            return result;
+        }
+
+        std::string strides() override {
+            return ShapeUtils::strideAsString(_z);
+        }
+
+        OpBenchmark* clone() override  {
+            return new EncodingBenchmark(_threshold, _value, _testName, new NDArray(_x->dup()), new NDArray(_z->dup()));
+        }
+    };
+}
+
+#endif //DEV_TESTS_ENCODINGBENCHMARK_H
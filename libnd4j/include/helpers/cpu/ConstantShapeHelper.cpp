@@ -27,11 +27,8 @@
 
 namespace nd4j {
     ConstantShapeHelper::ConstantShapeHelper() {
-        _cache.resize(32);
-        for (int e = 0; e < 32; e++) {
-            std::map<ShapeDescriptor, ConstantDataBuffer> cache;
-            _cache[e] = cache;
-        }
+        // single device, so we only have shards for device 0
+        _cache.resize(_numShards);
     }
 
     ConstantShapeHelper* ConstantShapeHelper::getInstance() {
@@ -54,24 +51,26 @@ namespace nd4j {
 
     ConstantDataBuffer ConstantShapeHelper::bufferForShapeInfo(const ShapeDescriptor &descriptor) {
         int deviceId = 0;
+        const int shard = shardForDescriptor(descriptor);
+        auto &cache = _cache[deviceId * _numShards + shard];
 
-        _mutex.lock();
+        std::lock_guard<std::mutex> lock(_mutex[shard]);
 
-        if (_cache[deviceId].count(descriptor) == 0) {
-            auto hPtr = descriptor.toShapeInfo();
-            ConstantDataBuffer buffer(hPtr, nullptr, shape::shapeInfoLength(hPtr)*sizeof(Nd4jLong), DataType::INT64);
-            ShapeDescriptor descriptor1(descriptor);
-            _cache[deviceId][descriptor1] = buffer;
-            auto r = _cache[deviceId][descriptor1];
-            _mutex.unlock();
+        auto it = cache.find(descriptor);
+        if (it != cache.end()) {
+            _cacheHits++;
+            return it->second;
+        }
 
-            return r;
-        } else {
-            auto r = _cache[deviceId].at(descriptor);
-            _mutex.unlock();
+        auto hPtr = descriptor.toShapeInfo();
+        ConstantDataBuffer buffer(hPtr, nullptr, shape::shapeInfoLength(hPtr)*sizeof(Nd4jLong), DataType::INT64);
+        ShapeDescriptor descriptor1(descriptor);
+        cache[descriptor1] = buffer;
 
-            return r;
-        }
+        _cacheMisses++;
+        _cachedBytes += shape::shapeInfoByteLength(hPtr);
+
+        return buffer;
     }
 
     ConstantDataBuffer ConstantShapeHelper::bufferForShapeInfo(const Nd4jLong *shapeInfo) {
@@ -80,18 +79,12 @@ namespace nd4j {
     }
 
     bool ConstantShapeHelper::checkBufferExistenceForShapeInfo(ShapeDescriptor &descriptor) {
-        bool result;
         int deviceId = 0;
-        _mutex.lock();
-
-        if (_cache[deviceId].count(descriptor) == 0)
-            result = false;
-        else
-            result = true;
+        const int shard = shardForDescriptor(descriptor);
 
-        _mutex.unlock();
+        std::lock_guard<std::mutex> lock(_mutex[shard]);
 
-        return result;
+        return _cache[deviceId * _numShards + shard].count(descriptor) != 0;
     }
 
     Nd4jLong* ConstantShapeHelper::createShapeInfo(const nd4j::DataType dataType, const char order, const int rank, const Nd4jLong* shape) {
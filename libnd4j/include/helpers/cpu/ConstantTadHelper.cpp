@@ -27,8 +27,8 @@
 namespace nd4j {
 
     ConstantTadHelper::ConstantTadHelper() {
-        std::map<TadDescriptor, TadPack> pack;
-        _cache.emplace_back(pack);
+        // single device, so we only have shards for device 0
+        _cache.resize(_numShards);
     }
 
     ConstantTadHelper* ConstantTadHelper::getInstance() {
@@ -58,58 +58,57 @@ namespace nd4j {
 
     TadPack ConstantTadHelper::tadForDimensions(TadDescriptor &descriptor) {
         const int deviceId = 0;
+        const int shard = shardForDescriptor(descriptor);
+        auto &cache = _cache[deviceId * _numShards + shard];
+
+        // fast path: lookup within single shard, so concurrent lookups for other descriptors aren't blocked
+        {
+            std::lock_guard<std::mutex> lock(_mutex[shard]);
+
+            auto it = cache.find(descriptor);
+            if (it != cache.end()) {
+                _cacheHits++;
+                return it->second;
+            }
+        }
 
-        _mutex.lock();
-        if (_cache[deviceId].count(descriptor) == 0) {
-
-            const auto shapeInfo = descriptor.originalShape().toShapeInfo();
-            const int rank = shape::rank(shapeInfo);
-            const std::vector<int> dimsToExclude = ShapeUtils::evalDimsToExclude(rank, descriptor.axis());
-            const Nd4jLong numOfSubArrs = ShapeUtils::getNumOfSubArrs(shapeInfo, dimsToExclude);
-            const int subArrRank = (rank == dimsToExclude.size() || descriptor.areUnitiesinShape()) ? rank : rank - dimsToExclude.size();
-
-            auto sPtr = new Nd4jLong[shape::shapeInfoLength(subArrRank)];   // shape of sub-arrays (same for all for them)
-            auto oPtr = new Nd4jLong[numOfSubArrs];
-
-            if (numOfSubArrs > 0)
-                shape::calcSubArrShapeAndOffsets(shapeInfo, numOfSubArrs, dimsToExclude.size(), dimsToExclude.data(), sPtr, oPtr, descriptor.areUnitiesinShape());
-
-
-            ConstantDataBuffer shapesBuffer(sPtr, nullptr, shape::shapeInfoLength(subArrRank)*sizeof(Nd4jLong), DataType::INT64);
-            ConstantDataBuffer offsetsBuffer(oPtr, nullptr, numOfSubArrs*sizeof(Nd4jLong), DataType::INT64);
-            TadPack t(shapesBuffer, offsetsBuffer, numOfSubArrs);
-
-
+        // TAD is calculated outside of lock
+        const auto shapeInfo = descriptor.originalShape().toShapeInfo();
+        const int rank = shape::rank(shapeInfo);
+        const std::vector<int> dimsToExclude = ShapeUtils::evalDimsToExclude(rank, descriptor.axis());
+        const Nd4jLong numOfSubArrs = ShapeUtils::getNumOfSubArrs(shapeInfo, dimsToExclude);
+        const int subArrRank = (rank == dimsToExclude.size() || descriptor.areUnitiesinShape()) ? rank : rank - dimsToExclude.size();
 
-            // auto shapeInfo = descriptor.originalShape().toShapeInfo();
-            // shape::TAD tad;
-            // tad.init(shapeInfo, descriptor.axis().data(), descriptor.axis().size());
-            // tad.createTadOnlyShapeInfo();
-            // tad.createOffsets();
+        auto sPtr = new Nd4jLong[shape::shapeInfoLength(subArrRank)];   // shape of sub-arrays (same for all for them)
+        auto oPtr = new Nd4jLong[numOfSubArrs];
 
-            // auto sPtr = new Nd4jLong[shape::shapeInfoLength(tad.tadOnlyShapeInfo)];
-            // auto oPtr = new Nd4jLong[tad.numTads];
+        if (numOfSubArrs > 0)
+            shape::calcSubArrShapeAndOffsets(shapeInfo, numOfSubArrs, dimsToExclude.size(), dimsToExclude.data(), sPtr, oPtr, descriptor.areUnitiesinShape());
 
-            // memcpy(sPtr, tad.tadOnlyShapeInfo, shape::shapeInfoByteLength(tad.tadOnlyShapeInfo));
-            // memcpy(oPtr, tad.tadOffsets, tad.numTads * sizeof(Nd4jLong));
+        delete[] shapeInfo;
 
-            // TadPack t(shapesBuffer, offsetsBuffer, tad.numTads);
+        std::lock_guard<std::mutex> lock(_mutex[shard]);
 
+        // other thread might have added the same TAD while we were calculating it
+        auto it = cache.find(descriptor);
+        if (it != cache.end()) {
+            delete[] sPtr;
+            delete[] oPtr;
 
-            _cache[deviceId][descriptor] = t;
+            _cacheHits++;
+            return it->second;
+        }
 
-            TadPack &r = _cache[deviceId][descriptor];
-            _mutex.unlock();
+        ConstantDataBuffer shapesBuffer(sPtr, nullptr, shape::shapeInfoLength(subArrRank)*sizeof(Nd4jLong), DataType::INT64);
+        ConstantDataBuffer offsetsBuffer(oPtr, nullptr, numOfSubArrs*sizeof(Nd4jLong), DataType::INT64);
+        TadPack t(shapesBuffer, offsetsBuffer, numOfSubArrs);
 
-            delete[] shapeInfo;
+        cache[descriptor] = t;
 
-            return r;
-        } else {
-            TadPack r = _cache[deviceId][descriptor];
-            _mutex.unlock();
+        _cacheMisses++;
+        _cachedBytes += (shape::shapeInfoLength(subArrRank) + numOfSubArrs) * sizeof(Nd4jLong);
 
-            return r;
-        }
+        return t;
     }
 
     nd4j::ConstantTadHelper* nd4j::ConstantTadHelper::_INSTANCE = 0;
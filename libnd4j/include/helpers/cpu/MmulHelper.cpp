@@ -29,71 +29,242 @@
 namespace nd4j {
 
 //////////////////////////////////////////////////////////////////////////////
-// MXK x KxN = MxN              -> actual sequence of axes doesn't matter
-template <typename T1, typename T2, typename T3>
-static  void usualGemm(const NDArray* vA, const NDArray* vB, NDArray* vC,
-                                 const int aMaxis, const int aKaxis, const int bKaxis, const int bNaxis, const int cMaxis, const int cNaxis,
-                                 const double alpha, const double beta) {
+// type used for accumulation in blockedGemm: half precision types are accumulated in float, narrow integers in int
+template <typename T>
+struct GemmAccumulator { typedef T type; };
+
+template <> struct GemmAccumulator<float16>  { typedef float type; };
+template <> struct GemmAccumulator<bfloat16> { typedef float type; };
+template <> struct GemmAccumulator<int8_t>   { typedef int type; };
+template <> struct GemmAccumulator<uint8_t>  { typedef int type; };
+template <> struct GemmAccumulator<int16_t>  { typedef int type; };
+template <> struct GemmAccumulator<uint16_t> { typedef int type; };
+
+// micro-kernel tile (MR x NR) and cache blocks (MC x KC for A, KC x NC for B)
+#define GEMM_MR 4
+#define GEMM_NR 8
+#define GEMM_MC 64
+#define GEMM_NC 128
+#define GEMM_KC 256
 
-    const T1* A = vA->bufferAsT<T1>();
-    const T2* B = vB->bufferAsT<T2>();
-          T3* C = vC->bufferAsT<T3>();
+//////////////////////////////////////////////////////////////////////////////
+// accumulates A[m0:m0+mc, kStart:kStop] x B[kStart:kStop, n0:n0+nc] into tile (leading dimension ldc, padded up to MR/NR)
+// blocks of A and B are packed into contiguous MR-row/NR-column panels (converted to accumulator type), and MR x NR register
+// tiles are computed by SIMD micro-kernel
+template <typename T, typename Z>
+static void gemmTile(const T* A, const Nd4jLong aMstride, const Nd4jLong aKstride,
+                     const T* B, const Nd4jLong bKstride, const Nd4jLong bNstride,
+                     Z* aPack, Z* bPack, Z* tile, const int ldc, const int kcBlock,
+                     const Nd4jLong m0, const int mc, const Nd4jLong n0, const int nc, const Nd4jLong kStart, const Nd4jLong kStop) {
+
+    const int mPanels = (mc + GEMM_MR - 1) / GEMM_MR;
+    const int nPanels = (nc + GEMM_NR - 1) / GEMM_NR;
+
+    for (Nd4jLong k0 = kStart; k0 < kStop; k0 += kcBlock) {
+
+        const int kc = nd4j::math::nd4j_min<Nd4jLong>(kcBlock, kStop - k0);
+
+        // packing A: aPack[(p * kc + k) * MR + r] = A[m0 + p * MR + r, k0 + k]
+        for (int p = 0; p < mPanels; p++) {
+            auto panel = aPack + p * kc * GEMM_MR;
+            for (int r = 0; r < GEMM_MR; r++) {
+                const int m = p * GEMM_MR + r;
+                if (m < mc) {
+                    auto a = A + (m0 + m) * aMstride + k0 * aKstride;
+                    for (int k = 0; k < kc; k++)
+                        panel[k * GEMM_MR + r] = static_cast<Z>(a[k * aKstride]);
+                }
+                else {
+                    for (int k = 0; k < kc; k++)
+                        panel[k * GEMM_MR + r] = static_cast<Z>(0);
+                }
+            }
+        }
 
-    const T3 alphaZ = alpha;
-    const T3 betaZ  = beta;
+        // packing B: bPack[(q * kc + k) * NR + c] = B[k0 + k, n0 + q * NR + c]
+        for (int q = 0; q < nPanels; q++) {
+            auto panel = bPack + q * kc * GEMM_NR;
+            for (int k = 0; k < kc; k++) {
+                auto b = B + (k0 + k) * bKstride + n0 * bNstride;
+                for (int c = 0; c < GEMM_NR; c++) {
+                    const int n = q * GEMM_NR + c;
+                    panel[k * GEMM_NR + c] = n < nc ? static_cast<Z>(b[n * bNstride]) : static_cast<Z>(0);
+                }
+            }
+        }
+
+        // micro-kernel over MR x NR register tiles
+        for (int p = 0; p < mPanels; p++) {
+            for (int q = 0; q < nPanels; q++) {
+
+                const Z* ap = aPack + p * kc * GEMM_MR;
+                const Z* bp = bPack + q * kc * GEMM_NR;
+
+                Z acc[GEMM_MR][GEMM_NR] = {};
+
+                for (int k = 0; k < kc; k++) {
+                    const Z* bk = bp + k * GEMM_NR;
+                    for (int r = 0; r < GEMM_MR; r++) {
+                        const Z a = ap[k * GEMM_MR + r];
+                        PRAGMA_OMP_SIMD
+                        for (int c = 0; c < GEMM_NR; c++)
+                            acc[r][c] += a * bk[c];
+                    }
+                }
+
+                for (int r = 0; r < GEMM_MR; r++) {
+                    auto cRow = tile + (p * GEMM_MR + r) * ldc + q * GEMM_NR;
+                    PRAGMA_OMP_SIMD
+                    for (int c = 0; c < GEMM_NR; c++)
+                        cRow[c] += acc[r][c];
+                }
+            }
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// C[m0:m0+mc, n0:n0+nc] = alpha * tile + beta * C
+template <typename T, typename Z>
+static void storeTile(T* C, const Nd4jLong cMstride, const Nd4jLong cNstride, const Z* tile, const int ldc,
+                      const Nd4jLong m0, const int mc, const Nd4jLong n0, const int nc, const Z alphaZ, const Z betaZ, const bool betaPersent) {
+
+    for (int m = 0; m < mc; m++) {
+        auto cRow = C + (m0 + m) * cMstride + n0 * cNstride;
+        auto tRow = tile + m * ldc;
+
+        if (betaPersent) {
+            for (int n = 0; n < nc; n++)
+                cRow[n * cNstride] = static_cast<T>(alphaZ * tRow[n] + betaZ * static_cast<Z>(cRow[n * cNstride]));
+        }
+        else {
+            for (int n = 0; n < nc; n++)
+                cRow[n * cNstride] = static_cast<T>(alphaZ * tRow[n]);
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// MXK x KxN = MxN, fallback for types not supported by BLAS
+// C is split into tiles (MC x NC at most) processed in parallel, see gemmTile for what happens within a tile.
+// Outputs too small to give every thread a tile of its own get smaller tiles (down to MR x NR), and if that's still
+// not enough, K is split as well: every K part is accumulated into its own tile, and parts are summed up at the end
+template <typename T>
+static void blockedGemm(const NDArray* vA, const NDArray* vB, NDArray* vC, const double alpha, const double beta) {
+
+    typedef typename GemmAccumulator<T>::type Z;
+
+    const T* A = vA->bufferAsT<T>();
+    const T* B = vB->bufferAsT<T>();
+          T* C = vC->bufferAsT<T>();
+
+    const Z alphaZ = alpha;
+    const Z betaZ  = beta;
 
     const bool betaPersent = beta;
 
-    const Nd4jLong* aShapeInfo = vA->getShapeInfo();
-    const Nd4jLong* bShapeInfo = vB->getShapeInfo();
-    const Nd4jLong* cShapeInfo = vC->getShapeInfo();
+    const Nd4jLong M = vA->sizeAt(0);
+    const Nd4jLong K = vA->sizeAt(1);
+    const Nd4jLong N = vB->sizeAt(1);
 
-    const int aRank = vA->rankOf();
-    const int bRank = vB->rankOf();
-    const int cRank = vC->rankOf();
+    const Nd4jLong aMstride = vA->strideAt(0), aKstride = vA->strideAt(1);
+    const Nd4jLong bKstride = vB->strideAt(0), bNstride = vB->strideAt(1);
+    const Nd4jLong cMstride = vC->strideAt(0), cNstride = vC->strideAt(1);
 
-    const Nd4jLong cLen = vC->lengthOf();
+    const int numThreads = Environment::getInstance()->maxMasterThreads();
 
-    const int K = vA->sizeAt(aKaxis);
+    // tile sizes, multiples of MR/NR
+    int mcBlock = ((nd4j::math::nd4j_min<Nd4jLong>(GEMM_MC, M) + GEMM_MR - 1) / GEMM_MR) * GEMM_MR;
+    int ncBlock = ((nd4j::math::nd4j_min<Nd4jLong>(GEMM_NC, N) + GEMM_NR - 1) / GEMM_NR) * GEMM_NR;
+
+    auto numTilesOf = [&] (int mc, int nc) -> Nd4jLong { return ((M + mc - 1) / mc) * ((N + nc - 1) / nc); };
+
+    while (numTilesOf(mcBlock, ncBlock) < numThreads && (mcBlock > GEMM_MR || ncBlock > GEMM_NR)) {
+        if (ncBlock > GEMM_NR && (ncBlock >= mcBlock || mcBlock == GEMM_MR))
+            ncBlock = ((ncBlock / 2 + GEMM_NR - 1) / GEMM_NR) * GEMM_NR;
+        else
+            mcBlock = ((mcBlock / 2 + GEMM_MR - 1) / GEMM_MR) * GEMM_MR;
+    }
+
+    const Nd4jLong nBlocks = (N + ncBlock - 1) / ncBlock;
+    const Nd4jLong numTiles = numTilesOf(mcBlock, ncBlock);
+
+    Nd4jLong kSplit = 1;
+    Nd4jLong kChunk = K;
+    if (numTiles < numThreads && K > GEMM_KC) {
+        kSplit = nd4j::math::nd4j_min<Nd4jLong>(numThreads / numTiles, (K + GEMM_KC - 1) / GEMM_KC);
+        kChunk = (K + kSplit - 1) / kSplit;
+        kSplit = (K + kChunk - 1) / kChunk;
+    }
+
+    const int kcBlock = nd4j::math::nd4j_min<Nd4jLong>(GEMM_KC, kChunk);
+    const Nd4jLong tileLength = mcBlock * ncBlock;
+
+    std::vector<Z> partials(kSplit > 1 ? numTiles * kSplit * tileLength : 0);
 
     auto func = PRAGMA_THREADS_FOR {
 
-        std::vector<Nd4jLong> aCoords(2), bCoords(2), cCoords(2);
+        // per-thread buffers
+        std::vector<Z> aPack(mcBlock * kcBlock), bPack(kcBlock * ncBlock), cTile(kSplit > 1 ? 0 : tileLength);
 
-        for (auto i = start; i < stop; ++i) {
+        for (auto t = start; t < stop; t++) {
 
-            // evaluate C coordinates
-            shape::index2coords(i, cShapeInfo, cCoords.data());
+            const Nd4jLong tile = t / kSplit;
+            const Nd4jLong part = t % kSplit;
 
-            // evaluate A coordinates
-            aCoords[aMaxis] = cCoords[cMaxis];
-            aCoords[aKaxis] = 0;
+            const Nd4jLong m0 = (tile / nBlocks) * mcBlock;
+            const Nd4jLong n0 = (tile % nBlocks) * ncBlock;
+            const int mc = nd4j::math::nd4j_min<Nd4jLong>(mcBlock, M - m0);
+            const int nc = nd4j::math::nd4j_min<Nd4jLong>(ncBlock, N - n0);
 
-            // evaluate B coordinates
-            bCoords[bKaxis] = 0;
-            bCoords[bNaxis] = cCoords[cNaxis];
+            Z* buffer = kSplit > 1 ? partials.data() + t * tileLength : cTile.data();
 
-            auto aOffset = shape::getOffset(aShapeInfo, aCoords.data());
-            auto bOffset = shape::getOffset(bShapeInfo, bCoords.data());
+            // only the part of tile covered by MR x NR panels of this block is used
+            const int mActive = ((mc + GEMM_MR - 1) / GEMM_MR) * GEMM_MR;
+            const int nActive = ((nc + GEMM_NR - 1) / GEMM_NR) * GEMM_NR;
+            for (int m = 0; m < mActive; m++)
+                std::fill(buffer + m * ncBlock, buffer + m * ncBlock + nActive, static_cast<Z>(0));
 
-            T3 val = A[aOffset] * B[bOffset];                       // first iteration
+            const Nd4jLong kStart = part * kChunk;
+            const Nd4jLong kStop = nd4j::math::nd4j_min<Nd4jLong>(K, kStart + kChunk);
 
-            for (uint j = 1; j < K; ++j) {                          // rest iterations
-                aOffset += shape::stride(aShapeInfo)[aKaxis];
-                bOffset += shape::stride(bShapeInfo)[bKaxis];
-                val = val + A[aOffset] * B[bOffset];
-            }
+            gemmTile<T, Z>(A, aMstride, aKstride, B, bKstride, bNstride, aPack.data(), bPack.data(), buffer, ncBlock, kcBlock, m0, mc, n0, nc, kStart, kStop);
 
-            auto cOffset = shape::getOffset(cShapeInfo, cCoords.data());
+            if (kSplit == 1)
+                storeTile<T, Z>(C, cMstride, cNstride, buffer, ncBlock, m0, mc, n0, nc, alphaZ, betaZ, betaPersent);
+        }
+    };
 
-            if(betaPersent)
-                C[cOffset] = alphaZ * val + betaZ * C[cOffset];
-            else
-                C[cOffset] = alphaZ * val;
+    samediff::Threads::parallel_for(func, 0, numTiles * kSplit);
+
+    if (kSplit == 1)
+        return;
+
+    auto reduce = PRAGMA_THREADS_FOR {
+
+        for (auto tile = start; tile < stop; tile++) {
+
+            const Nd4jLong m0 = (tile / nBlocks) * mcBlock;
+            const Nd4jLong n0 = (tile % nBlocks) * ncBlock;
+            const int mc = nd4j::math::nd4j_min<Nd4jLong>(mcBlock, M - m0);
+            const int nc = nd4j::math::nd4j_min<Nd4jLong>(ncBlock, N - n0);
+
+            Z* sum = partials.data() + tile * kSplit * tileLength;
+
+            for (Nd4jLong part = 1; part < kSplit; part++) {
+                const Z* other = sum + part * tileLength;
+                for (int m = 0; m < mc; m++) {
+                    PRAGMA_OMP_SIMD
+                    for (int n = 0; n < nc; n++)
+                        sum[m * ncBlock + n] += other[m * ncBlock + n];
+                }
+            }
+
+            storeTile<T, Z>(C, cMstride, cNstride, sum, ncBlock, m0, mc, n0, nc, alphaZ, betaZ, betaPersent);
         }
     };
 
-    samediff::Threads::parallel_tad(func, 0, cLen);
+    samediff::Threads::parallel_for(reduce, 0, numTiles);
 }
 
 
@@ -216,8 +387,7 @@ NDArray* MmulHelper::mmulMxM(const NDArray* A, const NDArray* B, NDArray* C, con
     const bool typeFloat  = hasGemm && ABC &&  aType == DataType::FLOAT32;
 
     if(!typeFloat && !typeDouble) {
-        BUILD_SINGLE_SELECTOR_THRICE(aType, usualGemm, (A, B, C, 0, 1, 0, 1, 0, 1, alpha, beta), NUMERIC_TYPES);
-        // BUILD_TRIPLE_SELECTOR(aType, bType, cType, usualGemm, (A, B, C, 0, 1, 0, 1, 0, 1, alpha, beta), LIBND4J_TYPES, FLOAT_TYPES, FLOAT_TYPES);
+        BUILD_SINGLE_SELECTOR(aType, blockedGemm, (A, B, C, alpha, beta), NUMERIC_TYPES);
     }
     else {
 
@@ -21,6 +21,7 @@
 #include <jacobiSVD.h>
 #include <hhColPivQR.h>
 #include <NDArrayFactory.h>
+#include <execution/Threads.h>
 
 
 namespace nd4j {
@@ -69,65 +70,55 @@ JacobiSVD<T>::JacobiSVD(const NDArray& matrix, const bool calcU, const bool calc
 }
 
 //////////////////////////////////////////////////////////////////////////
+// rows i and j of block are replaced by rotation * [row_i; row_j]
 template <typename T>
 void JacobiSVD<T>::mulRotationOnLeft(const int i, const int j, NDArray& block, const NDArray& rotation) {
 
-    if(i < j) {
+    if(j+1 > block.sizeAt(0) || i+1 > block.sizeAt(0))
+        throw std::runtime_error("ops::helpers::JacobiSVD mulRotationOnLeft: some or both integer arguments are out of array row range !");
 
-        if(j+1 > block.sizeAt(0))
-            throw std::runtime_error("ops::helpers::JacobiSVD mulRotationOnLeft: second arguments is out of array row range !");
+    const T r00 = rotation.e<T>(0,0), r01 = rotation.e<T>(0,1), r10 = rotation.e<T>(1,0), r11 = rotation.e<T>(1,1);
 
-        auto pTemp = block({i,j+1,j-i,  0,0,0}, true, true);
-        auto temp = pTemp;
-        pTemp.assign(mmul(rotation, temp));
-    }
-    else {
+    T* rowI = block.bufferAsT<T>() + i * block.strideAt(0);
+    T* rowJ = block.bufferAsT<T>() + j * block.strideAt(0);
+    const Nd4jLong stride = block.strideAt(1);
 
-        if(j+1 > block.sizeAt(0) || i+1 > block.sizeAt(0))
-            throw std::runtime_error("ops::helpers::JacobiSVD mulRotationOnLeft: some or both integer arguments are out of array row range !");
-
-        auto temp = NDArrayFactory::create(block.ordering(), {2, block.sizeAt(1)}, block.dataType(), block.getContext());
-        auto row1     = block({i,i+1, 0,0}, true);
-        auto row2     = block({j,j+1, 0,0}, true);
-        auto rowTemp1 = temp({0,1, 0,0}, true);
-        auto rowTemp2 = temp({1,2, 0,0}, true);
-        rowTemp1.assign(row1);
-        rowTemp2.assign(row2);
-        temp.assign(mmul(rotation, temp));
-        row1.assign(rowTemp1);
-        row2.assign(rowTemp2);
-    }
+    auto func = PRAGMA_THREADS_FOR {
+        for (auto k = start; k < stop; k += increment) {
+            const T a = rowI[k * stride];
+            const T b = rowJ[k * stride];
+            rowI[k * stride] = r00 * a + r01 * b;
+            rowJ[k * stride] = r10 * a + r11 * b;
+        }
+    };
+
+    samediff::Threads::parallel_for(func, 0, block.sizeAt(1));
 }
 
 //////////////////////////////////////////////////////////////////////////
+// columns i and j of block are replaced by [col_i, col_j] * rotation
 template <typename T>
 void JacobiSVD<T>::mulRotationOnRight(const int i, const int j, NDArray& block, const NDArray& rotation) {
 
-    if(i < j) {
+    if(j+1 > block.sizeAt(1) || i+1 > block.sizeAt(1))
+        throw std::runtime_error("ops::helpers::JacobiSVD mulRotationOnRight: some or both integer arguments are out of array column range !");
 
-        if(j+1 > block.sizeAt(1))
-            throw std::runtime_error("ops::helpers::JacobiSVD mulRotationOnRight: second argument is out of array column range !");
+    const T r00 = rotation.e<T>(0,0), r01 = rotation.e<T>(0,1), r10 = rotation.e<T>(1,0), r11 = rotation.e<T>(1,1);
 
-        auto pTemp = block({0,0,0,  i,j+1,j-i}, true, true);
-        auto temp = pTemp;
-        pTemp.assign(mmul(temp, rotation));
-    }
-    else {
+    T* colI = block.bufferAsT<T>() + i * block.strideAt(1);
+    T* colJ = block.bufferAsT<T>() + j * block.strideAt(1);
+    const Nd4jLong stride = block.strideAt(0);
 
-        if(j+1 > block.sizeAt(1) || i+1 > block.sizeAt(1))
-            throw std::runtime_error("ops::helpers::JacobiSVD mulRotationOnRight: some or both integer arguments are out of array column range !");
-
-        auto temp = NDArrayFactory::create(block.ordering(), {block.sizeAt(0), 2}, block.dataType(), block.getContext());
-        auto col1     = block({0,0, i,i+1}, true);
-        auto col2     = block({0,0, j,j+1}, true);
-        auto colTemp1 = temp({0,0, 0,1}, true);
-        auto colTemp2 = temp({0,0, 1,2}, true);
-        colTemp1.assign(col1);
-        colTemp2.assign(col2);
-        temp.assign(mmul(temp, rotation));
-        col1.assign(colTemp1);
-        col2.assign(colTemp2);
-    }
+    auto func = PRAGMA_THREADS_FOR {
+        for (auto k = start; k < stop; k += increment) {
+            const T a = colI[k * stride];
+            const T b = colJ[k * stride];
+            colI[k * stride] = a * r00 + b * r10;
+            colJ[k * stride] = a * r01 + b * r11;
+        }
+    };
+
+    samediff::Threads::parallel_for(func, 0, block.sizeAt(0));
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -210,47 +201,39 @@ bool JacobiSVD<T>::createJacobiRotation(const T& x, const T& y, const T& z, NDAr
 template <typename T>
 void JacobiSVD<T>::svd2x2(const NDArray& block, int p, int q, NDArray& left, NDArray& right) {
 
-    auto m = NDArrayFactory::create(block.ordering(), {2, 2}, block.dataType(), block.getContext());
-    m.p<T>(0,0, block.e<T>(p,p));
-    m.p<T>(0,1, block.e<T>(p,q));
-    m.p<T>(1,0, block.e<T>(q,p));
-    m.p<T>(1,1, block.e<T>(q,q));
+    // 2x2 products are done on scalars, there is no point in gemm calls for them
+    const T m00 = block.e<T>(p,p), m01 = block.e<T>(p,q), m10 = block.e<T>(q,p), m11 = block.e<T>(q,q);
 
-    auto rotation = NDArrayFactory::create(block.ordering(), {2, 2}, block.dataType(), block.getContext());
-    T t = m.e<T>(0,0) + m.e<T>(1,1);
-    T d = m.e<T>(1,0) - m.e<T>(0,1);
+    T t = m00 + m11;
+    T d = m10 - m01;
+    T r00, r01, r10, r11;
 
     if(math::nd4j_abs<T>(d) < DataTypeUtils::min<T>()) {
-
-        rotation.p(0,0, 1.f);
-        rotation.p(1,1, 1.f);
-        rotation.p(0,1, 0.f);
-        rotation.p(1,0, 0.f);
+        r00 = r11 = 1.f;
+        r01 = r10 = 0.f;
     }
     else {
 
         T u = t / d;
         T tmp = math::nd4j_sqrt<T,T>(1. + u*u);
-        rotation.p(0,0, u / tmp);
-        rotation.p(1,1, u / tmp);
-        rotation.p(0,1, 1.f / tmp);
-        rotation.p(1,0, -rotation.e<T>(0,1));
+        r00 = r11 = u / tmp;
+        r01 = 1.f / tmp;
+        r10 = -r01;
     }
 
-    m.assign(mmul(rotation, m));
-
-    auto _x = m.e<T>(0,0);
-    auto _y = m.e<T>(0,1);
-    auto _z = m.e<T>(1,1);
+    // m = rotation * m, lower left element is not needed
+    T _x = r00 * m00 + r01 * m10;
+    T _y = r00 * m01 + r01 * m11;
+    T _z = r10 * m01 + r11 * m11;
 
     createJacobiRotation(_x, _y, _z, right);
 
-    m.p<T>(0, 0, _x);
-    m.p<T>(0, 1, _y);
-    m.p<T>(1, 1, _z);
-
-    auto temp = right.transpose();
-    left.assign(mmul(rotation, temp));
+    // left = rotation * right^T
+    const T q00 = right.e<T>(0,0), q01 = right.e<T>(0,1), q10 = right.e<T>(1,0), q11 = right.e<T>(1,1);
+    left.p<T>(0, 0, r00 * q00 + r01 * q01);
+    left.p<T>(0, 1, r00 * q10 + r01 * q11);
+    left.p<T>(1, 0, r10 * q00 + r11 * q01);
+    left.p<T>(1, 1, r10 * q10 + r11 * q11);
 }
 
 
@@ -314,9 +297,19 @@ void JacobiSVD<T>::evalData(const NDArray& matrix) {
             _v.setIdentity();
     }
 
+    // rotations are applied in place, so buffer of _m stays valid during sweeps
+    const T* m = _m.bufferAsT<T>();
+    const Nd4jLong mStride0 = _m.strideAt(0);
+    const Nd4jLong mStride1 = _m.strideAt(1);
+    auto mElem = [&](const int r, const int c) -> T { return m[r * mStride0 + c * mStride1]; };
+
+    auto rotLeft = NDArrayFactory::create(_m.ordering(), {2, 2}, _m.dataType(), _m.getContext());
+    auto rotRight = NDArrayFactory::create(_m.ordering(), {2, 2}, _m.dataType(), _m.getContext());
+    auto rotLeftT = rotLeft.transpose();
+
     T maxDiagElem = 0.;
     for(int i = 0; i < _diagSize; ++i) {
-        T current = math::nd4j_abs<T>(_m.e<T>(i,i));
+        T current = math::nd4j_abs<T>(mElem(i,i));
         if(maxDiagElem < current )
             maxDiagElem = current;
     }
@@ -333,29 +326,25 @@ void JacobiSVD<T>::evalData(const NDArray& matrix) {
 
                 T threshold = math::nd4j_max<T>(almostZero, precision * maxDiagElem);
 
-                if(math::nd4j_abs<T>(_m.e<T>(p,q)) > threshold || math::nd4j_abs<T>(_m.e<T>(q,p)) > threshold){
+                if(math::nd4j_abs<T>(mElem(p,q)) > threshold || math::nd4j_abs<T>(mElem(q,p)) > threshold){
 
                     stop = false;
 
                     // if(isBlock2x2NotDiag(_m, p, q, maxDiagElem))
                     {
-                        auto rotLeft = NDArrayFactory::create(_m.ordering(), {2, 2}, _m.dataType(), _m.getContext());
-                        auto rotRight = NDArrayFactory::create(_m.ordering(), {2, 2}, _m.dataType(), _m.getContext());
                         svd2x2(_m, p, q, rotLeft, rotRight);
 
                         mulRotationOnLeft(p, q, _m, rotLeft);
 
-                        if(_calcU) {
-                            auto temp = rotLeft.transpose();
-                            mulRotationOnRight(p, q, _u, temp);
-                        }
+                        if(_calcU)
+                            mulRotationOnRight(p, q, _u, rotLeftT);
 
                         mulRotationOnRight(p, q, _m, rotRight);
 
                         if(_calcV)
                             mulRotationOnRight(p, q, _v, rotRight);
 
-                        maxDiagElem = math::nd4j_max<T>(maxDiagElem, math::nd4j_max<T>(math::nd4j_abs<T>(_m.e<T>(p,p)), math::nd4j_abs<T>(_m.e<T>(q,q))));
+                        maxDiagElem = math::nd4j_max<T>(maxDiagElem, math::nd4j_max<T>(math::nd4j_abs<T>(mElem(p,p)), math::nd4j_abs<T>(mElem(q,q))));
                     }
                 }
             }
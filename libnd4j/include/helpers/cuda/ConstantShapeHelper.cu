@@ -30,11 +30,7 @@ namespace nd4j {
     ConstantShapeHelper::ConstantShapeHelper() {
         auto numDevices = AffinityManager::numberOfDevices();
 
-        _cache.resize(numDevices);
-        for (int e = 0; e < numDevices; e++) {
-            std::map<ShapeDescriptor, ConstantDataBuffer> cache;
-            _cache[e] = cache;
-        }
+        _cache.resize(numDevices * _numShards);
     }
 
     ConstantShapeHelper* ConstantShapeHelper::getInstance() {
@@ -56,18 +52,26 @@ namespace nd4j {
 
     ConstantDataBuffer ConstantShapeHelper::bufferForShapeInfo(const ShapeDescriptor &descriptor) {
         int deviceId = AffinityManager::currentDeviceId();
+        const int shard = shardForDescriptor(descriptor);
+        auto &cache = _cache[deviceId * _numShards + shard];
 
-        std::lock_guard<std::mutex> lock(_mutex);
+        std::lock_guard<std::mutex> lock(_mutex[shard]);
 
-        if (_cache[deviceId].count(descriptor) == 0) {
+        if (cache.count(descriptor) == 0) {
             auto hPtr = descriptor.toShapeInfo();
             auto dPtr = ConstantHelper::getInstance()->replicatePointer(hPtr, shape::shapeInfoByteLength(hPtr));
             ConstantDataBuffer buffer(hPtr, dPtr, shape::shapeInfoLength(hPtr) * sizeof(Nd4jLong), DataType::INT64);
             ShapeDescriptor descriptor1(descriptor);
-            _cache[deviceId][descriptor1] = buffer;
-            return _cache[deviceId][descriptor1];
+            cache[descriptor1] = buffer;
+
+            _cacheMisses++;
+            _cachedBytes += shape::shapeInfoByteLength(hPtr);
+
+            return buffer;
         } else {
-            return _cache[deviceId].at(descriptor);
+            _cacheHits++;
+
+            return cache.at(descriptor);
         }
     }
 
@@ -78,9 +82,11 @@ namespace nd4j {
 
     bool ConstantShapeHelper::checkBufferExistenceForShapeInfo(ShapeDescriptor &descriptor) {
         auto deviceId = AffinityManager::currentDeviceId();
-        std::lock_guard<std::mutex> lock(_mutex);
+        const int shard = shardForDescriptor(descriptor);
+
+        std::lock_guard<std::mutex> lock(_mutex[shard]);
 
-        return _cache[deviceId].count(descriptor) != 0;
+        return _cache[deviceId * _numShards + shard].count(descriptor) != 0;
     }
 
     Nd4jLong* ConstantShapeHelper::createShapeInfo(const nd4j::DataType dataType, const char order, const int rank, const Nd4jLong* shape) {
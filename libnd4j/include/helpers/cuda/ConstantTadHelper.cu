@@ -30,10 +30,7 @@ namespace nd4j {
     ConstantTadHelper::ConstantTadHelper() {
         auto numDevices = AffinityManager::numberOfDevices();
 
-        for (int e = 0; e < numDevices; e++) {
-            std::map<TadDescriptor, TadPack> pack;
-            _cache.emplace_back(pack);
-        }
+        _cache.resize(numDevices * _numShards);
     }
 
     ConstantTadHelper* ConstantTadHelper::getInstance() {
@@ -63,10 +60,12 @@ namespace nd4j {
 
     TadPack ConstantTadHelper::tadForDimensions(TadDescriptor &descriptor) {
         const int deviceId = AffinityManager::currentDeviceId();
+        const int shard = shardForDescriptor(descriptor);
+        auto &cache = _cache[deviceId * _numShards + shard];
 
-        std::lock_guard<std::mutex> lock(_mutex);
+        std::lock_guard<std::mutex> lock(_mutex[shard]);
 
-        if (_cache[deviceId].count(descriptor) == 0) {
+        if (cache.count(descriptor) == 0) {
             const auto shapeInfo = descriptor.originalShape().toShapeInfo();
             const int rank = shape::rank(shapeInfo);
             const std::vector<int> dimsToExclude = ShapeUtils::evalDimsToExclude(rank, descriptor.axis());
@@ -94,17 +93,18 @@ namespace nd4j {
             ConstantDataBuffer offsetsBuffer(oPtr, soPtr, numOfSubArrs * sizeof(Nd4jLong), DataType::INT64);
 
             TadPack t(shapesBuffer, offsetsBuffer, numOfSubArrs);
-            _cache[deviceId][descriptor] = t;
+            cache[descriptor] = t;
 
-            TadPack r = _cache[deviceId][descriptor];
+            _cacheMisses++;
+            _cachedBytes += (shape::shapeInfoLength(subArrRank) + numOfSubArrs) * sizeof(Nd4jLong);
 
             delete[] shapeInfo;
 
-            return r;
+            return t;
         } else {
-            TadPack r = _cache[deviceId][descriptor];
+            _cacheHits++;
 
-            return r;
+            return cache[descriptor];
         }
     }
 
@@ -0,0 +1,154 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Read-only memory mapping of a whole file
+//
+
+#include <helpers/MappedFile.h>
+#include <helpers/logger.h>
+#include <mutex>
+#include <vector>
+#include <stdexcept>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace nd4j {
+
+    // registry of live mappings, [start, end) pairs
+    static std::mutex& mappingsLock() {
+        static std::mutex lock;
+        return lock;
+    }
+
+    static std::vector<std::pair<uintptr_t, uintptr_t>>& mappings() {
+        static std::vector<std::pair<uintptr_t, uintptr_t>> list;
+        return list;
+    }
+
+    MappedFile::MappedFile(const char* fileName) : _fileName(fileName) {
+#if defined(_WIN32) || defined(_WIN64)
+        auto file = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE) {
+            nd4j_printf("File [%s] wasn't found. Please check path and permissions\n", fileName);
+            throw std::runtime_error("File not found");
+        }
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+            CloseHandle(file);
+            throw std::runtime_error("Can't map empty file");
+        }
+
+        auto mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+        CloseHandle(file);
+        if (mapping == NULL)
+            throw std::runtime_error("CreateFileMapping failed");
+
+        auto ptr = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+        if (ptr == NULL) {
+            CloseHandle(mapping);
+            throw std::runtime_error("MapViewOfFile failed");
+        }
+
+        _data = reinterpret_cast<uint8_t*>(ptr);
+        _length = static_cast<Nd4jLong>(size.QuadPart);
+        _handle = reinterpret_cast<intptr_t>(mapping);
+#else
+        int fd = open(fileName, O_RDONLY);
+        if (fd < 0) {
+            nd4j_printf("File [%s] wasn't found. Please check path and permissions\n", fileName);
+            throw std::runtime_error("File not found");
+        }
+
+        struct stat stat_buf;
+        if (fstat(fd, &stat_buf) != 0 || stat_buf.st_size == 0) {
+            close(fd);
+            throw std::runtime_error("Can't map empty file");
+        }
+
+        // private mapping: in-place writes into mapped arrays trigger copy-on-write instead of SIGSEGV or file modification
+        auto ptr = mmap(nullptr, static_cast<size_t>(stat_buf.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+
+        // mapping holds its own reference to the file
+        close(fd);
+
+        if (ptr == MAP_FAILED)
+            throw std::runtime_error("Failed to mmap file");
+
+        _data = reinterpret_cast<uint8_t*>(ptr);
+        _length = static_cast<Nd4jLong>(stat_buf.st_size);
+#endif
+
+        nd4j_debug("Mapped file [%s], length: %lld\n", fileName, (long long) _length);
+
+        std::lock_guard<std::mutex> lock(mappingsLock());
+        auto start = reinterpret_cast<uintptr_t>(_data);
+        mappings().emplace_back(start, start + static_cast<uintptr_t>(_length));
+    }
+
+    MappedFile::~MappedFile() {
+        {
+            std::lock_guard<std::mutex> lock(mappingsLock());
+            auto start = reinterpret_cast<uintptr_t>(_data);
+            auto &list = mappings();
+            for (auto it = list.begin(); it != list.end(); ++it) {
+                if (it->first == start) {
+                    list.erase(it);
+                    break;
+                }
+            }
+        }
+
+#if defined(_WIN32) || defined(_WIN64)
+        UnmapViewOfFile(_data);
+        CloseHandle(reinterpret_cast<HANDLE>(_handle));
+#else
+        munmap(_data, static_cast<size_t>(_length));
+#endif
+    }
+
+    uint8_t* MappedFile::data() const {
+        return _data;
+    }
+
+    Nd4jLong MappedFile::length() const {
+        return _length;
+    }
+
+    const std::string& MappedFile::fileName() const {
+        return _fileName;
+    }
+
+    bool MappedFile::isMapped(const void* pointer, Nd4jLong length) {
+        auto start = reinterpret_cast<uintptr_t>(pointer);
+        auto end = start + static_cast<uintptr_t>(length);
+
+        std::lock_guard<std::mutex> lock(mappingsLock());
+        for (const auto &v: mappings())
+            if (start >= v.first && end <= v.second)
+                return true;
+
+        return false;
+    }
+}
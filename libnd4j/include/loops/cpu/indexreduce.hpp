@@ -23,6 +23,7 @@
 #include <Loops.h>
 #include <types/types.h>
 #include <helpers/ConstantTadHelper.h>
+#include <helpers/ReductionPartials.h>
 #include <execution/Threads.h>
 #include "../legacy_ops.h"
 
@@ -64,10 +65,10 @@ Nd4jLong IndexReduce<X, Y>::execScalar(void *vx, Nd4jLong *xShapeInfo, void *vex
 
     uint xShapeInfoCast[MAX_RANK];
     bool canCastX = nd4j::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
-    int maxThreads = nd4j::math::nd4j_min<int>(64, nd4j::Environment::getInstance()->maxThreads());
-    IndexValue<X> intermediatery[64];
-    for (int e = 0; e < maxThreads; e++)
-        intermediatery[e].index = -1;
+    int maxThreads = nd4j::Environment::getInstance()->maxThreads();
+    auto empty = OpType::startingIndexValue(x);
+    empty.index = -1;
+    nd4j::ReductionPartials<IndexValue<X>> intermediatery(maxThreads, empty);
 
     if (xEws == 1) {
         auto func = PRAGMA_THREADS_FOR {
@@ -26,6 +26,7 @@
 #include <OmpLaunchHelper.h>
 #include <helpers/Loops.h>
 #include <helpers/ConstantTadHelper.h>
+#include <helpers/ReductionPartials.h>
 
 using namespace simdOps;
 
@@ -72,12 +73,8 @@ namespace functions {
                 auto startingValue = OpType::startingValue(x);
                 uint xShapeInfoCast[MAX_RANK];
                 const bool canCastX = nd4j::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
-                int maxThreads = nd4j::math::nd4j_min<int>(64, nd4j::Environment::getInstance()->maxThreads());
-                Z intermediate[64];
-
-                PRAGMA_OMP_SIMD
-                for (auto e = 0; e < maxThreads; e++)
-                    intermediate[e] = OpType::startingValue(x);
+                int maxThreads = nd4j::Environment::getInstance()->maxThreads();
+                nd4j::ReductionPartials<Z> intermediate(maxThreads, OpType::startingValue(x));
 
                 auto func = PRAGMA_THREADS_FOR {
                     for (auto i = start; i < stop; i++)
@@ -242,21 +239,19 @@ namespace functions {
 
             auto x = reinterpret_cast<X *>(vx);
             auto extraParams = reinterpret_cast<Z *>(vextraParams);
-            int maxThreads = nd4j::math::nd4j_min<int>(64, nd4j::Environment::getInstance()->maxThreads());
-            Z intermediate[64];
-
-            PRAGMA_OMP_SIMD
-            for (auto e = 0; e < maxThreads; e++)
-                intermediate[e] = OpType::startingValue(x);
+            int maxThreads = nd4j::Environment::getInstance()->maxThreads();
+            nd4j::ReductionPartials<Z> intermediate(maxThreads, OpType::startingValue(x));
 
             auto func = PRAGMA_THREADS_FOR {
-                if (xEws == 1) {
-                    for (auto i = start; i < stop; i++)
-                        intermediate[thread_id] = OpType::update(intermediate[thread_id], OpType::op(x[i], extraParams), extraParams);
-                } else {
-                    for (auto i = start; i < stop; i++)
-                        intermediate[thread_id] = OpType::update(intermediate[thread_id], OpType::op(x[i * xEws], extraParams), extraParams);
-                }
+                auto merge = [&](Z a, Z b) -> Z { return OpType::update(a, b, extraParams); };
+
+                Z partial;
+                if (xEws == 1)
+                    partial = nd4j::blockedReduce<Z>(start, stop, OpType::startingValue(x), [&](Nd4jLong i) -> Z { return OpType::op(x[i], extraParams); }, merge);
+                else
+                    partial = nd4j::blockedReduce<Z>(start, stop, OpType::startingValue(x), [&](Nd4jLong i) -> Z { return OpType::op(x[i * xEws], extraParams); }, merge);
+
+                intermediate[thread_id] = OpType::update(intermediate[thread_id], partial, extraParams);
             };
 
             maxThreads = samediff::Threads::parallel_for(func, 0, length, 1, maxThreads);
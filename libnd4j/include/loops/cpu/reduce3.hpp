@@ -23,6 +23,7 @@
 #include <loops/reduce3.h>
 #include <loops/legacy_ops.h>
 #include <helpers/ConstantTadHelper.h>
+#include <helpers/ReductionPartials.h>
 #include <Loops.h>
 #include <execution/Threads.h>
 
@@ -65,22 +66,16 @@ void Reduce3<X,Z>::execScalar(void *vx, Nd4jLong *xShapeInfo,
     const bool canCastX = nd4j::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
 
     Z startingVal = OpType::startingValue(x);
-    int maxThreads = nd4j::math::nd4j_min<int>(64, nd4j::Environment::getInstance()->maxThreads());
-    Z intermediate[64];
-    Z extraParamsLocal[3 * 64];
+    int maxThreads = nd4j::Environment::getInstance()->maxThreads();
+    nd4j::ReductionPartials<Z> intermediate(maxThreads, startingVal);
+    nd4j::ReductionPartials<Z> extraParamsLocal(maxThreads, static_cast<Z>(0.f), 3);
 
-    PRAGMA_OMP_SIMD
-    for (int e = 0; e < maxThreads; e++)
-        intermediate[e] = startingVal;
-
-    memset(extraParamsLocal, 0, 3 * 64 * sizeof(Z));
     if (extraParams != nullptr) {
-        PRAGMA_OMP_SIMD
         // mostly for future reference
         for (int e = 0; e < maxThreads; e++) {
-            extraParamsLocal[3 * e] = extraParams[0];
-            extraParamsLocal[3 * e + 1] = extraParams[1];
-            extraParamsLocal[3 * e + 2] = extraParams[2];
+            extraParamsLocal.row(e)[0] = extraParams[0];
+            extraParamsLocal.row(e)[1] = extraParams[1];
+            extraParamsLocal.row(e)[2] = extraParams[2];
         }
     }
 
@@ -89,7 +84,7 @@ void Reduce3<X,Z>::execScalar(void *vx, Nd4jLong *xShapeInfo,
     if (kindOfLoop == nd4j::LoopKind::EWS1) {
         auto func = PRAGMA_THREADS_FOR {
             for (auto i = start; i < stop; i++) {
-                intermediate[thread_id] = OpType::update(intermediate[thread_id], OpType::op(x[i], y[i], extraParamsLocal + 3 * thread_id), extraParamsLocal + 3 * thread_id);
+                intermediate[thread_id] = OpType::update(intermediate[thread_id], OpType::op(x[i], y[i], extraParamsLocal.row(thread_id)), extraParamsLocal.row(thread_id));
             }
         };
 
@@ -100,7 +95,7 @@ void Reduce3<X,Z>::execScalar(void *vx, Nd4jLong *xShapeInfo,
         auto func = PRAGMA_THREADS_FOR {
             for (auto i = start; i < stop; i++) {
                 auto offset = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
-                intermediate[thread_id] = OpType::update(intermediate[thread_id], OpType::op(x[offset], y[offset], extraParamsLocal + 3 * thread_id), extraParamsLocal + 3 * thread_id);
+                intermediate[thread_id] = OpType::update(intermediate[thread_id], OpType::op(x[offset], y[offset], extraParamsLocal.row(thread_id)), extraParamsLocal.row(thread_id));
             }
         };
 
@@ -113,7 +108,7 @@ void Reduce3<X,Z>::execScalar(void *vx, Nd4jLong *xShapeInfo,
             for (auto i = start; i < stop; i++) {
                 auto xOffset = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
                 auto yOffset = shape::indexOffset(i, yShapeInfo, yShapeInfoCast, canCastY);
-                intermediate[thread_id] = OpType::update(intermediate[thread_id], OpType::op(x[xOffset], y[yOffset], extraParamsLocal + 3 * thread_id), extraParamsLocal + 3 * thread_id);
+                intermediate[thread_id] = OpType::update(intermediate[thread_id], OpType::op(x[xOffset], y[yOffset], extraParamsLocal.row(thread_id)), extraParamsLocal.row(thread_id));
             }
         };
 
@@ -122,7 +117,7 @@ void Reduce3<X,Z>::execScalar(void *vx, Nd4jLong *xShapeInfo,
 
     // merge step
     for (int e = 0; e < maxThreads; e++)
-        OpType::aggregateExtraParams(extraParamsVals, extraParamsLocal + 3 * e);
+        OpType::aggregateExtraParams(extraParamsVals, extraParamsLocal.row(e));
 
     for (int e = 0; e < maxThreads; e++)
         startingVal = OpType::update(startingVal, intermediate[e], extraParamsVals);
@@ -33,14 +33,26 @@
 #include <memory/ExternalWorkspace.h>
 #include <memory/MemoryType.h>
 
+// default alignment of workspace allocations, enough for AVX-512 loads
+#define WORKSPACE_ALIGNMENT 64
+
 namespace nd4j {
     namespace memory {
 
+        /**
+         * Arena for temporary buffers, reset in cycles: scopeIn() starts new cycle, scopeOut() releases everything at once.
+         *
+         * Allocations are served by lock-free bump of the offset, every allocation starts at offset aligned to getAlignment().
+         * Allocations not fitting into the arena are spilled to the system allocator, and spills of the previous cycle are
+         * recycled by size classes (powers of 2), while the arena itself grows to what the previous cycle has used.
+         */
         class ND4J_EXPORT Workspace {
         protected:
             char* _ptrHost = nullptr;
             char* _ptrDevice = nullptr;
 
+            Nd4jLong _alignment = WORKSPACE_ALIGNMENT;
+
             bool _allocatedHost = false;
             bool _allocatedDevice = false;
 
@@ -61,14 +73,25 @@ namespace nd4j {
             std::vector<void*> _spills;
             std::vector<void*> _spillsSecondary;
 
+            // size classes of _spills, and spills of previous cycle available for reuse, indexed by size class
+            std::vector<int> _spillsClasses;
+            std::vector<std::vector<void*>> _spillsPool;
+
             std::atomic<Nd4jLong> _spillsSize;
             std::atomic<Nd4jLong> _cycleAllocations;
 
             std::atomic<Nd4jLong> _spillsSizeSecondary;
             std::atomic<Nd4jLong> _cycleAllocationsSecondary;
 
+            // usage counters, accumulated since construction or resetStats()
+            std::atomic<Nd4jLong> _peakUsage{0};
+            std::atomic<Nd4jLong> _numberOfAllocations{0};
+            std::atomic<Nd4jLong> _numberOfSpills{0};
+            std::atomic<Nd4jLong> _numberOfRecycledSpills{0};
+
             void init(Nd4jLong primaryBytes, Nd4jLong secondaryBytes = 0L);
             void freeSpills();
+            void recycleSpills();
         public:
             explicit Workspace(ExternalWorkspace *external);
             Workspace(Nd4jLong initialSize = 0L, Nd4jLong secondaryBytes = 0L);
@@ -86,6 +109,29 @@ namespace nd4j {
             Nd4jLong getSpilledSecondarySize();
             Nd4jLong getUsedSecondarySize();
 
+            /**
+             * Alignment of allocations, power of 2 up to 4096. Applies to offsets within the arena and to spills
+             */
+            Nd4jLong getAlignment();
+            void setAlignment(Nd4jLong alignment);
+
+            /**
+             * High-water mark of memory used within single cycle, arena and spills together (host and device together on CUDA).
+             * This is the size workspace should be created with to avoid spills
+             */
+            Nd4jLong getPeakUsage();
+
+            Nd4jLong getNumberOfAllocations();
+            Nd4jLong getNumberOfSpills();
+
+            /**
+             * Number of spills served from memory of spills released by previous cycle.
+             * PLEASE NOTE: CUDA workspaces release spills on every scopeIn(), so this counter stays 0 there
+             */
+            Nd4jLong getNumberOfRecycledSpills();
+
+            void resetStats();
+
             void expandBy(Nd4jLong primaryBytes, Nd4jLong secondaryBytes = 0L);
             void expandTo(Nd4jLong primaryBytes, Nd4jLong secondaryBytes = 0L);
 
@@ -0,0 +1,73 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Per-thread sub-arena of Workspace for temporaries of parallel ops
+//
+
+#ifndef LIBND4J_WORKSPACEARENA_H
+#define LIBND4J_WORKSPACEARENA_H
+
+#include <dll.h>
+#include <pointercast.h>
+#include <memory/Workspace.h>
+#include <vector>
+
+namespace nd4j {
+    namespace memory {
+
+        /**
+         * Sub-arena owned by single thread: blocks are taken from the parent Workspace by single allocateBytes call each,
+         * and split between allocations of the owning thread without any synchronization.
+         * Parallel ops allocating temporaries within parallel regions create one arena per thread.
+         *
+         * Memory belongs to the parent workspace and is released with its cycle. If there's no parent workspace,
+         * arena allocates blocks on heap and releases them in destructor.
+         *
+         * PLEASE NOTE: this class isn't thread-safe by design
+         */
+        class ND4J_EXPORT WorkspaceArena {
+        private:
+            Workspace *_workspace;
+            Nd4jLong _blockSize;
+            Nd4jLong _alignment;
+
+            char *_block = nullptr;
+            Nd4jLong _blockOffset = 0;
+            Nd4jLong _blockLength = 0;
+
+            // blocks allocated on heap, if there's no workspace
+            std::vector<char*> _owned;
+
+            char* takeBlock(Nd4jLong numBytes);
+        public:
+            explicit WorkspaceArena(Workspace *workspace, Nd4jLong blockSize = 1048576L);
+            ~WorkspaceArena();
+
+            WorkspaceArena(const WorkspaceArena& other) = delete;
+            WorkspaceArena& operator=(const WorkspaceArena& other) = delete;
+
+            /**
+             * This method returns memory aligned the same way as parent workspace allocations are
+             */
+            void* allocateBytes(Nd4jLong numBytes);
+
+            Nd4jLong blockSize() const;
+        };
+    }
+}
+
+#endif //LIBND4J_WORKSPACEARENA_H
@@ -29,10 +29,60 @@
 #include <helpers/logger.h>
 #include <templatemath.h>
 #include <cstring>
+#include <execution/NumaTopology.h>
+#include <graph/profiling/TraceRecorder.h>
+#include <algorithm>
+#include <stdexcept>
+#include <mutex>
 
 
 namespace nd4j {
     namespace memory {
+        // arena itself is aligned to page boundary, so aligned offsets are aligned addresses for any supported alignment
+        static const Nd4jLong MAX_ALIGNMENT = 4096;
+
+        // spills are rounded up to size classes: 4 classes per power of 2, starting at 256 bytes, so at most 25% is wasted
+        static int sizeClass(Nd4jLong numBytes, Nd4jLong &classBytes) {
+            int index = 0;
+            for (int power = 8; power < 62; power++) {
+                for (int q = 0; q < 4; q++, index++) {
+                    classBytes = (1LL << power) + q * (1LL << (power - 2));
+                    if (classBytes >= numBytes)
+                        return index;
+                }
+            }
+
+            classBytes = numBytes;
+            return index;
+        }
+
+        static void* alignedMalloc(Nd4jLong numBytes, Nd4jLong alignment) {
+            alignment = nd4j::math::nd4j_max<Nd4jLong>(alignment, sizeof(void*));
+#ifdef _WIN32
+            return _aligned_malloc(numBytes, alignment);
+#else
+            void *ptr = nullptr;
+            return posix_memalign(&ptr, alignment, numBytes) == 0 ? ptr : nullptr;
+#endif
+        }
+
+        static void alignedFree(void *ptr) {
+#ifdef _WIN32
+            _aligned_free(ptr);
+#else
+            free(ptr);
+#endif
+        }
+
+        static FORCEINLINE Nd4jLong alignUp(Nd4jLong value, Nd4jLong alignment) {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        static FORCEINLINE void updateMax(std::atomic<Nd4jLong> &target, Nd4jLong value) {
+            auto current = target.load();
+            while (current < value && !target.compare_exchange_weak(current, value));
+        }
+
         Workspace::Workspace(ExternalWorkspace *external) {
             if (external->sizeHost() > 0) {
                 _ptrHost = (char *) external->pointerHost();
@@ -51,11 +101,12 @@ namespace nd4j {
 
         Workspace::Workspace(Nd4jLong initialSize, Nd4jLong secondaryBytes) {
             if (initialSize > 0) {
-                this->_ptrHost = (char *) malloc(initialSize);
+                this->_ptrHost = (char *) alignedMalloc(initialSize, MAX_ALIGNMENT);
 
                 CHECK_ALLOC(this->_ptrHost, "Failed to allocate new workspace", initialSize);
 
-                memset(this->_ptrHost, 0, initialSize);
+                // spreading pages over NUMA nodes, if there are any
+                samediff::NumaTopology::firstTouch(this->_ptrHost, initialSize);
                 this->_allocatedHost = true;
             } else
                 this->_allocatedHost = false;
@@ -73,13 +124,13 @@ namespace nd4j {
         void Workspace::init(Nd4jLong bytes, Nd4jLong secondaryBytes) {
             if (this->_currentSize < bytes) {
                 if (this->_allocatedHost && !_externalized)
-                    free((void *)this->_ptrHost);
+                    alignedFree((void *)this->_ptrHost);
 
-                this->_ptrHost =(char *) malloc(bytes);
+                this->_ptrHost =(char *) alignedMalloc(bytes, MAX_ALIGNMENT);
 
                 CHECK_ALLOC(this->_ptrHost, "Failed to allocate new workspace", bytes);
 
-                memset(this->_ptrHost, 0, bytes);
+                samediff::NumaTopology::firstTouch(this->_ptrHost, bytes);
                 this->_currentSize = bytes;
                 this->_allocatedHost = true;
             }
@@ -94,20 +145,48 @@ namespace nd4j {
         }
 
         void Workspace::freeSpills() {
+            std::lock_guard<std::mutex> lock(_mutexSpills);
             _spillsSize = 0;
 
-            if (_spills.size() < 1)
-                return;
-
             for (auto v:_spills)
-                free(v);
+                alignedFree(v);
+
+            for (auto &cls:_spillsPool)
+                for (auto v:cls)
+                    alignedFree(v);
 
             _spills.clear();
+            _spillsClasses.clear();
+            _spillsPool.clear();
+        }
+
+        void Workspace::recycleSpills() {
+            std::lock_guard<std::mutex> lock(_mutexSpills);
+            _spillsSize = 0;
+
+            // whatever wasn't reused within this cycle isn't needed anymore
+            for (auto &cls:_spillsPool) {
+                for (auto v:cls)
+                    alignedFree(v);
+
+                cls.clear();
+            }
+
+            for (size_t e = 0; e < _spills.size(); e++) {
+                auto cls = _spillsClasses[e];
+                if (cls >= (int) _spillsPool.size())
+                    _spillsPool.resize(cls + 1);
+
+                _spillsPool[cls].emplace_back(_spills[e]);
+            }
+
+            _spills.clear();
+            _spillsClasses.clear();
         }
 
         Workspace::~Workspace() {
             if (this->_allocatedHost && !_externalized)
-                free((void *)this->_ptrHost);
+                alignedFree((void *)this->_ptrHost);
 
             freeSpills();
         }
@@ -124,43 +203,111 @@ namespace nd4j {
             return _offset.load();
         }
 
+        Nd4jLong Workspace::getAlignment() {
+            return _alignment;
+        }
+
+        void Workspace::setAlignment(Nd4jLong alignment) {
+            if (alignment < 1 || alignment > MAX_ALIGNMENT || (alignment & (alignment - 1)) != 0)
+                throw std::runtime_error("Workspace alignment should be power of 2, up to 4096 bytes");
+
+            // pooled spills might be aligned for smaller value
+            std::lock_guard<std::mutex> lock(_mutexSpills);
+            for (auto &cls:_spillsPool) {
+                for (auto v:cls)
+                    alignedFree(v);
+
+                cls.clear();
+            }
+
+            _alignment = alignment;
+        }
+
+        Nd4jLong Workspace::getPeakUsage() {
+            return _peakUsage.load();
+        }
+
+        Nd4jLong Workspace::getNumberOfAllocations() {
+            return _numberOfAllocations.load();
+        }
+
+        Nd4jLong Workspace::getNumberOfSpills() {
+            return _numberOfSpills.load();
+        }
+
+        Nd4jLong Workspace::getNumberOfRecycledSpills() {
+            return _numberOfRecycledSpills.load();
+        }
+
+        void Workspace::resetStats() {
+            _peakUsage = 0;
+            _numberOfAllocations = 0;
+            _numberOfSpills = 0;
+            _numberOfRecycledSpills = 0;
+        }
 
         void* Workspace::allocateBytes(Nd4jLong numBytes) {
             if (numBytes < 1)
                 throw allocation_exception::build("Number of bytes for allocation should be positive", numBytes);
 
+            const auto alignment = _alignment;
 
-            //numBytes += 32;
-            void* result = nullptr;
-            this->_cycleAllocations += numBytes;
-            this->_mutexAllocation.lock();
+            // next cycle has to fit this allocation together with padding
+            this->_cycleAllocations += alignUp(numBytes, alignment);
+            this->_numberOfAllocations++;
 
-            if (_offset.load() + numBytes > _currentSize) {
-                nd4j_debug("Allocating %lld bytes in spills\n", numBytes);
-                this->_mutexAllocation.unlock();
+            // bump pointer: offset is advanced by CAS, so concurrent allocations never get overlapping regions
+            auto current = _offset.load();
+            while (true) {
+                auto start = alignUp(current, alignment);
+                auto end = start + numBytes;
 
-                void *p = malloc(numBytes);
+                if (end > _currentSize)
+                    break;
 
-                CHECK_ALLOC(p, "Failed to allocate new workspace", numBytes);
+                if (_offset.compare_exchange_weak(current, end)) {
+                    updateMax(_peakUsage, end + _spillsSize.load());
 
-                _mutexSpills.lock();
-                _spills.push_back(p);
-                _mutexSpills.unlock();
+                    nd4j_debug("Allocating %lld bytes from workspace; Current PTR: %p; Current offset: %lld\n", numBytes, _ptrHost + start, end);
+                    return (void *)(_ptrHost + start);
+                }
+            }
 
-                _spillsSize += numBytes;
+            nd4j_debug("Allocating %lld bytes in spills\n", numBytes);
 
-                return p;
+            Nd4jLong classBytes = 0;
+            auto cls = sizeClass(numBytes, classBytes);
+            void *p = nullptr;
+
+            {
+                std::lock_guard<std::mutex> lock(_mutexSpills);
+                if (cls < (int) _spillsPool.size() && !_spillsPool[cls].empty()) {
+                    p = _spillsPool[cls].back();
+                    _spillsPool[cls].pop_back();
+                    _numberOfRecycledSpills++;
+                }
             }
 
-            result = (void *)(_ptrHost + _offset.load());
-            _offset += numBytes;
-            //memset(result, 0, (int) numBytes);
+            if (p == nullptr) {
+                p = alignedMalloc(classBytes, alignment);
+                CHECK_ALLOC(p, "Failed to allocate new workspace", classBytes);
+            }
 
-            nd4j_debug("Allocating %lld bytes from workspace; Current PTR: %p; Current offset: %lld\n", numBytes, result, _offset.load());
+            {
+                std::lock_guard<std::mutex> lock(_mutexSpills);
+                _spills.push_back(p);
+                _spillsClasses.push_back(cls);
+            }
 
-            this->_mutexAllocation.unlock();
+            _spillsSize += numBytes;
+            _numberOfSpills++;
+            updateMax(_peakUsage, _offset.load() + _spillsSize.load());
 
-            return result;
+            auto tracer = nd4j::graph::TraceRecorder::getInstance();
+            if (tracer->isActive())
+                tracer->instant("workspace_spill", "memory", "bytes", numBytes);
+
+            return p;
         }
 
         Nd4jLong Workspace::getAllocatedSize() {
@@ -168,7 +315,7 @@ namespace nd4j {
         }
 
         void Workspace::scopeIn() {
-            freeSpills();
+            recycleSpills();
             init(_cycleAllocations.load());
             _cycleAllocations = 0;
         }
@@ -211,8 +358,9 @@ namespace nd4j {
 
         Workspace* Workspace::clone() {
             // for clone we take whatever is higher: current allocated size, or allocated size of current loop
-            return new Workspace(nd4j::math::nd4j_max<Nd4jLong >(this->getCurrentSize(), this->_cycleAllocations.load()));
+            auto result = new Workspace(nd4j::math::nd4j_max<Nd4jLong >(this->getCurrentSize(), this->_cycleAllocations.load()));
+            result->_alignment = _alignment;
+            return result;
         }
     }
 }
-
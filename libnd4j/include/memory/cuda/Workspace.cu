@@ -83,6 +83,7 @@ namespace nd4j {
             this->_offset = 0;
             this->_offsetSecondary = 0;
             this->_cycleAllocations = 0;
+            this->_cycleAllocationsSecondary = 0;
             this->_spillsSize = 0;
             this->_spillsSizeSecondary = 0;
         }
@@ -92,7 +93,7 @@ namespace nd4j {
                 if (this->_allocatedDevice && !_externalized)
                     cudaFree((void *)this->_ptrDevice);
 
-                auto res = cudaMalloc(reinterpret_cast<void **>(&_ptrDevice), secondaryBytes);
+                auto res = cudaMalloc(reinterpret_cast<void **>(&_ptrDevice), primaryBytes);
                 if (res != 0)
                     throw cuda_exception::build("Can't allocate [DEVICE] memory", res);
 
@@ -183,94 +184,87 @@ namespace nd4j {
             return _spillsSize.load();
         }
 
-        void* Workspace::allocateBytes(nd4j::memory::MemoryType type, Nd4jLong numBytes) {
-            switch (type) {
-                case HOST: {
-                        if (numBytes < 1)
-                            throw allocation_exception::build("Number of [HOST] bytes for allocation should be positive", numBytes);
-
+        // cudaMalloc and cudaHostAlloc guarantee at least this alignment of returned pointers
+        static const Nd4jLong CUDA_ALIGNMENT = 256;
 
-                        //numBytes += 32;
-                        void* result = nullptr;
-                        this->_cycleAllocationsSecondary += numBytes;
-                        this->_mutexAllocation.lock();
-
-                        if (_offsetSecondary.load() + numBytes > _currentSizeSecondary) {
-                            nd4j_debug("Allocating %lld [HOST] bytes in spills\n", numBytes);
-                            this->_mutexAllocation.unlock();
+        static FORCEINLINE Nd4jLong alignUp(Nd4jLong value, Nd4jLong alignment) {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
 
-                            Nd4jPointer p;
-                            auto res = cudaHostAlloc(reinterpret_cast<void **>(&p), numBytes, cudaHostAllocDefault);
-                            if (res != 0)
-                                throw cuda_exception::build("Can't allocate [HOST] memory", res);
+        static FORCEINLINE void updateMax(std::atomic<Nd4jLong> &target, Nd4jLong value) {
+            auto current = target.load();
+            while (current < value && !target.compare_exchange_weak(current, value));
+        }
 
-                            _mutexSpills.lock();
-                            _spillsSecondary.push_back(p);
-                            _mutexSpills.unlock();
+        // offset within arena, such that base + offset is aligned address
+        static FORCEINLINE Nd4jLong alignedOffset(char *base, Nd4jLong offset, Nd4jLong alignment) {
+            auto address = reinterpret_cast<Nd4jLong>(base) + offset;
+            return offset + (alignUp(address, alignment) - address);
+        }
 
-                            _spillsSizeSecondary += numBytes;
+        void* Workspace::allocateBytes(nd4j::memory::MemoryType type, Nd4jLong numBytes) {
+            if (type != HOST && type != DEVICE)
+                throw std::runtime_error("Unknown MemoryType was passed in");
 
-                            return p;
-                        }
+            if (numBytes < 1)
+                throw allocation_exception::build(type == HOST ? "Number of [HOST] bytes for allocation should be positive" : "Number of [DEVICE] bytes for allocation should be positive", numBytes);
 
-                        result = (void *)(_ptrHost + _offsetSecondary.load());
-                        _offsetSecondary += numBytes;
-                        //memset(result, 0, (int) numBytes);
+            const auto alignment = _alignment;
+            const bool host = type == HOST;
 
-                        nd4j_debug("Allocating %lld bytes from [HOST] workspace; Current PTR: %p; Current offset: %lld\n", numBytes, result, _offset.load());
+            auto base = host ? _ptrHost : _ptrDevice;
+            auto &offset = host ? _offsetSecondary : _offset;
+            auto &spillsSize = host ? _spillsSizeSecondary : _spillsSize;
+            auto &spills = host ? _spillsSecondary : _spills;
+            auto currentSize = host ? _currentSizeSecondary : _currentSize;
 
-                        this->_mutexAllocation.unlock();
+            // next cycle has to fit this allocation together with padding
+            (host ? _cycleAllocationsSecondary : _cycleAllocations) += alignUp(numBytes, alignment);
+            _numberOfAllocations++;
 
-                        return result;
-                    }
-                    break;
-                case DEVICE: {
-                        if (numBytes < 1)
-                            throw allocation_exception::build("Number of [DEVICE] bytes for allocation should be positive", numBytes);
+            this->_mutexAllocation.lock();
 
+            auto start = alignedOffset(base, offset.load(), alignment);
+            if (base != nullptr && start + numBytes <= currentSize) {
+                void* result = (void *)(base + start);
+                offset = start + numBytes;
 
-                        //numBytes += 32;
-                        void* result = nullptr;
-                        this->_cycleAllocations += numBytes;
-                        this->_mutexAllocation.lock();
+                nd4j_debug("Allocating %lld bytes from [%s] workspace; Current PTR: %p; Current offset: %lld\n", numBytes, host ? "HOST" : "DEVICE", result, offset.load());
 
-                        if (_offset.load() + numBytes > _currentSize) {
-                            nd4j_debug("Allocating %lld [DEVICE] bytes in spills\n", numBytes);
-                            this->_mutexAllocation.unlock();
+                this->_mutexAllocation.unlock();
 
-                            Nd4jPointer p;
-                            auto res = cudaMalloc(reinterpret_cast<void **>(&p), numBytes);
-                            if (res != 0)
-                                throw cuda_exception::build("Can't allocate [DEVICE] memory", res);
+                updateMax(_peakUsage, _offset.load() + _spillsSize.load() + _offsetSecondary.load() + _spillsSizeSecondary.load());
+                return result;
+            }
 
-                            _mutexSpills.lock();
-                            _spills.push_back(p);
-                            _mutexSpills.unlock();
+            this->_mutexAllocation.unlock();
 
-                            _spillsSize += numBytes;
+            nd4j_debug("Allocating %lld [%s] bytes in spills\n", numBytes, host ? "HOST" : "DEVICE");
 
-                            return p;
-                        }
+            // CUDA allocations are aligned to 256 bytes at least, stricter alignment requires padding
+            auto padding = alignment > CUDA_ALIGNMENT ? alignment : 0;
 
-                        result = (void *)(_ptrDevice + _offset.load());
-                        _offset += numBytes;
-                        //memset(result, 0, (int) numBytes);
+            Nd4jPointer p;
+            auto res = host ? cudaHostAlloc(reinterpret_cast<void **>(&p), numBytes + padding, cudaHostAllocDefault) : cudaMalloc(reinterpret_cast<void **>(&p), numBytes + padding);
+            if (res != 0)
+                throw cuda_exception::build(host ? "Can't allocate [HOST] memory" : "Can't allocate [DEVICE] memory", res);
 
-                        nd4j_debug("Allocating %lld bytes from [DEVICE] workspace; Current PTR: %p; Current offset: %lld\n", numBytes, result, _offset.load());
+            _mutexSpills.lock();
+            spills.push_back(p);
+            _mutexSpills.unlock();
 
-                        this->_mutexAllocation.unlock();
+            spillsSize += numBytes;
+            _numberOfSpills++;
+            updateMax(_peakUsage, _offset.load() + _spillsSize.load() + _offsetSecondary.load() + _spillsSizeSecondary.load());
 
-                        return result;
-                    }
-                    break;
-                default:
-                    throw std::runtime_error("Unknown MemoryType was passed in");
-            }
+            return reinterpret_cast<char*>(p) + alignedOffset(reinterpret_cast<char*>(p), 0, alignment);
         }
 
         Workspace* Workspace::clone() {
             // for clone we take whatever is higher: current allocated size, or allocated size of current loop
-            return new Workspace(nd4j::math::nd4j_max<Nd4jLong >(this->getCurrentSize(), this->_cycleAllocations.load()));
+            auto result = new Workspace(nd4j::math::nd4j_max<Nd4jLong >(this->getCurrentSize(), this->_cycleAllocations.load()));
+            result->_alignment = _alignment;
+            return result;
         }
 
         Nd4jLong Workspace::getAllocatedSecondarySize() {
@@ -293,5 +287,43 @@ namespace nd4j {
             return getCurrentSecondaryOffset();
         }
 
+        Nd4jLong Workspace::getAlignment() {
+            return _alignment;
+        }
+
+        void Workspace::setAlignment(Nd4jLong alignment) {
+            if (alignment < 1 || alignment > 4096 || (alignment & (alignment - 1)) != 0)
+                throw std::runtime_error("Workspace alignment should be power of 2, up to 4096 bytes");
+
+            _alignment = alignment;
+        }
+
+        Nd4jLong Workspace::getPeakUsage() {
+            return _peakUsage.load();
+        }
+
+        Nd4jLong Workspace::getNumberOfAllocations() {
+            return _numberOfAllocations.load();
+        }
+
+        Nd4jLong Workspace::getNumberOfSpills() {
+            return _numberOfSpills.load();
+        }
+
+        Nd4jLong Workspace::getNumberOfRecycledSpills() {
+            return _numberOfRecycledSpills.load();
+        }
+
+        void Workspace::resetStats() {
+            _peakUsage = 0;
+            _numberOfAllocations = 0;
+            _numberOfSpills = 0;
+            _numberOfRecycledSpills = 0;
+        }
+
+        void Workspace::recycleSpills() {
+            freeSpills();
+        }
+
     }
 }
@@ -0,0 +1,75 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// WorkspaceArena implementation
+//
+
+#include <memory/WorkspaceArena.h>
+#include <op_boilerplate.h>
+#include <exceptions/allocation_exception.h>
+
+namespace nd4j {
+    namespace memory {
+        WorkspaceArena::WorkspaceArena(Workspace *workspace, Nd4jLong blockSize) {
+            _workspace = workspace;
+            _blockSize = blockSize;
+            _alignment = workspace != nullptr ? workspace->getAlignment() : WORKSPACE_ALIGNMENT;
+        }
+
+        WorkspaceArena::~WorkspaceArena() {
+            for (auto b:_owned)
+                delete[] b;
+        }
+
+        char* WorkspaceArena::takeBlock(Nd4jLong numBytes) {
+            if (_workspace != nullptr)
+                return reinterpret_cast<char*>(_workspace->allocateBytes(numBytes));
+
+            // heap blocks get extra room, so the first allocation can be aligned
+            auto block = new char[numBytes + _alignment];
+            _owned.emplace_back(block);
+
+            auto address = reinterpret_cast<Nd4jLong>(block);
+            return block + ((_alignment - address % _alignment) % _alignment);
+        }
+
+        void* WorkspaceArena::allocateBytes(Nd4jLong numBytes) {
+            if (numBytes < 1)
+                throw allocation_exception::build("Number of bytes for allocation should be positive", numBytes);
+
+            auto start = (_blockOffset + _alignment - 1) / _alignment * _alignment;
+            if (_block != nullptr && start + numBytes <= _blockLength) {
+                _blockOffset = start + numBytes;
+                return _block + start;
+            }
+
+            // big allocations go to parent directly, and current block stays available for smaller ones
+            if (numBytes > _blockSize / 2)
+                return takeBlock(numBytes);
+
+            _block = takeBlock(_blockSize);
+            _blockLength = _blockSize;
+            _blockOffset = numBytes;
+
+            return _block;
+        }
+
+        Nd4jLong WorkspaceArena::blockSize() const {
+            return _blockSize;
+        }
+    }
+}
@@ -109,8 +109,9 @@ namespace nd4j {
 
             /**
             *   This method pre-allocates NDArrays for Op output, in case they are not available at op execution time
+            *   @param signature - signature of input shapes, used by OpStatistics if it's enabled
             */
-            int prepareOutputs(Context& block);
+            int prepareOutputs(Context& block, Nd4jLong signature = 0);
 
             virtual samediff::EmptyHandling emptyHandling();
         public:
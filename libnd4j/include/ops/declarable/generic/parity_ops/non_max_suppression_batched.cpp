@@ -0,0 +1,87 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Batched multi-class non max suppression
+//
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/image_suppression.h>
+
+#if NOT_EXCLUDED(OP_image_non_max_suppression_batched)
+
+namespace nd4j {
+    namespace ops {
+        CUSTOM_OP_IMPL(non_max_suppression_batched, 2, 1, false, 0, 0) {
+            auto boxes = INPUT_VARIABLE(0);
+            auto scores = INPUT_VARIABLE(1);
+            auto output = OUTPUT_VARIABLE(0);
+
+            int maxOutputSize;
+            if (block.width() > 2)
+                maxOutputSize = INPUT_VARIABLE(2)->e<int>(0);
+            else if (block.getIArguments()->size() == 1)
+                maxOutputSize = INT_ARG(0);
+            else
+                REQUIRE_TRUE(false, 0, "image.non_max_suppression_batched: Max output size argument cannot be retrieved.");
+
+            REQUIRE_TRUE(boxes->rankOf() == 3 && boxes->sizeAt(2) == 4, 0, "image.non_max_suppression_batched: boxes should have [batch, boxes, 4] shape, but %s is given", ShapeUtils::shapeAsString(boxes).c_str());
+            REQUIRE_TRUE(scores->rankOf() == 3 && scores->sizeAt(0) == boxes->sizeAt(0) && scores->sizeAt(1) == boxes->sizeAt(1), 0, "image.non_max_suppression_batched: scores should have [batch, boxes, classes] shape, but %s is given", ShapeUtils::shapeAsString(scores).c_str());
+            REQUIRE_TRUE(boxes->dataType() == scores->dataType(), 0, "image.non_max_suppression_batched: boxes and scores should have the same data type");
+
+            double overlapThreshold = 0.5;
+            double scoreThreshold = -DataTypeUtils::infOrMax<double>();
+            if (block.getTArguments()->size() > 0)
+                overlapThreshold = T_ARG(0);
+            if (block.getTArguments()->size() > 1)
+                scoreThreshold = T_ARG(1);
+
+            helpers::nonMaxSuppressionBatched(block.launchContext(), boxes, scores, maxOutputSize, overlapThreshold, scoreThreshold, output);
+            return Status::OK();
+        }
+
+        DECLARE_SHAPE_FN(non_max_suppression_batched) {
+            auto boxes = inputShape->at(0);
+            auto scores = inputShape->at(1);
+
+            int maxOutputSize;
+            if (block.width() > 2)
+                maxOutputSize = INPUT_VARIABLE(2)->e<int>(0);
+            else if (block.getIArguments()->size() == 1)
+                maxOutputSize = INT_ARG(0);
+            else
+                REQUIRE_TRUE(false, 0, "image.non_max_suppression_batched: Max output size argument cannot be retrieved.");
+
+            REQUIRE_TRUE(maxOutputSize >= 0, 0, "image.non_max_suppression_batched: Max output size should be non-negative, but %i is given", maxOutputSize);
+            REQUIRE_TRUE(shape::rank(boxes) == 3 && shape::rank(scores) == 3, 0, "image.non_max_suppression_batched: boxes and scores should be 3D tensors");
+
+            auto outputShape = ConstantShapeHelper::getInstance()->createShapeInfo(DataType::INT32, 'c', {shape::sizeAt(boxes, 0), shape::sizeAt(scores, 2), (Nd4jLong) maxOutputSize});
+
+            return SHAPELIST(outputShape);
+        }
+
+        DECLARE_TYPES(non_max_suppression_batched) {
+            getOpDescriptor()
+                    ->setAllowedInputTypes(0, {ALL_FLOATS})
+                    ->setAllowedInputTypes(1, {ALL_FLOATS})
+                    ->setAllowedInputTypes(2, {ALL_INTS})
+                    ->setAllowedOutputTypes({ALL_INDICES});
+        }
+
+    }
+}
+#endif
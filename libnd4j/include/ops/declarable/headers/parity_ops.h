@@ -1859,6 +1859,8 @@ namespace nd4j {
          * output:
          *     - vector with size M, where M <= output_size by int type
          *
+         * PLEASE NOTE: boxes with equal scores are selected in order of their indices, lower index first
+         *
          * */
         #if NOT_EXCLUDED(OP_image_non_max_suppression)
         DECLARE_CUSTOM_OP(non_max_suppression, 2, 1, false, 0, 0);
@@ -1886,6 +1888,26 @@ namespace nd4j {
         DECLARE_CUSTOM_OP(non_max_suppression_overlaps, 2, 1, false, 0, 0);
         #endif
 
+        /*
+         * image.non_max_suppression_batched op - multi-class NMS over batch of images
+         * input:
+         *     0 - boxes - 3D-tensor with shape (batch_size, num_boxes, 4) by float type, boxes are shared by all classes of an image
+         *     1 - scores - 3D-tensor with shape (batch_size, num_boxes, num_classes), same type as boxes
+         *     2 - output_size - 0D-tensor by int type (optional)
+         * float args:
+         *     0 - overlap_threshold - threshold value for overlap checks (optional, by default 0.5)
+         *     1 - score_threshold - the threshold for deciding when to remove boxes based on score (optional, by default -inf)
+         * int args:
+         *     0 - output_size - as arg 2 used for same target. Eigher this or arg 2 should be provided.
+         *
+         * output:
+         *     0 - 3D integer tensor with shape (batch_size, num_classes, output_size), selected box indices
+         *         for each image and class in selection order, padded with -1
+         * */
+        #if NOT_EXCLUDED(OP_image_non_max_suppression_batched)
+        DECLARE_CUSTOM_OP(non_max_suppression_batched, 2, 1, false, 0, 0);
+        #endif
+
         /*
          * cholesky op - decomposite positive square symetric matrix (or matricies when rank > 2).
          * input:
@@ -256,6 +256,231 @@ namespace nd4j {
         }
 
 
+//////////////////////////////////////////////////////////////////////////
+// tiled conv2d: im2col is applied to tiles of output positions only, so scratch memory is limited by tile size instead of bS*oH*oW*kH*kW*iC
+// column layout within tile is [tile, kH, kW, iC], so tile of columns multiplied by weights [kH*kW*iC, oC] gives output tile directly
+
+        // maximal number of elements in columns tile
+        static const Nd4jLong conv2dTileLength = 1 << 20;
+
+        // [bS, iC, iH, iW] (NCHW) or [bS, iH, iW, iC] (NHWC) -> [tile, kH, kW, iC] for output positions [pos0, pos0 + tile) within bS*oH*oW
+        template <typename X>
+        static void im2colTile_(const NDArray& input, X* col, const Nd4jLong pos0, const Nd4jLong tile, const int oH, const int oW, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int isNCHW) {
+
+            const X* x = input.bufferAsT<X>();
+
+            const int iC = input.sizeAt(isNCHW ? 1 : 3);
+            const int iH = input.sizeAt(isNCHW ? 2 : 1);
+            const int iW = input.sizeAt(isNCHW ? 3 : 2);
+
+            const Nd4jLong xStrideB = input.strideAt(0);
+            const Nd4jLong xStrideC = input.strideAt(isNCHW ? 1 : 3);
+            const Nd4jLong xStrideH = input.strideAt(isNCHW ? 2 : 1);
+            const Nd4jLong xStrideW = input.strideAt(isNCHW ? 3 : 2);
+
+            const Nd4jLong K = (Nd4jLong) kH * kW * iC;
+            const Nd4jLong P = (Nd4jLong) oH * oW;
+
+            auto func = PRAGMA_THREADS_FOR {
+                for (auto r = start; r < stop; r++) {
+                    const Nd4jLong pos = pos0 + r;
+                    const Nd4jLong b  = pos / P;
+                    const int oh = (pos % P) / oW;
+                    const int ow = (pos % P) % oW;
+
+                    X* colRow = col + r * K;
+
+                    for (int kh = 0; kh < kH; ++kh) {
+                        const int ih = oh * sH - pH + kh * dH;
+
+                        for (int kw = 0; kw < kW; ++kw) {
+                            const int iw = ow * sW - pW + kw * dW;
+
+                            X* c = colRow + (kh * kW + kw) * iC;
+
+                            if (static_cast<unsigned>(ih) >= static_cast<unsigned>(iH) || static_cast<unsigned>(iw) >= static_cast<unsigned>(iW)) {
+                                for (int ic = 0; ic < iC; ++ic)
+                                    c[ic] = static_cast<X>(0.f);
+                            }
+                            else {
+                                const X* xp = x + b * xStrideB + ih * xStrideH + iw * xStrideW;
+                                for (int ic = 0; ic < iC; ++ic)
+                                    c[ic] = xp[ic * xStrideC];
+                            }
+                        }
+                    }
+                }
+            };
+
+            samediff::Threads::parallel_tad(func, 0, tile);
+        }
+
+        // [tile, kH, kW, iC] is added to gradI [bS, iC, iH, iW] (NCHW) or [bS, iH, iW, iC] (NHWC), parallelized over iC to avoid races between overlapping windows
+        template <typename X>
+        static void col2imTile_(const X* col, NDArray& gradI, const Nd4jLong pos0, const Nd4jLong tile, const int oH, const int oW, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int isNCHW) {
+
+            X* z = gradI.bufferAsT<X>();
+
+            const int iC = gradI.sizeAt(isNCHW ? 1 : 3);
+            const int iH = gradI.sizeAt(isNCHW ? 2 : 1);
+            const int iW = gradI.sizeAt(isNCHW ? 3 : 2);
+
+            const Nd4jLong zStrideB = gradI.strideAt(0);
+            const Nd4jLong zStrideC = gradI.strideAt(isNCHW ? 1 : 3);
+            const Nd4jLong zStrideH = gradI.strideAt(isNCHW ? 2 : 1);
+            const Nd4jLong zStrideW = gradI.strideAt(isNCHW ? 3 : 2);
+
+            const Nd4jLong K = (Nd4jLong) kH * kW * iC;
+            const Nd4jLong P = (Nd4jLong) oH * oW;
+
+            auto func = PRAGMA_THREADS_FOR {
+                for (auto ic = start; ic < stop; ic++) {
+                    for (Nd4jLong r = 0; r < tile; r++) {
+                        const Nd4jLong pos = pos0 + r;
+                        const Nd4jLong b  = pos / P;
+                        const int oh = (pos % P) / oW;
+                        const int ow = (pos % P) % oW;
+
+                        const X* colRow = col + r * K + ic;
+
+                        for (int kh = 0; kh < kH; ++kh) {
+                            const int ih = oh * sH - pH + kh * dH;
+                            if (static_cast<unsigned>(ih) >= static_cast<unsigned>(iH))
+                                continue;
+
+                            for (int kw = 0; kw < kW; ++kw) {
+                                const int iw = ow * sW - pW + kw * dW;
+                                if (static_cast<unsigned>(iw) >= static_cast<unsigned>(iW))
+                                    continue;
+
+                                z[b * zStrideB + ic * zStrideC + ih * zStrideH + iw * zStrideW] += colRow[(kh * kW + kw) * iC];
+                            }
+                        }
+                    }
+                }
+            };
+
+            samediff::Threads::parallel_for(func, 0, iC);
+        }
+
+        // view [tile, oC] of output-like array [bS, oH, oW, oC] (NHWC) or [bS, oC, oH, oW] (NCHW), array is expected to be c-contiguous
+        // for NCHW tile should not cross images boundary
+        static NDArray outputTile(const NDArray& array, const Nd4jLong pos0, const Nd4jLong tile, const int oC, const Nd4jLong P, const int isNCHW) {
+
+            auto buffer = reinterpret_cast<int8_t*>(const_cast<void*>(array.getBuffer()));
+
+            if(!isNCHW)
+                return NDArray(buffer + pos0 * oC * array.sizeOfT(), 'c', {tile, (Nd4jLong) oC}, array.dataType(), array.getContext());
+
+            const Nd4jLong b  = pos0 / P;
+            const Nd4jLong p0 = pos0 % P;
+
+            NDArray image(buffer + b * oC * P * array.sizeOfT(), 'c', {(Nd4jLong) oC, P}, array.dataType(), array.getContext());
+            return image({0,0, p0,p0+tile}).transpose();                 // [oC, tile] -> [tile, oC]
+        }
+
+        // tiles are produced by splitting bS*oH*oW positions, for NCHW each image is split separately
+        static Nd4jLong tileLength(const Nd4jLong pos, const Nd4jLong tile, const Nd4jLong total, const Nd4jLong P, const int isNCHW) {
+            const Nd4jLong limit = isNCHW ? (pos / P + 1) * P : total;
+            return nd4j::math::nd4j_min<Nd4jLong>(tile, limit - pos);
+        }
+
+        static bool isTiledConv2dApplicable(const NDArray* outputLike) {
+            return Environment::getInstance()->isUseTiledConvolutions() && outputLike->ordering() == 'c' && outputLike->ews() == 1;
+        }
+
+//////////////////////////////////////////////////////////////////////////
+        template <typename X, typename Y>
+        static void conv2dTiled_(nd4j::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int isNCHW) {
+
+            const int bS = input->sizeAt(0);
+            const int iC = weights->sizeAt(2);
+            const int oC = weights->sizeAt(3);
+            const int oH = output->sizeAt(isNCHW ? 2 : 1);
+            const int oW = output->sizeAt(isNCHW ? 3 : 2);
+
+            const Nd4jLong K = (Nd4jLong) kH * kW * iC;
+            const Nd4jLong P = (Nd4jLong) oH * oW;
+            const Nd4jLong total = bS * P;
+            const Nd4jLong tile = nd4j::math::nd4j_max<Nd4jLong>(1, nd4j::math::nd4j_min<Nd4jLong>(isNCHW ? P : total, conv2dTileLength / K));
+
+            NDArray wMat = weights->reshape('c', {K, (Nd4jLong) oC});                             // [kH, kW, iC, oC] -> [kH*kW*iC, oC]
+            NDArray col('c', {tile, K}, input->dataType(), input->getContext());
+
+            for (Nd4jLong pos = 0; pos < total; ) {
+                const Nd4jLong len = tileLength(pos, tile, total, P, isNCHW);
+
+                im2colTile_<X>(*input, col.bufferAsT<X>(), pos, len, oH, oW, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW);
+
+                NDArray colTile(col.getBuffer(), 'c', {len, K}, col.dataType(), col.getContext());
+                NDArray outTile = outputTile(*output, pos, len, oC, P, isNCHW);
+
+                MmulHelper::mmul(&colTile, &wMat, &outTile, 1.0, 0.0);                            // [tile, K] x [K, oC] = [tile, oC]
+
+                pos += len;
+            }
+
+            if(bias)
+                helpers::addBias(block, *output, *bias, *output, isNCHW);
+        }
+
+//////////////////////////////////////////////////////////////////////////
+        template <typename X, typename Y>
+        static void conv2dBPTiled_(nd4j::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* gradO, NDArray* gradI, NDArray* gradW, const int kH, const int kW, const int sH, const int sW, const int pH, const int pW, const int dH, const int dW, const int isNCHW) {
+
+            const int bS = input->sizeAt(0);
+            const int iC = weights->sizeAt(2);
+            const int oC = weights->sizeAt(3);
+            const int oH = gradO->sizeAt(isNCHW ? 2 : 1);
+            const int oW = gradO->sizeAt(isNCHW ? 3 : 2);
+
+            const Nd4jLong K = (Nd4jLong) kH * kW * iC;
+            const Nd4jLong P = (Nd4jLong) oH * oW;
+            const Nd4jLong total = bS * P;
+            const Nd4jLong tile = nd4j::math::nd4j_max<Nd4jLong>(1, nd4j::math::nd4j_min<Nd4jLong>(isNCHW ? P : total, conv2dTileLength / K));
+
+            NDArray wMat = weights->reshape('c', {K, (Nd4jLong) oC});                             // [kH, kW, iC, oC] -> [kH*kW*iC, oC]
+            NDArray wMatT = wMat.transpose();
+            NDArray col('c', {tile, K}, input->dataType(), input->getContext());
+
+            // gradW is accumulated over tiles directly if it's contiguous
+            NDArray* gradWMat = nullptr;
+            if(gradW) {
+                if(gradW->ordering() == 'c' && gradW->ews() == 1)
+                    gradWMat = new NDArray(gradW->getBuffer(), 'c', {K, (Nd4jLong) oC}, gradW->dataType(), gradW->getContext());
+                else
+                    gradWMat = new NDArray('c', {K, (Nd4jLong) oC}, gradW->dataType(), gradW->getContext());
+            }
+
+            gradI->nullify();
+
+            for (Nd4jLong pos = 0; pos < total; ) {
+                const Nd4jLong len = tileLength(pos, tile, total, P, isNCHW);
+
+                NDArray colTile(col.getBuffer(), 'c', {len, K}, col.dataType(), col.getContext());
+                NDArray gradOTile = outputTile(*gradO, pos, len, oC, P, isNCHW);
+
+                // ----- calculation of gradW ----- //
+                if(gradW) {
+                    im2colTile_<X>(*input, col.bufferAsT<X>(), pos, len, oH, oW, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW);
+                    NDArray colTileT = colTile.transpose();
+                    MmulHelper::mmul(&colTileT, &gradOTile, gradWMat, 1.0, pos == 0 ? 0.0 : 1.0);    // [K, tile] x [tile, oC] = [K, oC]
+                }
+
+                //----- calculation of gradI -----//
+                MmulHelper::mmul(&gradOTile, &wMatT, &colTile, 1.0, 0.0);                            // [tile, oC] x [oC, K] = [tile, K]
+                col2imTile_<X>(col.bufferAsT<X>(), *gradI, pos, len, oH, oW, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW);
+
+                pos += len;
+            }
+
+            if(gradW) {
+                if(gradWMat->getBuffer() != gradW->getBuffer())
+                    gradW->assign(gradWMat->reshape('c', {kH, kW, iC, oC}));
+                delete gradWMat;
+            }
+        }
+
 //////////////////////////////////////////////////////////////////////////
         template <typename X, typename Y>
         static void conv2d_(nd4j::graph::Context& block, const NDArray* input, const NDArray* weights, const NDArray* bias, NDArray* output, const int kH, const int kW, const int sH, const int sW, int pH, int pW, const int dH, const int dW, const int paddingMode, const int isNCHW) {
@@ -284,6 +509,11 @@ namespace nd4j {
 
             nd4j_debug("MKL-DNN is not used for conv2d!\n", 0);
 
+            if(isTiledConv2dApplicable(output)) {
+                conv2dTiled_<X,Y>(block, input, weights, bias, output, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW);
+                return;
+            }
+
             std::vector<int> permutForOutput;
 
             if(isNCHW)
@@ -349,6 +579,22 @@ namespace nd4j {
 
             nd4j_debug("MKL-DNN is not used for conv2d_bp!\n", 0);
 
+            if(isTiledConv2dApplicable(gradO)) {
+                conv2dBPTiled_<X,Y>(block, input, weights, gradO, gradI, gradW, kH, kW, sH, sW, pH, pW, dH, dW, isNCHW);
+
+                // ----- calculation of gradB ----- //
+                if(gradB) {
+                    NDArray* gradBR = gradB;
+                    if(gradB->rankOf() == 2)
+                        gradBR = new NDArray(gradB->reshape(gradB->ordering(), {(int)gradB->lengthOf()}));
+                    gradO->reduceAlongDimension(reduce::Sum, *gradBR, isNCHW ? std::vector<int>({0, 2, 3}) : std::vector<int>({0, 1, 2}));      // sum over bS, oH, oW
+                    if(gradBR != gradB)
+                        delete gradBR;
+                }
+
+                return;
+            }
+
             std::vector<int> gradOaxesForDot;
 
             if(!isNCHW) {
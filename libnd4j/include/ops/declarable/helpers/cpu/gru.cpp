@@ -28,12 +28,225 @@
 #include <ops/declarable/CustomOperations.h>
 #include<ops/declarable/helpers/transforms.h>
 #include <MmulHelper.h>
+#include <execution/Threads.h>
 
 namespace nd4j 	  {
 namespace ops 	  {
 namespace helpers {
 
 
+//////////////////////////////////////////////////////////////////////////
+// [bS, K] arrays may be strided views (e.g. column blocks of packed gates), [K] arrays are single row broadcasted over batch
+static FORCEINLINE Nd4jLong rowStride(const NDArray& arr) { return arr.rankOf() == 1 ? 0 : arr.strideAt(0); }
+static FORCEINLINE Nd4jLong colStride(const NDArray& arr) { return arr.strideAt(-1); }
+
+//////////////////////////////////////////////////////////////////////////
+// reset and update gates in single pass: ru contains recurrent (or full) projection for [r, u] on entry and gates on exit,
+// zx is optional input projection with [r, u] in its first 2*nU columns, rh = r * hLast is input of cell gate projection
+template <typename T>
+static void gruResetUpdate_(const NDArray* zx, const NDArray& b, const NDArray& hLast, NDArray& ru, NDArray& rh) {
+
+    const Nd4jLong nU   = rh.sizeAt(-1);
+    const Nd4jLong rows = rh.rankOf() == 1 ? 1 : rh.sizeAt(0);
+
+    const T* pZx = zx != nullptr ? zx->bufferAsT<T>() : nullptr;
+    const T* pB  = b.bufferAsT<T>();
+    const T* pH  = hLast.bufferAsT<T>();
+    T* pRu = ru.bufferAsT<T>();
+    T* pRh = rh.bufferAsT<T>();
+
+    const Nd4jLong zxR = zx != nullptr ? rowStride(*zx) : 0, zxC = zx != nullptr ? colStride(*zx) : 0;
+    const Nd4jLong bC  = colStride(b);
+    const Nd4jLong hR  = rowStride(hLast), hC = colStride(hLast);
+    const Nd4jLong ruR = rowStride(ru),    ruC = colStride(ru);
+    const Nd4jLong rhR = rowStride(rh),    rhC = colStride(rh);
+
+    auto func = PRAGMA_THREADS_FOR {
+        for (auto i = start; i < stop; i += increment) {
+
+            T* z = pRu + i * ruR;
+            const T* h = pH + i * hR;
+            T* rhi = pRh + i * rhR;
+
+            if (pZx != nullptr) {
+                const T* x = pZx + i * zxR;
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong j = 0; j < 2 * nU; ++j)
+                    z[j * ruC] += x[j * zxC];
+            }
+
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong j = 0; j < 2 * nU; ++j)
+                z[j * ruC] = nd4j::math::nd4j_sigmoid<T,T>(z[j * ruC] + pB[j * bC]);
+
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong j = 0; j < nU; ++j)
+                rhi[j * rhC] = z[j * ruC] * h[j * hC];
+        }
+    };
+
+    samediff::Threads::parallel_for(func, 0, rows);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// cell gate and cell output in single pass: c contains (r * hLast) × Wch (or full) projection on entry and cell gate on exit,
+// zx is optional input projection of cell gate, h = u * hLast + (1 - u) * c is skipped if h is nullptr
+template <typename T>
+static void gruCellOutput_(const NDArray* zx, const NDArray& bc, const NDArray& u, const NDArray& hLast, NDArray& c, NDArray* h) {
+
+    const Nd4jLong nU   = c.sizeAt(-1);
+    const Nd4jLong rows = c.rankOf() == 1 ? 1 : c.sizeAt(0);
+
+    const T* pZx = zx != nullptr ? zx->bufferAsT<T>() : nullptr;
+    const T* pB  = bc.bufferAsT<T>();
+    const T* pU  = u.bufferAsT<T>();
+    const T* pHl = hLast.bufferAsT<T>();
+    T* pC = c.bufferAsT<T>();
+    T* pH = h != nullptr ? h->bufferAsT<T>() : nullptr;
+
+    const Nd4jLong zxR = zx != nullptr ? rowStride(*zx) : 0, zxC = zx != nullptr ? colStride(*zx) : 0;
+    const Nd4jLong bC  = colStride(bc);
+    const Nd4jLong uR  = rowStride(u),     uC  = colStride(u);
+    const Nd4jLong hlR = rowStride(hLast), hlC = colStride(hLast);
+    const Nd4jLong cR  = rowStride(c),     cC  = colStride(c);
+    const Nd4jLong hR  = h != nullptr ? rowStride(*h) : 0, hC = h != nullptr ? colStride(*h) : 0;
+
+    auto func = PRAGMA_THREADS_FOR {
+        for (auto i = start; i < stop; i += increment) {
+
+            T* ci = pC + i * cR;
+
+            if (pZx != nullptr) {
+                const T* x = pZx + i * zxR;
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong j = 0; j < nU; ++j)
+                    ci[j * cC] += x[j * zxC];
+            }
+
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong j = 0; j < nU; ++j)
+                ci[j * cC] = nd4j::math::nd4j_tanh<T,T>(ci[j * cC] + pB[j * bC]);
+
+            if (pH != nullptr) {
+                const T* ui = pU + i * uR;
+                const T* hl = pHl + i * hlR;
+                T* hi = pH + i * hR;
+
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong j = 0; j < nU; ++j)
+                    hi[j * hC] = ui[j * uC] * hl[j * hlC] + (static_cast<T>(1) - ui[j * uC]) * ci[j * cC];
+            }
+        }
+    };
+
+    samediff::Threads::parallel_for(func, 0, rows);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// gradients wrt gates pre-activations in single pass: dLdZru = [dLdr * drdZr, dLdu * dudZu], dLdZc = dLdc * dcdZc,
+// dLdZcr = dLdZc * r, and dLdhLast is initialized by its direct part dLdh * u
+template <typename T>
+static void gruCellGrads_(const NDArray& ru, const NDArray& c, const NDArray& dLdr, const NDArray& dLdu, const NDArray& dLdc, const NDArray& dLdh,
+                          NDArray& dLdZru, NDArray& dLdZc, NDArray& dLdZcr, NDArray& dLdhLast) {
+
+    const Nd4jLong nU   = c.sizeAt(-1);
+    const Nd4jLong rows = c.rankOf() == 1 ? 1 : c.sizeAt(0);
+
+    const T* pRu = ru.bufferAsT<T>();
+    const T* pC  = c.bufferAsT<T>();
+    const T* pDr = dLdr.bufferAsT<T>();
+    const T* pDu = dLdu.bufferAsT<T>();
+    const T* pDc = dLdc.bufferAsT<T>();
+    const T* pDh = dLdh.bufferAsT<T>();
+    T* pZru = dLdZru.bufferAsT<T>();
+    T* pZc  = dLdZc.bufferAsT<T>();
+    T* pZcr = dLdZcr.bufferAsT<T>();
+    T* pDhl = dLdhLast.bufferAsT<T>();
+
+    const Nd4jLong ruR  = rowStride(ru),       ruC  = colStride(ru);
+    const Nd4jLong cR   = rowStride(c),        cC   = colStride(c);
+    const Nd4jLong drR  = rowStride(dLdr),     drC  = colStride(dLdr);
+    const Nd4jLong duR  = rowStride(dLdu),     duC  = colStride(dLdu);
+    const Nd4jLong dcR  = rowStride(dLdc),     dcC  = colStride(dLdc);
+    const Nd4jLong dhR  = rowStride(dLdh),     dhC  = colStride(dLdh);
+    const Nd4jLong zruR = rowStride(dLdZru),   zruC = colStride(dLdZru);
+    const Nd4jLong zcR  = rowStride(dLdZc),    zcC  = colStride(dLdZc);
+    const Nd4jLong zcrR = rowStride(dLdZcr),   zcrC = colStride(dLdZcr);
+    const Nd4jLong dhlR = rowStride(dLdhLast), dhlC = colStride(dLdhLast);
+
+    auto func = PRAGMA_THREADS_FOR {
+        for (auto i = start; i < stop; i += increment) {
+
+            const T* r  = pRu + i * ruR;
+            const T* u  = r + nU * ruC;
+            const T* ci = pC + i * cR;
+            const T* dr = pDr + i * drR;
+            const T* du = pDu + i * duR;
+            const T* dc = pDc + i * dcR;
+            const T* dh = pDh + i * dhR;
+            T* zr  = pZru + i * zruR;
+            T* zu  = zr + nU * zruC;
+            T* zc  = pZc + i * zcR;
+            T* zcr = pZcr + i * zcrR;
+            T* dhl = pDhl + i * dhlR;
+
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong j = 0; j < nU; ++j) {
+                const T rj = r[j * ruC];
+                const T uj = u[j * ruC];
+                const T cj = ci[j * cC];
+
+                zr[j * zruC]  = dr[j * drC] * rj * (static_cast<T>(1) - rj);
+                zu[j * zruC]  = du[j * duC] * uj * (static_cast<T>(1) - uj);
+                zc[j * zcC]   = dc[j * dcC] * (static_cast<T>(1) - cj * cj);
+                zcr[j * zcrC] = zc[j * zcC] * rj;
+                dhl[j * dhlC] = dh[j * dhC] * uj;
+            }
+        }
+    };
+
+    samediff::Threads::parallel_for(func, 0, rows);
+}
+
+//////////////////////////////////////////////////////////////////////////
+static void gruResetUpdate(const NDArray* zx, const NDArray& b, const NDArray& hLast, NDArray& ru, NDArray& rh) {
+
+    NDArray::preparePrimaryUse({&ru, &rh}, {zx, &b, &hLast});
+    BUILD_SINGLE_SELECTOR(ru.dataType(), gruResetUpdate_, (zx, b, hLast, ru, rh), FLOAT_TYPES);
+    NDArray::registerPrimaryUse({&ru, &rh}, {zx, &b, &hLast});
+}
+
+//////////////////////////////////////////////////////////////////////////
+static void gruCellOutput(const NDArray* zx, const NDArray& bc, const NDArray& u, const NDArray& hLast, NDArray& c, NDArray* h) {
+
+    NDArray::preparePrimaryUse({&c, h}, {zx, &bc, &u, &hLast});
+    BUILD_SINGLE_SELECTOR(c.dataType(), gruCellOutput_, (zx, bc, u, hLast, c, h), FLOAT_TYPES);
+    NDArray::registerPrimaryUse({&c, h}, {zx, &bc, &u, &hLast});
+}
+
+//////////////////////////////////////////////////////////////////////////
+// feed forward step of cell with packed weights, 2 GEMMs in total: [x, hLast] × W for both gates and [x, r * hLast] × Wc for cell gate
+// xh and xrh are [bS, iS+nU] scratch buffers, on exit they contain [x, hLast] and [x, r * hLast] correspondingly, ru is [bS, 2*nU]
+static void gruCellFF(const NDArray* x, const NDArray* hLast, const NDArray* W, const NDArray* Wc, const NDArray* b, const NDArray* bc,
+                      NDArray& xh, NDArray& xrh, NDArray& ru, NDArray& c, NDArray* h) {
+
+    const Nd4jLong iS = x->sizeAt(1);
+    const Nd4jLong nU = hLast->sizeAt(1);
+
+    xh({0,0, 0,iS}, true).assign(x);
+    xh({0,0, iS,iS+nU}, true).assign(hLast);
+    xrh({0,0, 0,iS}, true).assign(x);
+
+    MmulHelper::mmul(&xh, W, &ru, 1.0, 0.0);        // [bS, iS+nU] × [iS+nU, 2*nU] = [bS, 2*nU]
+
+    NDArray rh = xrh({0,0, iS,iS+nU}, true);
+    gruResetUpdate(nullptr, *b, *hLast, ru, rh);
+
+    MmulHelper::mmul(&xrh, Wc, &c, 1.0, 0.0);       // [bS, iS+nU] × [iS+nU, nU] = [bS, nU]
+
+    gruCellOutput(nullptr, *bc, ru({0,0, nU,2*nU}, true), *hLast, c, h);
+}
+
 //////////////////////////////////////////////////////////////////////////
 void gruCell(nd4j::LaunchContext * context, const NDArray* x, const NDArray* hLast, const NDArray* W, const NDArray* Wc,
              const NDArray* b, const NDArray* bc,
@@ -53,78 +266,26 @@ void gruCell(nd4j::LaunchContext * context, const NDArray* x, const NDArray* hLa
     // c        Cell gate output [bS, nU]
     // h        current cell output [bS, nU]
 
-    /***************************************************************************************/
-    /************************ THIS IS NOT OPTIMAZED CODE ***********************************/
-    /** however it is more math-friendly and convenient for backprop formulas derivation) **/
-
-    const int bS  = x->sizeAt(0);
-    const int iS = x->sizeAt(1);
-    const int nU = hLast->sizeAt(1);
-
-    NDArray Wrx = (*W)({0,iS,     0,nU});       // [iS, nU]
-    NDArray Wux = (*W)({0,iS,     nU,2*nU});    // [iS, nU]
-    NDArray Wrh = (*W)({iS,iS+nU, 0,nU});       // [nU, nU]
-    NDArray Wuh = (*W)({iS,iS+nU, nU,2*nU});    // [nU, nU]
-
-    NDArray Wcx = (*Wc)({0,iS,     0,0});       // reset cell weights    [iS, nU]
-    NDArray Wch = (*Wc)({iS,iS+nU, 0,0});       // updates cell weights  [nU, nU]
-
-    NDArray br = (*b)({0,  nU});                // [nU]
-    NDArray bu = (*b)({nU, 2*nU});              // [nU]
-
     // × means matrix multipication
     // * means element-wise product or so called Hadamard product
 
-    // reset gate
-    r->assign(mmul(*x, Wrx) + mmul(*hLast, Wrh) + br);         // [bS, iS] × [iS, nU] + [bS, nU] × [nU, nU] + [nU] = [bS, nU]
-    r->applyTransform(transform::Sigmoid, *r);
-
-    // update gate
-    u->assign(mmul(*x, Wux) + mmul(*hLast, Wuh) + bu);         // [bS, iS] × [iS, nU] + [bS, nU] × [nU, nU] + [nU] = [bS, nU]
-    u->applyTransform(transform::Sigmoid, *u);
-
-    // cell gate c = activation(x × Wcx + (r * hlast) × Wch + bc)
-    c->assign(mmul(*x, Wcx) + mmul(*r * *hLast, Wch) + *bc);    // [bS, iS] × [iS, nU] + [bS, nU] × [nU, nU] + [nU] = [bS, nU]
-    c->applyTransform(transform::Tanh, *c);
-
-    NDArray temp = 1.f - *c * *c;
-
-    // cell output
-    h->assign(*u * *hLast + (1.f - *u) * *c);
-
-
-    /***************************************************************************************/
-    /*************** THIS IS MORE OPTIMAZED CODE (should think about concat) ***************/
-    /***************************************************************************************/
-/*
-    //Concat inputs: x + hLast : [bs, iS + nU]
-    NDArray xhConcat(x->ordering(), {bS, iS + nU}, x->dataType(), context);  // concat([bs, iS], [bs, nU]) -> [bs, iS + nU]
-    helpers::concat(context, {const_cast<NDArray*>(x), const_cast<NDArray*>(hLast)},  xhConcat, {1});
-
-    //mmul for reset and update gates: (x × weight_ux + hLast × weight_xr + b_u)
-    auto m = mmul(xhConcat, *W) + *b ;    // [bs, iS+nU] * [iS+nU, 2*nU] = [bs, 2*nU]
-    // m += *bru;
+    // r = sigmoid(x × Wrx + hLast × Wrh + br)
+    // u = sigmoid(x × Wux + hLast × Wuh + bu)
+    // c = tanh(x × Wcx + (r * hLast) × Wch + bc)
+    // h = u * hLast + (1 - u) * c
 
-    m.applyTransform(transform::Sigmoid);  //sigmoid(rz) and sigmoid(uz)
+    const Nd4jLong bS = x->sizeAt(0);
+    const Nd4jLong iS = x->sizeAt(1);
+    const Nd4jLong nU = hLast->sizeAt(1);
 
-    r->assign(m({0,0, 0, nU}));
-    u->assign(m({0,0, nU, 2*nU}));
+    NDArray xh ('c', {bS, iS+nU}, x->dataType(), context);     // [x, hLast]
+    NDArray xrh('c', {bS, iS+nU}, x->dataType(), context);     // [x, r * hLast]
+    NDArray ru ('c', {bS, 2*nU},  x->dataType(), context);     // [r, u]
 
-    // hLast = hLast * r
-    xhConcat({0,0, iS, iS+nU}) *= *r;
+    gruCellFF(x, hLast, W, Wc, b, bc, xh, xrh, ru, *c, h);
 
-    //c = tanh(x × weight_cx + (hLast * r) × weight_cr + b_c)
-    MmulHelper::mmul(&xhConcat, Wc, c, 1.0, 0.0);       //c = 1.0 * xhConcat * Wc + 0.0 * c
-    *c += *bc;
-    c->applyTransform(transform::Tanh);
-
-    //Output: h = (1-u).*c + u .* hPrev
-    //auto hResult = (*u) * (*hLast) + (1.0f - *u) * (*c); const_cast<NDArray*>(h)->assign(&hResult);
-    u->applyPairwiseTransform(pairwise::Multiply, hLast, h, nullptr);        //h = u * hLast
-    auto temp = (1.0f - *u);
-    temp *= (*c);
-    (*h) += temp;
-*/
+    r->assign(ru({0,0, 0,nU}, true));
+    u->assign(ru({0,0, nU,2*nU}, true));
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -138,19 +299,65 @@ void gruTimeLoop(nd4j::LaunchContext * context, const NDArray* x, const NDArray*
 
     // h is cell outputs at each time step [time, bS, nU]
 
-    const int time = x->sizeAt(0);
+    // gates order within packed weights and biases is [r, u, c], then per time step
+    // r = sigmoid(xt × Wxr + ht_1 × Whr + br)
+    // u = sigmoid(xt × Wxu + ht_1 × Whu + bu)
+    // c = tanh(xt × Wxc + (r * ht_1) × Whc + bc)
+    // ht = u * ht_1 + (1 - u) * c
+
+    const Nd4jLong time = x->sizeAt(0);
+    const Nd4jLong bS   = x->sizeAt(1);
+    const Nd4jLong iS   = x->sizeAt(2);
+    const Nd4jLong nU   = hLast->sizeAt(1);
+
+    if (time == 0)
+        return;
+
+    // input projection doesn't depend on recurrence, so it is done for whole sequence by single GEMM
+    NDArray zx('c', {time * bS, 3*nU}, h->dataType(), context);
+    NDArray x2d = x->reshape('c', {time * bS, iS});
+    MmulHelper::mmul(&x2d, Wx, &zx, 1.0, 0.0);      // [time*bS, iS] × [iS, 3*nU] = [time*bS, 3*nU]
+
+    // contiguous copies of recurrent weights blocks, reused by every time step
+    NDArray Whru = (*Wh)({0,0, 0,2*nU},    true).dup('c');    // [nU, 2*nU]
+    NDArray Whc  = (*Wh)({0,0, 2*nU,3*nU}, true).dup('c');    // [nU, nU]
+
+    NDArray bru = (*b)({0, 2*nU});
+    NDArray bc  = (*b)({2*nU, 3*nU});
+
+    // gate buffers are allocated once for whole sequence
+    NDArray ru('c', {bS, 2*nU}, h->dataType(), context);
+    NDArray rh('c', {bS, nU},   h->dataType(), context);
+    NDArray c ('c', {bS, nU},   h->dataType(), context);
+    NDArray u = ru({0,0, nU,2*nU}, true);
+
+    // time steps are written directly into output, unless it can't be viewed as [time*bS, nU] matrix
+    const bool direct = h->ordering() == 'c' && h->ews() == 1;
+    NDArray h2d = direct ? h->reshape('c', {time * bS, nU}, false) : NDArray('c', {time * bS, nU}, h->dataType(), context);
 
-    NDArray ht_1(*hLast);
+    const NDArray* ht_1 = hLast;
+    NDArray hPrev;
 
     // loop through time steps
-    for (int t = 0; t < time; ++t) {
+    for (Nd4jLong t = 0; t < time; ++t) {
 
-        auto xt = (*x)({t,t+1, 0,0, 0,0});
-        auto ht = (*h)({t,t+1, 0,0, 0,0});
+        NDArray zxt  = zx({t*bS,(t+1)*bS, 0,0}, true);
+        NDArray zxru = zxt({0,0, 0,2*nU},    true);
+        NDArray zxc  = zxt({0,0, 2*nU,3*nU}, true);
+        NDArray ht   = h2d({t*bS,(t+1)*bS, 0,0}, true);
 
-        // helpers::gruCell(&xt, &ht_1, Wx, Wh, b, &ht);
-        // ht_1.assign(ht);
+        MmulHelper::mmul(ht_1, &Whru, &ru, 1.0, 0.0);      // [bS, nU] × [nU, 2*nU] = [bS, 2*nU]
+        gruResetUpdate(&zxru, bru, *ht_1, ru, rh);
+
+        MmulHelper::mmul(&rh, &Whc, &c, 1.0, 0.0);         // [bS, nU] × [nU, nU] = [bS, nU]
+        gruCellOutput(&zxc, bc, u, *ht_1, c, &ht);
+
+        hPrev = std::move(ht);
+        ht_1 = &hPrev;
     }
+
+    if (!direct)
+        h->assign(h2d.reshape(h->ordering(), h->getShapeAsVector()));
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -185,61 +392,19 @@ void gruCellBP(nd4j::LaunchContext* context,
     // * means element-wise product or so called Hadamard product
     // × means matrix multiplication
 
-    /************************************************************************************************/
-    /******************************* THIS IS NOT OPTIMAZED CODE *************************************/
-    /*** aim is to have math-readable code in order to keep track of backprop formulas derivation ***/
-
-    const int bS  = x->sizeAt(0);
-    const int iS = x->sizeAt(1);
-    const int nU = hLast->sizeAt(1);
-
-    NDArray xT     = x->transpose();            // [iS, bS]
-    NDArray hLastT = hLast->transpose();        // [nU, bS]
-
-    NDArray Wrx = (*W)({0,iS,     0,nU});       // [iS, nU]
-    NDArray Wux = (*W)({0,iS,     nU,2*nU});    // [iS, nU]
-    NDArray Wrh = (*W)({iS,iS+nU, 0,nU});       // [nU, nU]
-    NDArray Wuh = (*W)({iS,iS+nU, nU,2*nU});    // [nU, nU]
-
-    NDArray Wcx = (*Wc)({0,iS,     0,0});       // reset cell weights    [iS, nU]
-    NDArray Wch = (*Wc)({iS,iS+nU, 0,0});       // updates cell weights  [nU, nU]
-
-    NDArray br = (*b)({0,  nU});                // [nU]
-    NDArray bu = (*b)({nU, 2*nU});              // [nU]
-
-    NDArray WrxT = Wrx.transpose();             // [nU, iS]
-    NDArray WuxT = Wux.transpose();             // [nU, iS]
-    NDArray WrhT = Wrh.transpose();             // [nU, nU]
-    NDArray WuhT = Wuh.transpose();             // [nU, nU]
-
-    NDArray WcxT = Wcx.transpose();             // [nU, iS]
-    NDArray WchT = Wch.transpose();             // [nU, nU]
-
-    NDArray dLdWrx = (*dLdW)({0,iS,     0,nU});     // [iS, nU]
-    NDArray dLdWux = (*dLdW)({0,iS,     nU,2*nU});  // [iS, nU]
-    NDArray dLdWrh = (*dLdW)({iS,iS+nU, 0,nU});     // [nU, nU]
-    NDArray dLdWuh = (*dLdW)({iS,iS+nU, nU,2*nU});  // [nU, nU]
-
-    NDArray dLdWcx = (*dLdWc)({0,iS,     0,0});     // [iS, nU]
-    NDArray dLdWch = (*dLdWc)({iS,iS+nU, 0,0});     // [nU, nU]
-
-    NDArray dLdbr = (*dLdb)({0,  nU});              // [nU]
-    NDArray dLdbu = (*dLdb)({nU, 2*nU});            // [nU]
-
+    const Nd4jLong bS = x->sizeAt(0);
+    const Nd4jLong iS = x->sizeAt(1);
+    const Nd4jLong nU = hLast->sizeAt(1);
 
     // ***** feed forward step ***** //
 
-    // reset gate
-    NDArray r = mmul(*x, Wrx) + mmul(*hLast, Wrh) + br;         // [bS, iS] × [iS, nU] + [bS, nU] × [nU, nU] + [nU] = [bS, nU]
-    r.applyTransform(transform::Sigmoid, r);
-
-    // update gate
-    NDArray u = mmul(*x, Wux) + mmul(*hLast, Wuh) + bu;         // [bS, iS] × [iS, nU] + [bS, nU] × [nU, nU] + [nU] = [bS, nU]
-    u.applyTransform(transform::Sigmoid, u);
+    // same packed buffers as in gruCell, they are reused below as GEMM operands of weights gradients
+    NDArray xh ('c', {bS, iS+nU}, x->dataType(), context);     // [x, hLast]
+    NDArray xrh('c', {bS, iS+nU}, x->dataType(), context);     // [x, r * hLast]
+    NDArray ru ('c', {bS, 2*nU},  x->dataType(), context);     // [r, u]
+    NDArray c  ('c', {bS, nU},    x->dataType(), context);
 
-    // cell gate c = activation(x×Wcx + (r*hlast)×Wcu + bc)
-    NDArray c = mmul(*x, Wcx) + mmul(r * *hLast, Wch) + *bc;    // [bS, iS] × [iS, nU] + [bS, nU] × [nU, nU] + [nU] = [bS, nU]
-    c.applyTransform(transform::Tanh, c);
+    gruCellFF(x, hLast, W, Wc, b, bc, xh, xrh, ru, c, nullptr);
 
     // h = (1 - u) * c + u * hPrev
 
@@ -327,35 +492,38 @@ void gruCellBP(nd4j::LaunchContext* context,
     // dZcdbc = 1
     // finally dLdbc = dLdc * dcdZc
 
-    NDArray dhdc  = 1.f - u;           // [bS, nU]
-    NDArray dhdu  = *hLast - c;        // [bS, nU]
-    NDArray dudZu = u * dhdc;          // [bS, nU]
-    NDArray drdZr = r * (1.f - r);     // [bS, nU]
-    NDArray dcdZc = 1.f - c * c;       // [bS, nU]
-    NDArray dLdZc = *dLdc * dcdZc;     // [bS, nU]
-    NDArray dLdZu = *dLdu * dudZu;     // [bS, nU]
-    NDArray dLdZr = *dLdr * drdZr;     // [bS, nU]
+    NDArray dLdZru('c', {bS, 2*nU}, x->dataType(), context);   // [dLdZr, dLdZu]
+    NDArray dLdZc ('c', {bS, nU},   x->dataType(), context);
+    NDArray dLdZcr('c', {bS, nU},   x->dataType(), context);   // dLdZc * r
 
-    // NDArray dLdc  = *dLdh * dhdc;                       // [bS, nU]
-    // NDArray dLdu  = *dLdh * dhdu;                       // [bS, nU]
-    // NDArray dLdr  = mmul(dLdc * dcdZc * *hLast, WchT);  // [bS, nU]
+    NDArray::preparePrimaryUse({&dLdZru, &dLdZc, &dLdZcr, dLdhLast}, {&ru, &c, dLdr, dLdu, dLdc, dLdh});
+    BUILD_SINGLE_SELECTOR(x->dataType(), gruCellGrads_, (ru, c, *dLdr, *dLdu, *dLdc, *dLdh, dLdZru, dLdZc, dLdZcr, *dLdhLast), FLOAT_TYPES);
+    NDArray::registerPrimaryUse({&dLdZru, &dLdZc, &dLdZcr, dLdhLast}, {&ru, &c, dLdr, dLdu, dLdc, dLdh});
 
-    dLdx->assign(mmul(dLdZu, WuxT) + mmul(dLdZc, WcxT) + mmul(dLdZr, WrxT));                        // [bS, iS]
+    // both gates share packed weights, so dLdZr × WrxT + dLdZu × WuxT = dLdZru × [Wrx, Wux]T, same for hLast part
+    NDArray WxT  = (*W)({0,iS,     0,0}, true).transpose();   // [2*nU, iS]
+    NDArray WhT  = (*W)({iS,iS+nU, 0,0}, true).transpose();   // [2*nU, nU]
+    NDArray WcxT = (*Wc)({0,iS,     0,0}, true).transpose();  // [nU, iS]
+    NDArray WchT = (*Wc)({iS,iS+nU, 0,0}, true).transpose();  // [nU, nU]
 
-    dLdhLast->assign(*dLdh * u + mmul(dLdZu, WuhT) + mmul(dLdZc * r, WchT) + mmul(dLdZr, WrhT));    // [bS, nU]
+    // dLdx = (dLdu * dudZu) × WuxT + (dLdc * dcdZc) × WcxT + (dLdr * drdZr) × WrxT
+    MmulHelper::mmul(&dLdZru, &WxT,  dLdx, 1.0, 0.0);          // [bS, 2*nU] × [2*nU, iS] = [bS, iS]
+    MmulHelper::mmul(&dLdZc,  &WcxT, dLdx, 1.0, 1.0);          // [bS, nU] × [nU, iS] = [bS, iS]
 
-    dLdWrx.assign(mmul(xT,     dLdZr));     // [iS, bS] × [bS, nU] = [iS, nU]
-    dLdWrh.assign(mmul(hLastT, dLdZr));     // [nU, bS] × [bS, nU] = [nU, nU]
-    dLdWux.assign(mmul(xT,     dLdZu));     // [iS, bS] × [bS, nU] = [iS, nU]
-    dLdWuh.assign(mmul(hLastT, dLdZu));     // [nU, bS] × [bS, nU] = [nU, nU]
+    // dLdhLast = dLdh * u + (dLdu * dudZu) × WuhT + (dLdc * dcdZc * r) × WchT + (dLdr * drdZr) × WrhT
+    MmulHelper::mmul(&dLdZru, &WhT,  dLdhLast, 1.0, 1.0);      // [bS, 2*nU] × [2*nU, nU] = [bS, nU]
+    MmulHelper::mmul(&dLdZcr, &WchT, dLdhLast, 1.0, 1.0);      // [bS, nU] × [nU, nU] = [bS, nU]
 
-    dLdWcx.assign(mmul(xT, dLdZc));                          // [iS, bS] × [bS, nU] = [iS, nU]
-    dLdWch.assign(mmul((r * *hLast).transpose(), dLdZc));    // [nU, bS] × [bS, nU] = [nU, nU]
+    // [dLdWrx, dLdWux; dLdWrh, dLdWuh] = [x, hLast]T × [dLdZr, dLdZu]
+    NDArray xhT = xh.transpose();
+    MmulHelper::mmul(&xhT, &dLdZru, dLdW, 1.0, 0.0);           // [iS+nU, bS] × [bS, 2*nU] = [iS+nU, 2*nU]
 
-    dLdbr.assign(dLdZr.reduceAlongDimension(reduce::Sum, {0}));  // [nU]
-    dLdbu.assign(dLdZu.reduceAlongDimension(reduce::Sum, {0}));  // [nU]
+    // [dLdWcx; dLdWch] = [x, r * hLast]T × dLdZc
+    NDArray xrhT = xrh.transpose();
+    MmulHelper::mmul(&xrhT, &dLdZc, dLdWc, 1.0, 0.0);          // [iS+nU, bS] × [bS, nU] = [iS+nU, nU]
 
-    dLdbc->assign(dLdZc.reduceAlongDimension(reduce::Sum, {0})); // [nU]
+    dLdZru.reduceAlongDimension(reduce::Sum, *dLdb, {0});      // [2*nU]
+    dLdZc.reduceAlongDimension(reduce::Sum, *dLdbc, {0});      // [nU]
 }
 
 // //////////////////////////////////////////////////////////////////////////
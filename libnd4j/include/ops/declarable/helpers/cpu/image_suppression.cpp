@@ -20,130 +20,202 @@
 
 #include <ops/declarable/helpers/image_suppression.h>
 #include <NDArrayFactory.h>
+#include <execution/Threads.h>
 #include <algorithm>
 #include <numeric>
 #include <queue>
+#include <memory>
 
 namespace nd4j {
 namespace ops {
 namespace helpers {
 
+    // number of selected boxes checked against candidate in one vectorized pass
+    static const size_t NMS_OVERLAP_BLOCK = 16;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Boxes kept as structure of arrays with normalized corners and precomputed areas
     template <typename T>
-    static void nonMaxSuppressionV2_(NDArray* boxes, NDArray* scales, int maxSize, double overlapThreshold,
-            double scoreThreshold, NDArray* output) {
-        std::vector<int> indices(scales->lengthOf());
-        std::iota(indices.begin(), indices.end(), 0);
-        auto actualIndicesCount = indices.size();
-        for (auto e = 0; e < scales->lengthOf(); e++) {
-            if (scales->e<float>(e) < (float)scoreThreshold) {
-                indices[e] = -1;
-                actualIndicesCount--;
+    struct BoxesSoA {
+        std::vector<T> yMin, xMin, yMax, xMax, area;
+
+        // boxes are given as rows of (y1, x1, y2, x2), corners may come in any order
+        BoxesSoA(const T* boxes, Nd4jLong numBoxes, Nd4jLong rowStride, Nd4jLong colStride) :
+                yMin(numBoxes), xMin(numBoxes), yMax(numBoxes), xMax(numBoxes), area(numBoxes) {
+            for (Nd4jLong i = 0; i < numBoxes; i++) {
+                const T* row = boxes + i * rowStride;
+                const T y1 = row[0], x1 = row[colStride], y2 = row[2 * colStride], x2 = row[3 * colStride];
+                yMin[i] = math::nd4j_min(y1, y2);
+                xMin[i] = math::nd4j_min(x1, x2);
+                yMax[i] = math::nd4j_max(y1, y2);
+                xMax[i] = math::nd4j_max(x1, x2);
+                area[i] = (yMax[i] - yMin[i]) * (xMax[i] - xMin[i]);
             }
         }
-        std::sort(indices.begin(), indices.end(), [scales](int i, int j) {return i >= 0 && j >=0?scales->e<T>(i) > scales->e<T>(j):(i > j);});
-
-//        std::vector<int> selected(output->lengthOf());
-        std::vector<int> selectedIndices(output->lengthOf(), 0);
-        auto needToSuppressWithThreshold = [] (NDArray& boxes, int previousIndex, int nextIndex, T threshold) -> bool {
-            if (previousIndex < 0 || nextIndex < 0) return true;
-            T minYPrev = nd4j::math::nd4j_min(boxes.t<T>(previousIndex, 0), boxes.t<T>(previousIndex, 2));
-            T minXPrev = nd4j::math::nd4j_min(boxes.t<T>(previousIndex, 1), boxes.t<T>(previousIndex, 3));
-            T maxYPrev = nd4j::math::nd4j_max(boxes.t<T>(previousIndex, 0), boxes.t<T>(previousIndex, 2));
-            T maxXPrev = nd4j::math::nd4j_max(boxes.t<T>(previousIndex, 1), boxes.t<T>(previousIndex, 3));
-            T minYNext = nd4j::math::nd4j_min(boxes.t<T>(nextIndex, 0), boxes.t<T>(nextIndex, 2));
-            T minXNext = nd4j::math::nd4j_min(boxes.t<T>(nextIndex, 1), boxes.t<T>(nextIndex, 3));
-            T maxYNext = nd4j::math::nd4j_max(boxes.t<T>(nextIndex, 0), boxes.t<T>(nextIndex, 2));
-            T maxXNext = nd4j::math::nd4j_max(boxes.t<T>(nextIndex, 1), boxes.t<T>(nextIndex, 3));
-            T areaPrev = (maxYPrev - minYPrev) * (maxXPrev - minXPrev);
-            T areaNext = (maxYNext - minYNext) * (maxXNext - minXNext);
-
-            if (areaNext <= T(0.f) || areaPrev <= T(0.f)) return false;
-
-            T minIntersectionY = nd4j::math::nd4j_max(minYPrev, minYNext);
-            T minIntersectionX = nd4j::math::nd4j_max(minXPrev, minXNext);
-            T maxIntersectionY = nd4j::math::nd4j_min(maxYPrev, maxYNext);
-            T maxIntersectionX = nd4j::math::nd4j_min(maxXPrev, maxXNext);
-            T intersectionArea =
-                    nd4j::math::nd4j_max(T(maxIntersectionY - minIntersectionY), T(0.0f)) *
-                            nd4j::math::nd4j_max(T(maxIntersectionX - minIntersectionX), T(0.0f));
-            T intersectionValue = intersectionArea / (areaPrev + areaNext - intersectionArea);
-            return intersectionValue > threshold;
+    };
 
-        };
-//        int numSelected = 0;
-        int numBoxes = actualIndicesCount; //boxes->sizeAt(0);
-        int numSelected = 0;
-
-        for (int i = 0; i < numBoxes; ++i) {
-            bool shouldSelect = numSelected < output->lengthOf();
-
-            // FIXME: add parallelism here
-            for (int j = numSelected - 1; j >= 0; --j) {
-                if (shouldSelect)
-                if (needToSuppressWithThreshold(*boxes, indices[i], indices[selectedIndices[j]], T(overlapThreshold))) {
-                    shouldSelect = false;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // Coordinates of already selected boxes, packed in selection order
+    template <typename T>
+    class SelectedBoxes {
+    private:
+        std::vector<T> _yMin, _xMin, _yMax, _xMax, _area;
+
+    public:
+        explicit SelectedBoxes(size_t capacity) {
+            _yMin.reserve(capacity);
+            _xMin.reserve(capacity);
+            _yMax.reserve(capacity);
+            _xMax.reserve(capacity);
+            _area.reserve(capacity);
+        }
+
+        size_t size() const {
+            return _area.size();
+        }
+
+        void push(const BoxesSoA<T>& boxes, Nd4jLong i) {
+            _yMin.push_back(boxes.yMin[i]);
+            _xMin.push_back(boxes.xMin[i]);
+            _yMax.push_back(boxes.yMax[i]);
+            _xMax.push_back(boxes.xMax[i]);
+            _area.push_back(boxes.area[i]);
+        }
+
+        /**
+         * Checks box i against selected boxes [begin, size()).
+         * Inclusive mode suppresses if IoU >= threshold (IoU of degenerate boxes is 0),
+         * otherwise box is suppressed if IoU > threshold and both boxes have positive area
+         */
+        template <bool Inclusive>
+        bool overlaps(const BoxesSoA<T>& boxes, Nd4jLong i, size_t begin, double threshold) const {
+            const T zero = static_cast<T>(0.f);
+            const T thresholdT = static_cast<T>(threshold);
+            const float thresholdF = static_cast<float>(threshold);
+            const T yMinI = boxes.yMin[i], xMinI = boxes.xMin[i], yMaxI = boxes.yMax[i], xMaxI = boxes.xMax[i], areaI = boxes.area[i];
+            const size_t n = size();
+
+            for (size_t start = begin; start < n; start += NMS_OVERLAP_BLOCK) {
+                const size_t stop = math::nd4j_min<size_t>(n, start + NMS_OVERLAP_BLOCK);
+                int hit = 0;
+
+                PRAGMA_OMP_SIMD_ARGS(reduction(|:hit))
+                for (size_t j = start; j < stop; j++) {
+                    const T intersectionY = math::nd4j_min(yMaxI, _yMax[j]) - math::nd4j_max(yMinI, _yMin[j]);
+                    const T intersectionX = math::nd4j_min(xMaxI, _xMax[j]) - math::nd4j_max(xMinI, _xMin[j]);
+                    const T intersectionArea = math::nd4j_max(intersectionY, zero) * math::nd4j_max(intersectionX, zero);
+                    const bool valid = areaI > zero && _area[j] > zero;
+                    const T iou = valid ? intersectionArea / (areaI + _area[j] - intersectionArea) : zero;
+
+                    hit |= Inclusive ? static_cast<float>(iou) >= thresholdF : (valid && iou > thresholdT);
                 }
+
+                if (hit)
+                    return true;
             }
-            if (shouldSelect) {
-                output->p(numSelected, indices[i]);
-                selectedIndices[numSelected++] = i;
-            }
+
+            return false;
         }
-    }
+    };
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-    // Return intersection-over-union overlap between boxes i and j
     template <typename T>
-    static inline T similirityV3_(NDArray const& boxes, Nd4jLong i, Nd4jLong j) {
-        const T zero = static_cast<T>(0.f);
-        const T yminI = math::nd4j_min(boxes.t<T>(i, 0), boxes.t<T>(i, 2));
-        const T xminI = math::nd4j_min(boxes.t<T>(i, 1), boxes.t<T>(i, 3));
-        const T ymaxI = math::nd4j_max(boxes.t<T>(i, 0), boxes.t<T>(i, 2));
-        const T xmaxI = math::nd4j_max(boxes.t<T>(i, 1), boxes.t<T>(i, 3));
-        const T yminJ = math::nd4j_min(boxes.t<T>(j, 0), boxes.t<T>(j, 2));
-        const T xminJ = math::nd4j_min(boxes.t<T>(j, 1), boxes.t<T>(j, 3));
-        const T ymaxJ = math::nd4j_max(boxes.t<T>(j, 0), boxes.t<T>(j, 2));
-        const T xmaxJ = math::nd4j_max(boxes.t<T>(j, 1), boxes.t<T>(j, 3));
-        const T areaI = (ymaxI - yminI) * (xmaxI - xminI);
-        const T areaJ = (ymaxJ - yminJ) * (xmaxJ - xminJ);
-        if (areaI <= zero || areaJ <= zero) {
-            return zero;
-        }
-        const T intersectionYmin = math::nd4j_max(yminI, yminJ);
-        const T intersectionXmin = math::nd4j_max(xminI, xminJ);
-        const T intersectionYmax = math::nd4j_min(ymaxI, ymaxJ);
-        const T intersectionXmax = math::nd4j_min(xmaxI, xmaxJ);
-        const T intersectionY = intersectionYmax - intersectionYmin;
-        const T intersectionX = intersectionXmax - intersectionXmin;
-        const T intersectionArea = math::nd4j_max(intersectionY, zero) *  math::nd4j_max(intersectionX, zero);
-        return intersectionArea / (areaI + areaJ - intersectionArea);
+    static BoxesSoA<T> boxesToSoA(NDArray* boxes) {
+        return BoxesSoA<T>(boxes->bufferAsT<T>(), boxes->sizeAt(0), boxes->strideAt(0), boxes->strideAt(1));
     }
 
+    // indices with score above threshold, sorted by score in descending order, ties are resolved by lower index.
+    // PLEASE NOTE: non_max_suppression (V2) used to pick among equal scores in unspecified order, now lower index always wins
     template <typename T>
-    static inline T similiratyOverlaps_(NDArray const& boxes, Nd4jLong i, Nd4jLong j) {
-        return boxes.t<T>(i, j);
+    static void sortCandidates(const T* scores, Nd4jLong scoreStride, std::vector<Nd4jLong>& candidates) {
+        std::sort(candidates.begin(), candidates.end(), [scores, scoreStride](Nd4jLong i, Nd4jLong j) {
+            const T si = scores[i * scoreStride], sj = scores[j * scoreStride];
+            return si > sj || (si == sj && i < j);
+        });
     }
 
-    typedef NDArray (*SimiliratyFunc)(NDArray const& boxes, Nd4jLong i, Nd4jLong j);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    static void nonMaxSuppressionV2_(NDArray* boxes, NDArray* scales, int maxSize, double overlapThreshold,
+            double scoreThreshold, NDArray* output) {
+        std::vector<T> scores(scales->lengthOf());
+        std::vector<Nd4jLong> candidates;
+        candidates.reserve(scores.size());
+
+        for (Nd4jLong e = 0; e < scales->lengthOf(); e++) {
+            scores[e] = scales->e<T>(e);
+            if (!(scales->e<float>(e) < (float)scoreThreshold))
+                candidates.emplace_back(e);
+        }
+
+        sortCandidates(scores.data(), 1, candidates);
 
-    static NDArray similiratyOverlaps(NDArray const& boxes, Nd4jLong i, Nd4jLong j) {
-        NDArray res(boxes.dataType(), boxes.getContext()); // = NDArrayFactory::create(0.);
-        BUILD_SINGLE_SELECTOR(boxes.dataType(), res = similiratyOverlaps_, (boxes, i, j) , FLOAT_TYPES);
-        return res;
-    }
+        auto soa = boxesToSoA<T>(boxes);
+        const Nd4jLong outputSize = output->lengthOf();
+        SelectedBoxes<T> selected(outputSize);
+
+        for (auto candidate : candidates) {
+            if (static_cast<Nd4jLong>(selected.size()) >= outputSize)
+                break;
 
-    static NDArray similiratyV3(NDArray const& boxes, Nd4jLong i, Nd4jLong j) {
-        NDArray res(boxes.dataType(), boxes.getContext()); // = NDArrayFactory::create(0.);
-        BUILD_SINGLE_SELECTOR(boxes.dataType(), res = similirityV3_, (boxes, i, j) , FLOAT_TYPES);
-        return res;
+            if (!selected.template overlaps<false>(soa, candidate, 0, overlapThreshold)) {
+                output->p(selected.size(), candidate);
+                selected.push(soa, candidate);
+            }
+        }
     }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-    template <typename T, typename I>
-    static Nd4jLong
-    nonMaxSuppressionGeneric_(nd4j::LaunchContext* context, NDArray* boxes, NDArray* scores, int outputSize,
-            float overlapThreshold, float scoreThreshold, NDArray* output,  SimiliratyFunc f) {
+    // IoU between candidate and selected boxes
+    template <typename T>
+    class SimilarityIoU {
+    private:
+        BoxesSoA<T> _boxes;
+        SelectedBoxes<T> _selected;
+
+    public:
+        SimilarityIoU(NDArray* boxes, size_t capacity) : _boxes(boxesToSoA<T>(boxes)), _selected(capacity) { }
+
+        bool suppress(Nd4jLong boxIndex, size_t begin, float threshold) const {
+            return _selected.template overlaps<true>(_boxes, boxIndex, begin, threshold);
+        }
+
+        void select(Nd4jLong boxIndex) {
+            _selected.push(_boxes, boxIndex);
+        }
+    };
+
+    // precomputed overlaps matrix
+    template <typename T>
+    class SimilarityOverlaps {
+    private:
+        const T* _overlaps;
+        Nd4jLong _rowStride, _colStride;
+        std::vector<Nd4jLong> _selected;
+
+    public:
+        SimilarityOverlaps(NDArray* overlaps, size_t capacity) : _overlaps(overlaps->bufferAsT<T>()), _rowStride(overlaps->strideAt(0)), _colStride(overlaps->strideAt(1)) {
+            _selected.reserve(capacity);
+        }
+
+        bool suppress(Nd4jLong boxIndex, size_t begin, float threshold) const {
+            const T* row = _overlaps + boxIndex * _rowStride;
+            for (size_t j = _selected.size(); j > begin; j--)
+                if (static_cast<float>(row[_selected[j - 1] * _colStride]) >= threshold)
+                    return true;
+
+            return false;
+        }
+
+        void select(Nd4jLong boxIndex) {
+            _selected.push_back(boxIndex);
+        }
+    };
 
-        auto numBoxes = boxes->sizeAt(0);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T, typename I, typename S>
+    static Nd4jLong
+    nonMaxSuppressionGeneric_(NDArray* scores, int outputSize, float overlapThreshold, float scoreThreshold, NDArray* output, S& similarity) {
         T* scoresData = scores->dataBuffer()->primaryAsT<T>();
 
         // Data structure for a selection candidate in NMS.
@@ -158,68 +230,36 @@ namespace helpers {
                     (bsI._score < bsJ._score);
         };
 
-        std::priority_queue<Candidate, std::deque<Candidate>, decltype(cmp)> candidatePriorityQueue(cmp);
+        std::vector<Candidate> candidates;
         for (auto i = 0; i < scores->lengthOf(); ++i) {
             if ((float)scoresData[i] > (float)scoreThreshold) {
-                candidatePriorityQueue.emplace(Candidate({i, scoresData[i], 0}));
+                candidates.emplace_back(Candidate({i, scoresData[i], 0}));
             }
         }
 
+        std::priority_queue<Candidate, std::vector<Candidate>, decltype(cmp)> candidatePriorityQueue(cmp, std::move(candidates));
+
         std::vector<I> selected;
-        T similarity, originalScore;
         Candidate nextCandidate;
 
         while (selected.size() < outputSize && !candidatePriorityQueue.empty()) {
             nextCandidate = candidatePriorityQueue.top();
-            originalScore = nextCandidate._score;
             candidatePriorityQueue.pop();
 
-            // Overlapping boxes are likely to have similar scores, therefore we
-            // iterate through the previously selected boxes backwards in order to
-            // see if `nextCandidate` should be suppressed. We also enforce a property
-            // that a candidate can be suppressed by another candidate no more than
-            // once via `suppress_begin_index` which tracks which previously selected
-            // boxes have already been compared against next_candidate prior to a given
-            // iteration.  These previous selected boxes are then skipped over in the
-            // following loop.
-            bool shouldHardSuppress = false;
-            for (int j = static_cast<int>(selected.size()) - 1; j >= nextCandidate._suppressBeginIndex; --j) {
-                auto similarityA = f(*boxes, nextCandidate._boxIndex, selected[j]); //boxes->t<T>(nextCandidate._boxIndex, selected[j]);
-                similarity = similarityA.template t<T>(0);
-                nextCandidate._score *= T(similarity <= overlapThreshold?1.0:0.); //suppressWeightFunc(similarity);
-
-                // First decide whether to perform hard suppression
-                if ((float)similarity >= static_cast<float>(overlapThreshold)) {
-                    shouldHardSuppress = true;
-                    break;
-                }
+            // A candidate can be suppressed by another candidate no more than once: `_suppressBeginIndex`
+            // tracks which previously selected boxes have already been compared against it, so they
+            // are skipped here. Suppression is hard, so the score of survived candidate never changes.
+            const bool shouldHardSuppress = similarity.suppress(nextCandidate._boxIndex, nextCandidate._suppressBeginIndex, overlapThreshold);
 
-                // If next_candidate survives hard suppression, apply soft suppression
-                if ((float)nextCandidate._score <= (float)scoreThreshold) break;
-            }
-            // If `nextCandidate._score` has not dropped below `scoreThreshold`
-            // by this point, then we know that we went through all of the previous
-            // selections and can safely update `suppress_begin_index` to
-            // `selected.size()`. If on the other hand `next_candidate.score`
-            // *has* dropped below the score threshold, then since `suppressWeight`
-            // always returns values in [0, 1], further suppression by items that were
-            // not covered in the above for loop would not have caused the algorithm
-            // to select this item. We thus do the same update to
-            // `suppressBeginIndex`, but really, this element will not be added back
-            // into the priority queue in the following.
             nextCandidate._suppressBeginIndex = selected.size();
 
             if (!shouldHardSuppress) {
-                if (nextCandidate._score == originalScore) {
-                    // Suppression has not occurred, so select next_candidate
-                    selected.push_back(nextCandidate._boxIndex);
-//                    selected_scores.push_back(nextCandidate._score);
-                }
-                if ((float)nextCandidate._score > (float)scoreThreshold) {
-                    // Soft suppression has occurred and current score is still greater than
-                    // score_threshold; add next_candidate back onto priority queue.
-                    candidatePriorityQueue.push(nextCandidate);
-                }
+                // Suppression has not occurred, so select next_candidate
+                selected.push_back(nextCandidate._boxIndex);
+                similarity.select(nextCandidate._boxIndex);
+
+                // candidate goes back to the queue, and will be checked against itself and later selections
+                candidatePriorityQueue.push(nextCandidate);
             }
         }
 
@@ -231,22 +271,114 @@ namespace helpers {
         return (Nd4jLong)selected.size();
     }
 
+    template <typename T, typename I>
+    static Nd4jLong
+    nonMaxSuppressionGeneric_(nd4j::LaunchContext* context, NDArray* boxes, NDArray* scores, int outputSize,
+            float overlapThreshold, float scoreThreshold, NDArray* output, bool precomputedOverlaps) {
+        if (precomputedOverlaps) {
+            SimilarityOverlaps<T> similarity(boxes, outputSize);
+            return nonMaxSuppressionGeneric_<T, I>(scores, outputSize, overlapThreshold, scoreThreshold, output, similarity);
+        }
+
+        SimilarityIoU<T> similarity(boxes, outputSize);
+        return nonMaxSuppressionGeneric_<T, I>(scores, outputSize, overlapThreshold, scoreThreshold, output, similarity);
+    }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    template <typename T, typename I>
+    static Nd4jLong
+    nonMaxSuppressionBatched_(NDArray* boxes, NDArray* scores, int maxSize, double overlapThreshold, double scoreThreshold, NDArray* output) {
+        const Nd4jLong batchSize = boxes->sizeAt(0);
+        const Nd4jLong numBoxes = boxes->sizeAt(1);
+        const Nd4jLong numClasses = scores->sizeAt(2);
+        const Nd4jLong numTasks = batchSize * numClasses;
+
+        const T* boxesData = boxes->bufferAsT<T>();
+        const T* scoresData = scores->bufferAsT<T>();
+              I* outputData = output->bufferAsT<I>();
+
+        // boxes are shared by all classes of the same image
+        std::vector<std::unique_ptr<BoxesSoA<T>>> images(batchSize);
+        auto buildBoxes = PRAGMA_THREADS_FOR {
+            for (auto b = start; b < stop; b += increment)
+                images[b].reset(new BoxesSoA<T>(boxesData + b * boxes->strideAt(0), numBoxes, boxes->strideAt(1), boxes->strideAt(2)));
+        };
+        samediff::Threads::parallel_tad(buildBoxes, 0, batchSize);
+
+        std::vector<Nd4jLong> counts(numTasks);
+        auto func = PRAGMA_THREADS_FOR {
+            std::vector<Nd4jLong> candidates;
+            candidates.reserve(numBoxes);
+
+            for (auto t = start; t < stop; t += increment) {
+                const auto b = t / numClasses;
+                const auto c = t % numClasses;
+                const T* classScores = scoresData + b * scores->strideAt(0) + c * scores->strideAt(2);
+                const Nd4jLong scoreStride = scores->strideAt(1);
+                I* z = outputData + b * output->strideAt(0) + c * output->strideAt(1);
+                const Nd4jLong zStride = output->strideAt(2);
+
+                candidates.clear();
+                for (Nd4jLong i = 0; i < numBoxes; i++)
+                    if ((float) classScores[i * scoreStride] > (float) scoreThreshold)
+                        candidates.emplace_back(i);
+
+                sortCandidates(classScores, scoreStride, candidates);
+
+                SelectedBoxes<T> selected(maxSize);
+                for (auto candidate : candidates) {
+                    if (static_cast<Nd4jLong>(selected.size()) >= maxSize)
+                        break;
+
+                    if (!selected.template overlaps<true>(*images[b], candidate, 0, overlapThreshold)) {
+                        z[selected.size() * zStride] = static_cast<I>(candidate);
+                        selected.push(*images[b], candidate);
+                    }
+                }
+
+                counts[t] = selected.size();
+                for (Nd4jLong e = counts[t]; e < maxSize; e++)
+                    z[e * zStride] = static_cast<I>(-1);
+            }
+        };
+        samediff::Threads::parallel_tad(func, 0, numTasks);
+
+        return std::accumulate(counts.begin(), counts.end(), (Nd4jLong) 0);
+    }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     Nd4jLong
     nonMaxSuppressionGeneric(nd4j::LaunchContext* context, NDArray* boxes, NDArray* scores, int maxSize,
                               double overlapThreshold, double scoreThreshold, NDArray* output) {
-        BUILD_DOUBLE_SELECTOR(boxes->dataType(), output == nullptr?DataType::INT32:output->dataType(), return nonMaxSuppressionGeneric_, (context, boxes, scores, maxSize, overlapThreshold, scoreThreshold, output, similiratyOverlaps), FLOAT_TYPES, INTEGER_TYPES);
+        BUILD_DOUBLE_SELECTOR(boxes->dataType(), output == nullptr?DataType::INT32:output->dataType(), return nonMaxSuppressionGeneric_, (context, boxes, scores, maxSize, overlapThreshold, scoreThreshold, output, true), FLOAT_TYPES, INTEGER_TYPES);
         return 0;
     }
 
     Nd4jLong
     nonMaxSuppressionV3(nd4j::LaunchContext* context, NDArray* boxes, NDArray* scores, int maxSize,
                              double overlapThreshold, double scoreThreshold, NDArray* output) {
-        BUILD_DOUBLE_SELECTOR(boxes->dataType(), output == nullptr?DataType::INT32:output->dataType(), return nonMaxSuppressionGeneric_, (context, boxes, scores, maxSize, overlapThreshold, scoreThreshold, output, similiratyV3), FLOAT_TYPES, INTEGER_TYPES);
+        BUILD_DOUBLE_SELECTOR(boxes->dataType(), output == nullptr?DataType::INT32:output->dataType(), return nonMaxSuppressionGeneric_, (context, boxes, scores, maxSize, overlapThreshold, scoreThreshold, output, false), FLOAT_TYPES, INTEGER_TYPES);
+        return 0;
+    }
+
+    Nd4jLong
+    nonMaxSuppressionBatched(nd4j::LaunchContext* context, NDArray* boxes, NDArray* scores, int maxSize,
+                             double overlapThreshold, double scoreThreshold, NDArray* output) {
+        if (boxes->rankOf() != 3 || boxes->sizeAt(2) != 4 || scores->rankOf() != 3 || scores->sizeAt(0) != boxes->sizeAt(0) || scores->sizeAt(1) != boxes->sizeAt(1))
+            throw std::runtime_error("ops::helpers::nonMaxSuppressionBatched: boxes should have [batch, boxes, 4] shape, and scores [batch, boxes, classes] shape");
+
+        // output is written through raw pointer, so its shape must match exactly
+        if (output->rankOf() != 3 || output->sizeAt(0) != boxes->sizeAt(0) || output->sizeAt(1) != scores->sizeAt(2) || output->sizeAt(2) != maxSize)
+            throw std::runtime_error("ops::helpers::nonMaxSuppressionBatched: output should have [batch, classes, maxSize] shape");
+
+        BUILD_DOUBLE_SELECTOR(boxes->dataType(), output->dataType(), return nonMaxSuppressionBatched_, (boxes, scores, maxSize, overlapThreshold, scoreThreshold, output), FLOAT_TYPES, INTEGER_TYPES);
         return 0;
     }
 
     BUILD_DOUBLE_TEMPLATE(template Nd4jLong nonMaxSuppressionGeneric_, (nd4j::LaunchContext* context, NDArray* boxes, NDArray* scores, int maxSize,
-            float overlapThreshold, float scoreThreshold, NDArray* output, SimiliratyFunc similiratyFunc), FLOAT_TYPES, INTEGER_TYPES);
+            float overlapThreshold, float scoreThreshold, NDArray* output, bool precomputedOverlaps), FLOAT_TYPES, INTEGER_TYPES);
+    BUILD_DOUBLE_TEMPLATE(template Nd4jLong nonMaxSuppressionBatched_, (NDArray* boxes, NDArray* scores, int maxSize,
+            double overlapThreshold, double scoreThreshold, NDArray* output), FLOAT_TYPES, INTEGER_TYPES);
 
     void
     nonMaxSuppression(nd4j::LaunchContext * context, NDArray* boxes, NDArray* scales, int maxSize,
@@ -21,94 +21,196 @@
 #include <ops/ops.h>
 #include <helpers/shape.h>
 #include <helpers/TAD.h>
+#include <ConstantTadHelper.h>
+#include <execution/Threads.h>
 #include <ops/declarable/helpers/prefix.h>
+#include <memory>
 
 namespace nd4j {
     namespace ops {
         namespace helpers {
-            template <typename T>
-            static void prefix_(scalar::Ops op, const void* vx, Nd4jLong* xShapeInfo, void* vz, Nd4jLong* zShapeInfo, bool exclusive, bool reverse) {
-                const auto x = reinterpret_cast<const T *>(vx);
-                      auto z = reinterpret_cast<T *>(vz);
-                auto length = shape::length(xShapeInfo);
+            // minimal number of elements per block for parallel scan of single sequence
+            static const Nd4jLong SCAN_MIN_BLOCK = 32768;
 
-                T prevSum = op == scalar::Add ? (T) 0 : (T) 1;
-                T sum = prevSum;
+            // index -> offset mappers, so the same scan kernels serve contiguous, strided and arbitrary layouts
+            struct StridedIndex {
+                Nd4jLong stride;
+                FORCEINLINE Nd4jLong operator()(const Nd4jLong e) const { return e * stride; }
+            };
 
-                if (reverse) {
-                    if (shape::elementWiseStride(xShapeInfo) == 1 && shape::elementWiseStride(zShapeInfo) == 1 &&
-                        shape::order(xShapeInfo) == 'c' && shape::order(zShapeInfo) == 'c') {
+            struct OffsetsIndex {
+                const Nd4jLong* offsets;
+                FORCEINLINE Nd4jLong operator()(const Nd4jLong e) const { return offsets[e]; }
+            };
+
+            struct ShapeIndex {
+                const Nd4jLong* shapeInfo;
+                FORCEINLINE Nd4jLong operator()(const Nd4jLong e) const { return shape::getIndexOffset(e, shapeInfo); }
+            };
 
-                        for (Nd4jLong e = length - 1; e >= 0; --e) {
-                            sum = op == scalar::Add ? simdOps::Add<T, T, T>::op(sum, x[e]) : simdOps::Multiply<T, T, T>::op(sum, x[e]);
-                            if (!exclusive)
-                                prevSum = sum;
+            /**
+             * Reduces [start, stop) range with OpType. Independent accumulators allow compiler to keep them in vector registers
+             */
+            template <typename T, typename OpType, typename XI>
+            static T reduceRange_(const T* x, const XI& xi, Nd4jLong start, Nd4jLong stop, T identity) {
+                T acc[8] = {identity, identity, identity, identity, identity, identity, identity, identity};
+
+                auto e = start;
+                for (; e + 8 <= stop; e += 8) {
+                    PRAGMA_OMP_SIMD
+                    for (int j = 0; j < 8; j++)
+                        acc[j] = OpType::op(acc[j], x[xi(e + j)]);
+                }
+
+                for (; e < stop; e++)
+                    acc[0] = OpType::op(acc[0], x[xi(e)]);
 
-                            z[e] = prevSum;
+                return OpType::op(OpType::op(OpType::op(acc[0], acc[1]), OpType::op(acc[2], acc[3])), OpType::op(OpType::op(acc[4], acc[5]), OpType::op(acc[6], acc[7])));
+            }
 
-                            prevSum = sum;
-                        }
+            /**
+             * Scans [start, stop) range starting from carry, in forward or reverse direction. Returns carry for the next range
+             */
+            template <typename T, typename OpType, typename XI, typename ZI>
+            static T scanRange_(const T* x, const XI& xi, T* z, const ZI& zi, Nd4jLong start, Nd4jLong stop, bool exclusive, bool reverse, T sum) {
+                if (reverse) {
+                    for (Nd4jLong e = stop - 1; e >= start; e--) {
+                        const T next = OpType::op(sum, x[xi(e)]);
+                        z[zi(e)] = exclusive ? sum : next;
+                        sum = next;
+                    }
+                } else {
+                    for (Nd4jLong e = start; e < stop; e++) {
+                        const T next = OpType::op(sum, x[xi(e)]);
+                        z[zi(e)] = exclusive ? sum : next;
+                        sum = next;
                     }
-                    else {
+                }
 
-                        for (Nd4jLong e = length - 1; e >= 0; --e) {
+                return sum;
+            }
 
-                            auto xOffset = shape::getIndexOffset(e, xShapeInfo);
-                            auto zOffset = shape::getIndexOffset(e, zShapeInfo);
-                            sum = op == scalar::Add ? simdOps::Add<T, T, T>::op(sum, x[xOffset]) : simdOps::Multiply<T, T, T>::op(sum, x[xOffset]);
+            /**
+             * Scans single sequence. Long sequences are split into blocks: block totals are reduced in parallel,
+             * scanned sequentially into per-block carries, and then every block is scanned in parallel from its carry
+             */
+            template <typename T, typename OpType, typename XI, typename ZI>
+            static void scanSequence_(const T* x, const XI& xi, T* z, const ZI& zi, Nd4jLong length, bool exclusive, bool reverse, T identity, int numThreads) {
+                if (numThreads <= 1 || length < 2 * SCAN_MIN_BLOCK) {
+                    scanRange_<T, OpType>(x, xi, z, zi, 0, length, exclusive, reverse, identity);
+                    return;
+                }
 
-                            if (!exclusive)
-                                prevSum = sum;
+                const Nd4jLong numBlocks = nd4j::math::nd4j_min<Nd4jLong>(numThreads, length / SCAN_MIN_BLOCK);
+                const Nd4jLong blockLen = (length + numBlocks - 1) / numBlocks;
 
-                            z[zOffset] = prevSum;
-                            prevSum = sum;
-                        }
-                    }
-                } else {
-                    if (shape::elementWiseStride(xShapeInfo) == 1 && shape::elementWiseStride(zShapeInfo) == 1 &&
-                        shape::order(xShapeInfo) == 'c' && shape::order(zShapeInfo) == 'c') {
+                std::unique_ptr<T[]> carries(new T[numBlocks]);
 
-                        for (int e = 0; e < length; e++) {
-                            sum = op == scalar::Add ? simdOps::Add<T, T, T>::op(sum, x[e]) : simdOps::Multiply<T, T, T>::op(sum, x[e]);
+                auto reduceBlocks = PRAGMA_THREADS_FOR {
+                    for (auto b = start; b < stop; b += increment)
+                        carries[b] = reduceRange_<T, OpType>(x, xi, b * blockLen, nd4j::math::nd4j_min<Nd4jLong>(length, (b + 1) * blockLen), identity);
+                };
+                samediff::Threads::parallel_tad(reduceBlocks, 0, numBlocks, 1, numThreads);
 
-                            if (!exclusive)
-                                prevSum = sum;
+                // exclusive scan of block totals, in scan direction
+                T carry = identity;
+                for (Nd4jLong i = 0; i < numBlocks; i++) {
+                    const auto b = reverse ? numBlocks - 1 - i : i;
+                    const T total = carries[b];
+                    carries[b] = carry;
+                    carry = OpType::op(carry, total);
+                }
 
-                            z[e] = prevSum;
+                auto scanBlocks = PRAGMA_THREADS_FOR {
+                    for (auto b = start; b < stop; b += increment)
+                        scanRange_<T, OpType>(x, xi, z, zi, b * blockLen, nd4j::math::nd4j_min<Nd4jLong>(length, (b + 1) * blockLen), exclusive, reverse, carries[b]);
+                };
+                samediff::Threads::parallel_tad(scanBlocks, 0, numBlocks, 1, numThreads);
+            }
 
-                            prevSum = sum;
-                        }
-                    }
-                    else {
+            template <typename T, typename OpType>
+            static void prefixOp_(const T* x, Nd4jLong* xShapeInfo, T* z, Nd4jLong* zShapeInfo, bool exclusive, bool reverse, T identity) {
+                const auto length = shape::length(xShapeInfo);
+                const auto numThreads = nd4j::Environment::getInstance()->maxMasterThreads();
+                const auto xEws = shape::elementWiseStride(xShapeInfo);
+                const auto zEws = shape::elementWiseStride(zShapeInfo);
+
+                if (xEws >= 1 && zEws >= 1 && shape::order(xShapeInfo) == 'c' && shape::order(zShapeInfo) == 'c')
+                    scanSequence_<T, OpType>(x, StridedIndex{xEws}, z, StridedIndex{zEws}, length, exclusive, reverse, identity, numThreads);
+                else
+                    scanSequence_<T, OpType>(x, ShapeIndex{xShapeInfo}, z, ShapeIndex{zShapeInfo}, length, exclusive, reverse, identity, numThreads);
+            }
 
-                        for (int e = 0; e < length; e++) {
+            template <typename T, typename OpType, typename XI, typename ZI>
+            static void prefixTads_(const T* x, Nd4jLong* xTadOffsets, const XI& xi, T* z, Nd4jLong* zTadOffsets, const ZI& zi, Nd4jLong numTads, Nd4jLong tadLength, bool exclusive, bool reverse, T identity) {
+                const int numThreads = nd4j::Environment::getInstance()->maxMasterThreads();
 
-                            auto xOffset = shape::getIndexOffset(e, xShapeInfo);
-                            auto zOffset = shape::getIndexOffset(e, zShapeInfo);
-                            sum = op == scalar::Add ? simdOps::Add<T, T, T>::op(sum, x[xOffset]) : simdOps::Multiply<T, T, T>::op(sum, x[xOffset]);
+                // few long TADs: scan them one by one, each one in parallel
+                if (numTads < numThreads && tadLength >= 2 * SCAN_MIN_BLOCK) {
+                    for (Nd4jLong t = 0; t < numTads; t++)
+                        scanSequence_<T, OpType>(x + xTadOffsets[t], xi, z + zTadOffsets[t], zi, tadLength, exclusive, reverse, identity, numThreads);
 
-                            if (!exclusive)
-                                prevSum = sum;
+                    return;
+                }
 
-                            z[zOffset] = prevSum;
-                            prevSum = sum;
-                        }
-                    }
+                auto func = PRAGMA_THREADS_FOR {
+                    for (auto t = start; t < stop; t += increment)
+                        scanRange_<T, OpType>(x + xTadOffsets[t], xi, z + zTadOffsets[t], zi, 0, tadLength, exclusive, reverse, identity);
+                };
+
+                samediff::Threads::parallel_tad(func, 0, numTads, 1, numThreads);
+            }
+
+            template <typename T, typename OpType>
+            static void prefixOp_(const NDArray* x, NDArray* z, const std::vector<int>& dims, bool exclusive, bool reverse, T identity) {
+                std::vector<int> dimensions(dims);
+                for (auto &d : dimensions)
+                    if (d < 0)
+                        d += x->rankOf();
+
+                auto packX = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(x->getShapeInfo(), dimensions);
+                auto packZ = nd4j::ConstantTadHelper::getInstance()->tadForDimensions(z->getShapeInfo(), dimensions);
+
+                auto xTadShapeInfo = packX.primaryShapeInfo();
+                auto zTadShapeInfo = packZ.primaryShapeInfo();
+                const Nd4jLong numTads = packX.numberOfTads();
+                const Nd4jLong tadLength = shape::length(xTadShapeInfo);
+
+                const auto xBuffer = reinterpret_cast<const T*>(x->getBuffer());
+                      auto zBuffer = reinterpret_cast<T*>(z->buffer());
+
+                const auto xEws = shape::elementWiseStride(xTadShapeInfo);
+                const auto zEws = shape::elementWiseStride(zTadShapeInfo);
+
+                if (xEws >= 1 && zEws >= 1 && shape::order(xTadShapeInfo) == 'c' && shape::order(zTadShapeInfo) == 'c') {
+                    prefixTads_<T, OpType>(xBuffer, packX.primaryOffsets(), StridedIndex{xEws}, zBuffer, packZ.primaryOffsets(), StridedIndex{zEws}, numTads, tadLength, exclusive, reverse, identity);
+                } else {
+                    // all TADs share the same shape, so offsets within TAD are computed once
+                    std::vector<Nd4jLong> xOffsets(tadLength), zOffsets(tadLength);
+                    shape::calcOffsets(xTadShapeInfo, xOffsets.data());
+                    shape::calcOffsets(zTadShapeInfo, zOffsets.data());
+
+                    prefixTads_<T, OpType>(xBuffer, packX.primaryOffsets(), OffsetsIndex{xOffsets.data()}, zBuffer, packZ.primaryOffsets(), OffsetsIndex{zOffsets.data()}, numTads, tadLength, exclusive, reverse, identity);
                 }
-            };
+            }
 
             template <typename T>
-            static void prefix_(scalar::Ops op, const NDArray* x, NDArray* z, const std::vector<int>& dims, bool exclusive, bool reverse) {
-                auto xTads = x->allTensorsAlongDimension(dims);
-                auto zTads = z->allTensorsAlongDimension(dims);
-                auto t = xTads.size();
+            static void prefix_(scalar::Ops op, const void* vx, Nd4jLong* xShapeInfo, void* vz, Nd4jLong* zShapeInfo, bool exclusive, bool reverse) {
+                const auto x = reinterpret_cast<const T *>(vx);
+                      auto z = reinterpret_cast<T *>(vz);
 
-                for (int e = 0; e < t; e++) {
-                    auto tx = xTads.at(e);
-                    auto tz = zTads.at(e);
+                if (op == scalar::Add)
+                    prefixOp_<T, simdOps::Add<T, T, T>>(x, xShapeInfo, z, zShapeInfo, exclusive, reverse, (T) 0);
+                else
+                    prefixOp_<T, simdOps::Multiply<T, T, T>>(x, xShapeInfo, z, zShapeInfo, exclusive, reverse, (T) 1);
+            };
 
-                    prefix_<T>(op, tx->buffer(), tx->shapeInfo(), tz->buffer(), tz->shapeInfo(), exclusive, reverse);
-                }
+            template <typename T>
+            static void prefix_(scalar::Ops op, const NDArray* x, NDArray* z, const std::vector<int>& dims, bool exclusive, bool reverse) {
+                if (op == scalar::Add)
+                    prefixOp_<T, simdOps::Add<T, T, T>>(x, z, dims, exclusive, reverse, (T) 0);
+                else
+                    prefixOp_<T, simdOps::Multiply<T, T, T>>(x, z, dims, exclusive, reverse, (T) 1);
             };
 
             template <typename T>
@@ -22,6 +22,7 @@
 #include <ops/declarable/helpers/segment.h>
 #include <ShapeUtils.h>
 #include <execution/Threads.h>
+#include <ConstantTadHelper.h>
 #include <unordered_map>
 
 namespace nd4j {
@@ -345,228 +346,301 @@ namespace helpers {
         return true;
     }
 
-    template <typename T>
-    static void unsortedSegmentMaxFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-
-        // if input is a vector: (as if in doc sample)
-        //int idx = static_cast<int>((*indices)(0.));
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
-
-        if (input->isVector()) { // 1D case
-            T maxVal = DataTypeUtils::max<T>();
-            output->assign(-maxVal);
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                T val = input->e<T>(fi->second.at(0));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    val = nd4j::math::nd4j_max(val, input->e<T>(fi->second.at(idx)));
+    // rows of an array along dimension 0, elements within every row are visited in logical c order
+    class SegmentRows {
+    private:
+        std::vector<Nd4jLong> _rowOffsets;
+        std::vector<Nd4jLong> _elementOffsets;
+        const Nd4jLong *_offsets;
+        Nd4jLong _ews;
+
+    public:
+        Nd4jLong numRows;
+        Nd4jLong rowLength;
+
+        explicit SegmentRows(NDArray* array) {
+            numRows = array->sizeAt(0);
+            rowLength = numRows > 0 ? array->lengthOf() / numRows : 0;
+
+            if (array->rankOf() == 1) {
+                _rowOffsets.resize(numRows);
+                for (Nd4jLong r = 0; r < numRows; r++)
+                    _rowOffsets[r] = shape::getIndexOffset(r, array->getShapeInfo());
+
+                _offsets = _rowOffsets.data();
+                _ews = 1;
+            } else {
+                auto restDims = ShapeUtils::evalDimsToExclude(array->rankOf(), {0});
+                auto pack = ConstantTadHelper::getInstance()->tadForDimensions(array->getShapeInfo(), restDims);
+                auto tad = pack.primaryShapeInfo();
+
+                // packs are cached by helper, so offsets outlive this object
+                _offsets = pack.primaryOffsets();
+                _ews = shape::order(tad) == 'c' || shape::rank(tad) == 1 ? shape::elementWiseStride(tad) : 0;
+
+                if (_ews < 1) {
+                    _ews = 0;
+                    _elementOffsets.resize(rowLength);
+                    shape::calcOffsets(tad, _elementOffsets.data());
                 }
-                output->p(fi->first, val);
             }
         }
-        else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
 
-            ResultSet listOfTensors = input->allTensorsAlongDimension(restDims);
-            ResultSet listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            T maxVal = DataTypeUtils::max<T>();
-            output->assign(-maxVal);
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors.at(fi->first);
-                outputT->assign(listOfTensors.at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto maxT = listOfTensors.at(fi->second.at(idx));
-                    for (Nd4jLong e = 0; e < outputT->lengthOf(); ++e) {
-                        T val = nd4j::math::nd4j_max(maxT->e<T>(e), outputT->e<T>(e));
-
-                        outputT->p(e, val);
-                    }
-                }
-            }
+        FORCEINLINE Nd4jLong offset(const Nd4jLong row, const Nd4jLong element) const {
+            return _offsets[row] + (_ews > 0 ? element * _ews : _elementOffsets[element]);
         }
-    }
-    void unsortedSegmentMaxFunctor(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentMaxFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
-    }
-    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMaxFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
-
-    template <typename T>
-    static void unsortedSegmentMinFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        // if input is a vector: (as if in doc sample)
-        //int idx = static_cast<int>((*indices)(0.));
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
+    };
+
+    // rows grouped by segment id with counting sort: rows of segment s are rows[offsets[s]] ... rows[offsets[s + 1] - 1],
+    // in their original order. Buffers are taken from workspace of given context, if there's one
+    class SegmentGroups {
+    private:
+        NDArray _ids;
+        NDArray _offsets;
+        NDArray _rows;
+
+    public:
+        const Nd4jLong *ids;
+        const Nd4jLong *offsets;
+        const Nd4jLong *rows;
+        Nd4jLong numOfClasses;
+
+        SegmentGroups(NDArray* indices, Nd4jLong numOfClasses, nd4j::LaunchContext* context) :
+                _offsets('c', {numOfClasses + 1}, nd4j::DataType::INT64, context),
+                _rows('c', {nd4j::math::nd4j_max<Nd4jLong>(1, indices->lengthOf())}, nd4j::DataType::INT64, context) {
+            this->numOfClasses = numOfClasses;
+
+            if (indices->dataType() == nd4j::DataType::INT64 && indices->ews() == 1) {
+                ids = indices->bufferAsT<Nd4jLong>();
+            } else {
+                _ids = indices->cast(nd4j::DataType::INT64);
+                ids = _ids.bufferAsT<Nd4jLong>();
+            }
 
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
+            const auto numRows = indices->lengthOf();
+            auto pOffsets = _offsets.bufferAsT<Nd4jLong>();
+            auto pRows = _rows.bufferAsT<Nd4jLong>();
 
-        //std::sort(idxs.begin(), idxs.end());
+            // negative ids are dropped, same as out-of-range ones
+            std::fill(pOffsets, pOffsets + numOfClasses + 1, 0);
+            for (Nd4jLong e = 0; e < numRows; e++)
+                if (ids[e] >= 0 && ids[e] < numOfClasses)
+                    pOffsets[ids[e] + 1]++;
 
-        if (input->isVector()) { // 1D case
-            T maxVal = DataTypeUtils::max<T>();
-            output->assign(maxVal);
+            for (Nd4jLong s = 0; s < numOfClasses; s++)
+                pOffsets[s + 1] += pOffsets[s];
 
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                T val = input->t<T>(fi->second.at(0));
+            std::vector<Nd4jLong> cursors(pOffsets, pOffsets + numOfClasses);
+            for (Nd4jLong e = 0; e < numRows; e++)
+                if (ids[e] >= 0 && ids[e] < numOfClasses)
+                    pRows[cursors[ids[e]]++] = e;
 
-                for (size_t idx = 1; idx < fi->second.size(); ++idx) {
-                    val = nd4j::math::nd4j_min(val, input->t<T>(fi->second.at(idx)));
-                }
-                output->t<T>(fi->first) = val;
-            }
+            offsets = pOffsets;
+            rows = pRows;
         }
-        else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
 
-            ResultSet listOfTensors = input->allTensorsAlongDimension(restDims);
-            ResultSet listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            T maxVal = DataTypeUtils::max<T>();
-            output->assign(maxVal);
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors.at(fi->first);
-                outputT->assign(listOfTensors.at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto minT = listOfTensors.at(fi->second.at(idx));
-
-                    for (Nd4jLong e = 0; e < outputT->lengthOf(); ++e) {
-                        outputT->t<T>(e) = nd4j::math::nd4j_min(minT->t<T>(e), outputT->t<T>(e));
-                    }
-                }
-                //outputT->assign(maxT);
-            }
+        FORCEINLINE Nd4jLong count(const Nd4jLong segment) const {
+            return offsets[segment + 1] - offsets[segment];
         }
 
-    }
-    void unsortedSegmentMinFunctor(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentMinFunctor_, (input, indices, numOfClasses, output),
-                              NUMERIC_TYPES);
-    }
-
-    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMinFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
+        FORCEINLINE bool isValid(const Nd4jLong segment) const {
+            return segment >= 0 && segment < numOfClasses;
+        }
+    };
 
-    void unsortedSegmentMeanFunctor(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
+    template <typename T>
+    struct SegmentSum {
+        static FORCEINLINE T update(const T old, const T value) { return old + value; }
+    };
 
-        //std::sort(idxs.begin(), idxs.end());
+    template <typename T>
+    struct SegmentProd {
+        static FORCEINLINE T update(const T old, const T value) { return old * value; }
+    };
 
-        if (input->isVector()) { // 1D case
+    template <typename T>
+    struct SegmentMax {
+        static FORCEINLINE T update(const T old, const T value) { return nd4j::math::nd4j_max<T>(old, value); }
+    };
 
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                double sumValue = input->e<double>(fi->second.at(0));
-                int loop_size = fi->second.size();
+    template <typename T>
+    struct SegmentMin {
+        static FORCEINLINE T update(const T old, const T value) { return nd4j::math::nd4j_min<T>(old, value); }
+    };
+
+    // post-processing of reduced segments
+    enum SegmentNorm {
+        SEGMENT_NONE = 0,
+        SEGMENT_MEAN = 1,
+        SEGMENT_SQRT_N = 2
+    };
+
+    template <typename T, int Norm>
+    static FORCEINLINE T segmentNormalize(const T value, const Nd4jLong count) {
+        if (Norm == SEGMENT_MEAN)
+            return static_cast<T>(static_cast<double>(value) / static_cast<double>(count));
+
+        if (Norm == SEGMENT_SQRT_N)
+            return static_cast<T>(static_cast<double>(value) / nd4j::math::nd4j_sqrt<double, double>(static_cast<double>(count)));
+
+        return value;
+    }
 
-                // FIXME: parallelism here?
-                for (size_t idx = 1; idx < loop_size; ++idx) {
-                    sumValue += input->e<double>(fi->second.at(idx));
+    template <typename T, typename OpType, int Norm>
+    static void unsortedSegmentReduce_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output, const T empty) {
+        SegmentGroups groups(indices, numOfClasses, input->getContext());
+        SegmentRows in(input);
+        SegmentRows out(output);
+
+        const auto x = input->bufferAsT<T>();
+        auto z = output->bufferAsT<T>();
+        const auto rowLength = in.rowLength;
+        const auto numRows = in.numRows;
+        const int numThreads = nd4j::Environment::getInstance()->maxMasterThreads();
+
+        // few short segments over many rows: every thread reduces its span of rows into private accumulators
+        if (numOfClasses < numThreads && numOfClasses * rowLength * numThreads <= 1048576 && numRows >= 1024 * numThreads) {
+            const Nd4jLong span = numRows / numThreads;
+            std::vector<T> partials(numThreads * numOfClasses * rowLength);
+            std::vector<int8_t> seen(numThreads * numOfClasses, 0);
+
+            auto reduceRows = PRAGMA_THREADS_FOR {
+                for (auto c = start; c < stop; c += increment) {
+                    auto rowStart = c * span;
+                    auto rowStop = c == numThreads - 1 ? numRows : rowStart + span;
+
+                    for (auto r = rowStart; r < rowStop; r++) {
+                        auto s = groups.ids[r];
+                        if (!groups.isValid(s))
+                            continue;
+
+                        auto acc = partials.data() + (c * numOfClasses + s) * rowLength;
+                        if (seen[c * numOfClasses + s] == 0) {
+                            seen[c * numOfClasses + s] = 1;
+                            for (Nd4jLong j = 0; j < rowLength; j++)
+                                acc[j] = x[in.offset(r, j)];
+                        } else {
+                            for (Nd4jLong j = 0; j < rowLength; j++)
+                                acc[j] = OpType::update(acc[j], x[in.offset(r, j)]);
+                        }
+                    }
                 }
+            };
+            samediff::Threads::parallel_tad(reduceRows, 0, numThreads, 1, numThreads);
 
-                output->p(fi->first, sumValue / fi->second.size());
-            }
-        }
-        else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
+            auto mergePartials = PRAGMA_THREADS_FOR_2D {
+                for (auto s = start_x; s < stop_x; s += inc_x) {
+                    for (auto j = start_y; j < stop_y; j += inc_y) {
+                        T value = empty;
+                        bool first = true;
 
-            ResultSet listOfTensors = input->allTensorsAlongDimension(restDims);
-            ResultSet listOfOutTensors = output->allTensorsAlongDimension(restDims);
+                        for (int c = 0; c < numThreads; c++) {
+                            if (seen[c * numOfClasses + s] == 0)
+                                continue;
 
-            // FIXME: parallelism here?
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors.at(fi->first);
-                outputT->assign(listOfTensors.at(fi->second.at(0)));
-                Nd4jLong loopSize = fi->second.size();
+                            auto partial = partials[(c * numOfClasses + s) * rowLength + j];
+                            value = first ? partial : OpType::update(value, partial);
+                            first = false;
+                        }
 
-                for (Nd4jLong idx = 1; idx < loopSize; ++idx) {
-                    auto current = listOfTensors.at(fi->second.at(idx));
-                    *outputT += *current;
+                        z[out.offset(s, j)] = first ? empty : segmentNormalize<T, Norm>(value, groups.count(s));
+                    }
                 }
-                (*outputT) /= double(fi->second.size());
-            }
+            };
+            samediff::Threads::parallel_for(mergePartials, 0, numOfClasses, 1, 0, rowLength, 1);
+            return;
         }
-    }
 
-    void unsortedSegmentSumFunctor(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        if (input->isVector()) { // 1D case
+        // otherwise every tile of segments x columns is reduced independently, using rows grouped by segment
+        auto reduceSegments = PRAGMA_THREADS_FOR_2D {
+            for (auto s = start_x; s < stop_x; s += inc_x) {
+                const auto begin = groups.offsets[s];
+                const auto end = groups.offsets[s + 1];
 
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                double sumValue = input->e<double>(fi->second.at(0));
-                Nd4jLong loop_size = fi->second.size();
+                if (begin == end) {
+                    for (auto j = start_y; j < stop_y; j += inc_y)
+                        z[out.offset(s, j)] = empty;
 
-                // FIXME: parallelism here?
-                for (Nd4jLong idx = 1; idx < loop_size; ++idx) {
-                    sumValue += input->e<double>(fi->second.at(idx));
+                    continue;
                 }
-                output->p(fi->first, sumValue);
-            }
-        }
-        else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
 
-            ResultSet listOfTensors = input->allTensorsAlongDimension(restDims);
-            ResultSet listOfOutTensors = output->allTensorsAlongDimension(restDims);
+                auto r = groups.rows[begin];
+                for (auto j = start_y; j < stop_y; j += inc_y)
+                    z[out.offset(s, j)] = x[in.offset(r, j)];
 
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors.at(fi->first);
-                outputT->assign(listOfTensors.at(fi->second.at(0)));
-                Nd4jLong loop_size = fi->second.size();
-
-                // FIXME: parallelism here?
-                for (Nd4jLong idx = 1; idx < loop_size; ++idx) {
-                    auto current = listOfTensors.at(fi->second.at(idx));
-                    *(outputT) += *current;
+                for (auto k = begin + 1; k < end; k++) {
+                    r = groups.rows[k];
+                    for (auto j = start_y; j < stop_y; j += inc_y) {
+                        auto zOffset = out.offset(s, j);
+                        z[zOffset] = OpType::update(z[zOffset], x[in.offset(r, j)]);
+                    }
                 }
-                //outputT->assign(maxT);
+
+                if (Norm != SEGMENT_NONE)
+                    for (auto j = start_y; j < stop_y; j += inc_y) {
+                        auto zOffset = out.offset(s, j);
+                        z[zOffset] = segmentNormalize<T, Norm>(z[zOffset], end - begin);
+                    }
             }
+        };
+        samediff::Threads::parallel_for(reduceSegments, 0, numOfClasses, 1, 0, rowLength, 1);
+    }
+
+    // output might be of other type than input for sum-like ops, then reduction goes through temporary array
+    template <typename T, typename OpType, int Norm>
+    static void unsortedSegmentFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output, const T empty) {
+        if (output->dataType() == input->dataType()) {
+            unsortedSegmentReduce_<T, OpType, Norm>(input, indices, numOfClasses, output, empty);
+        } else {
+            NDArray temp(output->ordering(), output->getShapeAsVector(), input->dataType(), input->getContext());
+            unsortedSegmentReduce_<T, OpType, Norm>(input, indices, numOfClasses, &temp, empty);
+            output->assign(temp);
         }
     }
 
     template <typename T>
-    void unsortedSegmentProdFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
+    static void unsortedSegmentMaxFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        // empty segments are filled with lowest value
+        unsortedSegmentFunctor_<T, SegmentMax<T>, SEGMENT_NONE>(input, indices, numOfClasses, output, -DataTypeUtils::max<T>());
+    }
+    void unsortedSegmentMaxFunctor(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentMaxFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
+    }
+    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMaxFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
-        output->assign(1.f);
+    template <typename T>
+    static void unsortedSegmentMinFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        // empty segments are filled with highest value
+        unsortedSegmentFunctor_<T, SegmentMin<T>, SEGMENT_NONE>(input, indices, numOfClasses, output, DataTypeUtils::max<T>());
+    }
+    void unsortedSegmentMinFunctor(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentMinFunctor_, (input, indices, numOfClasses, output),
+                              NUMERIC_TYPES);
+    }
 
-        if (input->isVector()) { // 1D case
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                T prodValue = input->e<T>(fi->second.at(0));
-                for (size_t idx = 1; idx < fi->second.size(); ++idx) {
-                    prodValue *= input->e<T>(fi->second.at(idx));
-                }
-                output->p(fi->first, prodValue);
-            }
-        }
-        else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
+    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMinFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
-            ResultSet listOfTensors = input->allTensorsAlongDimension(restDims);
-            ResultSet listOfOutTensors = output->allTensorsAlongDimension(restDims);
+    template <typename T>
+    static void unsortedSegmentMeanFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        unsortedSegmentFunctor_<T, SegmentSum<T>, SEGMENT_MEAN>(input, indices, numOfClasses, output, static_cast<T>(0));
+    }
+    void unsortedSegmentMeanFunctor(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentMeanFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
+    }
+    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentMeanFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors.at(fi->first);
-                outputT->assign(listOfTensors.at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto current = listOfTensors.at(fi->second.at(idx));
+    template <typename T>
+    static void unsortedSegmentSumFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        unsortedSegmentFunctor_<T, SegmentSum<T>, SEGMENT_NONE>(input, indices, numOfClasses, output, static_cast<T>(0));
+    }
+    void unsortedSegmentSumFunctor(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentSumFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
+    }
+    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentSumFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
-                    *outputT *= *current;
-                }
-            }
-        }
+    template <typename T>
+    void unsortedSegmentProdFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        unsortedSegmentFunctor_<T, SegmentProd<T>, SEGMENT_NONE>(input, indices, numOfClasses, output, static_cast<T>(1));
     }
 
     void unsortedSegmentProdFunctor(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
@@ -574,40 +648,14 @@ namespace helpers {
     }
     BUILD_SINGLE_TEMPLATE(template void unsortedSegmentProdFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
+    template <typename T>
+    static void unsortedSegmentSqrtNFunctor_(NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
+        unsortedSegmentFunctor_<T, SegmentSum<T>, SEGMENT_SQRT_N>(input, indices, numOfClasses, output, static_cast<T>(0));
+    }
     void unsortedSegmentSqrtNFunctor(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, std::vector<Nd4jLong>> idxs;//(indices->lengthOf());
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e)
-            idxs[indices->e<Nd4jLong>(e)].push_back(e);
-
-        //std::sort(idxs.begin(), idxs.end());
-
-        if (input->isVector()) { // 1D case
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                double sumValue = input->e<double>(fi->second.at(0));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    sumValue += input->e<double>(fi->second.at(idx));
-                }
-                output->p(fi->first, sumValue / nd4j::math::nd4j_sqrt<Nd4jLong, double>(fi->second.size()));
-            }
-        }
-        else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
-
-            ResultSet listOfTensors = input->allTensorsAlongDimension(restDims);
-            ResultSet listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            for (auto fi = idxs.begin(); fi != idxs.end(); ++fi) {
-                auto outputT = listOfOutTensors.at(fi->first);
-                outputT->assign(listOfTensors.at(fi->second.at(0)));
-                for (Nd4jLong idx = 1; idx < fi->second.size(); ++idx) {
-                    auto current = listOfTensors.at(fi->second.at(idx));
-                    *outputT += *current;
-                }
-                //outputT->assign(maxT);
-                (*outputT) /= nd4j::math::nd4j_sqrt<size_t, double>(fi->second.size());
-            }
-        }
+        BUILD_SINGLE_SELECTOR(input->dataType(), unsortedSegmentSqrtNFunctor_, (input, indices, numOfClasses, output), NUMERIC_TYPES);
     }
+    BUILD_SINGLE_TEMPLATE(template void unsortedSegmentSqrtNFunctor_, (NDArray* input, NDArray* indices, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
     // -------------------------------------------------------------------------------------------------------------- //
     // Backpropagate ops helpers
@@ -838,39 +886,83 @@ namespace helpers {
     // Unsorted backpropagate segment ops
     // -------------------------------------------------------------------------------------------------------------- //
 
-    template <typename T>
-    static int unsortedSegmentMaxFunctorBP_(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-//        int numOfClasses = gradOut->sizeAt(0);
-        // if input is a vector: (as if in doc sample)
-        auto tempRes = gradOut->dup();
-        unsortedSegmentMaxFunctor(context, input, indices, numOfClasses, &tempRes);
-        if (input->isVector()) {
+    enum SegmentBP {
+        SEGMENT_BP_SUM = 0,
+        SEGMENT_BP_MEAN = 1,
+        SEGMENT_BP_SQRT_N = 2,
+        SEGMENT_BP_PROD = 3,
+        // gradient goes to elements equal to forward result, used by max and min
+        SEGMENT_BP_MATCH = 4
+    };
+
+    template <typename T, int Mode>
+    static void unsortedSegmentBP_(NDArray* input, NDArray* indices, NDArray* gradOut, NDArray* forward, Nd4jLong numOfClasses, NDArray* output, const double eps) {
+        // all arrays are read as T below
+        NDArray inputCast, gradCast, forwardCast;
+        if (input->dataType() != output->dataType()) {
+            inputCast = input->cast(output->dataType());
+            input = &inputCast;
+        }
 
-            for (Nd4jLong e = 0; e < input->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                if (nd4j::math::nd4j_abs(tempRes.e<double>(classNum) - input->e<double>(e)) < 1.e-5)
-                    output->p(e, gradOut->e<T>(classNum));
-            }
+        if (gradOut->dataType() != output->dataType()) {
+            gradCast = gradOut->cast(output->dataType());
+            gradOut = &gradCast;
         }
-        else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
 
-            ResultSet listOfBPTensors = tempRes.allTensorsAlongDimension(restDims);
-            ResultSet listOfGradOuts = gradOut->allTensorsAlongDimension(restDims);
-            ResultSet listOfTensors = input->allTensorsAlongDimension(restDims);
-            ResultSet listOfOutTensors = output->allTensorsAlongDimension(restDims);
+        if (forward != nullptr && forward->dataType() != output->dataType()) {
+            forwardCast = forward->cast(output->dataType());
+            forward = &forwardCast;
+        }
 
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors.at(i);
-                NDArray* currentOut = listOfOutTensors.at(i);
-                NDArray* currentGradOut = listOfGradOuts.at(classNum);
-                for (int e = 0; e < current->lengthOf(); e++) {
-                    if (nd4j::math::nd4j_abs(listOfBPTensors.at(classNum)->e<double>(e) - current->e<double>(e)) < 1.e-5)
-                        currentOut->p(e, currentGradOut->e<T>(e));
+        SegmentGroups groups(indices, numOfClasses, input->getContext());
+        SegmentRows in(input);
+        SegmentRows grad(gradOut);
+        SegmentRows out(output);
+        SegmentRows fwd(forward != nullptr ? forward : gradOut);
+
+        const auto x = input->bufferAsT<T>();
+        const auto g = gradOut->bufferAsT<T>();
+        const auto f = forward != nullptr ? forward->bufferAsT<T>() : nullptr;
+        auto z = output->bufferAsT<T>();
+
+        auto func = PRAGMA_THREADS_FOR_2D {
+            for (auto r = start_x; r < stop_x; r += inc_x) {
+                const auto s = groups.ids[r];
+                if (!groups.isValid(s))
+                    continue;
+
+                double divisor = 1.;
+                if (Mode == SEGMENT_BP_MEAN)
+                    divisor = static_cast<double>(groups.count(s));
+                else if (Mode == SEGMENT_BP_SQRT_N)
+                    divisor = nd4j::math::nd4j_sqrt<double, double>(static_cast<double>(groups.count(s)));
+
+                for (auto j = start_y; j < stop_y; j += inc_y) {
+                    const auto gradient = g[grad.offset(s, j)];
+
+                    if (Mode == SEGMENT_BP_SUM) {
+                        z[out.offset(r, j)] = gradient;
+                    } else if (Mode == SEGMENT_BP_MEAN || Mode == SEGMENT_BP_SQRT_N) {
+                        z[out.offset(r, j)] = static_cast<T>(static_cast<double>(gradient) / divisor);
+                    } else if (Mode == SEGMENT_BP_PROD) {
+                        z[out.offset(r, j)] = f[fwd.offset(s, j)] * gradient / x[in.offset(r, j)];
+                    } else {
+                        auto diff = static_cast<double>(f[fwd.offset(s, j)]) - static_cast<double>(x[in.offset(r, j)]);
+                        if (nd4j::math::nd4j_abs<double>(diff) < eps)
+                            z[out.offset(r, j)] = gradient;
+                    }
                 }
             }
-        }
+        };
+
+        samediff::Threads::parallel_for(func, 0, in.numRows, 1, 0, in.rowLength, 1);
+    }
+
+    template <typename T>
+    static int unsortedSegmentMaxFunctorBP_(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
+        auto tempRes = gradOut->dup();
+        unsortedSegmentMaxFunctor(context, input, indices, numOfClasses, &tempRes);
+        unsortedSegmentBP_<T, SEGMENT_BP_MATCH>(input, indices, gradOut, &tempRes, numOfClasses, output, 1.e-5);
 
         return ND4J_STATUS_OK;
     }
@@ -884,42 +976,7 @@ namespace helpers {
     static int unsortedSegmentMinFunctorBP_(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
         auto tempRes = gradOut->dup();
         unsortedSegmentMinFunctor(context, input, indices, numOfClasses, &tempRes);
-        if (input->isVector()) {
-
-            auto func = PRAGMA_THREADS_FOR {
-                for (auto e = start; e < stop; e++) {
-                    auto classNum = indices->e<Nd4jLong>(e);
-                    if (nd4j::math::nd4j_abs(tempRes.t<T>(classNum) - input->t<T>(e)) < 1.e-6)
-                        output->t<T>(e) = gradOut->t<T>(classNum);
-                }
-            };
-
-            samediff::Threads::parallel_for(func, 0, input->lengthOf());
-        }
-        else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
-
-            ResultSet listOfBPTensors = tempRes.allTensorsAlongDimension(restDims);
-            ResultSet listOfGradOuts = gradOut->allTensorsAlongDimension(restDims);
-            ResultSet listOfTensors = input->allTensorsAlongDimension(restDims);
-            ResultSet listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            //auto func = PRAGMA_THREADS_FOR {
-                for (auto i = 0; i < indices->lengthOf(); i++) {
-                    auto classNum = indices->e<Nd4jLong>(i);
-                    auto current = listOfTensors.at(i);
-                    auto currentOut = listOfOutTensors.at(i);
-                    auto currentGradOut = listOfGradOuts.at(classNum);
-
-                    for (int e = 0; e < current->lengthOf(); e++) {
-                        if (nd4j::math::nd4j_abs(listOfBPTensors.at(classNum)->t<T>(e) - current->t<T>(e)) < 1.e-6)
-                            currentOut->t<T>(e) = currentGradOut->t<T>(e);
-                    }
-                }
-            //};
-
-            //samediff::Threads::parallel_for(func, 0, indices->lengthOf());
-        }
+        unsortedSegmentBP_<T, SEGMENT_BP_MATCH>(input, indices, gradOut, &tempRes, numOfClasses, output, 1.e-6);
 
         return ND4J_STATUS_OK;
     }
@@ -929,162 +986,52 @@ namespace helpers {
     }
     BUILD_SINGLE_TEMPLATE(template int unsortedSegmentMinFunctorBP_, (nd4j::LaunchContext * context, NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
-    int unsortedSegmentMeanFunctorBP(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-
-        std::map<Nd4jLong, Nd4jLong> classCount;//(numClasses);
-
-        for (Nd4jLong count = 0; count < numOfClasses; ++count) {
-            classCount[count] = 0;
-        }
-
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-            classCount[indices->e<Nd4jLong>(e)]++;
-        }
-
-        // if input is a vector: (as if in doc sample)
-        if (input->isVector()) {
-            for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                output->p(e, gradOut->e<double>(classNum) / classCount[classNum]);
-            }
-        }
-        else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
-
-            ResultSet listOfGradOuts = gradOut->allTensorsAlongDimension(restDims);
-            ResultSet listOfTensors = input->allTensorsAlongDimension(restDims);
-            ResultSet listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            for (int i = 0; i < indices->lengthOf(); i++) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(i);
-                NDArray* current = listOfTensors.at(i);
-                NDArray* currentOut = listOfOutTensors.at(i);
-                NDArray* currentGradOut = listOfGradOuts.at(classNum);
-                currentOut->assign(*currentGradOut / double(classCount[classNum]));
-            }
-        }
+    template <typename T>
+    static int unsortedSegmentMeanFunctorBP_(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
+        unsortedSegmentBP_<T, SEGMENT_BP_MEAN>(input, indices, gradOut, nullptr, numOfClasses, output, 0.);
         return ND4J_STATUS_OK;
     }
 
-    int unsortedSegmentSumFunctorBP(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-
-        // if input is a vector: (as if in doc sample)
-        Nd4jLong idx = indices->e<Nd4jLong>(0);
-        if (input->isVector()) {
-            for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-                Nd4jLong classNum = indices->e<Nd4jLong>(e);
-                output->p(e, gradOut->e<double>(classNum));
-            }
-        }
-        else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
-
-            ResultSet listOfGradOuts = gradOut->allTensorsAlongDimension(restDims);
-            ResultSet listOfTensors = input->allTensorsAlongDimension(restDims);
-            ResultSet listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            //auto func = PRAGMA_THREADS_FOR {
-                for (auto i = 0; i < indices->lengthOf(); i++) {
-                    auto classNum = indices->e<Nd4jLong>(i);
-                    auto currentOut = listOfOutTensors.at(i);
-                    auto currentGradOut = listOfGradOuts.at(classNum);
-
-                    currentOut->assign(currentGradOut);
-                }
-            //};
+    int unsortedSegmentMeanFunctorBP(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
+        BUILD_SINGLE_SELECTOR(output->dataType(), return unsortedSegmentMeanFunctorBP_, (context, input, indices, gradOut, numOfClasses, output), NUMERIC_TYPES);
+    }
+    BUILD_SINGLE_TEMPLATE(template int unsortedSegmentMeanFunctorBP_, (nd4j::LaunchContext * context, NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
-            //samediff::Threads::parallel_for(func, 0, indices->lengthOf());
-        }
+    template <typename T>
+    static int unsortedSegmentSumFunctorBP_(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
+        unsortedSegmentBP_<T, SEGMENT_BP_SUM>(input, indices, gradOut, nullptr, numOfClasses, output, 0.);
         return Status::OK();
     }
 
-    int unsortedSegmentProdFunctorBP(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
+    int unsortedSegmentSumFunctorBP(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
+        BUILD_SINGLE_SELECTOR(output->dataType(), return unsortedSegmentSumFunctorBP_, (context, input, indices, gradOut, numOfClasses, output), NUMERIC_TYPES);
+    }
+    BUILD_SINGLE_TEMPLATE(template int unsortedSegmentSumFunctorBP_, (nd4j::LaunchContext * context, NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
+    template <typename T>
+    static int unsortedSegmentProdFunctorBP_(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
         auto tempRes = gradOut->dup();
         unsortedSegmentProdFunctor(context, input, indices, numOfClasses, &tempRes);
-        if (input->isVector()) {
-            auto func = PRAGMA_THREADS_FOR {
-                for (auto e = start; e < stop; e++) {
-                    auto classNum = indices->e<Nd4jLong>(e);
-                    output->p<double>(e, gradOut->e<double>(classNum) * tempRes.e<double>(classNum) / input->e<double>(e));
-                }
-            };
-
-            samediff::Threads::parallel_for(func, 0, indices->lengthOf());
-        }
-        else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
+        unsortedSegmentBP_<T, SEGMENT_BP_PROD>(input, indices, gradOut, &tempRes, numOfClasses, output, 0.);
 
-            ResultSet listOfBPTensors = tempRes.allTensorsAlongDimension(restDims);
-            ResultSet listOfGradOuts = gradOut->allTensorsAlongDimension(restDims);
-            ResultSet listOfTensors = input->allTensorsAlongDimension(restDims);
-            ResultSet listOfOutTensors = output->allTensorsAlongDimension(restDims);
-
-            //auto func = PRAGMA_THREADS_FOR {
-                for (auto i = 0; i < indices->lengthOf(); i++) {
-                    auto classNum = indices->e<Nd4jLong>(i);
-                    auto current = listOfTensors.at(i);
-                    auto currentOut = listOfOutTensors.at(i);
-                    auto currentGradOut = listOfGradOuts.at(classNum);
-                    auto currentFFOut = listOfBPTensors.at(classNum);
-
-                    currentOut->assign((*currentFFOut) * (*currentGradOut) / (*current));
-                }
-            //};
+        return Status::OK();
+    }
 
-            //samediff::Threads::parallel_for(func, 0, indices->lengthOf());
-        }
+    int unsortedSegmentProdFunctorBP(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
+        BUILD_SINGLE_SELECTOR(output->dataType(), return unsortedSegmentProdFunctorBP_, (context, input, indices, gradOut, numOfClasses, output), NUMERIC_TYPES);
+    }
+    BUILD_SINGLE_TEMPLATE(template int unsortedSegmentProdFunctorBP_, (nd4j::LaunchContext * context, NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
+    template <typename T>
+    static int unsortedSegmentSqrtNFunctorBP_(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
+        unsortedSegmentBP_<T, SEGMENT_BP_SQRT_N>(input, indices, gradOut, nullptr, numOfClasses, output, 0.);
         return Status::OK();
     }
 
-//    template <typename T>
     int unsortedSegmentSqrtNFunctorBP(nd4j::LaunchContext * context, NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output) {
-        std::map<Nd4jLong, Nd4jLong> classCount;//(numClasses);
-
-        for (Nd4jLong count = 0; count < numOfClasses; ++count) {
-            classCount[count] = 0;
-        }
-
-        for (Nd4jLong e = 0; e < indices->lengthOf(); ++e) {
-            classCount[indices->e<Nd4jLong>(e)]++;
-        }
-
-        // if input is a vector: (as if in doc sample)
-        if (input->isVector()) {
-            //auto func = PRAGMA_THREADS_FOR {
-                for (auto e = 0; e < indices->lengthOf(); e++) {
-                    auto classNum = indices->e<Nd4jLong>(e);
-                    output->p(e, gradOut->e<double>(classNum) / nd4j::math::nd4j_sqrt<double, double>(classCount[classNum]));
-                }
-            //};
-
-            //samediff::Threads::parallel_for(func, 0, indices->lengthOf());
-        }
-        else {
-            auto restDims = ShapeUtils::evalDimsToExclude(input->rankOf(), {0});
-
-            ResultSet listOfGradOuts  =gradOut->allTensorsAlongDimension(restDims);
-            ResultSet listOfTensors  =input->allTensorsAlongDimension(restDims);
-            ResultSet listOfOutTensors  =output->allTensorsAlongDimension(restDims);
-
-            //auto func = PRAGMA_THREADS_FOR {
-                for (auto i = 0; i < indices->lengthOf(); i++) {
-                    auto classNum = indices->e<Nd4jLong>(i);
-                    auto current = listOfTensors.at(i);
-                    auto currentOut = listOfOutTensors.at(i);
-                    auto currentGradOut = listOfGradOuts.at(classNum);
-
-                    for (int e = 0; e < current->lengthOf(); e++) {
-                        currentOut->p<double>(e, currentGradOut->e<double>(e) / nd4j::math::nd4j_sqrt<double, double>(classCount[classNum]));
-                    }
-                }
-            //};
-
-            //samediff::Threads::parallel_for(func, 0, indices->lengthOf());
-        }
-        return Status::OK();
+        BUILD_SINGLE_SELECTOR(output->dataType(), return unsortedSegmentSqrtNFunctorBP_, (context, input, indices, gradOut, numOfClasses, output), NUMERIC_TYPES);
     }
+    BUILD_SINGLE_TEMPLATE(template int unsortedSegmentSqrtNFunctorBP_, (nd4j::LaunchContext * context, NDArray* input, NDArray* indices, NDArray* gradOut, Nd4jLong numOfClasses, NDArray* output), NUMERIC_TYPES);
 
 }
 }
@@ -21,6 +21,7 @@
 #include <ops/declarable/helpers/sg_cb.h>
 #include <specials.h>
 #include <execution/Threads.h>
+#include <memory/WorkspaceArena.h>
 
 #define HS_MAX_EXP 6.0f
 
@@ -361,11 +362,16 @@ namespace nd4j {
                     auto bIndices = indices.bufferAsT<int>();
                     auto bCodes = codes.bufferAsT<int8_t>();
 
+                    auto workspace = s0.getContext()->getWorkspace();
+
                     auto func = PRAGMA_THREADS_FOR {
                         T sneu1e[600];
 
+                        // long vectors get scratch from per-thread arena, once per chunk
+                        nd4j::memory::WorkspaceArena arena(workspace, 2 * vectorLength * sizeof(T));
+                        T *neu1e = vectorLength <= 600 ? sneu1e : reinterpret_cast<T*>(arena.allocateBytes(vectorLength * sizeof(T)));
+
                         for (auto t = start; t < stop; t++) {
-                            T *neu1e = vectorLength <= 600 ? sneu1e : new T[vectorLength];
                             memset(neu1e, 0, vectorLength * sizeof(T));
 
                             auto target = bTarget[t];
@@ -418,10 +424,6 @@ namespace nd4j {
 
                             for (int e = 0; e < vectorLength; e++)
                                 syn0row[e] += neu1e[e];
-
-                            // optionally release temp arrays
-                            if (vectorLength > 600)
-                                delete[] neu1e;
                         }
                     };
 
@@ -453,14 +455,18 @@ namespace nd4j {
                 const auto bStarters = negStarters.bufferAsT<int>();
                 const auto numIndices = indices.isEmpty() ? 0 : indices.sizeAt(1);
 
+                auto workspace = s0.getContext()->getWorkspace();
+
                 auto func = PRAGMA_THREADS_FOR {
                     T sneu1[600];
                     T sneu1e[600];
 
-                    for (int e = start; e < stop; e++) {
-                        T *neu1 = vectorLength <= 600 ? sneu1 : new T[vectorLength];
-                        T *neu1e = vectorLength <= 600 ? sneu1e : new T[vectorLength];
+                    // long vectors get scratch from per-thread arena, once per chunk, and it's released even if we throw
+                    nd4j::memory::WorkspaceArena arena(workspace, 4 * vectorLength * sizeof(T));
+                    T *neu1 = vectorLength <= 600 ? sneu1 : reinterpret_cast<T*>(arena.allocateBytes(vectorLength * sizeof(T)));
+                    T *neu1e = vectorLength <= 600 ? sneu1e : reinterpret_cast<T*>(arena.allocateBytes(vectorLength * sizeof(T)));
 
+                    for (int e = start; e < stop; e++) {
                         // optionally we nullify temp arrays after successful (and on first) cycle
                         memset(neu1, 0, sizeof(T) * vectorLength);
                         memset(neu1e, 0, sizeof(T) * vectorLength);
@@ -568,12 +574,6 @@ namespace nd4j {
                                 syn0word[i] += neu1e[i];
 
                         }
-
-                        // optionally release temp arrays
-                        if (vectorLength > 600) {
-                            delete[] neu1;
-                            delete[] neu1e;
-                        }
                     }
                 };
 
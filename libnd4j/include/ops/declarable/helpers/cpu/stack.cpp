@@ -22,6 +22,8 @@
 #include <helpers/ShapeUtils.h>
 #include <array/ResultSet.h>
 #include <execution/Threads.h>
+#include <ops/specials.h>
+#include <algorithm>
 
 
 namespace nd4j {
@@ -43,7 +45,7 @@ static void stack_(const std::vector<const NDArray*>& inArrs, NDArray* outArr, c
 
         samediff::Threads::parallel_for(func, 0, inSize);
 	}
-	else {
+	else if (!std::all_of(inArrs.begin(), inArrs.end(), [outArr](const NDArray* arr) { return arr->dataType() == outArr->dataType(); })) {
 
 		std::vector<int> dimsToExclude = ShapeUtils::evalDimsToExclude(outArr->rankOf(), {dim});
 		auto list = outArr->allTensorsAlongDimension(dimsToExclude);		// list.size() == block.width()
@@ -55,6 +57,38 @@ static void stack_(const std::vector<const NDArray*>& inArrs, NDArray* outArr, c
         };
         samediff::Threads::parallel_tad(func, 0, listSize);
 	}
+	else {
+        // stack is concatenation of inputs with unit dimension inserted at dim, concat engine needs only shapes and strides
+        const int rank = inArrs[0]->rankOf();
+        const int infoLength = shape::shapeInfoLength(rank + 1);
+
+        std::vector<Nd4jLong> infos(infoLength * inArrs.size(), 0);
+        std::vector<const Nd4jLong*> inShapeInfos(inArrs.size());
+        std::vector<const void*> inBuffers(inArrs.size());
+
+        for (uint i = 0; i < inArrs.size(); ++i) {
+            Nd4jLong* info = infos.data() + i * infoLength;
+            info[0] = rank + 1;
+
+            for (int d = 0, src = 0; d <= rank; ++d) {
+                if (d == dim) {
+                    info[1 + d] = 1;
+                    info[2 + rank + d] = 1;
+                }
+                else {
+                    info[1 + d] = inArrs[i]->sizeAt(src);
+                    info[2 + rank + d] = inArrs[i]->strideAt(src);
+                    ++src;
+                }
+            }
+            info[infoLength - 1] = inArrs[i]->ordering();
+
+            inShapeInfos[i] = info;
+            inBuffers[i] = inArrs[i]->getBuffer();
+        }
+
+        nd4j::SpecialMethods<T>::concatCpuGeneric(inBuffers, inShapeInfos, outArr->getBuffer(), outArr->getShapeInfo(), dim);
+	}
 }
 
 	void stack(nd4j::LaunchContext * context, const std::vector<const NDArray*>& inArrs, NDArray* outArr, const int dim) {
@@ -22,6 +22,7 @@
 #include <NDArrayFactory.h>
 #include <helpers/jacobiSVD.h>
 #include <helpers/biDiagonalUp.h>
+#include <execution/Threads.h>
 
 namespace nd4j {
 namespace ops {
@@ -953,18 +954,20 @@ static void svd_(const NDArray* x, const std::vector<NDArray*>& outArrs, const b
         listV = new ResultSet(v->allTensorsAlongDimension({rank-2, rank-1}));
     }
 
-    for(int i = 0; i < listX.size(); ++i) {
+    // matrices of batch are independent, so they are decomposed in parallel
+    auto func = PRAGMA_THREADS_FOR {
+        for (auto i = start; i < stop; i += increment) {
+            helpers::SVD<T> svdObj(*(listX.at(i)), switchNum, calcUV, calcUV, fullUV);
+            listS.at(i)->assign(svdObj._s);
 
-        // NDArray<T> matrix(x->ordering(), {listX.at(i)->sizeAt(0), listX.at(i)->sizeAt(1)}, block.getContext());
-        // matrix.assign(listX.at(i));
-        helpers::SVD<T> svdObj(*(listX.at(i)), switchNum, calcUV, calcUV, fullUV);
-        listS.at(i)->assign(svdObj._s);
-
-        if(calcUV) {
-            listU->at(i)->assign(svdObj._u);
-            listV->at(i)->assign(svdObj._v);
+            if(calcUV) {
+                listU->at(i)->assign(svdObj._u);
+                listV->at(i)->assign(svdObj._v);
+            }
         }
-    }
+    };
+
+    samediff::Threads::parallel_tad(func, 0, listX.size());
 
     if(calcUV) {
         delete listU;
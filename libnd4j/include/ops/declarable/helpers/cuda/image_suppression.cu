@@ -23,6 +23,8 @@
 #include <NativeOps.h>
 #include <cuda_exception.h>
 #include <queue>
+#include <algorithm>
+#include <vector>
 
 namespace nd4j {
 namespace ops {
@@ -409,6 +411,102 @@ namespace helpers {
         return boxes->sizeAt(0);
     }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    // greedy selection is sequential per class, so batched NMS is done on host side
+    template <typename T, typename I>
+    static Nd4jLong nonMaxSuppressionBatched_(NDArray* boxes, NDArray* scores, int maxSize, double overlapThreshold, double scoreThreshold, NDArray* output) {
+        NDArray::preparePrimaryUse({output}, {boxes, scores});
+
+        const Nd4jLong batchSize = boxes->sizeAt(0);
+        const Nd4jLong numBoxes = boxes->sizeAt(1);
+        const Nd4jLong numClasses = scores->sizeAt(2);
+        const T* boxesData = boxes->bufferAsT<T>();
+        const T* scoresData = scores->bufferAsT<T>();
+              I* outputData = output->bufferAsT<I>();
+
+        auto coord = [&](Nd4jLong b, Nd4jLong i, int j) -> T {
+            return boxesData[b * boxes->strideAt(0) + i * boxes->strideAt(1) + j * boxes->strideAt(2)];
+        };
+
+        auto iou = [&](Nd4jLong b, Nd4jLong i, Nd4jLong j) -> float {
+            const float yminI = math::nd4j_min<float>(coord(b, i, 0), coord(b, i, 2)), ymaxI = math::nd4j_max<float>(coord(b, i, 0), coord(b, i, 2));
+            const float xminI = math::nd4j_min<float>(coord(b, i, 1), coord(b, i, 3)), xmaxI = math::nd4j_max<float>(coord(b, i, 1), coord(b, i, 3));
+            const float yminJ = math::nd4j_min<float>(coord(b, j, 0), coord(b, j, 2)), ymaxJ = math::nd4j_max<float>(coord(b, j, 0), coord(b, j, 2));
+            const float xminJ = math::nd4j_min<float>(coord(b, j, 1), coord(b, j, 3)), xmaxJ = math::nd4j_max<float>(coord(b, j, 1), coord(b, j, 3));
+            const float areaI = (ymaxI - yminI) * (xmaxI - xminI);
+            const float areaJ = (ymaxJ - yminJ) * (xmaxJ - xminJ);
+            if (areaI <= 0.f || areaJ <= 0.f)
+                return 0.f;
+
+            const float intersection = math::nd4j_max<float>(math::nd4j_min<float>(ymaxI, ymaxJ) - math::nd4j_max<float>(yminI, yminJ), 0.f) *
+                                       math::nd4j_max<float>(math::nd4j_min<float>(xmaxI, xmaxJ) - math::nd4j_max<float>(xminI, xminJ), 0.f);
+            return intersection / (areaI + areaJ - intersection);
+        };
+
+        Nd4jLong total = 0;
+        std::vector<Nd4jLong> candidates, selected;
+        for (Nd4jLong b = 0; b < batchSize; b++) {
+            for (Nd4jLong c = 0; c < numClasses; c++) {
+                const T* classScores = scoresData + b * scores->strideAt(0) + c * scores->strideAt(2);
+                const Nd4jLong scoreStride = scores->strideAt(1);
+                I* z = outputData + b * output->strideAt(0) + c * output->strideAt(1);
+
+                candidates.clear();
+                selected.clear();
+                for (Nd4jLong i = 0; i < numBoxes; i++)
+                    if ((float) classScores[i * scoreStride] > (float) scoreThreshold)
+                        candidates.emplace_back(i);
+
+                std::sort(candidates.begin(), candidates.end(), [&](Nd4jLong i, Nd4jLong j) {
+                    const T si = classScores[i * scoreStride], sj = classScores[j * scoreStride];
+                    return si > sj || (si == sj && i < j);
+                });
+
+                for (auto candidate : candidates) {
+                    if (static_cast<Nd4jLong>(selected.size()) >= maxSize)
+                        break;
+
+                    bool suppressed = false;
+                    for (auto s : selected)
+                        if (iou(b, candidate, s) >= (float) overlapThreshold) {
+                            suppressed = true;
+                            break;
+                        }
+
+                    if (!suppressed) {
+                        z[selected.size() * output->strideAt(2)] = static_cast<I>(candidate);
+                        selected.emplace_back(candidate);
+                    }
+                }
+
+                for (Nd4jLong e = selected.size(); e < maxSize; e++)
+                    z[e * output->strideAt(2)] = static_cast<I>(-1);
+
+                total += selected.size();
+            }
+        }
+
+        NDArray::registerPrimaryUse({output}, {boxes, scores});
+
+        return total;
+    }
+
+    Nd4jLong
+    nonMaxSuppressionBatched(nd4j::LaunchContext* context, NDArray* boxes, NDArray* scores, int maxSize,
+                             double overlapThreshold, double scoreThreshold, NDArray* output) {
+        if (boxes->rankOf() != 3 || boxes->sizeAt(2) != 4 || scores->rankOf() != 3 || scores->sizeAt(0) != boxes->sizeAt(0) || scores->sizeAt(1) != boxes->sizeAt(1))
+            throw std::runtime_error("ops::helpers::nonMaxSuppressionBatched: boxes should have [batch, boxes, 4] shape, and scores [batch, boxes, classes] shape");
+
+        // output is written through raw pointer, so its shape must match exactly
+        if (output->rankOf() != 3 || output->sizeAt(0) != boxes->sizeAt(0) || output->sizeAt(1) != scores->sizeAt(2) || output->sizeAt(2) != maxSize)
+            throw std::runtime_error("ops::helpers::nonMaxSuppressionBatched: output should have [batch, classes, maxSize] shape");
+
+        BUILD_DOUBLE_SELECTOR(boxes->dataType(), output->dataType(), return nonMaxSuppressionBatched_,
+                              (boxes, scores, maxSize, overlapThreshold, scoreThreshold, output),
+                              FLOAT_TYPES, INDEXING_TYPES);
+        return 0;
+    }
+
 }
 }
 }
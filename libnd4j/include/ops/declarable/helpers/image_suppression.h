@@ -33,6 +33,16 @@ namespace helpers {
     Nd4jLong nonMaxSuppressionGeneric(nd4j::LaunchContext* context, NDArray* boxes, NDArray* scores, int maxSize,
                              double overlapThreshold, double scoreThreshold, NDArray* output);
 
+    /**
+     * Batched multi-class NMS, images and classes are processed in parallel.
+     * boxes  - [batchSize, numBoxes, 4], boxes are shared by all classes of the same image
+     * scores - [batchSize, numBoxes, numClasses], same data type as boxes
+     * output - [batchSize, numClasses, maxSize], selected box indices for each image and class, padded with -1
+     * returns total number of selected boxes
+     */
+    Nd4jLong nonMaxSuppressionBatched(nd4j::LaunchContext* context, NDArray* boxes, NDArray* scores, int maxSize,
+                             double overlapThreshold, double scoreThreshold, NDArray* output);
+
 }
 }
 }
@@ -0,0 +1,53 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// views of concatenation output
+//
+
+#include <ops/declarable/helpers/transforms.h>
+
+namespace nd4j {
+    namespace ops {
+        namespace helpers {
+            std::vector<NDArray> concatViews(NDArray& output, const std::vector<Nd4jLong>& sizes, const int axis) {
+                if (axis < 0 || axis >= output.rankOf())
+                    throw std::invalid_argument("helpers::concatViews: axis is out of output rank range !");
+
+                std::vector<NDArray> views;
+                views.reserve(sizes.size());
+
+                std::vector<Nd4jLong> idx(2 * output.rankOf(), 0);
+                Nd4jLong start = 0;
+
+                for (auto size : sizes) {
+                    if (size < 1)
+                        throw std::invalid_argument("helpers::concatViews: all sizes must be positive !");
+
+                    idx[2 * axis]     = start;
+                    idx[2 * axis + 1] = start + size;
+                    views.emplace_back(output(idx, true));
+                    start += size;
+                }
+
+                if (start != output.sizeAt(axis))
+                    throw std::invalid_argument("helpers::concatViews: sum of sizes must be equal to output size along axis !");
+
+                return views;
+            }
+        }
+    }
+}
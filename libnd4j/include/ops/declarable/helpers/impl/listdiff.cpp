@@ -19,6 +19,7 @@
 //
 
 #include <ops/declarable/helpers/listdiff.h>
+#include <helpers/UniqueEngine.h>
 #include <vector>
 //#include <memory>
 
@@ -27,16 +28,7 @@ namespace ops {
 namespace helpers {
     template <typename T>
     static Nd4jLong listDiffCount_(NDArray* values, NDArray* keep) {
-        Nd4jLong saved = 0L;
-        for (Nd4jLong e = 0; e < values->lengthOf(); e++) {
-            auto v = values->e<double>(e);
-            ExtraArguments extras({v, 0.0, 10.0});
-            auto idx = keep->indexReduceNumber(indexreduce::FirstIndex, &extras);
-            auto index = idx.e<Nd4jLong>(0);
-            if (index < 0)
-                saved++;
-        }
-        return saved;
+        return UniqueEngine::difference<T>(values->bufferAsT<T>(), values->shapeInfo(), keep->bufferAsT<T>(), keep->shapeInfo(), nullptr, nullptr);
     }
 
     Nd4jLong listDiffCount(nd4j::LaunchContext * context, NDArray* values, NDArray* keep) {
@@ -57,18 +49,7 @@ namespace helpers {
         std::vector<T> saved;
         std::vector<Nd4jLong> indices;
 
-        for (Nd4jLong e = 0; e < values->lengthOf(); e++) {
-            auto v = values->e<double>(e);
-            ExtraArguments extras({v, 0.0, 10.0});
-            NDArray idxScalar = keep->indexReduceNumber(indexreduce::FirstIndex, &extras);
-            Nd4jLong idx = idxScalar.e<Nd4jLong>(0);
-
-            if (idx < 0) {
-                saved.emplace_back(v);
-                indices.emplace_back(e);
-            }
-        }
-
+        UniqueEngine::difference<T>(values->bufferAsT<T>(), values->shapeInfo(), keep->bufferAsT<T>(), keep->shapeInfo(), &saved, &indices);
 
         if (saved.size() == 0) {
 //            if (nd4j::ops::conditionHelper(__FILE__, __LINE__, false, 0, "ListDiff: search returned no results") != 0)
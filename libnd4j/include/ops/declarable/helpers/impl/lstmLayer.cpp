@@ -28,6 +28,9 @@
 
 #include <ops/declarable/helpers/lstmLayer.h>
 #include <helpers/ShapeUtils.h>
+#include <helpers/MmulHelper.h>
+#include <execution/Threads.h>
+#include <algorithm>
 // #include <VariableSpace.h>
 // #include <ops/declarable/CustomOperations.h>
 // #include<ops/declarable/helpers/transforms.h>
@@ -144,6 +147,352 @@ void lstmLayerCell(const NDArray* x, const NDArray* Wx, const NDArray* Wr,
 
 
 
+//////////////////////////////////////////////////////////////////////////
+// applies activation with given id to contiguous buffer in place, the same math as applyActivation
+template <typename T>
+static FORCEINLINE void activate(T* x, const Nd4jLong len, const int opId, const T alpha, const T beta) {
+
+    switch (opId) {
+        case 0:
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong i = 0; i < len; ++i)
+                x[i] = nd4j::math::nd4j_tanh<T, T>(x[i]);
+            break;
+        case 1:
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong i = 0; i < len; ++i)
+                x[i] = x[i] < static_cast<T>(0) ? static_cast<T>(0) : x[i];
+            break;
+        case 2:
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong i = 0; i < len; ++i)
+                x[i] = nd4j::math::nd4j_sigmoid<T, T>(x[i]);
+            break;
+        case 3:
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong i = 0; i < len; ++i)
+                x[i] = alpha * x[i] + beta;
+            break;
+        case 4:
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong i = 0; i < len; ++i)
+                x[i] = x[i] < static_cast<T>(0) ? alpha * x[i] : x[i];
+            break;
+        case 5:
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong i = 0; i < len; ++i)
+                x[i] = x[i] > alpha ? x[i] : static_cast<T>(0);
+            break;
+        case 6:
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong i = 0; i < len; ++i)
+                x[i] = alpha * nd4j::math::nd4j_tanh<T, T>(beta * x[i]);
+            break;
+        case 7:
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong i = 0; i < len; ++i)
+                x[i] = nd4j::math::nd4j_min<T>(static_cast<T>(1), nd4j::math::nd4j_max<T>(static_cast<T>(0), static_cast<T>(0.2f) * x[i] + static_cast<T>(0.5f)));
+            break;
+        case 8:
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong i = 0; i < len; ++i)
+                x[i] = nd4j::math::nd4j_elu<T, T>(x[i], alpha);
+            break;
+        case 9:
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong i = 0; i < len; ++i)
+                x[i] = nd4j::math::nd4j_softsign<T, T>(x[i]);
+            break;
+        case 10:
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong i = 0; i < len; ++i)
+                x[i] = nd4j::math::nd4j_softplus<T, T>(x[i]);
+            break;
+        default:
+            throw std::invalid_argument("LSTM_LAYER operation: wrong id number of activation !");
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// gates, cell state and output for all batch rows in single pass, z contains recurrent projection hI * Wr on entry and is used as scratch
+template <typename T>
+static void lstmLayerGates_(const NDArray& zx, const NDArray* b, const NDArray& cI, const NDArray* Wp, const std::vector<float>& params, NDArray& z, NDArray& h, NDArray& c) {
+
+    const Nd4jLong nOut = h.sizeAt(-1);
+    const Nd4jLong rows = h.rankOf() == 1 ? 1 : h.sizeAt(0);
+
+    // [bS, K] arrays may be strided views (e.g. time step slices of [bS, sL, K] array), [K] arrays are single row
+    auto rowStride = [](const NDArray& arr) -> Nd4jLong { return arr.rankOf() == 1 ? 0 : arr.strideAt(0); };
+    auto colStride = [](const NDArray& arr) -> Nd4jLong { return arr.strideAt(-1); };
+
+    const T* pZx = zx.bufferAsT<T>();
+    const T* pB  = b  != nullptr ? b->bufferAsT<T>()  : nullptr;
+    const T* pWp = Wp != nullptr ? Wp->bufferAsT<T>() : nullptr;
+    const T* pCi = cI.bufferAsT<T>();
+    T* pZ = z.bufferAsT<T>();
+    T* pH = h.bufferAsT<T>();
+    T* pC = c.bufferAsT<T>();
+
+    const Nd4jLong zxR = rowStride(zx), zxC = colStride(zx);
+    const Nd4jLong ciR = rowStride(cI), ciC = colStride(cI);
+    const Nd4jLong hR  = rowStride(h),  hC  = colStride(h);
+    const Nd4jLong cR  = rowStride(c),  cC  = colStride(c);
+    const Nd4jLong zR  = rowStride(z);
+    const Nd4jLong bC  = b  != nullptr ? colStride(*b)  : 0;
+    const Nd4jLong wpC = Wp != nullptr ? colStride(*Wp) : 0;
+
+    const T clip = static_cast<T>(params[2]);
+    const int gateAct = params[3], cellAct = params[6], outAct = params[9];
+    const T gateAlpha = params[4], gateBeta = params[5];
+    const T cellAlpha = params[7], cellBeta = params[8];
+    const T outAlpha  = params[10], outBeta = params[11];
+
+    auto func = PRAGMA_THREADS_FOR {
+        for (auto r = start; r < stop; r += increment) {
+
+            // z row is contiguous: [it, ft, c't, ot] pre-activations
+            T* zr = pZ + r * zR;
+            const T* x  = pZx + r * zxR;
+            const T* ci = pCi + r * ciR;
+            T* hr = pH + r * hR;
+            T* cr = pC + r * cR;
+
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong j = 0; j < 4 * nOut; ++j)
+                zr[j] += x[j * zxC];
+
+            if (pB != nullptr) {
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong j = 0; j < 4 * nOut; ++j)
+                    zr[j] += pB[j * bC];
+            }
+
+            // peephole connections for input and forget gates
+            if (pWp != nullptr) {
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong j = 0; j < nOut; ++j) {
+                    zr[j]        += ci[j * ciC] * pWp[j * wpC];
+                    zr[nOut + j] += ci[j * ciC] * pWp[(nOut + j) * wpC];
+                }
+            }
+
+            activate<T>(zr, 2 * nOut, gateAct, gateAlpha, gateBeta);
+            activate<T>(zr + 2 * nOut, nOut, cellAct, cellAlpha, cellBeta);
+
+            // new cell state overwrites c't, previous state is read before c is written, so cI and c may be the same array
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong j = 0; j < nOut; ++j) {
+                T ct = zr[nOut + j] * ci[j * ciC] + zr[j] * zr[2 * nOut + j];
+                if (clip != static_cast<T>(0))
+                    ct = ct > clip ? clip : (ct < -clip ? -clip : ct);
+
+                zr[2 * nOut + j] = ct;
+                cr[j * cC] = ct;
+            }
+
+            // peephole connection for output gate
+            if (pWp != nullptr) {
+                PRAGMA_OMP_SIMD
+                for (Nd4jLong j = 0; j < nOut; ++j)
+                    zr[3 * nOut + j] += zr[2 * nOut + j] * pWp[(2 * nOut + j) * wpC];
+            }
+
+            activate<T>(zr + 3 * nOut, nOut, gateAct, gateAlpha, gateBeta);
+            activate<T>(zr + 2 * nOut, nOut, outAct, outAlpha, outBeta);
+
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong j = 0; j < nOut; ++j)
+                hr[j * hC] = zr[3 * nOut + j] * zr[2 * nOut + j];
+        }
+    };
+
+    samediff::Threads::parallel_for(func, 0, rows);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void lstmLayerCellFused(const NDArray* zx, const NDArray* Wr, const NDArray* b,
+                        const NDArray* hI, const NDArray* cI, const NDArray* Wp,
+                        const std::vector<float>& params,
+                        NDArray* z, NDArray* h, NDArray* c) {
+
+    // z = hI * Wr, the only GEMM left within time loop
+    MmulHelper::mmul(hI, Wr, z, 1.0, 0.0);
+
+    NDArray::preparePrimaryUse({z, h, c}, {zx, b, cI, Wp});
+    BUILD_SINGLE_SELECTOR(z->dataType(), lstmLayerGates_, (*zx, b, *cI, Wp, params, *z, *h, *c), FLOAT_TYPES);
+    NDArray::registerPrimaryUse({z, h, c}, {zx, b, cI, Wp});
+}
+
+BUILD_SINGLE_TEMPLATE(template void lstmLayerGates_, (const NDArray& zx, const NDArray* b, const NDArray& cI, const NDArray* Wp, const std::vector<float>& params, NDArray& z, NDArray& h, NDArray& c), FLOAT_TYPES);
+
+
+
+//////////////////////////////////////////////////////////////////////////
+// copies rows of length len between buffers, offsets are given in elements for every (src, dst) pair of rows
+template <typename T>
+static void copyRows_(const void* vsrc, const Nd4jLong srcStride, void* vdst, const Nd4jLong dstStride, const std::vector<std::pair<Nd4jLong, Nd4jLong>>& offsets, const Nd4jLong len) {
+
+    auto src = reinterpret_cast<const T*>(vsrc);
+    auto dst = reinterpret_cast<T*>(vdst);
+
+    for (const auto& o : offsets) {
+        auto s = src + o.first;
+        auto d = dst + o.second;
+
+        if (srcStride == 1 && dstStride == 1) {
+            PRAGMA_OMP_SIMD
+            for (Nd4jLong j = 0; j < len; ++j)
+                d[j] = s[j];
+        }
+        else {
+            for (Nd4jLong j = 0; j < len; ++j)
+                d[j * dstStride] = s[j * srcStride];
+        }
+    }
+}
+
+BUILD_SINGLE_TEMPLATE(template void copyRows_, (const void* vsrc, const Nd4jLong srcStride, void* vdst, const Nd4jLong dstStride, const std::vector<std::pair<Nd4jLong, Nd4jLong>>& offsets, const Nd4jLong len), FLOAT_TYPES);
+
+//////////////////////////////////////////////////////////////////////////
+static void copyRows(const NDArray& src, const Nd4jLong srcStride, NDArray& dst, const Nd4jLong dstStride, const std::vector<std::pair<Nd4jLong, Nd4jLong>>& offsets, const Nd4jLong len) {
+
+    if (offsets.empty())
+        return;
+
+    NDArray::preparePrimaryUse({&dst}, {&src});
+    BUILD_SINGLE_SELECTOR(src.dataType(), copyRows_, (src.getBuffer(), srcStride, dst.getBuffer(), dstStride, offsets, len), FLOAT_TYPES);
+    NDArray::registerPrimaryUse({&dst}, {&src});
+}
+
+//////////////////////////////////////////////////////////////////////////
+// time loop over variable-length sequences in packed layout: examples are sorted by length in descending order,
+// so examples still active at time step k always form the first rows of packed state, and each step is single
+// recurrent GEMM over these rows. Results are the same as of processing every example separately
+static void lstmLayerPackedLoop(const NDArray& zx, const NDArray* Wr, const NDArray* b, const NDArray* seqLen,
+                                const NDArray* h0, const NDArray* c0, const NDArray* Wp,
+                                const std::vector<float>& params, const bool forward,
+                                NDArray* h, NDArray* hL, NDArray* cL) {
+
+    // zx - input projection, [sL, bS, 4*nOut] for TNS data format, [bS, sL, 4*nOut] otherwise
+    // h0, c0 - initial output and cell state [bS, nOut]
+    // h - output, optional, hL and cL - output and cell state at last step of every example, optional
+
+    const int dataFormat    = params[0];
+    const int directionMode = params[1];
+
+    const bool timeMajor = dataFormat == 0 || dataFormat == 3;
+    const Nd4jLong sL   = timeMajor ? zx.sizeAt(0) : zx.sizeAt(1);
+    const Nd4jLong bS   = timeMajor ? zx.sizeAt(1) : zx.sizeAt(0);
+    const Nd4jLong nOut = Wr->sizeAt(0);
+
+    // longest examples go first
+    std::vector<Nd4jLong> order(bS), limits(bS);
+    for (Nd4jLong e = 0; e < bS; ++e) {
+        order[e] = e;
+        limits[e] = seqLen->e<Nd4jLong>(e);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](Nd4jLong a, Nd4jLong c) { return limits[a] > limits[c]; });
+
+    const Nd4jLong maxLen = bS > 0 ? limits[order[0]] : 0;
+
+    // time index of k-th step of example e, forward: [0, limit), backward: [sL-limit, sL) or [0, limit) in bidirectional mode, reversed
+    auto timeOf = [&](const Nd4jLong e, const Nd4jLong k) -> Nd4jLong {
+        if (forward)
+            return k;
+        return directionMode == 1 ? sL - 1 - k : limits[e] - 1 - k;
+    };
+
+    // offsets of rows within arrays
+    auto stateRow = [](const NDArray* arr, const Nd4jLong e) -> Nd4jLong { return e * arr->strideAt(0); };
+    auto outRow = [&](const Nd4jLong t, const Nd4jLong e) -> Nd4jLong {
+        if (timeMajor)
+            return t * h->strideAt(0) + e * h->strideAt(1);      // [sL, bS, nOut]
+        if (dataFormat == 1)
+            return e * h->strideAt(0) + t * h->strideAt(1);      // [bS, sL, nOut]
+        return e * h->strideAt(0) + t * h->strideAt(2);          // [bS, nOut, sL]
+    };
+    const Nd4jLong outStride = h == nullptr ? 0 : (dataFormat == 2 ? h->strideAt(1) : h->strideAt(-1));
+
+    NDArray hP('c', {bS, nOut},   zx.dataType(), zx.getContext());      // packed output
+    NDArray cP('c', {bS, nOut},   zx.dataType(), zx.getContext());      // packed cell state
+    NDArray xP('c', {bS, 4*nOut}, zx.dataType(), zx.getContext());      // packed input projection of current step
+    NDArray zP('c', {bS, 4*nOut}, zx.dataType(), zx.getContext());      // gates buffer
+
+    std::vector<std::pair<Nd4jLong, Nd4jLong>> offsets;
+
+    // initial state
+    for (Nd4jLong i = 0; i < bS; ++i)
+        offsets.emplace_back(stateRow(h0, order[i]), i * nOut);
+    copyRows(*h0, h0->strideAt(1), hP, 1, offsets, nOut);
+
+    offsets.clear();
+    for (Nd4jLong i = 0; i < bS; ++i)
+        offsets.emplace_back(stateRow(c0, order[i]), i * nOut);
+    copyRows(*c0, c0->strideAt(1), cP, 1, offsets, nOut);
+
+    // time steps beyond length of example are zeros
+    if (h)
+        h->nullify();
+
+    Nd4jLong active = bS;
+    for (Nd4jLong k = 0; k < maxLen; ++k) {
+
+        while (active > 0 && limits[order[active - 1]] <= k)
+            --active;
+
+        // gathering projections of active examples for their k-th step
+        offsets.clear();
+        for (Nd4jLong i = 0; i < active; ++i) {
+            const auto e = order[i];
+            offsets.emplace_back(getBatchTimeTotalIndex(dataFormat, sL, bS, timeOf(e, k), e) * 4 * nOut, i * 4 * nOut);
+        }
+        copyRows(zx, 1, xP, 1, offsets, 4 * nOut);
+
+        auto xk = xP({0,active, 0,0}, true);
+        auto zk = zP({0,active, 0,0}, true);
+        auto hk = hP({0,active, 0,0}, true);
+        auto ck = cP({0,active, 0,0}, true);
+
+        lstmLayerCellFused(&xk, Wr, b, &hk, &ck, Wp, params, &zk, &hk, &ck);
+
+        // scattering outputs back to their time steps
+        if (h) {
+            offsets.clear();
+            for (Nd4jLong i = 0; i < active; ++i) {
+                const auto e = order[i];
+                offsets.emplace_back(i * nOut, outRow(timeOf(e, k), e));
+            }
+            copyRows(hP, 1, *h, outStride, offsets, nOut);
+        }
+    }
+
+    // rows of finished examples aren't touched after their last step, so packed state holds last step of every example
+    if (hL) {
+        offsets.clear();
+        for (Nd4jLong i = 0; i < bS; ++i)
+            offsets.emplace_back(i * nOut, stateRow(hL, order[i]));
+        copyRows(hP, 1, *hL, hL->strideAt(1), offsets, nOut);
+    }
+
+    if (cL) {
+        offsets.clear();
+        for (Nd4jLong i = 0; i < bS; ++i)
+            offsets.emplace_back(i * nOut, stateRow(cL, order[i]));
+        copyRows(cP, 1, *cL, cL->strideAt(1), offsets, nOut);
+    }
+
+    // examples of zero length have zero state
+    for (Nd4jLong e = 0; e < bS; ++e) {
+        if (limits[e] != 0)
+            continue;
+        if (hL)
+            (*hL)({e,e+1, 0,0}).nullify();
+        if (cL)
+            (*cL)({e,e+1, 0,0}).nullify();
+    }
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 void lstmLayerTimeLoop(const NDArray* x, const NDArray* Wx, const NDArray* Wr,
                        const NDArray* b, const NDArray* seqLen, const NDArray* hI, const NDArray* cI, const NDArray* Wp,
@@ -170,10 +519,10 @@ void lstmLayerTimeLoop(const NDArray* x, const NDArray* Wx, const NDArray* Wr,
     // dataFormat: 0,3 = [sL, bS, nIn], 1 = [bS, sL ,nIn], 2 = [bS, nIn, sL]
 
     const int dataFormat    = params[0];
-    const int directionMode = params[1];
 
-    const Nd4jLong sL   = x->sizeAt(dataFormat);
+    const Nd4jLong sL   = dataFormat == 3 ? x->sizeAt(0) : x->sizeAt(dataFormat);
     const Nd4jLong bS   = dataFormat == 1 || dataFormat == 2 ? x->sizeAt(0) : x->sizeAt(1);
+    const Nd4jLong nIn  = Wx->sizeAt(0);
     const Nd4jLong nOut = Wx->sizeAt(-1) / 4;
 
     const std::vector<Nd4jLong> shapeOut = {bS, nOut};
@@ -192,265 +541,84 @@ void lstmLayerTimeLoop(const NDArray* x, const NDArray* Wx, const NDArray* Wr,
 
     auto ct = cL;
     if(!cL)
-        cL = new NDArray(x->ordering(), shapeOut, x->dataType(), x->getContext());
+        ct = new NDArray(x->ordering(), shapeOut, x->dataType(), x->getContext());
 
     auto ht = hL;
     if(!h && !hL)
         ht = new NDArray(x->ordering(), shapeOut, x->dataType(), x->getContext());
 
-    // create sets of required (depends on seqLen presence) sub-arrays
-    std::vector<int> dims;
-    ResultSet *xSet(nullptr), *hSet(nullptr), *h0Set(nullptr), *c0Set(nullptr), *htSet(nullptr), *ctSet(nullptr);
-
-    if(!seqLen) {
-
-        dims = ShapeUtils::evalDimsToExclude(x->rankOf(), {dataFormat < 3 ? dataFormat : 0});    // points on bS and nIn/nOut axes
+    // input projection x * Wx for the whole sequence by single GEMM, zx rows are ordered the same way as time steps of x:
+    // TNS: [sL, bS, 4*nOut], NTS and NST: [bS, sL, 4*nOut], so getBatchTimeTotalIndex applies to zx as well
+    const bool timeMajor = dataFormat == 0 || dataFormat == 3;
+    NDArray zx('c', timeMajor ? std::vector<Nd4jLong>({sL, bS, 4*nOut}) : std::vector<Nd4jLong>({bS, sL, 4*nOut}), x->dataType(), x->getContext());
+    {
+        // reshape copies only if x can't be viewed as 2d array
+        auto x2d  = dataFormat == 2 ? x->permute({0, 2, 1}).reshape('c', {sL * bS, nIn}) : x->reshape('c', {sL * bS, nIn});
+        auto zx2d = zx.reshape('c', {sL * bS, 4*nOut}, false);
+        MmulHelper::mmul(&x2d, Wx, &zx2d, 1.0, 0.0);
+    }
 
-        xSet = new ResultSet(x->allTensorsAlongDimension(dims));       // sub-arrays with shape [bS, nIn]
-        if(h)
-            hSet = new ResultSet(h->allTensorsAlongDimension(dims));   // sub-arrays with shape [bS, nOut]
+    if(seqLen) {
+        // examples of different lengths are processed together, see lstmLayerPackedLoop
+        lstmLayerPackedLoop(zx, Wr, b, seqLen, h0, c0, Wp, params, forward, h, ht, ct);
     }
     else {
 
-        dims = dataFormat == 2 ? std::vector<int>({1}) : std::vector<int>({2});    // points on nIn/nOut axis
+        const std::vector<int> dims = ShapeUtils::evalDimsToExclude(x->rankOf(), {dataFormat < 3 ? dataFormat : 0});    // points on bS and nIn/nOut axes
 
-        xSet  = new ResultSet(x->allTensorsAlongDimension(dims));               //  sub-arrays with shape [nIn]
-        h0Set = new ResultSet(h0->allTensorsAlongDimension({1}));              //  sub-arrays with shape [nOut]
-        c0Set = new ResultSet(c0->allTensorsAlongDimension({1}));              //  sub-arrays with shape [nOut]
-        ctSet = new ResultSet(ct->allTensorsAlongDimension({1}));              //  sub-arrays with shape [nOut]
-        if(h)
-            hSet = new ResultSet(h->allTensorsAlongDimension(dims));            //  sub-arrays with shape [nOut]
-        if(ht)
-            htSet = new ResultSet(ht->allTensorsAlongDimension({1}));          //  sub-arrays with shape [nOut]
-    }
+        ResultSet xSet = zx.allTensorsAlongDimension({timeMajor ? 1 : 0, 2});      // sub-arrays of input projection with shape [bS, 4*nOut]
+        ResultSet *hSet = h ? new ResultSet(h->allTensorsAlongDimension(dims)) : nullptr;   // sub-arrays with shape [bS, nOut]
 
-    // loops
-    if(forward) {
+        NDArray z('c', {bS, 4*nOut}, x->dataType(), x->getContext());     // per-step buffer for recurrent projection and gates
 
-        if(!seqLen) {
+        if(forward) {
 
-            if(!h) {    // seqLen and h are absent
+            if(!h) {    // h is absent
 
-                lstmLayerCell(xSet->at(0), Wx, Wr, b, h0, c0, Wp, params, ht, ct); // first time step
+                lstmLayerCellFused(xSet.at(0), Wr, b, h0, c0, Wp, params, &z, ht, ct); // first time step
                 for (int t = 1; t < sL; ++t)
-                    lstmLayerCell(xSet->at(t), Wx, Wr, b, ht, ct, Wp, params, ht, ct); // rest time steps
+                    lstmLayerCellFused(xSet.at(t), Wr, b, ht, ct, Wp, params, &z, ht, ct); // rest time steps
             }
-            else {      // seqLen is absent and h is present
+            else {      // h is present
 
-                lstmLayerCell(xSet->at(0), Wx, Wr, b, h0, c0, Wp, params, hSet->at(0), ct); // first time step
+                lstmLayerCellFused(xSet.at(0), Wr, b, h0, c0, Wp, params, &z, hSet->at(0), ct); // first time step
                 for (int t = 1; t < sL; ++t)
-                    lstmLayerCell(xSet->at(t), Wx, Wr, b, hSet->at(t - 1), ct, Wp, params, hSet->at(t), ct); // rest time steps
+                    lstmLayerCellFused(xSet.at(t), Wr, b, hSet->at(t - 1), ct, Wp, params, &z, hSet->at(t), ct); // rest time steps
 
                 if(hL)
                     hL->assign(hSet->at(sL - 1));     // assign last output to hL if it is not nullptr
             }
         }
-        else {
-
-            if(!h) {    // seqLen is present and h is absent
-
-                for (int e = 0; e < bS; ++e) {
-
-                    const int limit = seqLen->e<int>(e);
-
-                    if(limit == 0) {
-                        if(cL)
-                            ctSet->at(e)->nullify();
-                        if(hL)
-                            htSet->at(e)->nullify();
-                        continue;
-                    }
-
-                    auto ind = getBatchTimeTotalIndex(dataFormat, sL, bS, 0, e);
-                    lstmLayerCell(xSet->at(ind), Wx, Wr, b, h0Set->at(e), c0Set->at(e), Wp, params, htSet->at(e), ctSet->at(e)); // first time step
-
-                    for (int t = 1; t < limit; ++t) {
-                        ind = getBatchTimeTotalIndex(dataFormat, sL, bS, t, e);
-                        lstmLayerCell(xSet->at(ind), Wx, Wr, b, htSet->at(e), ctSet->at(e), Wp, params, htSet->at(e), ctSet->at(e)); // rest time steps
-                    }
-                }
-            }
-            else { // seqLen and h are present
-
-                for (int e = 0; e < bS; ++e) {
-
-                    int limit = seqLen->e<int>(e);
-
-                    if(limit == 0) {
-
-                        tensorAlongTimeBatchDims(*h, dataFormat, 0,0, e,e+1).nullify();     // nullify for given e and whole time range
-
-                        if(cL)
-                            ctSet->at(e)->nullify();
-                        if(hL)
-                            htSet->at(e)->nullify();
-
-                        continue;
-                    }
+        else {   // backward
 
-                    auto indPrev = getBatchTimeTotalIndex(dataFormat, sL, bS, 0, e);
-                    lstmLayerCell(xSet->at(indPrev), Wx, Wr, b, h0Set->at(e), c0Set->at(e), Wp, params, hSet->at(indPrev), ctSet->at(e)); // first time step
+            if(!h) {    // h is absent
 
-                    for (int t = 1; t < limit; ++t) {
-                        auto indCurr = getBatchTimeTotalIndex(dataFormat, sL, bS, t, e);
-                        lstmLayerCell(xSet->at(indCurr), Wx, Wr, b, hSet->at(indPrev), ctSet->at(e), Wp, params, hSet->at(indCurr), ctSet->at(e)); // rest time steps
-                        indPrev = indCurr;
-                    }
-
-                    if(hL)
-                        htSet->at(e)->assign(hSet->at(indPrev));     // assign last output to hL if hL is not nullptr
-
-                    tensorAlongTimeBatchDims(*h, dataFormat, limit,sL, e,e+1).nullify();     // nullify for given e and time range [limit, sL)
-                }
-            }
-        }
-    }
-    else {   // backward
-
-         if(!seqLen) {
-
-            if(!h) {    // seqLen and h are absent
-
-                lstmLayerCell(xSet->at(sL - 1), Wx, Wr, b, h0, c0, Wp, params, ht, ct); // first time step
+                lstmLayerCellFused(xSet.at(sL - 1), Wr, b, h0, c0, Wp, params, &z, ht, ct); // first time step
                 for (int t = sL - 2; t >= 0; --t)
-                    lstmLayerCell(xSet->at(t), Wx, Wr, b, ht, ct, Wp, params, ht, ct); // rest time steps
+                    lstmLayerCellFused(xSet.at(t), Wr, b, ht, ct, Wp, params, &z, ht, ct); // rest time steps
             }
-            else {  // seqLen is absent and h is present
+            else {  // h is present
 
-                lstmLayerCell(xSet->at(sL - 1), Wx, Wr, b, h0, c0, Wp, params, hSet->at(sL - 1), ct); // first time step
+                lstmLayerCellFused(xSet.at(sL - 1), Wr, b, h0, c0, Wp, params, &z, hSet->at(sL - 1), ct); // first time step
                 for (int t = sL - 2; t >= 0; --t)
-                    lstmLayerCell(xSet->at(t), Wx, Wr, b, hSet->at(t + 1), ct, Wp, params, hSet->at(t), ct); // rest time steps
+                    lstmLayerCellFused(xSet.at(t), Wr, b, hSet->at(t + 1), ct, Wp, params, &z, hSet->at(t), ct); // rest time steps
 
                 if(hL)
                     hL->assign(hSet->at(0));     // assign last output to hL if it is not nullptr
             }
         }
-        else if(directionMode == 1) {   // only backward, no bidirectional mode
-
-            if(!h) {    // h is absent and seqLen is present
-
-                for (int e = 0; e < bS; ++e) {
-
-                    const int limit = seqLen->e<int>(e);
-
-                    if(limit == 0) {
-                        if(cL)
-                            ctSet->at(e)->nullify();
-                        if(hL)
-                            htSet->at(e)->nullify();
-                        continue;
-                    }
-
-                    auto ind = getBatchTimeTotalIndex(dataFormat, sL, bS, sL - 1, e);
-                    lstmLayerCell(xSet->at(ind), Wx, Wr, b, h0Set->at(e), c0Set->at(e), Wp, params, htSet->at(e), ctSet->at(e)); // first time step
-
-                    for (int t = sL - 2; t >= sL - limit; --t) {
-                        ind = getBatchTimeTotalIndex(dataFormat, sL, bS, t, e);
-                        lstmLayerCell(xSet->at(ind), Wx, Wr, b, htSet->at(e), ctSet->at(e), Wp, params, htSet->at(e), ctSet->at(e)); // rest time steps
-                    }
-                }
-            }
-            else {  // seqLen and h are present
-
-                for (int e = 0; e < bS; ++e) {
-
-                    int limit = seqLen->e<int>(e);
-
-                    if(limit == 0) {
-
-                        tensorAlongTimeBatchDims(*h, dataFormat, 0,0, e,e+1).nullify();     // nullify for given e and whole time range
-
-                        if(cL)
-                            ctSet->at(e)->nullify();
-                        if(hL)
-                            htSet->at(e)->nullify();
-
-                        continue;
-                    }
-
-                    auto indPrev = getBatchTimeTotalIndex(dataFormat, sL, bS, sL - 1, e);
-                    lstmLayerCell(xSet->at(indPrev), Wx, Wr, b, h0Set->at(e), c0Set->at(e), Wp, params, hSet->at(indPrev), ctSet->at(e)); // first time step
-
-                    for (int t = sL - 2; t >= sL - limit; --t) {
-                        auto indCurr = getBatchTimeTotalIndex(dataFormat, sL, bS, t, e);
-                        lstmLayerCell(xSet->at(indCurr), Wx, Wr, b, hSet->at(indPrev), ctSet->at(e), Wp, params, hSet->at(indCurr), ctSet->at(e)); // rest time steps
-                        indPrev = indCurr;
-                    }
-
-                    if(hL)
-                        htSet->at(e)->assign(hSet->at(indPrev));     // assign last output to hL if it is not nullptr
-
-                    tensorAlongTimeBatchDims(*h, dataFormat, 0,sL-limit, e,e+1).nullify();    // nullify for given e and time range [limit, sL)
-                }
-            }
-        }
-        else {   // backward in bidirectional mode
-
-            if(!h) {    // h is absent and seqLen is present
-
-                for (int e = 0; e < bS; ++e) {
-
-                    const int limit = seqLen->e<int>(e);
-
-                    if(limit == 0) {
-                        if(cL)
-                            ctSet->at(e)->nullify();
-                        if(hL)
-                            htSet->at(e)->nullify();
-                        continue;
-                    }
-
-                    auto ind = getBatchTimeTotalIndex(dataFormat, sL, bS, limit - 1, e);
-                    lstmLayerCell(xSet->at(ind), Wx, Wr, b, h0Set->at(e), c0Set->at(e), Wp, params, htSet->at(e), ctSet->at(e)); // first time step
 
-                    for (int t = limit - 2; t >= 0; --t) {
-                        ind = getBatchTimeTotalIndex(dataFormat, sL, bS, t, e);
-                        lstmLayerCell(xSet->at(ind), Wx, Wr, b, htSet->at(e), ctSet->at(e), Wp, params, htSet->at(e), ctSet->at(e)); // rest time steps
-                    }
-                }
-            }
-            else {  // seqLen and h are present
-
-                for (int e = 0; e < bS; ++e) {
-
-                    int limit = seqLen->e<int>(e);
-
-                    if(limit == 0) {
-
-                        tensorAlongTimeBatchDims(*h, dataFormat, 0,0, e,e+1).nullify();     // nullify for given e and whole time range
-
-                        if(cL)
-                            ctSet->at(e)->nullify();
-                        if(hL)
-                            htSet->at(e)->nullify();
-
-                        continue;
-                    }
-
-                    auto indPrev = getBatchTimeTotalIndex(dataFormat, sL, bS, limit - 1, e);
-                    lstmLayerCell(xSet->at(indPrev), Wx, Wr, b, h0Set->at(e), c0Set->at(e), Wp, params, hSet->at(indPrev), ctSet->at(e)); // first time step
-
-                    for (int t = limit - 2; t >= 0; --t) {
-                        auto indCurr = getBatchTimeTotalIndex(dataFormat, sL, bS, t, e);
-                        lstmLayerCell(xSet->at(indCurr), Wx, Wr, b, hSet->at(indPrev), ctSet->at(e), Wp, params, hSet->at(indCurr), ctSet->at(e)); // rest time steps
-                        indPrev = indCurr;
-                    }
-
-                    if(hL)
-                        htSet->at(e)->assign(hSet->at(indPrev));     // assign last output to hL if it is not nullptr
-
-                    tensorAlongTimeBatchDims(*h, dataFormat, limit,sL, e,e+1).nullify();    // nullify for given e and time range [limit, sL)
-                }
-            }
-        }
+        delete hSet;
     }
 
-    delete xSet;
-    delete hSet;
-    delete h0Set;
-    delete c0Set;
-    delete htSet;
-    delete ctSet;
+    if(!hI)
+        delete h0;
+    if(!cI)
+        delete c0;
+    if(!cL)
+        delete ct;
+    if(!h && !hL)
+        delete ht;
 }
 
 
@@ -20,6 +20,7 @@
 
 #include <ops/declarable/helpers/multiUnique.h>
 #include <ops/declarable/CustomOperations.h>
+#include <helpers/UniqueEngine.h>
 
 namespace nd4j {
 namespace ops {
@@ -27,40 +28,29 @@ namespace helpers {
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     bool multiUnique(std::vector<NDArray*> const& inputList, nd4j::memory::Workspace *workspace) {
         Nd4jLong length = 0;
-        std::vector<NDArray> reshaped(inputList.size());
-        int pos = 0;
-        Nd4jLong axis = 0;
-        Context cContext(1);
         for (auto array: inputList) {
             if (array->dataType() != nd4j::DataType::INT32)
                 throw std::runtime_error("multiUnique: this op support INT32 data type only.");
 
-            reshaped[pos] = array->reshape(array->ordering(), {-1});
-            cContext.setInputArray(pos, &reshaped[pos]);
-
             length += array->lengthOf();
-            pos++;
         }
-        NDArray arrayFull('c', {length}, nd4j::DataType::INT32);
-        cContext.setOutputArray(0, &arrayFull);
-        cContext.setIArguments(&axis, 1);
-
-        nd4j::ops::concat opConcat;
-        auto cResult = opConcat.execute(&cContext);
-        if (Status::OK() != cResult)
-            throw std::runtime_error("multiUnique: cannot execute concat op properly.");
 
-        nd4j::ops::unique opUnique;
-        auto uResult = opUnique.evaluate({&arrayFull});
-        if (Status::OK() != uResult->status())
-            throw std::runtime_error("multiUnique: cannot execute unique op properly.");
+        // all arrays share single table, so first repeated value ends the search
+        UniqueEngine::Table<int> table(2 * length);
+        for (auto array: inputList) {
+            array->syncToHost();
 
-        auto uniqueVals = uResult->at(0);
+            for (Nd4jLong e = 0; e < array->lengthOf(); e++) {
+                auto v = array->e<int>(e);
+                auto before = table.size();
 
-        bool res = uniqueVals->lengthOf() == arrayFull.lengthOf();
+                table.insert(v, UniqueEngine::hashOf(v), e);
+                if (table.size() == before)
+                    return false;
+            }
+        }
 
-        delete uResult;        
-        return res;
+        return true;
     }
 
 }
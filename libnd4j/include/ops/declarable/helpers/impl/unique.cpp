@@ -21,6 +21,7 @@
 #include <ops/declarable/helpers/unique.h>
 #include <Status.h>
 #include <execution/Threads.h>
+#include <helpers/UniqueEngine.h>
 
 namespace nd4j {
 namespace ops {
@@ -28,60 +29,55 @@ namespace helpers {
 
     template <typename T>
     static Nd4jLong uniqueCount_(NDArray* input) {
-        Nd4jLong count = 0;
-
-        std::vector<T> values;
-
-        for (int e = 0; e < input->lengthOf(); e++) {
-            T v = input->e<T>(e);
-            if (std::find(values.begin(), values.end(), v) == values.end()) {
-                values.push_back(v);
-                count++;
-            }
-        }
-        return count;
+        return UniqueEngine::unique<T>(input->bufferAsT<T>(), input->shapeInfo(), nullptr, nullptr, nullptr);
     }
 
     Nd4jLong uniqueCount(nd4j::LaunchContext * context, NDArray* input) {
+        input->syncToHost();
+
         BUILD_SINGLE_SELECTOR(input->dataType(), return uniqueCount_, (input), LIBND4J_TYPES);
     }
 
     BUILD_SINGLE_TEMPLATE(template Nd4jLong uniqueCount_, (NDArray* input), LIBND4J_TYPES);
 
+    template <typename T, typename V>
+    static void assignVector(NDArray* target, const std::vector<V>& source) {
+        // direct writes are possible for dense arrays of the same type only
+        if (target->dataType() == DataTypeUtils::fromT<T>() && target->ews() == 1 && target->ordering() == 'c') {
+            auto z = target->bufferAsT<T>();
+            auto func = PRAGMA_THREADS_FOR {
+                for (auto e = start; e < stop; e++)
+                    z[e] = static_cast<T>(source[e]);
+            };
+            samediff::Threads::parallel_for(func, 0, target->lengthOf());
+        } else {
+            auto func = PRAGMA_THREADS_FOR {
+                for (auto e = start; e < stop; e++)
+                    target->p(e, static_cast<T>(source[e]));
+            };
+            samediff::Threads::parallel_for(func, 0, target->lengthOf());
+        }
+    }
 
     template <typename T>
     static Nd4jStatus uniqueFunctor_(NDArray* input, NDArray* values, NDArray* indices, NDArray* counts) {
-    
         std::vector<T> valuesVector;
-        std::map<T, int> indicesMap;
-        std::map<T, int> countsMap;
-
-        for (int e = 0; e < input->lengthOf(); e++) {
-            T v = input->e<T>(e);
-            if (std::find(valuesVector.begin(), valuesVector.end(), v) == valuesVector.end()) {
-                valuesVector.push_back(v);
-                indicesMap[v] = e;
-                countsMap[v] = 1;
-            }
-            else {
-                countsMap[v]++;
-            }
-        }
+        std::vector<Nd4jLong> countsVector;
 
-        auto func = PRAGMA_THREADS_FOR {
-            for (auto e = start; e < stop; e++) {
-                values->p(e, static_cast<T>(valuesVector[e]));
-                if (counts != nullptr)
-                    counts->p(e, countsMap[valuesVector[e]]);
-            }
-        };
-        samediff::Threads::parallel_for(func, 0, values->lengthOf());
-
-        for (int e = 0; e < indices->lengthOf(); e++) {
-            auto posI = std::find(valuesVector.begin(), valuesVector.end(), input->e<T>(e));
-            auto dist = std::distance(valuesVector.begin(), posI);
-            indices->p(e, Nd4jLong(dist));//indicesMap[(*input)(e)];
-        }
+        // indices are written in place when output layout allows that
+        const bool directIndices = indices->dataType() == nd4j::DataType::INT64 && indices->ews() == 1 && indices->ordering() == 'c';
+        std::vector<Nd4jLong> indicesVector(directIndices ? 0 : input->lengthOf());
+        auto indicesBuffer = directIndices ? indices->bufferAsT<Nd4jLong>() : indicesVector.data();
+
+        UniqueEngine::unique<T>(input->bufferAsT<T>(), input->shapeInfo(), &valuesVector, indicesBuffer, counts != nullptr ? &countsVector : nullptr);
+
+        assignVector<T, T>(values, valuesVector);
+
+        if (counts != nullptr)
+            assignVector<Nd4jLong, Nd4jLong>(counts, countsVector);
+
+        if (!directIndices)
+            assignVector<Nd4jLong, Nd4jLong>(indices, indicesVector);
 
         return Status::OK();
     }
@@ -34,6 +34,15 @@ void ND4J_EXPORT lstmLayerCell(const NDArray* x, const NDArray* Wx, const NDArra
                    const std::vector<float>& params,
                          NDArray* h, NDArray* c);
 
+//////////////////////////////////////////////////////////////////////////
+// the same cell as above, with input projection zx = x * Wx precomputed for the whole sequence: only recurrent GEMM is done here,
+// bias, peepholes, activations and cell update are applied in single pass
+// zx - [bS, 4*nOut] or [4*nOut], z - preallocated buffer of the same shape, contents are overwritten
+void ND4J_EXPORT lstmLayerCellFused(const NDArray* zx, const NDArray* Wr, const NDArray* b,
+                        const NDArray* hI, const NDArray* cI, const NDArray* Wp,
+                        const std::vector<float>& params,
+                              NDArray* z, NDArray* h, NDArray* c);
+
 //////////////////////////////////////////////////////////////////////////
 void ND4J_EXPORT lstmLayerTimeLoop(const NDArray* x, const NDArray* Wx, const NDArray* Wr,
                         const NDArray* b, const NDArray* seqLen, const NDArray* hI, const NDArray* cI, const NDArray* Wp,
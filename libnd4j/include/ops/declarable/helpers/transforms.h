@@ -72,6 +72,12 @@ namespace helpers {
 
 	void concat(nd4j::LaunchContext * context, const std::vector<NDArray*>& inArrs, NDArray& output, const int axis);
 
+	/**
+	 * Splits output into views of given sizes along axis. Inputs computed directly into these views are already
+	 * at their place, so concat doesn't copy them on cpu
+	 */
+	std::vector<NDArray> concatViews(NDArray& output, const std::vector<Nd4jLong>& sizes, const int axis);
+
 	void tileBP(nd4j::LaunchContext * context, const NDArray& gradO /*input*/, NDArray& gradI /*output*/, const std::vector<Nd4jLong> reps);
 }
 }
@@ -27,6 +27,8 @@
 #include <ops/declarable/OpRegistrator.h>
 #include <exceptions/datatype_exception.h>
 #include <helpers/StringUtils.h>
+#include <graph/profiling/OpStatistics.h>
+#include <graph/profiling/TraceRecorder.h>
 #include <cstdarg>
 
 namespace nd4j {
@@ -47,6 +49,19 @@ namespace nd4j {
             return ND4J_STATUS_OK;
         }
 
+        static void inputShapes(Context &ctx, std::vector<const Nd4jLong*> &shapes) {
+            if (ctx.isFastPath()) {
+                for (const auto p:ctx.fastpath_in())
+                    shapes.emplace_back(p == nullptr ? nullptr : p->getShapeInfo());
+            } else {
+                for (auto p: *ctx.inputs()) {
+                    auto var = ctx.variable(p);
+                    if (var->variableType() == VariableType::NDARRAY && var->getNDArray() != nullptr)
+                        shapes.emplace_back(var->getNDArray()->getShapeInfo());
+                }
+            }
+        }
+
         DeclarableOp::DeclarableOp() {
             // no-op
         }
@@ -136,7 +151,7 @@ namespace nd4j {
             return z;
         }
 
-        int nd4j::ops::DeclarableOp::prepareOutputs(Context &ctx) {
+        int nd4j::ops::DeclarableOp::prepareOutputs(Context &ctx, Nd4jLong signature) {
             auto workspace = ctx.getWorkspace();
             GraphProfile *prof = nullptr;
             NodeProfile *node = nullptr;
@@ -215,9 +230,27 @@ namespace nd4j {
                     shapeStart = std::chrono::system_clock::now();
                 }
 
+                auto statistics = OpStatistics::getInstance();
+                auto tracer = TraceRecorder::getInstance();
+                auto observeShapes = statistics->isEnabled() || tracer->isActive();
+                TraceRecorder::clock::time_point observeStart;
+                if (observeShapes)
+                    observeStart = TraceRecorder::clock::now();
+
                 auto outSha = this->calculateOutputShape(&inSha, ctx);
                 results = outSha->size();
 
+                if (observeShapes) {
+                    auto observeEnd = TraceRecorder::clock::now();
+                    if (statistics->isEnabled()) {
+                        auto shapes = const_cast<const Nd4jLong * const *>(inSha.asVector()->data());
+                        auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(observeEnd - observeStart).count();
+                        statistics->recordShapeFunction(this->getOpHash(), *this->getOpName(), signature, inSha.size(), shapes, nanos);
+                    }
+
+                    tracer->span(*this->getOpName(), "shape", observeStart, observeEnd);
+                }
+
                 // optionally saving shapeTime
                 if (Environment::getInstance()->isProfiling() && node != nullptr) {
                     shapeEnd = std::chrono::system_clock::now();
@@ -241,7 +274,10 @@ namespace nd4j {
                             if (Environment::getInstance()->isDebugAndVerbose())
                                 shape::printShapeInfoLinear("Going to create variable with shape", out);
 
-                            auto outArr = new NDArray(out, true, ctx.launchContext());
+                            // memory plan might have place for this output within arena
+                            auto outArr = ctx.getVariableSpace()->allocatePlanned(pair, out, ctx.launchContext());
+                            if (outArr == nullptr)
+                                outArr = new NDArray(out, true, ctx.launchContext());
 
                             ctx.pushNDArrayToVariableSpace(pair, outArr);
                         } else {
@@ -551,8 +587,20 @@ namespace nd4j {
             REQUIRE_OK(this->validateDataTypes(*block));
 
 
+            auto statistics = OpStatistics::getInstance();
+            auto tracer = TraceRecorder::getInstance();
+            auto observe = statistics->isEnabled() || tracer->isActive();
+
+            // input shapes and their signature are used for both shape function and execution statistics
+            std::vector<const Nd4jLong*> shapes;
+            Nd4jLong signature = 0;
+            if (statistics->isEnabled()) {
+                inputShapes(*block, shapes);
+                signature = OpStatistics::signatureOf((int) shapes.size(), shapes.data());
+            }
+
             // this method will allocate output NDArrays for this op
-            auto numOutputs = this->prepareOutputs(*block);
+            auto numOutputs = this->prepareOutputs(*block, signature);
 
             if (Environment::getInstance()->isProfiling()) {
                 timeStart = std::chrono::system_clock::now();
@@ -560,6 +608,10 @@ namespace nd4j {
             }
 
 
+            TraceRecorder::clock::time_point observeStart;
+            if (observe)
+                observeStart = TraceRecorder::clock::now();
+
             Nd4jStatus status;
             bool hasHelper = false;
 
@@ -579,6 +631,17 @@ namespace nd4j {
             if (!hasHelper)
                 status = this->validateAndExecute(*block);
 
+            // always-on statistics, independent of graph profiling below
+            if (observe) {
+                auto observeEnd = TraceRecorder::clock::now();
+                if (statistics->isEnabled()) {
+                    auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(observeEnd - observeStart).count();
+                    statistics->recordExecution(this->getOpHash(), *this->getOpName(), signature, (int) shapes.size(), shapes.data(), nanos);
+                }
+
+                tracer->span(*this->getOpName(), hasHelper ? "helper" : "op", observeStart, observeEnd, "node", block->nodeId());
+            }
+
             // optionally saving execution time
             if (Environment::getInstance()->isProfiling()) {
                 timeEnd = std::chrono::system_clock::now();
@@ -29,6 +29,7 @@
 #include <ops/declarable/CustomOperations.h>
 #include <types/types.h>
 #include <helpers/Loops.h>
+#include <helpers/ParallelSort.h>
 
 namespace nd4j {
 /**
@@ -107,94 +108,197 @@ namespace nd4j {
 //         samediff::Threads::parallel_tad(func, 0, numOfArrs);
 // }
 
-template <typename T>
-void SpecialMethods<T>::concatCpuGeneric(const std::vector<NDArray*>& inArrs, NDArray& output, const int axis) {
+// checks if array occupies dense memory block with given order, unit dimensions may have any stride
+static bool isDenseInOrder(const Nd4jLong* shapeInfo, const char order) {
+    const int rank = shape::rank(shapeInfo);
+    const Nd4jLong* shape = shape::shapeOf(shapeInfo);
+    const Nd4jLong* strides = shape::stride(shapeInfo);
+
+    Nd4jLong expected = 1;
+    for (int i = 0; i < rank; ++i) {
+        const int d = order == 'c' ? rank - 1 - i : i;
+        if (shape[d] == 1)
+            continue;
+        if (strides[d] != expected)
+            return false;
+        expected *= shape[d];
+    }
 
-    const int numOfInArrs = inArrs.size();
-    const auto sizeofT    = output.sizeOfT();
+    return true;
+}
 
-    T* zBuff = output.bufferAsT<T>();
+template <typename T>
+void SpecialMethods<T>::concatCpuGeneric(const std::vector<const void*>& inBuffers, const std::vector<const Nd4jLong*>& inShapeInfos, void *vresult, const Nd4jLong *resultShapeInfo, const int axis) {
+
+    const int numOfInArrs = inBuffers.size();
+    const int rank = shape::rank(resultShapeInfo);
+    const Nd4jLong* zShape = shape::shapeOf(resultShapeInfo);
+    const Nd4jLong* zStrides = shape::stride(resultShapeInfo);
+    T* zBuff = reinterpret_cast<T*>(vresult);
+
+    // start of every input along axis
+    std::vector<Nd4jLong> axisStart(numOfInArrs + 1, 0);
+    for (int i = 0; i < numOfInArrs; ++i)
+        axisStart[i + 1] = axisStart[i] + shape::shapeOf(inShapeInfos[i])[axis];
+
+    // inputs which are already views of their part of output (see helpers::concatViews) don't need copying
+    std::vector<int> toCopy;
+    toCopy.reserve(numOfInArrs);
+    for (int i = 0; i < numOfInArrs; ++i) {
+        if (shape::length(inShapeInfos[i]) == 0)
+            continue;
+
+        bool inPlace = inBuffers[i] == zBuff + axisStart[i] * zStrides[axis];
+        const Nd4jLong* xShape = shape::shapeOf(inShapeInfos[i]);
+        const Nd4jLong* xStrides = shape::stride(inShapeInfos[i]);
+        for (int d = 0; d < rank && inPlace; ++d)
+            inPlace = xShape[d] == 1 || xStrides[d] == zStrides[d];
+
+        if (!inPlace)
+            toCopy.push_back(i);
+    }
 
-    bool luckCase1 = ((axis == 0 && output.ordering() == 'c') || (axis == output.rankOf() - 1 && output.ordering() == 'f')) && output.ews() == 1;
+    if (toCopy.empty())
+        return;
 
-    if(luckCase1) {
-        for (uint i = 0; i < numOfInArrs; ++i) {
-            luckCase1 &= inArrs[i]->ordering() == output.ordering() && inArrs[i]->ews() == 1;
-            if(!luckCase1)
-                break;
-        }
-    }
+    const Nd4jLong numToCopy = toCopy.size();
 
-    if(luckCase1) {     // for example {1,10} + {2,10} + {3,10} = {6, 10} order c; or {10,1} + {10,2} + {10,3} = {10, 6} order f
+    char order = 0;
+    for (const char o : {'c', 'f'}) {
+        bool dense = isDenseInOrder(resultShapeInfo, o);
+        for (int i = 0; i < numOfInArrs && dense; ++i)
+            dense = isDenseInOrder(inShapeInfos[i], o);
 
-        T* z = zBuff;
-        for (uint i = 0; i < numOfInArrs; ++i) {
-            const auto memAmountToCopy = inArrs[i]->lengthOf();
-            memcpy(z, inArrs[i]->bufferAsT<T>(), memAmountToCopy * sizeofT);
-            z += memAmountToCopy;
+        if (dense) {
+            order = o;
+            break;
         }
-        return;
     }
 
-    const bool isZcontin = output.strideAt(axis) == 1 && output.ordering() == 'c';
-    bool areInputsContin = true;
-    bool allSameOrder    = true;
-
-    if(isZcontin) {
-        for (uint i = 0; i < numOfInArrs; ++i) {
-            areInputsContin &= inArrs[i]->strideAt(axis) == 1;
-            allSameOrder    &= inArrs[i]->ordering() == output.ordering();
-            if(!areInputsContin || !allSameOrder)
-                break;
+    if (order != 0) {
+        // every input gives one contiguous run in output per each index of dimensions which are slower than axis,
+        // for example {2,1,3} + {2,5,3} + {2,10,3} = {2,16,3} gives runs of 3, 15 and 30 elements for each of 2 outer indexes
+        Nd4jLong outer = 1, inner = 1;
+        for (int d = 0; d < rank; ++d) {
+            if (d == axis)
+                continue;
+            if ((order == 'c') == (d < axis))
+                outer *= zShape[d];
+            else
+                inner *= zShape[d];
         }
-    }
 
-    const bool luckCase2 = isZcontin && areInputsContin && allSameOrder;
+        const Nd4jLong zRun = zShape[axis] * inner;
+        const Nd4jLong numRuns = outer * numToCopy;
+        // threads count is chosen by amount of copied data, not by number of runs
+        const int numThreads = samediff::ThreadsHelper::numberOfThreads(nd4j::Environment::getInstance()->maxMasterThreads(), shape::length(resultShapeInfo));
+
+        auto copyRun = [&](Nd4jLong r, Nd4jLong from, Nd4jLong to) {
+            const auto o = r / numToCopy;
+            const auto i = toCopy[r % numToCopy];
+            const Nd4jLong xRun = (axisStart[i + 1] - axisStart[i]) * inner;
+            to = nd4j::math::nd4j_min<Nd4jLong>(to, xRun);
+            if (from < to)
+                memcpy(zBuff + o * zRun + axisStart[i] * inner + from, reinterpret_cast<const T*>(inBuffers[i]) + o * xRun + from, (to - from) * sizeof(T));
+        };
 
-    if(luckCase2) {     // for example {2,1,3} + {2,5,3} + {2,10,3} = {2,16,3}, here axis 1 shoud have stride = 1 for all inputs arrays and output array
+        if (numRuns >= numThreads) {
+            auto func = PRAGMA_THREADS_FOR {
+                for (auto r = start; r < stop; r += increment)
+                    copyRun(r, 0, DataTypeUtils::max<Nd4jLong>());
+            };
 
-        const uint zDim       = output.sizeAt(axis);
+            samediff::Threads::parallel_tad(func, 0, numRuns, 1, numThreads);
+        }
+        else {
+            // few long runs: each one is split into chunks
+            for (Nd4jLong r = 0; r < numRuns; ++r) {
+                const auto i = toCopy[r % numToCopy];
+                const Nd4jLong xRun = (axisStart[i + 1] - axisStart[i]) * inner;
 
-        for (uint i = 0; i < output.lengthOf() / zDim; ++i) {
-            T* z = zBuff + zDim * i;
+                auto func = PRAGMA_THREADS_FOR {
+                    copyRun(r, start, stop);
+                };
 
-            for (uint j = 0; j < inArrs.size(); ++j) {
-                const auto xDim = inArrs[j]->sizeAt(axis);
-                const T* x = inArrs[j]->bufferAsT<T>() + xDim * i;
-                memcpy(z, x, xDim * sizeofT);
-                z += xDim;
+                samediff::Threads::parallel_for(func, 0, xRun);
             }
         }
 
         return;
     }
 
-    // general case
-    auto func = PRAGMA_THREADS_FOR {
+    // general case: rows along output dimension with the smallest stride are copied one by one,
+    // so coordinates are evaluated once per row instead of once per element
+    int last = rank - 1;
+    for (int d = 0; d < rank; ++d)
+        if (zShape[d] != 1 && (zShape[last] == 1 || nd4j::math::nd4j_abs<Nd4jLong>(zStrides[d]) < nd4j::math::nd4j_abs<Nd4jLong>(zStrides[last])))
+            last = d;
+
+    // rows of all inputs are enumerated together
+    std::vector<Nd4jLong> rowsStart(numToCopy + 1, 0);
+    for (Nd4jLong j = 0; j < numToCopy; ++j) {
+        const auto i = toCopy[j];
+        rowsStart[j + 1] = rowsStart[j] + shape::length(inShapeInfos[i]) / shape::shapeOf(inShapeInfos[i])[last];
+    }
 
+    auto func = PRAGMA_THREADS_FOR {
         Nd4jLong coords[MAX_RANK];
+        auto j = std::upper_bound(rowsStart.begin(), rowsStart.end(), start) - rowsStart.begin() - 1;
+
+        for (auto r = start; r < stop; r += increment) {
+            while (r >= rowsStart[j + 1])
+                ++j;
+
+            const auto i = toCopy[j];
+            const Nd4jLong* xShape = shape::shapeOf(inShapeInfos[i]);
+            const Nd4jLong* xStrides = shape::stride(inShapeInfos[i]);
+            const T* x = reinterpret_cast<const T*>(inBuffers[i]);
+            T* z = zBuff + axisStart[i] * zStrides[axis];
+
+            // row index -> coordinates over all dimensions except last one
+            Nd4jLong row = r - rowsStart[j];
+            for (int d = rank - 1; d >= 0; --d) {
+                if (d == last) {
+                    coords[d] = 0;
+                    continue;
+                }
+                coords[d] = row % xShape[d];
+                row /= xShape[d];
+            }
 
-        for (auto i = start; i < stop; i += increment) {
-
-            shape::index2coords(i, output.getShapeInfo(), coords);
-            const auto zOffset = shape::getOffset(output.getShapeInfo(), coords);
-
-            uint inArrIdx = 0;
-            uint xDim = inArrs[inArrIdx]->sizeAt(axis);
-
-            while (coords[axis] >= xDim) {
-                coords[axis] -= xDim;
-                xDim = inArrs[++inArrIdx]->sizeAt(axis);
+            Nd4jLong xOffset = 0, zOffset = 0;
+            for (int d = 0; d < rank; ++d) {
+                xOffset += coords[d] * xStrides[d];
+                zOffset += coords[d] * zStrides[d];
             }
 
-            const T* x = inArrs[inArrIdx]->bufferAsT<T>();
-            const auto xOffset = shape::getOffset(inArrs[inArrIdx]->getShapeInfo(), coords);
+            const Nd4jLong xStride = xStrides[last];
+            const Nd4jLong zStride = zStrides[last];
+            const Nd4jLong len = xShape[last];
 
-            zBuff[zOffset] = x[xOffset];
+            if (xStride == 1 && zStride == 1)
+                memcpy(z + zOffset, x + xOffset, len * sizeof(T));
+            else
+                for (Nd4jLong e = 0; e < len; ++e)
+                    z[zOffset + e * zStride] = x[xOffset + e * xStride];
         }
     };
 
-    samediff::Threads::parallel_for(func, 0, output.lengthOf());
+    samediff::Threads::parallel_for(func, 0, rowsStart[numToCopy]);
+}
+
+template <typename T>
+void SpecialMethods<T>::concatCpuGeneric(const std::vector<NDArray*>& inArrs, NDArray& output, const int axis) {
+
+    std::vector<const void*> inBuffers(inArrs.size());
+    std::vector<const Nd4jLong*> inShapeInfos(inArrs.size());
+
+    for (uint i = 0; i < inArrs.size(); ++i) {
+        inBuffers[i] = inArrs[i]->getBuffer();
+        inShapeInfos[i] = inArrs[i]->getShapeInfo();
+    }
+
+    concatCpuGeneric(inBuffers, inShapeInfos, output.getBuffer(), output.getShapeInfo(), axis);
 }
 
 /**
@@ -203,18 +307,13 @@ void SpecialMethods<T>::concatCpuGeneric(const std::vector<NDArray*>& inArrs, ND
 */
 template <typename T>
 void SpecialMethods<T>::concatCpuGeneric(int dimension, int numArrays, Nd4jPointer *data, Nd4jPointer *inputShapeInfo, void *vresult, Nd4jLong *resultShapeInfo) {
-    auto result = reinterpret_cast<T *>(vresult);
-    std::vector<NDArray*> inputs(numArrays);
-
-    NDArray output(static_cast<void*>(result), static_cast<Nd4jLong*>(resultShapeInfo));
+    std::vector<const void*> inBuffers(data, data + numArrays);
+    std::vector<const Nd4jLong*> inShapeInfos(numArrays);
 
     for(int i = 0; i < numArrays; ++i)
-        inputs[i] = new NDArray(static_cast<void *>(data[i]), static_cast<Nd4jLong*>(inputShapeInfo[i]));
-
-    nd4j::SpecialMethods<T>::concatCpuGeneric(inputs, output, dimension);
+        inShapeInfos[i] = reinterpret_cast<const Nd4jLong*>(inputShapeInfo[i]);
 
-    for(int i = 0; i < numArrays; ++i)
-        delete inputs[i];
+    concatCpuGeneric(inBuffers, inShapeInfos, vresult, resultShapeInfo, dimension);
 }
 
 
@@ -316,77 +415,6 @@ void SpecialMethods<T>::concatCpuGeneric(int dimension, int numArrays, Nd4jPoint
             return shape::getIndexOffset(index, xShapeInfo);
     }
 
-    template<typename T>
-    void SpecialMethods<T>::quickSort_parallel_internal(T* array, Nd4jLong *xShapeInfo, int left, int right, int cutoff, bool descending) {
-
-        int i = left, j = right;
-        T tmp;
-        T pivot = array[getPosition(xShapeInfo, (left + right) / 2)];
-
-
-        {
-            /* PARTITION PART */
-            while (i <= j) {
-                if (descending) {
-                    while (array[getPosition(xShapeInfo, i)] > pivot)
-                        i++;
-                    while (array[getPosition(xShapeInfo, j)] < pivot)
-                        j--;
-                    if (i <= j) {
-                        tmp = array[getPosition(xShapeInfo, i)];
-                        array[getPosition(xShapeInfo, i)] = array[getPosition(xShapeInfo, j)];
-                        array[getPosition(xShapeInfo, j)] = tmp;
-                        i++;
-                        j--;
-                    }
-                } else {
-                    while (array[getPosition(xShapeInfo, i)] < pivot)
-                        i++;
-                    while (array[getPosition(xShapeInfo, j)] > pivot)
-                        j--;
-                    if (i <= j) {
-                        tmp = array[getPosition(xShapeInfo, i)];
-                        array[getPosition(xShapeInfo, i)] = array[getPosition(xShapeInfo, j)];
-                        array[getPosition(xShapeInfo, j)] = tmp;
-                        i++;
-                        j--;
-                    }
-                }
-            }
-
-        }
-
-        //
-
-        if ( ((right-left)<cutoff) ){
-            if (left < j){ quickSort_parallel_internal(array, xShapeInfo, left, j, cutoff, descending); }
-            if (i < right){ quickSort_parallel_internal(array, xShapeInfo, i, right, cutoff, descending); }
-
-        }else{
-PRAGMA_OMP_TASK
-            { quickSort_parallel_internal(array, xShapeInfo, left, j, cutoff, descending); }
-PRAGMA_OMP_TASK
-            { quickSort_parallel_internal(array, xShapeInfo, i, right, cutoff, descending); }
-        }
-    }
-
-    template<typename T>
-    void SpecialMethods<T>::quickSort_parallel(void *varray, Nd4jLong *xShapeInfo, Nd4jLong lenArray, int numThreads, bool descending){
-        auto array = reinterpret_cast<T *>(varray);
-        int cutoff = 1000;
-
-        PRAGMA_OMP_PARALLEL_THREADS(numThreads)
-        {
-PRAGMA_OMP_SINGLE_ARGS(nowait)
-            {
-                quickSort_parallel_internal(array, xShapeInfo, 0, lenArray-1, cutoff, descending);
-            }
-        }
-
-    }
-
-
-
     template <typename T>
     int SpecialMethods<T>::nextPowerOf2(int number) {
         int pos = 0;
@@ -413,23 +441,23 @@ PRAGMA_OMP_SINGLE_ARGS(nowait)
     void SpecialMethods<T>::sortGeneric(void *vx, Nd4jLong *xShapeInfo, bool descending) {
         auto x = reinterpret_cast<T *>(vx);
 
-        quickSort_parallel(x, xShapeInfo, shape::length(xShapeInfo), omp_get_max_threads(), descending);
+        ParallelSort::sort<T>(x, xShapeInfo, descending);
     }
 
     template<typename T>
     void SpecialMethods<T>::sortTadGeneric(void *vx, Nd4jLong *xShapeInfo, int *dimension, int dimensionLength, Nd4jLong *tadShapeInfo, Nd4jLong *tadOffsets, bool descending) {
         auto x = reinterpret_cast<T *>(vx);
 
-        //quickSort_parallel(x, xShapeInfo, shape::length(xShapeInfo), omp_get_max_threads(), descending);
         Nd4jLong xLength = shape::length(xShapeInfo);
         Nd4jLong xTadLength = shape::tadLength(xShapeInfo, dimension, dimensionLength);
-        int numTads = xLength / xTadLength;
+        Nd4jLong numTads = xLength / xTadLength;
 
+        // tads are distributed between threads, each one is sorted within its thread
         auto func = PRAGMA_THREADS_FOR {
             for (auto r = start; r < stop; r++) {
                 T *dx = x + tadOffsets[r];
 
-                quickSort_parallel(dx, tadShapeInfo, xTadLength, 1, descending);
+                ParallelSort::sort<T>(dx, tadShapeInfo, descending, 1);
             }
         };
         samediff::Threads::parallel_tad(func, 0, numTads);
@@ -516,5 +544,103 @@ PRAGMA_OMP_SINGLE_ARGS(nowait)
         };
         return samediff::Threads::parallel_long(func, LAMBDA_SUML, 0, N, 16);
     }
-}
 
+    /**
+     * Threshold encoding, phase 1: number of eligible elements is counted for each block of THRESHOLD_BLOCK_SIZE elements
+     * dz[0] receives total count, dz[b + 1] receives count for block b
+     */
+    template<typename T>
+    void SpecialMethods<T>::encodeThresholdP1Generic(void *vx, Nd4jLong N, int *dz, float threshold) {
+        auto dx = reinterpret_cast<T *>(vx);
+        const auto tt = static_cast<T>(threshold);
+        const Nd4jLong numBlocks = N / THRESHOLD_BLOCK_SIZE + (N % THRESHOLD_BLOCK_SIZE ? 1 : 0);
+
+        auto func = PRAGMA_REDUCE_LONG {
+            int64_t total = 0;
+
+            for (auto b = start; b < stop; b++) {
+                const auto bStart = b * THRESHOLD_BLOCK_SIZE;
+                const auto bStop = nd4j::math::nd4j_min<Nd4jLong>(bStart + THRESHOLD_BLOCK_SIZE, N);
+
+                int cnt = 0;
+                PRAGMA_OMP_SIMD_ARGS(reduction(+:cnt))
+                for (Nd4jLong e = bStart; e < bStop; e++)
+                    cnt += nd4j::math::nd4j_abs<T>(dx[e]) >= tt ? 1 : 0;
+
+                dz[b + 1] = cnt;
+                total += cnt;
+            }
+
+            return total;
+        };
+
+        dz[0] = static_cast<int>(samediff::Threads::parallel_long(func, LAMBDA_SUML, 0, numBlocks));
+    }
+
+    /**
+     * Threshold encoding, phase 3: eligible elements are written to encoded buffer, starting from per-block offsets produced by phase 2
+     * Order of elements within the block is preserved, so result is identical to CUDA encoder
+     */
+    template<typename T>
+    void SpecialMethods<T>::encodeThresholdP3Generic(void *vx, int *offsets, Nd4jLong N, int *dz) {
+        auto dx = reinterpret_cast<T *>(vx);
+        const Nd4jLong numBlocks = N / THRESHOLD_BLOCK_SIZE + (N % THRESHOLD_BLOCK_SIZE ? 1 : 0);
+
+        // first 4 ints are header: encoded length, dense length, threshold, reserved
+        FloatBits2 fb;
+        fb.i_ = dz[2];
+        const int flimit = dz[0] + 4;
+        const auto tt = static_cast<T>(fb.f_);
+        auto z = dz + 4;
+
+        auto func = PRAGMA_THREADS_FOR {
+            for (auto b = start; b < stop; b++) {
+                const auto bStart = b * THRESHOLD_BLOCK_SIZE;
+                const auto bStop = nd4j::math::nd4j_min<Nd4jLong>(bStart + THRESHOLD_BLOCK_SIZE, N);
+
+                int idx = offsets[b];
+                for (Nd4jLong e = bStart; e < bStop && idx + 4 < flimit; e++) {
+                    const T value = dx[e];
+                    if (nd4j::math::nd4j_abs<T>(value) < tt)
+                        continue;
+
+                    if (value > static_cast<T>(0.0f)) {
+                        z[idx++] = static_cast<int>(e + 1);
+                        dx[e] = value - tt;
+                    } else {
+                        z[idx++] = static_cast<int>(-(e + 1));
+                        dx[e] = value + tt;
+                    }
+                }
+            }
+        };
+
+        samediff::Threads::parallel_for(func, 0, numBlocks);
+    }
+
+    /**
+     * This method decodes threshold-encoded buffer, accumulating decoded values into dz
+     */
+    template<typename T>
+    void SpecialMethods<T>::decodeThresholdGeneric(void *vx, Nd4jLong N, void *vz) {
+        auto x = reinterpret_cast<int *>(vx);
+        auto z = reinterpret_cast<T *>(vz);
+
+        FloatBits2 fb;
+        fb.i_ = x[2];
+        const int limit = x[0];
+        const auto tt = static_cast<T>(fb.f_);
+        const auto mtt = static_cast<T>(-fb.f_);
+
+        // indices within encoded buffer are unique, so there's no races here
+        auto func = PRAGMA_THREADS_FOR {
+            for (auto e = start; e < stop; e++) {
+                const int el = x[e + 4];
+                const int ael = nd4j::math::nd4j_abs<int>(el) - 1;
+                z[ael] += el > 0 ? tt : mtt;
+            }
+        };
+
+        samediff::Threads::parallel_for(func, 0, limit);
+    }
+}
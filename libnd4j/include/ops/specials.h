@@ -30,6 +30,9 @@
 #include <pointercast.h>
 #include <vector>
 
+// number of elements covered by single entry of threshold encoding P1/P2 buffers, must match CUDA block size
+#define THRESHOLD_BLOCK_SIZE 1024
+
 namespace nd4j {
     class NDArray;
 
@@ -52,12 +55,15 @@ namespace nd4j {
     public:
         static void concatCpuGeneric(const std::vector<NDArray*>& inArrs, NDArray& output, const int axis);
         static void concatCpuGeneric(int dimension, int numArrays, Nd4jPointer *data, Nd4jPointer *inputShapeInfo, void *result, Nd4jLong *resultShapeInfo);
+        /**
+         * Concatenates inputs along axis directly into output buffer. Only rank, shape and strides of shapeInfos are used,
+         * inputs which are views of their own part of output are not copied
+         */
+        static void concatCpuGeneric(const std::vector<const void*>& inBuffers, const std::vector<const Nd4jLong*>& inShapeInfos, void *result, const Nd4jLong *resultShapeInfo, const int axis);
         static void accumulateGeneric(void **x, void *z, Nd4jLong *zShapeInfo, int n, const Nd4jLong length);
         static void averageGeneric(void **x, void *z, Nd4jLong  *zShapeInfo, int n, const Nd4jLong length, bool propagate);
 
         static Nd4jLong getPosition(Nd4jLong *xShapeInfo, Nd4jLong index);
-        static void quickSort_parallel_internal(T* array, Nd4jLong *xShapeInfo, int left, int right, int cutoff, bool descending);
-        static void quickSort_parallel(void* array, Nd4jLong *xShapeInfo, Nd4jLong lenArray, int numThreads, bool descending);
 
         static int nextPowerOf2(int number);
         static int lastPowerOf2(int number);
@@ -67,6 +73,10 @@ namespace nd4j {
 
         static void decodeBitmapGeneric(void *dx, Nd4jLong N, void *dz, Nd4jLong *zShapeInfo);
         static Nd4jLong encodeBitmapGeneric(void *dx, Nd4jLong *zShapeInfo, Nd4jLong N, int *dz, float threshold);
+
+        static void encodeThresholdP1Generic(void *dx, Nd4jLong N, int *dz, float threshold);
+        static void encodeThresholdP3Generic(void *dx, int *offsets, Nd4jLong N, int *dz);
+        static void decodeThresholdGeneric(void *dx, Nd4jLong N, void *dz);
     };
 
     template <typename X, typename Y>
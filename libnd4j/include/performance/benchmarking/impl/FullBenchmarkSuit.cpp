@@ -21,7 +21,10 @@
 #include <ops/declarable/CustomOperations.h>
 #include <performance/benchmarking/FullBenchmarkSuit.h>
 #include <ops/declarable/LegacyRandomOp.h>
+#include <helpers/RandomLauncher.h>
 #include <algorithm>
+#include <thread>
+#include <execution/Threads.h>
 
 #ifdef RELEASE_BUILD
     int wIterations = 4;
@@ -537,7 +540,16 @@ namespace nd4j {
             return ctx;
         };
 
+        // generic implementation is benchmarked both with full im2col buffer and with tiled im2col
+        auto tiled = Environment::getInstance()->isUseTiledConvolutions();
+
+        Environment::getInstance()->setUseTiledConvolutions(false);
         output += helper.runOperationSuit(&benchmark, generator, batch, "Conv2d Operation");
+
+        Environment::getInstance()->setUseTiledConvolutions(true);
+        output += helper.runOperationSuit(&benchmark, generator, batch, "Conv2d Operation - tiled");
+
+        Environment::getInstance()->setUseTiledConvolutions(tiled);
         return output;
     }
 
@@ -811,6 +823,109 @@ namespace nd4j {
             }
         }
 
+        // data types without BLAS support, these go through fallback gemm
+        for (auto dtype : {DataType::HALF, DataType::BFLOAT16, DataType::INT8, DataType::INT16}) {
+            IntPowerParameters pa("sz", 2, 7, gemmRegularUpperPow, 2);
+
+            ParametersBatch b({&pa});
+
+            auto generator = PARAMETRIC_XYZ() {
+                auto s = p.getIntParam("sz");
+                auto A = NDArrayFactory::create_('c', {s, s}, dtype);
+                auto B = NDArrayFactory::create_('c', {s, s}, dtype);
+                auto C = NDArrayFactory::create_('f', {s, s}, dtype);
+
+                x.push_back(A);
+                y.push_back(B);
+                z.push_back(C);
+            };
+
+            std::string n;
+            n += "Gemm - dtype=";
+            n += DataTypeUtils::asString(dtype);
+
+            MatrixBenchmark mb(1.0, 0.0, false, false, n);
+
+            output += helper.runOperationSuit(&mb, generator, b, n.c_str());
+        }
+
+        return output;
+    }
+
+#ifndef __CUDABLAS__
+    static std::string encodingBenchmark() {
+        std::string output;
+        BenchmarkHelper helper(wIterations, rIterations);
+
+        const float threshold = 1e-3f;
+
+        // fraction of elements above threshold
+        for (auto density : {0.001, 0.01, 0.1, 0.5}) {
+            std::string n;
+            n += "Encoding - density=";
+            n += std::to_string(density);
+
+            for (int p = 10; p <= limit24; p += 2) {
+                Nd4jLong length = 1L << p;
+
+                // values are uniform in [-r, r], with r chosen so that |v| >= threshold with given probability
+                auto x = NDArrayFactory::create_<float>('c', {length});
+                nd4j::graph::RandomGenerator rng(119, 5);
+                auto range = threshold / (1.0 - density);
+                RandomLauncher::fillUniform(LaunchContext::defaultContext(), rng, x, -range, range);
+
+                EncodingBenchmark tb(true, threshold, "threshold - density=" + std::to_string(density), x, NDArrayFactory::create_<float>('c', {length}));
+                EncodingBenchmark bb(false, threshold, "bitmap - density=" + std::to_string(density), new NDArray(x->dup()), NDArrayFactory::create_<float>('c', {length}));
+
+                std::vector<OpBenchmark*> list({&tb, &bb});
+                output += helper.runOperationSuit(list, p == 10, n.c_str());
+            }
+        }
+
+        return output;
+    }
+#endif
+
+    static std::string concurrentCallersBenchmark() {
+        std::string output;
+        output += "\nConcurrent parallel_for callers\n";
+        output += "Callers\tRegions per caller\tLength\ttotal (us)\tregions/s\n";
+
+        const Nd4jLong length = 1L << limit20;
+        const int regions = rIterations * 10;
+
+        for (int numCallers : {1, 2, 4, 8}) {
+            std::vector<std::vector<float>> buffers(numCallers, std::vector<float>(length, 1.0f));
+            std::vector<std::thread> callers;
+
+            auto timeStart = std::chrono::system_clock::now();
+
+            for (int c = 0; c < numCallers; c++) {
+                callers.emplace_back([&buffers, c, regions, length] {
+                    auto buffer = buffers[c].data();
+
+                    for (int r = 0; r < regions; r++) {
+                        auto func = PRAGMA_THREADS_FOR {
+                            PRAGMA_OMP_SIMD
+                            for (auto e = start; e < stop; e++)
+                                buffer[e] = buffer[e] * 1.0001f + 0.5f;
+                        };
+
+                        samediff::Threads::parallel_for(func, 0, length);
+                    }
+                });
+            }
+
+            for (auto &t : callers)
+                t.join();
+
+            auto timeEnd = std::chrono::system_clock::now();
+            auto time = std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count();
+
+            output += std::to_string(numCallers) + "\t" + std::to_string(regions) + "\t" + std::to_string(length) + "\t" + std::to_string(time) + "\t";
+            output += std::to_string(time > 0 ? (double) numCallers * regions * 1e6 / time : 0.0) + "\n";
+        }
+
         return output;
     }
 
@@ -1875,6 +1990,9 @@ namespace nd4j {
 
 
         // set 3
+        nd4j_printf("Running FullBenchmarkSuite.concurrentCallersBenchmark\n", "");
+        result += concurrentCallersBenchmark();
+        start = done(start);
         nd4j_printf("Running FullBenchmarkSuite.gatherOpBenchmark\n", "");
         result += gatherOpBenchmark();
         start = done(start);
@@ -1886,6 +2004,11 @@ namespace nd4j {
         nd4j_printf("Running FullBenchmarkSuite.gemmRegularBenchmark\n", "");
         result += gemmRegularBenchmark();
         start = done(start);
+#ifndef __CUDABLAS__
+        nd4j_printf("Running FullBenchmarkSuite.encodingBenchmark\n", "");
+        result += encodingBenchmark();
+        start = done(start);
+#endif
         nd4j_printf("Running FullBenchmarkSuite.gemmIrregularBenchmark\n", "");
         result += gemmIrregularBenchmark();
         start = done(start);
@@ -26,10 +26,10 @@
 #include <algorithm>
 #include <stdexcept>
 
-#include <graph/exceptions/unknown_graph_exception.h>
-#include <graph/exceptions/graph_exists_exception.h>
-#include <graph/exceptions/no_results_exception.h>
-#include <graph/exceptions/graph_execution_exception.h>
+#include <exceptions/unknown_graph_exception.h>
+#include <exceptions/graph_exists_exception.h>
+#include <exceptions/no_results_exception.h>
+#include <exceptions/graph_execution_exception.h>
 
 
 
@@ -37,18 +37,18 @@ namespace nd4j {
     namespace graph {
             grpc::Status GraphInferenceServerImpl::RegisterGraph( grpc::ServerContext *context, const flatbuffers::grpc::Message<FlatGraph> *request_msg, flatbuffers::grpc::Message<FlatResponse> *response_msg) {
                 auto flat_graph = request_msg->GetRoot();
+                flatbuffers::grpc::MessageBuilder mb;
 
                 try {
-                    // building our graph
-                    auto graph = new Graph<float>(flat_graph);
+                    // building our graph, data types are defined per variable, so any graph goes here
+                    auto graph = new Graph(flat_graph);
 
-                    // single data type for now
-                    GraphHolder::getInstance()->registerGraph<float>(flat_graph->id(), graph);
+                    GraphHolder::getInstance()->registerGraph(flat_graph->id(), graph);
 
                     // sending out OK response
-                    auto response_offset = CreateFlatResponse(mb_, 0);
-                    mb_.Finish(response_offset);
-                    *response_msg = mb_.ReleaseMessage<FlatResponse>();
+                    auto response_offset = CreateFlatResponse(mb, 0);
+                    mb.Finish(response_offset);
+                    *response_msg = mb.ReleaseMessage<FlatResponse>();
                     assert(response_msg->Verify());
 
                     return grpc::Status::OK;
@@ -60,22 +60,22 @@ namespace nd4j {
 
             grpc::Status GraphInferenceServerImpl::ReplaceGraph( grpc::ServerContext *context, const flatbuffers::grpc::Message<FlatGraph> *request_msg, flatbuffers::grpc::Message<FlatResponse> *response_msg) {
                 auto flat_graph = request_msg->GetRoot();
+                flatbuffers::grpc::MessageBuilder mb;
 
                 try {
                     // building our graph
-                    auto graph = new Graph<float>(flat_graph);
+                    auto graph = new Graph(flat_graph);
 
-                    // single data type for now
                     GraphHolder::getInstance()->replaceGraph(flat_graph->id(), graph);
 
                     // sending out OK response
-                    auto response_offset = CreateFlatResponse(mb_, 0);
-                    mb_.Finish(response_offset);
-                    *response_msg = mb_.ReleaseMessage<FlatResponse>();
+                    auto response_offset = CreateFlatResponse(mb, 0);
+                    mb.Finish(response_offset);
+                    *response_msg = mb.ReleaseMessage<FlatResponse>();
                     assert(response_msg->Verify());
 
                     return grpc::Status::OK;
-                } catch (nd4j::graph::unknown_graph_exception &e) {
+                } catch (nd4j::unknown_graph_exception &e) {
                     grpc::string gmsg(e.message());
                     return grpc::Status(grpc::StatusCode::NOT_FOUND, gmsg);
                 } catch (std::runtime_error &e) {
@@ -85,6 +85,7 @@ namespace nd4j {
             }
 
             grpc::Status GraphInferenceServerImpl::ForgetGraph( grpc::ServerContext *context, const flatbuffers::grpc::Message<FlatDropRequest> *request_msg, flatbuffers::grpc::Message<FlatResponse> *response_msg) {
+                flatbuffers::grpc::MessageBuilder mb;
                 try {
 
                     // getting drop request
@@ -94,13 +95,13 @@ namespace nd4j {
                     GraphHolder::getInstance()->dropGraphAny(request->id());
 
                     // sending out OK response
-                    auto response_offset = CreateFlatResponse(mb_, 0);
-                    mb_.Finish(response_offset);
-                    *response_msg = mb_.ReleaseMessage<FlatResponse>();
+                    auto response_offset = CreateFlatResponse(mb, 0);
+                    mb.Finish(response_offset);
+                    *response_msg = mb.ReleaseMessage<FlatResponse>();
                     assert(response_msg->Verify());
 
                     return grpc::Status::OK;
-                } catch (nd4j::graph::unknown_graph_exception &e) {
+                } catch (nd4j::unknown_graph_exception &e) {
                     grpc::string gmsg(e.message());
                     return grpc::Status(grpc::StatusCode::NOT_FOUND, gmsg);
                 }
@@ -109,22 +110,24 @@ namespace nd4j {
             grpc::Status GraphInferenceServerImpl::InferenceRequest( grpc::ServerContext *context, const flatbuffers::grpc::Message<FlatInferenceRequest> *request_msg, flatbuffers::grpc::Message<FlatResult> *response_msg) {
                 auto request = request_msg->GetRoot();
 
+                // handlers are called concurrently, so every call gets its own builder
+                flatbuffers::grpc::MessageBuilder mb;
                 try {
                     // GraphHolder
-                    auto response_offset = GraphHolder::getInstance()->execute(request->id(), mb_, request);
+                    auto response_offset = GraphHolder::getInstance()->execute(request->id(), mb, request);
 
-                    mb_.Finish(response_offset);
-                    *response_msg = mb_.ReleaseMessage<FlatResult>();
+                    mb.Finish(response_offset);
+                    *response_msg = mb.ReleaseMessage<FlatResult>();
                     assert(response_msg->Verify());
 
                     return grpc::Status::OK;
-                } catch (nd4j::graph::no_results_exception &e) {
+                } catch (nd4j::no_results_exception &e) {
                     grpc::string gmsg(e.message());
                     return grpc::Status(grpc::StatusCode::INTERNAL, gmsg);
-                } catch (nd4j::graph::unknown_graph_exception &e) {
+                } catch (nd4j::unknown_graph_exception &e) {
                     grpc::string gmsg(e.message());
                     return grpc::Status(grpc::StatusCode::NOT_FOUND, gmsg);
-                } catch (nd4j::graph::graph_execution_exception &e) {
+                } catch (nd4j::graph_execution_exception &e) {
                     grpc::string gmsg(e.message());
                     return grpc::Status(grpc::StatusCode::INTERNAL, gmsg);
                 } catch (std::runtime_error &e) {
@@ -180,8 +183,19 @@ int main(int argc, char *argv[]) {
 
     if(cmdOptionExists(argv, argv+argc, "-f")) {
         auto file = getCmdOption(argv, argv + argc, "-f");
-        auto graph = GraphExecutioner<float>::importFromFlatBuffers(file);
-        nd4j::graph::GraphHolder::getInstance()->registerGraph<float>(0L, graph);
+        auto graph = nd4j::graph::GraphExecutioner::importFromFlatBuffers(file);
+        nd4j::graph::GraphHolder::getInstance()->registerGraph(0L, graph);
+    }
+
+    // dynamic batching: latency window in microseconds, and max number of rows per batch
+    if(cmdOptionExists(argv, argv+argc, "-b")) {
+        auto sWindow = getCmdOption(argv, argv + argc, "-b");
+        nd4j::graph::GraphHolder::getInstance()->batcher().setWindow(atol(sWindow));
+    }
+
+    if(cmdOptionExists(argv, argv+argc, "-m")) {
+        auto sRows = getCmdOption(argv, argv + argc, "-m");
+        nd4j::graph::GraphHolder::getInstance()->batcher().setMaxBatchSize(atol(sRows));
     }
 
     RunServer(port);
@@ -29,8 +29,6 @@
 namespace nd4j {
     namespace graph {
         class GraphInferenceServerImpl final : public GraphInferenceServer::Service {
-        private:
-            flatbuffers::grpc::MessageBuilder mb_;
         public:
             virtual grpc::Status RegisterGraph( grpc::ServerContext *context, const flatbuffers::grpc::Message<FlatGraph> *request_msg, flatbuffers::grpc::Message<FlatResponse> *response_msg);
 
@@ -62,6 +62,49 @@ TEST_F(HeaderTest, test_dataTypes_4) {
     ASSERT_EQ(nd4j::DataType::UINT16, dataTypeFromNpyHeader(const_cast<char *>(header.data())));
 }
 
+TEST_F(FileTest, test_npz_map_1) {
+    auto map = mapFromNpzFile("./resources/stored_2_arrays.npz");
+    ASSERT_EQ(2, getNumNpyArraysInMap(map));
+
+    auto a = getNpyArrayFromMap(map, 0);
+    auto b = getNpyArrayFromMap(map, 1);
+
+    // arrays taken from map keep mapping alive on their own
+    deleteNPArrayMap(map);
+
+    ASSERT_EQ(2, getNpyArrayRank(a));
+    ASSERT_EQ(4, getNpyArrayElemSize(a));
+    ASSERT_EQ('c', getNpyArrayOrder(a));
+    ASSERT_NEAR(5.f, reinterpret_cast<float *>(getNpyArrayData(a))[5], 1e-5f);
+
+    ASSERT_EQ(1, getNpyArrayRank(b));
+    auto bData = reinterpret_cast<int *>(getNpyArrayData(b));
+    ASSERT_EQ(1, bData[0]);
+    ASSERT_EQ(3, bData[2]);
+
+    deleteNPArrayStruct(a);
+    deleteNPArrayStruct(b);
+}
+
+TEST_F(HeaderTest, test_scalar_header_1) {
+    unsigned int *shape;
+    unsigned int ndims, wordSize;
+    bool fortranOrder, isScalar;
+
+    cnpy::parseNpyHeaderStr("{'descr': '<f4', 'fortran_order': False, 'shape': (), }", wordSize, shape, ndims, fortranOrder, isScalar);
+    ASSERT_TRUE(isScalar);
+    ASSERT_EQ(1, ndims);
+    ASSERT_EQ(0, shape[0]);
+    delete[] shape;
+
+    // empty array has the same {0} shape, but it's not a scalar
+    cnpy::parseNpyHeaderStr("{'descr': '<f4', 'fortran_order': False, 'shape': (0,), }", wordSize, shape, ndims, fortranOrder, isScalar);
+    ASSERT_FALSE(isScalar);
+    ASSERT_EQ(1, ndims);
+    ASSERT_EQ(0, shape[0]);
+    delete[] shape;
+}
+
 /*
 TEST_F(FileTest,T) {
     cnpy::NpyArray npy = cnpy::npyLoad(std::string("/home/agibsonccc/code/libnd4j/test.npy"));
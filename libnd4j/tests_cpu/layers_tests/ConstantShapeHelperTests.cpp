@@ -75,6 +75,38 @@ TEST_F(ConstantTadHelperTests, test_cachedAmount_1) {
     ASSERT_EQ(ttlMiddle, ttlAfter);
 }
 
+TEST_F(ConstantShapeHelperTests, test_cacheStats_1) {
+    ShapeDescriptor descriptor(nd4j::DataType::INT16, 'c', {3, 19, 7, 29});
+
+    auto missesBefore = ConstantShapeHelper::getInstance()->cacheMisses();
+    auto bytesBefore = ConstantShapeHelper::getInstance()->cachedBytes();
+
+    auto bufferA = ConstantShapeHelper::getInstance()->bufferForShapeInfo(descriptor);
+
+    auto hitsMiddle = ConstantShapeHelper::getInstance()->cacheHits();
+    ASSERT_EQ(missesBefore + 1, ConstantShapeHelper::getInstance()->cacheMisses());
+    ASSERT_TRUE(ConstantShapeHelper::getInstance()->cachedBytes() > bytesBefore);
+
+    auto bufferB = ConstantShapeHelper::getInstance()->bufferForShapeInfo(descriptor);
+
+    ASSERT_TRUE(bufferA.primary() == bufferB.primary());
+    ASSERT_TRUE(ConstantShapeHelper::getInstance()->cacheHits() > hitsMiddle);
+    ASSERT_EQ(missesBefore + 1, ConstantShapeHelper::getInstance()->cacheMisses());
+}
+
+TEST_F(ConstantTadHelperTests, test_cacheStats_1) {
+    auto array = NDArrayFactory::create<float>('c', {5, 13, 3, 11});
+
+    auto missesBefore = ConstantTadHelper::getInstance()->cacheMisses();
+
+    auto packA = ConstantTadHelper::getInstance()->tadForDimensions(array.shapeInfo(), {1, 3});
+    auto packB = ConstantTadHelper::getInstance()->tadForDimensions(array.shapeInfo(), {1, 3});
+
+    ASSERT_EQ(missesBefore + 1, ConstantTadHelper::getInstance()->cacheMisses());
+    ASSERT_TRUE(packA.primaryOffsets() == packB.primaryOffsets());
+    ASSERT_EQ(15, packA.numberOfTads());
+}
+
 TEST_F(ConstantShapeHelperTests, basic_test_1) {
     auto ptr = ShapeBuilders::createShapeInfo(nd4j::DataType::BFLOAT16, 'f', {5, 10, 15});
     ShapeDescriptor descriptor(ptr);
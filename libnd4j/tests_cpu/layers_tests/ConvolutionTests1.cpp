@@ -318,6 +318,110 @@ TEST_F(ConvolutionTests1, conv2d_8) {
     delete results;
 }
 
+//////////////////////////////////////////////////////////////////////
+// tiled and im2col-based conv2d/conv2d_bp must produce same results
+TEST_F(ConvolutionTests1, conv2d_tiled_1) {
+
+    int bS=3, iH=7,iW=6,  iC=3,oC=4,  kH=3,kW=2,  sH=2,sW=1,  pH=0,pW=0,  dH=1,dW=2;
+    int paddingMode = 1;             // 1-SAME, 0-VALID;
+
+    for (int dataFormat = 0; dataFormat <= 1; dataFormat++) {
+
+        const bool isNCHW = dataFormat == 0;
+        const int oH = (iH + sH - 1) / sH;
+        const int oW = iW;
+
+        NDArray input  = isNCHW ? NDArrayFactory::create<float>('c', {bS, iC, iH, iW}) : NDArrayFactory::create<float>('c', {bS, iH, iW, iC});
+        NDArray gradO  = isNCHW ? NDArrayFactory::create<float>('c', {bS, oC, oH, oW}) : NDArrayFactory::create<float>('c', {bS, oH, oW, oC});
+        NDArray weights = NDArrayFactory::create<float>('c', {kH, kW, iC, oC});
+        NDArray bias    = NDArrayFactory::create<float>('c', {oC}, {1, -2, 3, -4});
+
+        input.linspace(-5, 0.1);
+        gradO.linspace(3, -0.05);
+        weights.linspace(-1, 0.03);
+
+        nd4j::ops::conv2d op;
+        nd4j::ops::conv2d_bp opBP;
+
+        nd4j::Environment::getInstance()->setUseTiledConvolutions(false);
+        auto expected   = op.evaluate({&input, &weights, &bias}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat});
+        auto expectedBP = opBP.evaluate({&input, &weights, &bias, &gradO}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat});
+
+        nd4j::Environment::getInstance()->setUseTiledConvolutions(true);
+        auto result   = op.evaluate({&input, &weights, &bias}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat});
+        auto resultBP = opBP.evaluate({&input, &weights, &bias, &gradO}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat});
+
+        ASSERT_EQ(Status::OK(), expected->status());
+        ASSERT_EQ(Status::OK(), result->status());
+        ASSERT_EQ(Status::OK(), expectedBP->status());
+        ASSERT_EQ(Status::OK(), resultBP->status());
+
+        ASSERT_TRUE(expected->at(0)->isSameShape(result->at(0)));
+        ASSERT_TRUE(expected->at(0)->equalsTo(result->at(0)));
+
+        for (int e = 0; e < 3; e++) {
+            ASSERT_TRUE(expectedBP->at(e)->isSameShape(resultBP->at(e)));
+            ASSERT_TRUE(expectedBP->at(e)->equalsTo(resultBP->at(e)));
+        }
+
+        delete expected;
+        delete expectedBP;
+        delete result;
+        delete resultBP;
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+// NHWC output spans several column tiles, tile boundaries fall in the middle of image rows
+TEST_F(ConvolutionTests1, conv2d_tiled_2) {
+
+    int bS=2, iH=64,iW=64,  iC=32,oC=8,  kH=3,kW=3,  sH=1,sW=1,  pH=0,pW=0,  dH=1,dW=1;
+    int       oH=64,oW=64;
+    int paddingMode = 1;             // 1-SAME, 0-VALID;
+    int dataFormat  = 1;             // 1-NHWC, 0-NCHW
+
+    NDArray input('c', {bS, iH, iW, iC}, nd4j::DataType::DOUBLE);
+    NDArray gradO('c', {bS, oH, oW, oC}, nd4j::DataType::DOUBLE);
+    NDArray weights('c', {kH, kW, iC, oC}, nd4j::DataType::DOUBLE);
+    NDArray bias('c', {oC}, {1, -2, 3, -4, 5, -6, 7, -8}, nd4j::DataType::DOUBLE);
+
+    input.linspace(-1, 1e-4);
+    gradO.linspace(2, -1e-4);
+    weights.linspace(-0.5, 0.001);
+
+    // columns of the whole output don't fit into single tile
+    ASSERT_TRUE((Nd4jLong) bS * oH * oW * kH * kW * iC > 2 * (1 << 20));
+
+    nd4j::ops::conv2d op;
+    nd4j::ops::conv2d_bp opBP;
+
+    nd4j::Environment::getInstance()->setUseTiledConvolutions(false);
+    auto expected   = op.evaluate({&input, &weights, &bias}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat});
+    auto expectedBP = opBP.evaluate({&input, &weights, &bias, &gradO}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat});
+
+    nd4j::Environment::getInstance()->setUseTiledConvolutions(true);
+    auto result   = op.evaluate({&input, &weights, &bias}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat});
+    auto resultBP = opBP.evaluate({&input, &weights, &bias, &gradO}, {kH,kW,  sH,sW,  pH,pW,  dH,dW, paddingMode, dataFormat});
+
+    ASSERT_EQ(Status::OK(), expected->status());
+    ASSERT_EQ(Status::OK(), result->status());
+    ASSERT_EQ(Status::OK(), expectedBP->status());
+    ASSERT_EQ(Status::OK(), resultBP->status());
+
+    ASSERT_TRUE(expected->at(0)->isSameShape(result->at(0)));
+    ASSERT_TRUE(expected->at(0)->equalsTo(result->at(0)));
+
+    for (int e = 0; e < 3; e++) {
+        ASSERT_TRUE(expectedBP->at(e)->isSameShape(resultBP->at(e)));
+        ASSERT_TRUE(expectedBP->at(e)->equalsTo(resultBP->at(e)));
+    }
+
+    delete expected;
+    delete expectedBP;
+    delete result;
+    delete resultBP;
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(ConvolutionTests1, sconv2d_1) {
     float _expB[] = {10025.0f,    10350.0f,    10675.0f,    11000.0f,    11325.0f,    11650.0f,    13275.0f,    13600.0f,    13925.0f,    14250.0f,    14575.0f,    14900.0f,    16525.0f,    16850.0f,    17175.0f,    17500.0f,    17825.0f,    18150.0f,    19775.0f,    20100.0f,    20425.0f,    20750.0f,    21075.0f,    21400.0f,    23025.0f,    23350.0f,    23675.0f,    24000.0f,    24325.0f,    24650.0f,    26275.0f,    26600.0f,    26925.0f,    27250.0f,    27575.0f,    27900.0f,    38775.0f,    40350.0f,    41925.0f,    43500.0f,    45075.0f,    46650.0f,    54525.0f,    56100.0f,    57675.0f,    59250.0f,    60825.0f,    62400.0f,    70275.0f,    71850.0f,    73425.0f,    75000.0f,    76575.0f,    78150.0f,    86025.0f,    87600.0f,    89175.0f,    90750.0f,    92325.0f,    93900.0f,   101775.0f,   103350.0f,   104925.0f,    106500.0f,   108075.0f,   109650.0f,   117525.0f,   119100.0f,   120675.0f,   122250.0f,    123825.0f,   125400.0f,    67525.0f,    70350.0f,    73175.0f,    76000.0f,    78825.0f,    81650.0f,    95775.0f,    98600.0f,   101425.0f,   104250.0f,   107075.0f,   109900.0f,    124025.0f,   126850.0f,   129675.0f,   132500.0f,   135325.0f,   138150.0f,   152275.0f,    155100.0f,   157925.0f,   160750.0f,   163575.0f,   166400.0f,   180525.0f,   183350.0f,    186175.0f,   189000.0f,   191825.0f,   194650.0f,   208775.0f,   211600.0f,   214425.0f,    217250.0f,   220075.0f,   222900.0f,   119400.0f,   120350.0f,   121300.0f,   122250.0f,    123200.0f,   124150.0f,   128900.0f,   129850.0f,   130800.0f,   131750.0f,   132700.0f,    133650.0f,   138400.0f,   139350.0f,   140300.0f,   141250.0f,   142200.0f,   143150.0f,    147900.0f,   148850.0f,   149800.0f,   150750.0f,   151700.0f,   152650.0f,   157400.0f,    158350.0f,   159300.0f,   160250.0f,   161200.0f,   162150.0f,   166900.0f,   167850.0f,    168800.0f,   169750.0f,   170700.0f,   171650.0f,   273150.0f,   275350.0f,   277550.0f,    279750.0f,   281950.0f,   284150.0f,   295150.0f,   297350.0f,   299550.0f,   301750.0f,    303950.0f,   306150.0f,   317150.0f,   319350.0f,   321550.0f,   323750.0f,   325950.0f,    328150.0f,   339150.0f,   341350.0f,   343550.0f,   345750.0f,   347950.0f,   350150.0f,    361150.0f,   363350.0f,   365550.0f,   367750.0f,   369950.0f,   372150.0f,   383150.0f,    385350.0f,   387550.0f,   389750.0f,   391950.0f,   394150.0f,   426900.0f,   430350.0f,    433800.0f,   437250.0f,   440700.0f,   444150.0f,   461400.0f,   464850.0f,   468300.0f,    471750.0f,   475200.0f,   478650.0f,   495900.0f,   499350.0f,   502800.0f,   506250.0f,    509700.0f,   513150.0f,   530400.0f,   533850.0f,   537300.0f,   540750.0f,   544200.0f,    547650.0f,   564900.0f,   568350.0f,   571800.0f,   575250.0f,   578700.0f,   582150.0f,    599400.0f,   602850.0f,   606300.0f,   609750.0f,   613200.0f,   616650.0f,    75025.0f,    75350.0f,    75675.0f,    76000.0f,    76325.0f,    76650.0f,    78275.0f,    78600.0f,    78925.0f,    79250.0f,    79575.0f,    79900.0f,    81525.0f,    81850.0f,    82175.0f,    82500.0f,    82825.0f,    83150.0f,    84775.0f,    85100.0f,    85425.0f,    85750.0f,    86075.0f,    86400.0f,    88025.0f,    88350.0f,    88675.0f,    89000.0f,    89325.0f,    89650.0f,    91275.0f,    91600.0f,    91925.0f,    92250.0f,    92575.0f,    92900.0f,    353775.0f,   355350.0f,   356925.0f,   358500.0f,   360075.0f,   361650.0f,   369525.0f,    371100.0f,   372675.0f,   374250.0f,   375825.0f,   377400.0f,   385275.0f,   386850.0f,    388425.0f,   390000.0f,   391575.0f,   393150.0f,   401025.0f,   402600.0f,   404175.0f,    405750.0f,   407325.0f,   408900.0f,   416775.0f,   418350.0f,   419925.0f,   421500.0f,    423075.0f,   424650.0f,   432525.0f,   434100.0f,   435675.0f,   437250.0f,   438825.0f,    440400.0f,   632525.0f,   635350.0f,   638175.0f,   641000.0f,   643825.0f,   646650.0f,    660775.0f,   663600.0f,   666425.0f,   669250.0f,   672075.0f,   674900.0f,   689025.0f,    691850.0f,   694675.0f,   697500.0f,   700325.0f,   703150.0f,   717275.0f,   720100.0f,    722925.0f,   725750.0f,   728575.0f,   731400.0f,   745525.0f,   748350.0f,   751175.0f,    754000.0f,   756825.0f,   759650.0f,   773775.0f,   776600.0f,   779425.0f,   782250.0f,    785075.0f,   787900.0f,   309400.0f,   310350.0f,   311300.0f,   312250.0f,   313200.0f,    314150.0f,   318900.0f,   319850.0f,   320800.0f,   321750.0f,   322700.0f,   323650.0f,    328400.0f,   329350.0f,   330300.0f,   331250.0f,   332200.0f,   333150.0f,   337900.0f,    338850.0f,   339800.0f,   340750.0f,   341700.0f,   342650.0f,   347400.0f,   348350.0f,    349300.0f,   350250.0f,   351200.0f,   352150.0f,   356900.0f,   357850.0f,   358800.0f,    359750.0f,   360700.0f,   361650.0f,   713150.0f,   715350.0f,   717550.0f,   719750.0f,    721950.0f,   724150.0f,   735150.0f,   737350.0f,   739550.0f,   741750.0f,   743950.0f,    746150.0f,   757150.0f,   759350.0f,   761550.0f,   763750.0f,   765950.0f,   768150.0f,    779150.0f,   781350.0f,   783550.0f,   785750.0f,   787950.0f,   790150.0f,   801150.0f,    803350.0f,   805550.0f,   807750.0f,   809950.0f,   812150.0f,   823150.0f,   825350.0f,    827550.0f,   829750.0f,   831950.0f,   834150.0f,  1116900.0f,  1120350.0f,  1123800.0f,    1127250.0f,  1130700.0f,  1134150.0f,  1151400.0f,  1154850.0f,  1158300.0f,  1161750.0f,    1165200.0f,  1168650.0f,  1185900.0f,  1189350.0f,  1192800.0f,  1196250.0f,  1199700.0f,    1203150.0f,  1220400.0f,  1223850.0f,  1227300.0f,  1230750.0f,  1234200.0f,  1237650.0f,    1254900.0f,  1258350.0f,  1261800.0f,  1265250.0f,  1268700.0f,  1272150.0f,  1289400.0f,    1292850.0f,  1296300.0f,  1299750.0f,  1303200.0f,  1306650.0f,};
@@ -25,6 +25,7 @@
 #include <NDArray.h>
 #include <ops/ops.h>
 #include <GradCheck.h>
+#include <ops/declarable/helpers/image_suppression.h>
 
 
 using namespace nd4j;
@@ -2681,6 +2682,61 @@ TEST_F(DeclarableOpsTests10, Image_NonMaxSuppressingOverlap_3) {
     delete results;
 }
 
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests10, Image_NonMaxSuppressingBatched_1) {
+
+    NDArray boxes    = NDArrayFactory::create<float>('c', {2, 4, 4}, {
+            0,     0, 1,    1,
+            0,   0.1, 1,  1.1,
+            0,  -0.1, 1,  0.9,
+            0,    10, 1,   11,
+
+            0,     0, 1,    1,
+            0,     2, 1,    3,
+            0,     4, 1,    5,
+            0,     6, 1,    7});
+    NDArray scores = NDArrayFactory::create<float>('c', {2, 4, 2}, {
+            0.9, 0.1,   0.75, 0.8,   0.6, 0.7,   0.95, 0.05,
+            0.3, 0.9,   0.4,  0.1,   0.5, 0.1,   0.6,  0.1});
+    NDArray expected = NDArrayFactory::create<int>('c', {2, 2, 3}, {3, 0, -1,   1, -1, -1,
+                                                                     3, 2,  1,   0, -1, -1});
+    NDArray output = NDArrayFactory::create<int>('c', {2, 2, 3});
+
+    auto count = nd4j::ops::helpers::nonMaxSuppressionBatched(LaunchContext::defaultContext(), &boxes, &scores, 3, 0.5, 0.2, &output);
+
+    ASSERT_EQ(7, count);
+    ASSERT_TRUE(expected.equalsTo(output));
+
+    // output of wrong shape is rejected instead of being written past its end
+    NDArray wrong = NDArrayFactory::create<int>('c', {2, 2, 2});
+    ASSERT_ANY_THROW(nd4j::ops::helpers::nonMaxSuppressionBatched(LaunchContext::defaultContext(), &boxes, &scores, 3, 0.5, 0.2, &wrong));
+}
+
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests10, Image_NonMaxSuppressingBatched_2) {
+
+    NDArray boxes    = NDArrayFactory::create<float>('c', {1, 4, 4}, {
+            0,     0, 1,    1,
+            0,   0.1, 1,  1.1,
+            0,  -0.1, 1,  0.9,
+            0,    10, 1,   11});
+    NDArray scores = NDArrayFactory::create<float>('c', {1, 4, 2}, {
+            0.9, 0.1,   0.75, 0.8,   0.6, 0.7,   0.95, 0.05});
+    NDArray max_num = NDArrayFactory::create<int>(2);
+    NDArray expected = NDArrayFactory::create<int>('c', {1, 2, 2}, {3, 0,   1, -1});
+
+    nd4j::ops::non_max_suppression_batched op;
+    auto results = op.evaluate({&boxes, &scores, &max_num}, {0.5, 0.2}, {});
+
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+    NDArray* result = results->at(0);
+    ASSERT_TRUE(expected.isSameShapeStrict(*result));
+    ASSERT_TRUE(expected.equalsTo(result));
+
+    delete results;
+}
+
 ////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests10, Image_CropAndResize_1) {
     int axis = 0;
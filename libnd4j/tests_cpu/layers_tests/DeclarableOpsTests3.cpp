@@ -164,6 +164,64 @@ TEST_F(DeclarableOpsTests3, Test_Unique_2) {
     delete result;
 }
 
+TEST_F(DeclarableOpsTests3, Test_Unique_3) {
+    // long enough to be split between threads, values repeat with period 1001
+    const Nd4jLong length = 200000;
+    const Nd4jLong period = 1001;
+
+    auto x = NDArrayFactory::create<Nd4jLong>('c', {length});
+    auto expV = NDArrayFactory::create<Nd4jLong>('c', {period});
+    auto expI = NDArrayFactory::create<Nd4jLong>('c', {length});
+    auto expC = NDArrayFactory::create<Nd4jLong>('c', {period});
+
+    for (Nd4jLong e = 0; e < length; e++) {
+        x.p(e, (e * 37) % period);
+        expI.p(e, e % period);
+    }
+
+    for (Nd4jLong e = 0; e < period; e++) {
+        expV.p(e, (e * 37) % period);
+        expC.p(e, e < length % period ? length / period + 1 : length / period);
+    }
+
+    nd4j::ops::unique_with_counts op;
+    auto result = op.evaluate({&x}, {}, {});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+    ASSERT_EQ(3, result->size());
+
+    ASSERT_TRUE(expV.equalsTo(result->at(0)));
+    ASSERT_TRUE(expI.equalsTo(result->at(1)));
+    ASSERT_TRUE(expC.equalsTo(result->at(2)));
+
+    delete result;
+}
+
+TEST_F(DeclarableOpsTests3, Test_Unique_4) {
+    // NaN never matches anything, so every NaN is unique value on its own
+    auto nan = std::numeric_limits<float>::quiet_NaN();
+    auto x = NDArrayFactory::create<float>('c', {5}, {1.f, nan, 2.f, nan, 1.f});
+    auto expI = NDArrayFactory::create<Nd4jLong>('c', {5}, {0, 1, 2, 3, 0});
+    auto expC = NDArrayFactory::create<Nd4jLong>('c', {4}, {2, 1, 1, 1});
+
+    nd4j::ops::unique_with_counts op;
+    auto result = op.evaluate({&x}, {}, {});
+
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+
+    auto v = result->at(0);
+    ASSERT_EQ(4, v->lengthOf());
+    ASSERT_EQ(1.f, v->e<float>(0));
+    ASSERT_TRUE(std::isnan(v->e<float>(1)));
+    ASSERT_EQ(2.f, v->e<float>(2));
+    ASSERT_TRUE(std::isnan(v->e<float>(3)));
+
+    ASSERT_TRUE(expI.equalsTo(result->at(1)));
+    ASSERT_TRUE(expC.equalsTo(result->at(2)));
+
+    delete result;
+}
+
 TEST_F(DeclarableOpsTests3, Test_Rint_1) {
     auto x= NDArrayFactory::create<float>('c', {1, 7}, {-1.7f, -1.5f, -0.2f, 0.2f, 1.5f, 1.7f, 2.0f});
     auto exp= NDArrayFactory::create<float>('c', {1, 7}, {-2.f, -2.f, -0.f, 0.f, 2.f, 2.f, 2.f});
@@ -1020,6 +1078,61 @@ TEST_F(DeclarableOpsTests3, gruCell_test3) {
     delete results;
 }
 
+////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests3, gru_test1) {
+
+    const int time      = 3;
+    const int batchSize = 2;
+    const int inSize    = 5;
+    const int numUnits  = 4;
+
+    auto x   = NDArrayFactory::create<float>('c', {time, batchSize, inSize});
+    auto h0  = NDArrayFactory::create<float>('c', {batchSize, numUnits});
+    auto Wx  = NDArrayFactory::create<float>('c', {inSize, 3*numUnits});
+    auto Wh  = NDArrayFactory::create<float>('c', {numUnits, 3*numUnits});
+    auto b   = NDArrayFactory::create<float>('c', {3*numUnits});
+
+    x.linspace(-0.5, 0.05);
+    h0.linspace(-0.2, 0.05);
+    Wx.linspace(-0.3, 0.01);
+    Wh.linspace(0.2, -0.01);
+    b.linspace(-0.1, 0.02);
+
+    nd4j::ops::gru op;
+    auto results = op.evaluate({&x, &h0, &Wx, &Wh, &b});
+
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+    auto *h = results->at(0);
+
+    // same recurrence by gruCell, its packed weights are rows of Wx and Wh stacked
+    auto Wru = NDArrayFactory::create<float>('c', {(inSize+numUnits), 2*numUnits});
+    auto Wc  = NDArrayFactory::create<float>('c', {(inSize+numUnits), numUnits});
+    Wru({0,inSize, 0,0}, true).assign(Wx({0,0, 0,2*numUnits}, true));
+    Wru({inSize,inSize+numUnits, 0,0}, true).assign(Wh({0,0, 0,2*numUnits}, true));
+    Wc({0,inSize, 0,0}, true).assign(Wx({0,0, 2*numUnits,3*numUnits}, true));
+    Wc({inSize,inSize+numUnits, 0,0}, true).assign(Wh({0,0, 2*numUnits,3*numUnits}, true));
+    auto bru = b({0, 2*numUnits}).dup();
+    auto bc  = b({2*numUnits, 3*numUnits}).dup();
+
+    nd4j::ops::gruCell cell;
+    auto ht_1 = h0.dup();
+    for (int t = 0; t < time; ++t) {
+        auto xt = x({t,t+1, 0,0, 0,0}, true).reshape('c', {batchSize, inSize});
+        auto cellResults = cell.evaluate({&xt, &ht_1, &Wru, &Wc, &bru, &bc});
+
+        ASSERT_EQ(ND4J_STATUS_OK, cellResults->status());
+
+        auto ht = (*h)({t,t+1, 0,0, 0,0}, true).reshape('c', {batchSize, numUnits});
+        ASSERT_TRUE(cellResults->at(3)->equalsTo(ht));
+
+        ht_1.assign(cellResults->at(3));
+        delete cellResults;
+    }
+
+    delete results;
+}
+
 ////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests3, invertPermutation_test1) {
 
@@ -2679,6 +2792,33 @@ TEST_F(DeclarableOpsTests3, svd_test12) {
     delete results;
 }
 
+///////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests3, svd_test13) {
+
+    // batch is decomposed in parallel, every matrix must give the same result as decomposed alone
+    NDArray x('c', {8, 6, 4}, nd4j::DataType::DOUBLE);
+    for (int i = 0; i < x.lengthOf(); ++i)
+        x.p(i, nd4j::math::nd4j_sin<double, double>(0.7 * i) + 0.1 * (i % 5));
+
+    nd4j::ops::svd op;
+    auto results = op.evaluate({&x}, {}, {0, 1, 16});
+    ASSERT_EQ(ND4J_STATUS_OK, results->status());
+
+    for (int i = 0; i < x.sizeAt(0); ++i) {
+        auto matrix = x(i, {0});
+        auto single = op.evaluate({&matrix}, {}, {0, 1, 16});
+        ASSERT_EQ(ND4J_STATUS_OK, single->status());
+
+        ASSERT_TRUE(single->at(0)->equalsTo((*results->at(0))(i, {0})));
+        ASSERT_TRUE(single->at(1)->equalsTo((*results->at(1))(i, {0})));
+        ASSERT_TRUE(single->at(2)->equalsTo((*results->at(2))(i, {0})));
+
+        delete single;
+    }
+
+    delete results;
+}
+
 ///////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests3, elu_test1) {
 
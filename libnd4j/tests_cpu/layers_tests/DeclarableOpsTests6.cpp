@@ -769,6 +769,57 @@ TEST_F(DeclarableOpsTests6, cumSum_20) {
     delete result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests6, cumSum_21) {
+    // long enough to be scanned in parallel blocks
+    const Nd4jLong length = 300001;
+    auto x = NDArrayFactory::create<Nd4jLong>('c', {length});
+    x.linspace(1);
+
+    for (int exclusive = 0; exclusive < 2; exclusive++) {
+        for (int reverse = 0; reverse < 2; reverse++) {
+            auto exp = NDArrayFactory::create<Nd4jLong>('c', {length});
+            Nd4jLong sum = 0;
+            for (Nd4jLong i = 0; i < length; i++) {
+                auto e = reverse ? length - 1 - i : i;
+                auto next = sum + e + 1;
+                exp.p(e, exclusive ? sum : next);
+                sum = next;
+            }
+
+            nd4j::ops::cumsum op;
+            auto result = op.evaluate({&x}, {}, {exclusive, reverse});
+            ASSERT_EQ(Status::OK(), result->status());
+            ASSERT_TRUE(exp.equalsTo(result->at(0)));
+
+            delete result;
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests6, cumSum_22) {
+    // strided TADs along axis 0
+    auto x = NDArrayFactory::create<Nd4jLong>('c', {5, 2000});
+    x.linspace(1);
+
+    auto exp = NDArrayFactory::create<Nd4jLong>('c', {5, 2000});
+    for (int c = 0; c < 2000; c++) {
+        Nd4jLong sum = 0;
+        for (int r = 4; r >= 0; r--) {
+            exp.p(r, c, sum);
+            sum += x.e<Nd4jLong>(r, c);
+        }
+    }
+
+    nd4j::ops::cumsum op;
+    auto result = op.evaluate({&x}, {}, {1, 1, 0});
+    ASSERT_EQ(Status::OK(), result->status());
+    ASSERT_TRUE(exp.equalsTo(result->at(0)));
+
+    delete result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests6, TestMergeMaxIndex_1) {
 
@@ -2581,6 +2581,57 @@ TEST_F(DeclarableOpsTests7, TestUnsortedSegmentProdBP_4) {
     delete result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests7, TestUnsortedSegment_Large_1) {
+    // many rows over few segments, last segment is empty
+    const Nd4jLong numRows = 100000;
+    auto x = NDArrayFactory::create<int>('c', {numRows, 2});
+    auto idx = NDArrayFactory::create<Nd4jLong>('c', {numRows});
+    auto expSum = NDArrayFactory::create<int>('c', {4, 2});
+    auto expMax = NDArrayFactory::create<int>('c', {4, 2});
+
+    expSum.assign(0);
+    expMax.assign(-DataTypeUtils::max<int>());
+
+    for (Nd4jLong r = 0; r < numRows; r++) {
+        auto s = r % 3;
+        idx.p(r, s);
+
+        for (int j = 0; j < 2; j++) {
+            int v = static_cast<int>((r * (j + 1)) % 7);
+            x.p(r * 2 + j, v);
+            expSum.p(s * 2 + j, expSum.e<int>(s * 2 + j) + v);
+            expMax.p(s * 2 + j, nd4j::math::nd4j_max<int>(expMax.e<int>(s * 2 + j), v));
+        }
+    }
+
+    nd4j::ops::unsorted_segment_sum opSum;
+    auto result = opSum.evaluate({&x, &idx}, {}, {4});
+    ASSERT_EQ(result->status(), Status::OK());
+    ASSERT_TRUE(expSum.equalsTo(result->at(0)));
+    delete result;
+
+    nd4j::ops::unsorted_segment_max opMax;
+    result = opMax.evaluate({&x, &idx}, {}, {4});
+    ASSERT_EQ(result->status(), Status::OK());
+    ASSERT_TRUE(expMax.equalsTo(result->at(0)));
+    delete result;
+
+    // gradient of sum is gradient of the segment, for every row
+    auto xf = x.cast(nd4j::DataType::FLOAT32);
+    auto gradO = NDArrayFactory::create<float>('c', {4, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f});
+    nd4j::ops::unsorted_segment_sum_bp opSumBP;
+    result = opSumBP.evaluate({&xf, &idx, &gradO}, {}, {4});
+    ASSERT_EQ(result->status(), Status::OK());
+
+    auto z = result->at(0);
+    for (Nd4jLong r = 0; r < numRows; r += 997)
+        for (int j = 0; j < 2; j++)
+            ASSERT_EQ(gradO.e<float>((r % 3) * 2 + j), z->e<float>(r * 2 + j));
+
+    delete result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests7, TestExtractImagePatches_1) {
     auto x = NDArrayFactory::create<double>('c', {2,4, 4, 4}, {
@@ -25,6 +25,7 @@
 #include <ops/ops.h>
 #include <GradCheck.h>
 #include <loops/random.h>
+#include <ops/declarable/helpers/transforms.h>
 
 
 using namespace nd4j;
@@ -778,6 +779,48 @@ TEST_F(DeclarableOpsTests9, concat_test25) {
     delete result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests9, concat_test26) {
+
+    // mixed orders and strided input go through general path
+    NDArray x0('c', {2,3,2}, nd4j::DataType::FLOAT32);
+    NDArray x1c('c', {2,1,2}, {13,14, 15,16}, nd4j::DataType::FLOAT32);
+    NDArray x2Full('c', {2,2,4}, nd4j::DataType::FLOAT32);
+    x0.linspace(1);
+    x2Full.linspace(17);
+    auto x1 = x1c.dup('f');
+    auto x2 = x2Full({0,0,1, 0,0,1, 0,4,2}, true, true);     // {2,2,2} with stride 2 along last axis
+
+    NDArray output('c', {2,6,2}, nd4j::DataType::FLOAT32);
+    NDArray exp('c', {2,6,2}, {1, 2, 3, 4, 5, 6,   13, 14,   17, 19, 21, 23,
+                               7, 8, 9,10,11,12,   15, 16,   25, 27, 29, 31}, nd4j::DataType::FLOAT32);
+
+    nd4j::ops::concat op;
+    auto status = op.execute({&x0, &x1, &x2}, {&output}, {}, {1}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, status);
+
+    ASSERT_TRUE(exp.equalsTo(output));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests9, concat_test27) {
+
+    NDArray output('c', {2,5}, nd4j::DataType::FLOAT32);
+    NDArray exp('c', {2,5}, {1,2,3,4,5, 6,7,8,9,10}, nd4j::DataType::FLOAT32);
+
+    // parts are written straight into output, and concat doesn't move them
+    auto views = nd4j::ops::helpers::concatViews(output, {2, 3}, 1);
+    ASSERT_EQ(2, views.size());
+    views[0].assign(NDArray('c', {2,2}, {1,2, 6,7}, nd4j::DataType::FLOAT32));
+    views[1].assign(NDArray('c', {2,3}, {3,4,5, 8,9,10}, nd4j::DataType::FLOAT32));
+
+    nd4j::ops::concat op;
+    auto status = op.execute({&views[0], &views[1]}, {&output}, {}, {1}, {});
+    ASSERT_EQ(ND4J_STATUS_OK, status);
+
+    ASSERT_TRUE(exp.equalsTo(output));
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests9, tile_bp_test1) {
 
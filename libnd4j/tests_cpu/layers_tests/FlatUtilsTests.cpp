@@ -23,6 +23,8 @@
 #include "testlayers.h"
 #include <graph/Stash.h>
 #include <FlatUtils.h>
+#include <helpers/MappedFile.h>
+#include <fstream>
 
 using namespace nd4j;
 
@@ -97,4 +99,37 @@ TEST_F(FlatUtilsTests, flat_string_serde_1) {
     ASSERT_EQ(array, *restored);
 
     delete restored;
-}
\ No newline at end of file
+}
+
+TEST_F(FlatUtilsTests, flat_float_mapped_fallback_1) {
+    auto array = NDArrayFactory::create<float>('c', {4}, {1.f, 2.f, 3.f, 4.f});
+
+    flatbuffers::FlatBufferBuilder builder(1024);
+    auto flatArray = FlatUtils::toFlatArray(builder, array);
+    builder.Finish(flatArray);
+
+    // one byte of padding in front of FlatBuffer leaves array data misaligned within the mapping
+    {
+        std::ofstream ofs("flat_misaligned", std::ios::binary | std::ios::out);
+        ofs.put(0);
+        ofs.write(reinterpret_cast<const char*>(builder.GetBufferPointer()), builder.GetSize());
+    }
+
+    NDArray *restored = nullptr;
+    {
+        MappedFile mapping("flat_misaligned");
+        auto pfArray = GetFlatArray(mapping.data() + 1);
+        ASSERT_TRUE(MappedFile::isMapped(pfArray->buffer()->data(), pfArray->buffer()->size()));
+
+        // misaligned data can't be used in place, so it's copied
+        restored = FlatUtils::fromFlatArray(pfArray);
+        ASSERT_FALSE(MappedFile::isMapped(restored->getBuffer(), restored->lengthOf() * restored->sizeOfT()));
+    }
+
+    remove("flat_misaligned");
+
+    // copy outlives the mapping
+    ASSERT_EQ(array, *restored);
+
+    delete restored;
+}
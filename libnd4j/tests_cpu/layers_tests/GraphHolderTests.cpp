@@ -20,6 +20,10 @@
 
 #include "testlayers.h"
 #include <graph/GraphHolder.h>
+#include <GraphExecutioner.h>
+#include <graph/profiling/LatencyHistogram.h>
+#include <ops/declarable/CustomOperations.h>
+#include <thread>
 
 using namespace nd4j;
 using namespace nd4j::ops;
@@ -83,4 +87,226 @@ TEST_F(GraphHolderTests, SimpleTests_3) {
 
 
     delete graph2;
-}
\ No newline at end of file
+}
+
+TEST_F(GraphHolderTests, SessionsPool_1) {
+    nd4j::ops::add opA;
+    nd4j::ops::multiply opB;
+
+    auto graph = new Graph;
+    Nd4jLong graphId = 121;
+
+    auto x = NDArrayFactory::create_<float>('c', {3, 4});
+    auto y = NDArrayFactory::create_<float>('c', {3, 4});
+    x->assign(2.0f);
+    y->assign(3.0f);
+
+    graph->getVariableSpace()->putVariable(-1, x);
+    graph->getVariableSpace()->putVariable(-2, y);
+
+    // (x + y) * y
+    graph->addNode(new Node(&opA, 1, {-1, -2}));
+    graph->addNode(new Node(&opB, 2, {1, -2}));
+
+    GraphHolder::getInstance()->registerGraph(graphId, graph);
+
+    ASSERT_EQ(0, GraphHolder::getInstance()->numberOfSessions(graphId));
+
+    auto session = GraphHolder::getInstance()->checkoutSession(graphId);
+    ASSERT_TRUE(session != nullptr);
+    ASSERT_TRUE(session != graph);
+
+    ASSERT_EQ(ND4J_STATUS_OK, GraphExecutioner::execute(session));
+
+    auto z = session->getVariableSpace()->getVariable(2)->getNDArray();
+    ASSERT_NEAR(15.0f, z->e<float>(0), 1e-5f);
+    auto buffer = z->getBuffer();
+
+    // session results never leak into the shared graph
+    ASSERT_FALSE(graph->getVariableSpace()->getVariable(2)->hasNDArray());
+
+    GraphHolder::getInstance()->releaseSession(graphId, session);
+    ASSERT_EQ(1, GraphHolder::getInstance()->numberOfSessions(graphId));
+
+    // pooled session should be reused
+    auto session2 = GraphHolder::getInstance()->checkoutSession(graphId);
+    ASSERT_TRUE(session == session2);
+    ASSERT_EQ(0, GraphHolder::getInstance()->numberOfSessions(graphId));
+
+    // per-run values are gone, but output arrays are reused by the next run
+    ASSERT_FALSE(session2->getVariableSpace()->localSpace()->hasVariable(2));
+
+    ASSERT_EQ(ND4J_STATUS_OK, GraphExecutioner::execute(session2));
+
+    auto z2 = session2->getVariableSpace()->getVariable(2)->getNDArray();
+    ASSERT_TRUE(buffer == z2->getBuffer());
+
+    auto exp = NDArrayFactory::create<float>('c', {3, 4});
+    exp.assign(15.0f);
+    ASSERT_EQ(exp, *z2);
+
+    GraphHolder::getInstance()->releaseSession(graphId, session2);
+    ASSERT_EQ(1, GraphHolder::getInstance()->numberOfSessions(graphId));
+
+    GraphHolder::getInstance()->dropGraph(graphId);
+
+    ASSERT_FALSE(GraphHolder::getInstance()->hasGraph(graphId));
+    ASSERT_EQ(0, GraphHolder::getInstance()->numberOfSessions(graphId));
+}
+
+TEST_F(GraphHolderTests, SessionsPool_2) {
+    auto graph = new Graph;
+    Nd4jLong graphId = 123;
+    GraphHolder::getInstance()->registerGraph(graphId, graph);
+
+    auto limit = GraphHolder::getInstance()->maxSessions();
+    GraphHolder::getInstance()->setMaxSessions(1);
+
+    auto session1 = GraphHolder::getInstance()->checkoutSession(graphId);
+    auto session2 = GraphHolder::getInstance()->checkoutSession(graphId);
+    ASSERT_TRUE(session1 != session2);
+
+    GraphHolder::getInstance()->releaseSession(graphId, session1);
+    GraphHolder::getInstance()->releaseSession(graphId, session2);
+
+    // second session is released, since pool is full
+    ASSERT_EQ(1, GraphHolder::getInstance()->numberOfSessions(graphId));
+
+    GraphHolder::getInstance()->setMaxSessions(limit);
+    GraphHolder::getInstance()->dropGraph(graphId);
+}
+
+TEST_F(GraphHolderTests, LatencyHistogram_1) {
+    LatencyHistogram histogram;
+
+    for (int e = 1; e <= 100; e++)
+        histogram.record(e);
+
+    ASSERT_EQ(100, histogram.count());
+    ASSERT_EQ(50, histogram.mean());
+    ASSERT_EQ(100, histogram.max());
+    ASSERT_EQ(63, histogram.percentile(0.5));
+    ASSERT_EQ(100, histogram.percentile(0.99));
+
+    ASSERT_EQ(0, LatencyHistogram::bucketOf(0));
+    ASSERT_EQ(1, LatencyHistogram::bucketOf(1));
+    ASSERT_EQ(7, LatencyHistogram::bucketOf(100));
+}
+
+TEST_F(GraphHolderTests, DynamicBatching_1) {
+    auto graph = new Graph;
+    Nd4jLong graphId = 125;
+
+    auto x = NDArrayFactory::create_<float>('c', {1, 4});
+    graph->getVariableSpace()->putVariable(-1, x);
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}));
+
+    GraphHolder::getInstance()->registerGraph(graphId, graph);
+
+    // window is large enough, so batch is flushed once all 4 rows are here
+    auto &batcher = GraphHolder::getInstance()->batcher();
+    batcher.resetStats();
+    batcher.setWindow(10000000);
+    batcher.setMaxBatchSize(4);
+
+    const int numRequests = 4;
+    std::vector<std::vector<Variable*>> inputs(numRequests);
+    std::vector<std::vector<Variable*>> outputs(numRequests);
+    std::vector<std::thread> threads;
+
+    for (int e = 0; e < numRequests; e++) {
+        auto array = NDArrayFactory::create_<float>('c', {1, 4});
+        array->assign(-(e + 1));
+        inputs[e].emplace_back(new Variable(array, nullptr, -1, 0));
+
+        threads.emplace_back(std::thread([&, e] {
+            outputs[e] = batcher.execute(graphId, inputs[e]);
+        }));
+    }
+
+    for (auto &t: threads)
+        t.join();
+
+    ASSERT_EQ(numRequests, batcher.numberOfRequests());
+    ASSERT_EQ(1, batcher.numberOfBatches());
+    ASSERT_EQ(numRequests, batcher.queueingTime().count());
+    ASSERT_EQ(1, batcher.executionTime().count());
+
+    for (int e = 0; e < numRequests; e++) {
+        ASSERT_EQ(1, outputs[e].size());
+
+        auto exp = NDArrayFactory::create<float>('c', {1, 4});
+        exp.assign(e + 1);
+        ASSERT_TRUE(exp.equalsTo(outputs[e][0]->getNDArray()));
+
+        delete outputs[e][0];
+        delete inputs[e][0];
+    }
+
+    batcher.setWindow(0);
+    GraphHolder::getInstance()->dropGraph(graphId);
+}
+
+TEST_F(GraphHolderTests, DynamicBatching_2) {
+    auto graph = new Graph;
+    Nd4jLong graphId = 126;
+
+    // full reduction doesn't keep batch dimension, so outputs can't be split
+    auto x = NDArrayFactory::create_<float>('c', {1, 4});
+    graph->getVariableSpace()->putVariable(-1, x);
+    graph->addNode(new Node(OpType_REDUCE_SAME, reduce::Sum, 1, {-1}));
+
+    GraphHolder::getInstance()->registerGraph(graphId, graph);
+
+    auto &batcher = GraphHolder::getInstance()->batcher();
+    batcher.resetStats();
+    batcher.setWindow(10000000);
+    batcher.setMaxBatchSize(4);
+
+    const int numRequests = 4;
+    std::vector<std::vector<Variable*>> inputs(numRequests);
+    std::vector<std::vector<Variable*>> outputs(numRequests);
+    std::vector<std::thread> threads;
+
+    for (int e = 0; e < numRequests; e++) {
+        auto array = NDArrayFactory::create_<float>('c', {1, 4});
+        array->assign(e + 1);
+        inputs[e].emplace_back(new Variable(array, nullptr, -1, 0));
+
+        threads.emplace_back(std::thread([&, e] {
+            outputs[e] = batcher.execute(graphId, inputs[e]);
+        }));
+    }
+
+    for (auto &t: threads)
+        t.join();
+
+    // merged batch, and then every request on its own
+    ASSERT_EQ(1, batcher.numberOfBatches());
+    ASSERT_EQ(numRequests + 1, batcher.executionTime().count());
+
+    for (int e = 0; e < numRequests; e++) {
+        ASSERT_EQ(1, outputs[e].size());
+        ASSERT_NEAR(4.f * (e + 1), outputs[e][0]->getNDArray()->e<float>(0), 1e-5f);
+
+        delete outputs[e][0];
+        delete inputs[e][0];
+    }
+
+    // graph is known to be not batchable now: request is executed right away instead of waiting for the window
+    auto array = NDArrayFactory::create_<float>('c', {1, 4});
+    array->assign(5);
+    std::vector<Variable*> single = {new Variable(array, nullptr, -1, 0)};
+
+    auto result = batcher.execute(graphId, single);
+    ASSERT_EQ(1, result.size());
+    ASSERT_NEAR(20.f, result[0]->getNDArray()->e<float>(0), 1e-5f);
+    ASSERT_EQ(2, batcher.numberOfBatches());
+    ASSERT_EQ(numRequests + 2, batcher.executionTime().count());
+
+    delete result[0];
+    delete single[0];
+
+    batcher.setWindow(0);
+    GraphHolder::getInstance()->dropGraph(graphId);
+}
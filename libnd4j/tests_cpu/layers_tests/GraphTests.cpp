@@ -25,6 +25,7 @@
 #include <graph/Node.h>
 #include <graph/Graph.h>
 #include <graph/GraphUtils.h>
+#include <execution/Threads.h>
 #include <NDArray.h>
 #include <ops/declarable/DeclarableOp.h>
 #include <ops/declarable/generic/parity_ops.cpp>
@@ -1636,3 +1637,197 @@ TEST_F(GraphTests, Test_Minifier_3) {
     //ASSERT_EQ(0, unlink("libnd4j_mini3.hpp"));
 
 }
+
+static Graph* buildTransformChain(int length) {
+    auto graph = new Graph();
+
+    auto x = NDArrayFactory::create_<float>('c', {32, 32});
+    x->linspace(-2.f, 0.01f);
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    for (int e = 1; e <= length; e++) {
+        auto input = e == 1 ? -1 : e - 1;
+        std::initializer_list<int> output = {e + 1};
+        if (e % 2)
+            graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, e, {input}, e < length ? output : std::initializer_list<int>{}));
+        else
+            graph->addNode(new Node(OpType_TRANSFORM_STRICT, transform::Cosine, e, {input}, e < length ? output : std::initializer_list<int>{}));
+    }
+
+    return graph;
+}
+
+TEST_F(GraphTests, memory_plan_1) {
+    auto reference = buildTransformChain(8);
+    auto graph = buildTransformChain(8);
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(reference));
+    auto exp = reference->getVariableSpace()->getVariable(8)->getNDArray();
+
+    Environment::getInstance()->setUseGraphMemoryPlanner(true);
+
+    // first run collects sizes, second one uses arena
+    for (int e = 0; e < 2; e++) {
+        ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+
+        auto z = graph->getVariableSpace()->getVariable(8)->getNDArray();
+        ASSERT_TRUE(exp->equalsTo(z));
+
+        // intermediate results are released
+        ASSERT_FALSE(graph->getVariableSpace()->getVariable(3)->hasNDArray());
+    }
+
+    Environment::getInstance()->setUseGraphMemoryPlanner(false);
+
+    auto plan = graph->memoryPlan();
+    ASSERT_TRUE(plan->isPlannable());
+    ASSERT_TRUE(plan->isFinalized());
+
+    // every op in the chain is elementwise, so all intermediate results share single buffer
+    ASSERT_EQ(7 * 32 * 32 * 4, plan->totalSize());
+    ASSERT_EQ(32 * 32 * 4, plan->arenaSize());
+
+    delete graph;
+    delete reference;
+}
+
+TEST_F(GraphTests, memory_plan_offsets_1) {
+    std::vector<MemoryPlan::Tensor> tensors(4);
+    int lifetimes[4][2] = {{0, 1}, {1, 2}, {2, 3}, {0, 3}};
+    Nd4jLong sizes[4] = {100, 200, 100, 64};
+
+    for (int e = 0; e < 4; e++) {
+        tensors[e].first = lifetimes[e][0];
+        tensors[e].last = lifetimes[e][1];
+        tensors[e].bytes = sizes[e];
+    }
+
+    auto arenaSize = MemoryPlan::assignOffsets(tensors, 64);
+
+    // tensors alive at the same time never overlap
+    for (int a = 0; a < 4; a++)
+        for (int b = a + 1; b < 4; b++) {
+            auto &x = tensors[a];
+            auto &y = tensors[b];
+            if (x.first <= y.last && y.first <= x.last)
+                ASSERT_TRUE(x.offset + x.bytes <= y.offset || y.offset + y.bytes <= x.offset);
+        }
+
+    // first and third tensors don't overlap in time, so they share memory
+    ASSERT_EQ(tensors[0].offset, tensors[2].offset);
+    ASSERT_EQ(256 + 128 + 64, arenaSize);
+}
+
+static Graph* buildBranchedGraph() {
+    auto graph = new Graph();
+
+    auto x = NDArrayFactory::create_<float>('c', {64, 64});
+    x->linspace(-2.f, 0.001f);
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    // four independent branches, reduced pairwise
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {5}));
+    graph->addNode(new Node(OpType_TRANSFORM_STRICT, transform::Cosine, 2, {-1}, {5}));
+    graph->addNode(new Node(OpType_TRANSFORM_STRICT, transform::Sin, 3, {-1}, {6}));
+    graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Square, 4, {-1}, {6}));
+    graph->addNode(new Node(OpType_PAIRWISE, pairwise::Add, 5, {1, 2}, {7}));
+    graph->addNode(new Node(OpType_PAIRWISE, pairwise::Multiply, 6, {3, 4}, {7}));
+    graph->addNode(new Node(OpType_PAIRWISE, pairwise::Subtract, 7, {5, 6}, {}));
+
+    return graph;
+}
+
+TEST_F(GraphTests, concurrent_layers_1) {
+    auto reference = buildBranchedGraph();
+    auto graph = buildBranchedGraph();
+
+    graph->getExecutorConfiguration()->_interOpThreads = 4;
+    graph->getExecutorConfiguration()->_intraOpThreads = 1;
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(reference));
+    auto exp = reference->getVariableSpace()->getVariable(7)->getNDArray();
+
+    for (int e = 0; e < 3; e++) {
+        ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+
+        auto z = graph->getVariableSpace()->getVariable(7)->getNDArray();
+        ASSERT_TRUE(exp->equalsTo(z));
+    }
+
+    // limit is restored once layer is done
+    ASSERT_EQ(0, samediff::Threads::threadsLimit());
+
+    delete graph;
+    delete reference;
+}
+
+TEST_F(GraphTests, concurrent_layers_3) {
+    auto graph = new Graph();
+    graph->getExecutorConfiguration()->_interOpThreads = 2;
+
+    auto x = NDArrayFactory::create_<float>('c', {64, 64});
+    x->linspace(-2.f, 0.001f);
+    graph->getVariableSpace()->putVariable(-1, x);
+
+    auto exp = x->transform(transform::Abs);
+    exp += exp.transform(transform::Sin);
+
+    // both nodes consume the same input, and the first one overwrites it
+    auto nodeA = new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {3});
+    auto nodeB = new Node(OpType_TRANSFORM_STRICT, transform::Sin, 2, {-1}, {3});
+    nodeA->markInplace(true);
+
+    graph->addNode(nodeA);
+    graph->addNode(nodeB);
+    graph->addNode(new Node(OpType_PAIRWISE, pairwise::Add, 3, {1, 2}, {}));
+
+    // such layer must be executed serially, in topological order
+    for (int e = 0; e < 3; e++) {
+        ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+
+        auto z = graph->getVariableSpace()->getVariable(3)->getNDArray();
+        ASSERT_TRUE(exp.equalsTo(z));
+    }
+
+    delete graph;
+}
+
+// sets memory planner flag for the scope, previous value is restored even if assertion fails
+class MemoryPlannerGuard {
+private:
+    bool _previous;
+
+public:
+    explicit MemoryPlannerGuard(bool usePlanner) : _previous(Environment::getInstance()->isUseGraphMemoryPlanner()) {
+        Environment::getInstance()->setUseGraphMemoryPlanner(usePlanner);
+    }
+
+    ~MemoryPlannerGuard() {
+        Environment::getInstance()->setUseGraphMemoryPlanner(_previous);
+    }
+};
+
+TEST_F(GraphTests, concurrent_layers_2) {
+    auto reference = buildBranchedGraph();
+    auto graph = buildBranchedGraph();
+
+    graph->getExecutorConfiguration()->_interOpThreads = 2;
+
+    ASSERT_EQ(Status::OK(), GraphExecutioner::execute(reference));
+    auto exp = reference->getVariableSpace()->getVariable(7)->getNDArray();
+
+    // concurrent layers combined with memory planner
+    {
+        MemoryPlannerGuard guard(true);
+
+        for (int e = 0; e < 3; e++) {
+            ASSERT_EQ(Status::OK(), GraphExecutioner::execute(graph));
+
+            auto z = graph->getVariableSpace()->getVariable(7)->getNDArray();
+            ASSERT_TRUE(exp->equalsTo(z));
+        }
+    }
+
+    delete graph;
+    delete reference;
+}
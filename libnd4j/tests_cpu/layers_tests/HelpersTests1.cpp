@@ -2301,6 +2301,81 @@ TEST_F(HelpersTests1, mmulMxV_7) {
     ASSERT_TRUE(y.equalsTo(&exp));
 }
 
+//////////////////////////////////////////////////////////////////////
+// non-BLAS types go through blocked fallback gemm, sizes are not multiples of tile sizes
+TEST_F(HelpersTests1, mmulMxM_fallback_1) {
+
+    const Nd4jLong M = 70;
+    const Nd4jLong K = 300;
+    const Nd4jLong N = 135;
+
+    NDArray aD('f', {M,K}, nd4j::DataType::DOUBLE);
+    NDArray bD('c', {K,N}, nd4j::DataType::DOUBLE);
+
+    for (Nd4jLong e = 0; e < aD.lengthOf(); e++)
+        aD.p(e, (e % 7) - 3);
+
+    for (Nd4jLong e = 0; e < bD.lengthOf(); e++)
+        bD.p(e, (e % 5) - 2);
+
+    NDArray cD('c', {M,N}, nd4j::DataType::DOUBLE);
+    nd4j::MmulHelper::mmul(&aD, &bD, &cD, 1., 0.);
+
+    for (auto dtype : {nd4j::DataType::INT32, nd4j::DataType::INT16, nd4j::DataType::HALF, nd4j::DataType::BFLOAT16}) {
+        auto a = aD.cast(dtype);
+        auto b = bD.cast(dtype);
+        NDArray c('f', {M,N}, dtype);
+
+        nd4j::MmulHelper::mmul(&a, &b, &c, 1., 0.);
+
+        ASSERT_TRUE(cD.cast(dtype).equalsTo(&c));
+    }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, mmulMxM_fallback_2) {
+
+    NDArray a('c', {2,3}, {1, 2, 3, 4, 5, 6}, nd4j::DataType::INT8);
+    NDArray b('c', {3,2}, {1, -1, 2, -2, 3, -3}, nd4j::DataType::INT8);
+    NDArray c('c', {2,2}, {1, 1, 1, 1}, nd4j::DataType::INT8);
+
+    NDArray exp('c', {2,2}, {29, -27, 65, -63}, nd4j::DataType::INT8);
+
+    nd4j::MmulHelper::mmul(&a, &b, &c, 2., 1.);
+    ASSERT_TRUE(c.equalsTo(&exp));
+}
+
+//////////////////////////////////////////////////////////////////////
+// output smaller than a single tile with long K, work is split over K
+TEST_F(HelpersTests1, mmulMxM_fallback_3) {
+
+    const Nd4jLong M = 5;
+    const Nd4jLong K = 3000;
+    const Nd4jLong N = 9;
+
+    NDArray aD('c', {M,K}, nd4j::DataType::DOUBLE);
+    NDArray bD('f', {K,N}, nd4j::DataType::DOUBLE);
+
+    for (Nd4jLong e = 0; e < aD.lengthOf(); e++)
+        aD.p(e, (e % 7) - 3);
+
+    for (Nd4jLong e = 0; e < bD.lengthOf(); e++)
+        bD.p(e, (e % 5) - 2);
+
+    NDArray cD('c', {M,N}, nd4j::DataType::DOUBLE);
+    cD.assign(1.);
+    nd4j::MmulHelper::mmul(&aD, &bD, &cD, 1., 1.);
+
+    auto a = aD.cast(nd4j::DataType::INT32);
+    auto b = bD.cast(nd4j::DataType::INT32);
+    NDArray c('c', {M,N}, nd4j::DataType::INT32);
+    c.assign(1);
+
+    nd4j::MmulHelper::mmul(&a, &b, &c, 1., 1.);
+
+    ASSERT_TRUE(cD.cast(nd4j::DataType::INT32).equalsTo(&c));
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(HelpersTests1, softmaxDerivative_1) {
 
@@ -2497,3 +2572,121 @@ TEST_F(HelpersTests1, lstmLayerCell_3) {
     ASSERT_TRUE(expC.equalsTo(c));
 }
 
+
+///////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, lstmLayerCellFused_1) {
+
+    const int bS   = 2;
+    const int nIn  = 10;
+    const int nOut = 4;
+
+    const float dataFormat = 0;     // is ignored in cell op
+    const float cellClip = 5;       // clipping value
+    const float gateAct = 2;        // sigmoid activation for input (i), forget (f) and output (o) gates
+    const float gateAlpha = 0;      // alpha value for activation for gates, not required for sigmoid
+    const float gateBeta = 0;       // beta value for activation for gates, not required for sigmoid
+    const float cellAct = 0;        // tanh activation for cell state
+    const float cellAlpha = 0;      // alpha value for cell state activation, not required for tanh
+    const float cellBeta = 0;       // beta value for cell state activation, not required for tanh
+    const float outAct = 0;         // tanh activation for output
+    const float outAlpha = 0;       // alpha value for output activation, not required for tanh
+    const float outBeta = 0;        // beta value for output activation, not required for tanh
+
+    NDArray x ('c', {bS, nIn}, nd4j::DataType::FLOAT32);
+    NDArray Wx('c', {nIn, 4*nOut}, nd4j::DataType::FLOAT32);
+    NDArray Wr('c', {nOut, 4*nOut}, nd4j::DataType::FLOAT32);
+    NDArray b ('c', {4*nOut}, nd4j::DataType::FLOAT32);
+    NDArray hI('c', {bS, nOut}, nd4j::DataType::FLOAT32);
+    NDArray cI('c', {bS, nOut}, nd4j::DataType::FLOAT32);
+    NDArray Wp('c', {3*nOut}, nd4j::DataType::FLOAT32);
+
+    NDArray z('c', {bS, 4*nOut}, nd4j::DataType::FLOAT32);
+    NDArray h('c', {bS, nOut}, nd4j::DataType::FLOAT32);
+    NDArray c('c', {bS, nOut}, nd4j::DataType::FLOAT32);
+
+    NDArray expH('c', {bS, nOut}, nd4j::DataType::FLOAT32);
+    NDArray expC('c', {bS, nOut}, nd4j::DataType::FLOAT32);
+
+    std::vector<float> params = {dataFormat, 0, cellClip, gateAct, gateAlpha, gateBeta, cellAct, cellAlpha, cellBeta, outAct, outAlpha, outBeta};
+
+    x.linspace(-0.5, 0.1);
+    hI.linspace(-0.3, 0.07);
+    cI.linspace(0.5, -0.15);
+    Wx.linspace(-0.2, 0.003);
+    Wr.linspace(0.1, -0.01);
+    Wp.linspace(-0.3, 0.05);
+    b.linspace(0.2, -0.02);
+
+    nd4j::ops::helpers::lstmLayerCell(&x, &Wx, &Wr, &b, &hI, &cI, &Wp, params, &expH, &expC);
+
+    // input projection is done by caller
+    auto zx = mmul(x, Wx);
+
+    nd4j::ops::helpers::lstmLayerCellFused(&zx, &Wr, &b, &hI, &cI, &Wp, params, &z, &h, &c);
+
+    ASSERT_TRUE(expH.equalsTo(h));
+    ASSERT_TRUE(expC.equalsTo(c));
+
+    // previous cell state and output are allowed to be overwritten in place
+    nd4j::ops::helpers::lstmLayerCellFused(&zx, &Wr, &b, &hI, &cI, &Wp, params, &z, &hI, &cI);
+
+    ASSERT_TRUE(expH.equalsTo(hI));
+    ASSERT_TRUE(expC.equalsTo(cI));
+}
+
+///////////////////////////////////////////////////////////////////
+TEST_F(HelpersTests1, lstmLayerTimeLoop_packed_1) {
+
+    const int sL   = 5;
+    const int bS   = 4;
+    const int nIn  = 3;
+    const int nOut = 2;
+
+    // dataFormat = 0 [sL, bS, nIn], forward, sigmoid gates, tanh cell and output activations, no clipping
+    std::vector<float> params = {0, 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0};
+
+    NDArray x ('c', {sL, bS, nIn}, nd4j::DataType::FLOAT32);
+    NDArray Wx('c', {nIn, 4*nOut}, nd4j::DataType::FLOAT32);
+    NDArray Wr('c', {nOut, 4*nOut}, nd4j::DataType::FLOAT32);
+    NDArray b ('c', {4*nOut}, nd4j::DataType::FLOAT32);
+    NDArray Wp('c', {3*nOut}, nd4j::DataType::FLOAT32);
+    NDArray seqLen('c', {bS}, {3, 0, 5, 1}, nd4j::DataType::INT64);
+
+    NDArray h ('c', {sL, bS, nOut}, nd4j::DataType::FLOAT32);
+    NDArray hL('c', {bS, nOut}, nd4j::DataType::FLOAT32);
+    NDArray cL('c', {bS, nOut}, nd4j::DataType::FLOAT32);
+
+    x.linspace(-1, 0.05);
+    Wx.linspace(0.3, -0.02);
+    Wr.linspace(-0.2, 0.03);
+    b.linspace(0.1, 0.01);
+    Wp.linspace(-0.1, 0.04);
+
+    nd4j::ops::helpers::lstmLayerTimeLoop(&x, &Wx, &Wr, &b, &seqLen, nullptr, nullptr, &Wp, params, true, &h, &hL, &cL);
+
+    // every example of ragged batch must match the same example processed alone, without padding
+    for (int e = 0; e < bS; ++e) {
+        const int limit = seqLen.e<int>(e);
+
+        if (limit == 0) {
+            ASSERT_EQ(0.f, h({0,0, e,e+1, 0,0}).reduceNumber(reduce::ASum).e<float>(0));
+            ASSERT_EQ(0.f, hL({e,e+1, 0,0}).reduceNumber(reduce::ASum).e<float>(0));
+            continue;
+        }
+
+        auto xe = x({0,limit, e,e+1, 0,0}, true).dup();
+        NDArray he ('c', {limit, 1, nOut}, nd4j::DataType::FLOAT32);
+        NDArray hLe('c', {1, nOut}, nd4j::DataType::FLOAT32);
+        NDArray cLe('c', {1, nOut}, nd4j::DataType::FLOAT32);
+
+        nd4j::ops::helpers::lstmLayerTimeLoop(&xe, &Wx, &Wr, &b, nullptr, nullptr, nullptr, &Wp, params, true, &he, &hLe, &cLe);
+
+        ASSERT_TRUE(he.equalsTo(h({0,limit, e,e+1, 0,0}, true)));
+        ASSERT_TRUE(hLe.equalsTo(hL({e,e+1, 0,0}, true)));
+        ASSERT_TRUE(cLe.equalsTo(cL({e,e+1, 0,0}, true)));
+
+        // padding is zero
+        if (limit < sL)
+            ASSERT_EQ(0.f, h({limit,sL, e,e+1, 0,0}).reduceNumber(reduce::ASum).e<float>(0));
+    }
+}
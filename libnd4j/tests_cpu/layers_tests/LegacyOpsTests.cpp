@@ -766,3 +766,16 @@ TEST_F(LegacyOpsTests, test_legacy_transform_float_1) {
 
     NativeOpExecutioner::execTransformFloat(LaunchContext::defaultContext(), transform::FloatOps::RSqrt, x.buffer(), x.shapeInfo(), x.specialBuffer(), x.specialShapeInfo(), x.buffer(), x.shapeInfo(), x.specialBuffer(), x.specialShapeInfo(), nullptr, nullptr, nullptr);
 }
+
+TEST_F(LegacyOpsTests, test_legacy_reduce_scalar_precision_1) {
+    auto x = NDArrayFactory::create<float>('c', {1 << 22});
+    x.assign(0.1f);
+
+    auto sum = x.reduceNumber(reduce::SameOps::Sum);
+    auto mean = x.reduceNumber(reduce::FloatOps::Mean);
+    auto norm = x.reduceNumber(reduce::FloatOps::SquaredNorm);
+
+    ASSERT_NEAR(0.1 * (1 << 22), sum.e<double>(0), 0.1 * (1 << 22) * 1e-5);
+    ASSERT_NEAR(0.1, mean.e<double>(0), 1e-6);
+    ASSERT_NEAR(0.01 * (1 << 22), norm.e<double>(0), 0.01 * (1 << 22) * 1e-5);
+}
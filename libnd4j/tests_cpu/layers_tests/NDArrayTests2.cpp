@@ -1304,4 +1304,37 @@ TEST_F(NDArrayTest2, test_numpy_import_1) {
     auto array = NDArrayFactory::fromNpyFile(fname.c_str());
 
     ASSERT_EQ(exp, array);
-}
\ No newline at end of file
+}
+
+TEST_F(NDArrayTest2, test_numpy_import_2) {
+    std::string fname("./resources/arr_3,4_float32.npy");
+    auto exp = NDArrayFactory::create<float>('c', {3, 4});
+    exp.linspace(0);
+
+    // mapping is private, so in-place updates must never reach the file
+    {
+        auto array = NDArrayFactory::fromNpyFile(fname.c_str());
+        array += 1.f;
+    }
+
+    auto array = NDArrayFactory::fromNpyFile(fname.c_str());
+    ASSERT_EQ(exp, array);
+}
+
+TEST_F(NDArrayTest2, test_numpy_import_3) {
+    // (0,) shape is parsed into the same {0} as scalar () shape, but must end up as empty array
+    auto array = NDArrayFactory::fromNpyFile("./resources/arr_0_float32.npy");
+
+    ASSERT_TRUE(array.isEmpty());
+    ASSERT_EQ(nd4j::DataType::FLOAT32, array.dataType());
+    ASSERT_EQ(0, array.lengthOf());
+}
+
+TEST_F(NDArrayTest2, test_numpy_import_4) {
+    auto exp = NDArrayFactory::create<float>(3.f);
+
+    auto array = NDArrayFactory::fromNpyFile("./resources/scalar_float32.npy");
+
+    ASSERT_TRUE(array.isScalar());
+    ASSERT_EQ(exp, array);
+}
@@ -1603,9 +1603,79 @@ TEST_F(NativeOpsTests, interop_databuffer_tests_1) {
     ::deleteDataBuffer(idb);
 }
 
+TEST_F(NativeOpsTests, workspace_stats_1) {
+    if (!Environment::getInstance()->isCPU())
+        return;
+
+    nd4j::memory::Workspace ws(1024);
+    auto ptr = reinterpret_cast<Nd4jPointer>(&ws);
+
+    ws.allocateBytes(100);
+    ws.allocateBytes(2000);
+
+    ASSERT_EQ(2, ::getWorkspaceNumberOfAllocations(ptr));
+    ASSERT_EQ(1, ::getWorkspaceNumberOfSpills(ptr));
+    ASSERT_EQ(0, ::getWorkspaceNumberOfRecycledSpills(ptr));
+    ASSERT_EQ(100 + 2000, ::getWorkspacePeakUsage(ptr));
+
+    ::resetWorkspaceStats(ptr);
+    ASSERT_EQ(0, ::getWorkspaceNumberOfAllocations(ptr));
+    ASSERT_EQ(0, ::getWorkspacePeakUsage(ptr));
+}
+
 //Uncomment when needed only - massive calculations
 //TEST_F(NativeOpsTests, BenchmarkTests_1) {
 //
 //    printf("%s\n", ::runLightBenchmarkSuit(true));
 //    printf("%s\n", ::runFullBenchmarkSuit(true));
 //}
+
+TEST_F(NativeOpsTests, threshold_encode_decode_1) {
+#ifdef __CUDABLAS__
+    printf("Unsupported for cuda now.\n");
+#else
+    const Nd4jLong length = 3000;
+    const float threshold = 0.5f;
+    auto x = NDArrayFactory::create<float>('c', {length});
+    auto z = NDArrayFactory::create<float>('c', {length});
+
+    // every 7th element is eligible for encoding, including negative values
+    for (Nd4jLong e = 0; e < length; e++)
+        x.p(e, e % 7 == 0 ? (e % 2 == 0 ? 0.75f : -1.25f) : 0.1f);
+
+    auto original = x.dup();
+
+    const int numBlocks = length / 1024 + (length % 1024 ? 1 : 0);
+    std::vector<int> blocks(numBlocks + 1, 0);
+    std::vector<int> offsets(numBlocks, 0);
+
+    ::encodeThresholdP1(nullptr, x.buffer(), x.shapeInfo(), length, blocks.data(), threshold);
+
+    const int numEncoded = blocks[0];
+    ASSERT_EQ(429, numEncoded);
+
+    ::encodeThresholdP2Int(nullptr, blocks.data(), numBlocks, offsets.data());
+    ASSERT_EQ(0, offsets[0]);
+    ASSERT_EQ(blocks[1], offsets[1]);
+    ASSERT_EQ(blocks[1] + blocks[2], offsets[2]);
+
+    FloatBits fb;
+    fb.f_ = threshold;
+    std::vector<int> encoded(numEncoded + 4, 0);
+    encoded[0] = numEncoded;
+    encoded[1] = length;
+    encoded[2] = fb.i_;
+
+    ::encodeThresholdP3(nullptr, x.buffer(), x.shapeInfo(), offsets.data(), length, encoded.data());
+
+    // encoded indices are sorted, as in CUDA encoder
+    ASSERT_EQ(1, encoded[4]);
+    ASSERT_EQ(-8, encoded[5]);
+
+    ::decodeThreshold(nullptr, encoded.data(), length, z.buffer(), z.shapeInfo());
+
+    // decoded updates + residuals must give original values back
+    z += x;
+    ASSERT_TRUE(original.equalsTo(z));
+#endif
+}
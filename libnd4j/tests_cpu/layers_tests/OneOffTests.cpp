@@ -113,6 +113,43 @@ TEST_F(OneOffTests, test_pad_1D_1) {
     ASSERT_EQ(e, *z);
     delete graph;
 }
+
+TEST_F(OneOffTests, test_pad_1D_2) {
+    auto e = NDArrayFactory::create<float>('c', {7}, {10.f,0.778786f, 0.801198f, 0.724375f, 0.230894f, 0.727141f,10.f});
+    auto graph = GraphExecutioner::importFromFlatBuffers("./resources/pad_1D.fb", true);
+
+    ASSERT_TRUE(graph != nullptr);
+    ASSERT_TRUE(graph->mappedFile() != nullptr);
+    ASSERT_TRUE(MappedFile::isMapped(graph->mappedFile()->data(), graph->mappedFile()->length()));
+
+    // constants are used in place, their buffers point into the mapped file
+    auto mapStart = graph->mappedFile()->data();
+    auto mapEnd = mapStart + graph->mappedFile()->length();
+    int numMapped = 0;
+    for (auto v: graph->getVariableSpace()->getVariables()) {
+        if (v->id() >= 0 || !v->hasNDArray() || v->getNDArray()->isEmpty())
+            continue;
+
+        auto array = v->getNDArray();
+        auto ptr = reinterpret_cast<uint8_t*>(array->getBuffer());
+        if (ptr >= mapStart && ptr + array->lengthOf() * array->sizeOfT() <= mapEnd) {
+            ASSERT_TRUE(MappedFile::isMapped(ptr, array->lengthOf() * array->sizeOfT()));
+            numMapped++;
+        }
+    }
+    ASSERT_TRUE(numMapped > 0);
+
+    Nd4jStatus status = GraphExecutioner::execute(graph);
+    ASSERT_EQ(Status::OK(), status);
+
+    ASSERT_TRUE(graph->getVariableSpace()->hasVariable(4));
+
+    auto z = graph->getVariableSpace()->getVariable(4)->getNDArray();
+    ASSERT_TRUE(z != nullptr);
+
+    ASSERT_EQ(e, *z);
+    delete graph;
+}
 /*
 TEST_F(OneOffTests, test_scatter_nd_update_1) {
 
@@ -0,0 +1,141 @@
+/*******************************************************************************
+ * Copyright (c) 2015-2018 Skymind, Inc.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Tests for per-op statistics and trace recording
+//
+
+#include "testlayers.h"
+#include <graph/profiling/OpStatistics.h>
+#include <graph/profiling/TraceRecorder.h>
+#include <ops/declarable/CustomOperations.h>
+
+using namespace nd4j;
+using namespace nd4j::ops;
+using namespace nd4j::graph;
+
+class OpStatisticsTests : public testing::Test {
+public:
+
+};
+
+TEST_F(OpStatisticsTests, OpStatistics_1) {
+    auto x = NDArrayFactory::create<float>('c', {2, 3});
+    auto y = NDArrayFactory::create<float>('c', {2, 3});
+    auto v = NDArrayFactory::create<float>('c', {3});
+
+    auto statistics = OpStatistics::getInstance();
+    statistics->setEnabled(true);
+    statistics->reset();
+
+    nd4j::ops::add op;
+    for (int e = 0; e < 3; e++) {
+        auto result = op.evaluate({&x, &y});
+        ASSERT_EQ(ND4J_STATUS_OK, result->status());
+        delete result;
+    }
+
+    auto result = op.evaluate({&x, &v});
+    ASSERT_EQ(ND4J_STATUS_OK, result->status());
+    delete result;
+
+    // different input shapes produce different entries
+    const Nd4jLong *same[] = {x.shapeInfo(), y.shapeInfo()};
+    const Nd4jLong *broadcast[] = {x.shapeInfo(), v.shapeInfo()};
+    auto sameSignature = OpStatistics::signatureOf(2, same);
+    auto broadcastSignature = OpStatistics::signatureOf(2, broadcast);
+    ASSERT_NE(sameSignature, broadcastSignature);
+
+    auto entry = statistics->lookup(op.getOpHash(), sameSignature);
+    ASSERT_TRUE(entry != nullptr);
+    ASSERT_EQ(3, entry->execution.count());
+    ASSERT_EQ(3, entry->shapeFunction.count());
+    ASSERT_EQ(std::string("[2,3]:FLOAT;[2,3]:FLOAT"), entry->shapes);
+
+    entry = statistics->lookup(op.getOpHash(), broadcastSignature);
+    ASSERT_TRUE(entry != nullptr);
+    ASSERT_EQ(1, entry->execution.count());
+
+    auto json = statistics->asJson();
+    ASSERT_NE(std::string::npos, json.find("\"op\":\"add\""));
+
+    statistics->reset();
+    ASSERT_EQ(0, statistics->numberOfEntries());
+    ASSERT_TRUE(statistics->lookup(op.getOpHash(), sameSignature) == nullptr);
+}
+
+TEST_F(OpStatisticsTests, OpStatistics_2) {
+    auto statistics = OpStatistics::getInstance();
+    statistics->setEnabled(true);
+    statistics->reset();
+
+    // twice as many signatures of a single op as the table can hold
+    Nd4jLong opHash = 119;
+    Nd4jLong numSignatures = 2 * OpStatistics::TABLE_SIZE;
+    for (Nd4jLong e = 1; e <= numSignatures; e++)
+        statistics->recordExecution(opHash, "fake", e, 0, nullptr, 10);
+
+    ASSERT_TRUE(statistics->numberOfEntries() <= OpStatistics::TABLE_SIZE);
+    ASSERT_TRUE(statistics->numberOfOverflows() >= numSignatures - OpStatistics::TABLE_SIZE);
+
+    // signatures without entry of their own are accounted in "other shapes" entry
+    auto other = statistics->lookup(opHash, OpStatistics::OTHER_SHAPES);
+    ASSERT_TRUE(other != nullptr);
+    ASSERT_EQ(std::string("other"), other->shapes);
+    ASSERT_EQ(statistics->numberOfOverflows(), other->execution.count());
+
+    Nd4jLong total = other->execution.count();
+    for (Nd4jLong e = 1; e <= numSignatures; e++) {
+        auto entry = statistics->lookup(opHash, e);
+        if (entry != nullptr)
+            total += entry->execution.count();
+    }
+    ASSERT_EQ(numSignatures, total);
+
+    statistics->reset();
+    ASSERT_EQ(0, statistics->numberOfEntries());
+    ASSERT_EQ(0, statistics->numberOfOverflows());
+}
+
+TEST_F(OpStatisticsTests, TraceRecorder_1) {
+    auto x = NDArrayFactory::create<float>('c', {2, 3});
+    auto y = NDArrayFactory::create<float>('c', {2, 3});
+
+    auto tracer = TraceRecorder::getInstance();
+    nd4j::ops::add op;
+
+    // nothing is recorded before tracing started
+    tracer->start();
+    tracer->stop();
+    auto result = op.evaluate({&x, &y});
+    delete result;
+    ASSERT_EQ(0, tracer->numberOfEvents());
+
+    tracer->start();
+    result = op.evaluate({&x, &y});
+    delete result;
+    tracer->instant("marker", "test", "bytes", 119);
+    tracer->stop();
+
+    // shape function, op itself and marker
+    ASSERT_EQ(3, tracer->numberOfEvents());
+
+    auto json = tracer->asJson();
+    ASSERT_NE(std::string::npos, json.find("\"traceEvents\""));
+    ASSERT_NE(std::string::npos, json.find("\"name\":\"add\",\"cat\":\"op\",\"ph\":\"X\""));
+    ASSERT_NE(std::string::npos, json.find("\"name\":\"add\",\"cat\":\"shape\""));
+    ASSERT_NE(std::string::npos, json.find("\"bytes\":119"));
+}
@@ -44,6 +44,8 @@
 
 #include <ops/declarable/helpers/legacy_helpers.h>
 #include <execution/ThreadPool.h>
+#include <NativeOpExecutioner.h>
+#include <specials.h>
 
 using namespace nd4j;
 using namespace nd4j::graph;
@@ -94,4 +96,35 @@ TEST_F(PerformanceTests, test_maxpooling2d_1) {
     nd4j_printf("Execution time: %lld; Min: %lld; Max: %lld;\n", valuesX[valuesX.size() / 2], valuesX[0], valuesX[valuesX.size() - 1]);
 }
 
+TEST_F(PerformanceTests, test_sort_1) {
+    // 1e9 floats need ~12GB: array itself plus radix sort buffers
+    for (Nd4jLong length : {1000000LL, 10000000LL, 100000000LL, 1000000000LL}) {
+        auto x = NDArrayFactory::create<float>('c', {length});
+        auto k = NDArrayFactory::create<int>('c', {length});
+        auto v = NDArrayFactory::create<int>('c', {length});
+
+        std::vector<Nd4jLong> valuesX, valuesK;
+        for (int i = 0; i < 5; i++) {
+            RandomGenerator rng(119, i);
+            RandomLauncher::fillUniform(LaunchContext::defaultContext(), rng, &x, -1e6, 1e6);
+            k.assign(x);
+            v.linspace(0);
+
+            auto timeStart = std::chrono::system_clock::now();
+            NativeOpExecutioner::execSort(x.buffer(), x.shapeInfo(), false);
+            auto timeEnd = std::chrono::system_clock::now();
+            valuesX.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+
+            timeStart = std::chrono::system_clock::now();
+            nd4j::DoubleMethods<int, int>::sortByKey(k.buffer(), k.shapeInfo(), v.buffer(), v.shapeInfo(), false);
+            timeEnd = std::chrono::system_clock::now();
+            valuesK.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(timeEnd - timeStart).count());
+        }
+
+        std::sort(valuesX.begin(), valuesX.end());
+        std::sort(valuesK.begin(), valuesK.end());
+        nd4j_printf("Sort of %lld elements: %lld us; sortByKey: %lld us;\n", length, valuesX[valuesX.size() / 2], valuesK[valuesK.size() / 2]);
+    }
+}
+
 #endif
\ No newline at end of file
@@ -102,3 +102,67 @@ TEST_F(SortCpuTests, test_tad_sort_by_val_1) {
     ASSERT_EQ(ek, k);
     ASSERT_EQ(ev, v);
 }
+
+TEST_F(SortCpuTests, test_linear_sort_2) {
+    if (!Environment::getInstance()->isCPU())
+        return;
+
+    // long enough to be split between threads, with negative values and duplicates
+    const Nd4jLong length = 300000;
+    auto x = NDArrayFactory::create<float>('c', {length});
+    for (Nd4jLong e = 0; e < length; e++)
+        x.p(e, static_cast<float>((e * 7919) % 1001) - 500.f);
+
+    std::vector<float> exp(x.bufferAsT<float>(), x.bufferAsT<float>() + length);
+    std::sort(exp.begin(), exp.end(), std::greater<float>());
+
+    sort(nullptr, x.buffer(), x.shapeInfo(), x.specialBuffer(), x.specialShapeInfo(), true);
+
+    for (Nd4jLong e = 0; e < length; e++)
+        ASSERT_EQ(exp[e], x.e<float>(e));
+}
+
+TEST_F(SortCpuTests, test_linear_sort_by_key_2) {
+    if (!Environment::getInstance()->isCPU())
+        return;
+
+    // half precision keys go through merge sort, equal keys keep their order
+    const Nd4jLong length = 200000;
+    auto k = NDArrayFactory::create<float16>('c', {length});
+    auto v = NDArrayFactory::create<Nd4jLong>('c', {length});
+    for (Nd4jLong e = 0; e < length; e++) {
+        k.p(e, static_cast<float>((e * 31) % 257));
+        v.p(e, e);
+    }
+
+    sortByKey(nullptr, k.buffer(), k.shapeInfo(), k.specialBuffer(), k.specialShapeInfo(), v.buffer(), v.shapeInfo(), v.specialBuffer(), v.specialShapeInfo(), false);
+
+    for (Nd4jLong e = 1; e < length; e++) {
+        ASSERT_TRUE(k.e<float>(e - 1) <= k.e<float>(e));
+        if (k.e<float>(e - 1) == k.e<float>(e))
+            ASSERT_TRUE(v.e<Nd4jLong>(e - 1) < v.e<Nd4jLong>(e));
+
+        ASSERT_EQ(static_cast<float>((v.e<Nd4jLong>(e) * 31) % 257), k.e<float>(e));
+    }
+}
+
+TEST_F(SortCpuTests, test_strided_sort_by_val_1) {
+    if (!Environment::getInstance()->isCPU())
+        return;
+
+    auto k = NDArrayFactory::create<int>('c', {5000, 2});
+    auto v = NDArrayFactory::create<double>('c', {5000, 2});
+    k.linspace(0);
+    v.linspace(20000, -2);
+
+    auto kc = k({0,0, 0,1});
+    auto vc = v({0,0, 0,1});
+
+    sortByValue(nullptr, kc.buffer(), kc.shapeInfo(), kc.specialBuffer(), kc.specialShapeInfo(), vc.buffer(), vc.shapeInfo(), vc.specialBuffer(), vc.specialShapeInfo(), false);
+
+    for (Nd4jLong e = 0; e < 5000; e++) {
+        ASSERT_EQ(2 * (4999 - e), k.e<int>(e, 0));
+        ASSERT_EQ(2 * e + 1, k.e<int>(e, 1));
+        ASSERT_EQ(20000 - 2 * k.e<int>(e, 0), v.e<double>(e, 0));
+    }
+}
@@ -24,6 +24,8 @@
 #include <execution/Threads.h>
 #include <chrono>
 #include <execution/ThreadPool.h>
+#include <execution/NumaTopology.h>
+#include <thread>
 
 using namespace samediff;
 using namespace nd4j;
@@ -208,6 +210,93 @@ TEST_F(ThreadsTests, reduction_test_1) {
     ASSERT_EQ(8192, sum);
 }
 
+TEST_F(ThreadsTests, nested_test_1) {
+    std::atomic<int64_t> sum(0);
+
+    // every chunk of outer loop runs its own parallel reduction
+    auto outer = PRAGMA_THREADS_FOR {
+        for (auto e = start; e < stop; e++) {
+            auto inner = PRAGMA_REDUCE_LONG {
+                return stop - start;
+            };
+
+            sum += samediff::Threads::parallel_long(inner, LAMBDA_SUML, 0, 8192, 1, 4);
+        }
+    };
+
+    samediff::Threads::parallel_for(outer, 0, 16, 1, 4);
+    ASSERT_EQ(16 * 8192, sum.load());
+}
+
+TEST_F(ThreadsTests, concurrent_callers_1) {
+    const int numCallers = 4;
+    std::vector<std::thread> callers;
+    std::vector<int64_t> results(numCallers, 0);
+
+    for (int c = 0; c < numCallers; c++) {
+        callers.emplace_back([&results, c] {
+            for (int i = 0; i < 10; i++) {
+                auto func = PRAGMA_REDUCE_LONG {
+                    int64_t sum = 0;
+                    for (auto e = start; e < stop; e++)
+                        sum += e;
+
+                    return sum;
+                };
+
+                results[c] += samediff::Threads::parallel_long(func, LAMBDA_SUML, 0, 100000);
+            }
+        });
+    }
+
+    for (auto &t:callers)
+        t.join();
+
+    for (int c = 0; c < numCallers; c++)
+        ASSERT_EQ(10LL * 4999950000LL, results[c]);
+}
+
+TEST_F(ThreadsTests, exception_test_1) {
+    auto func = PRAGMA_THREADS_FOR {
+        if (thread_id == 1)
+            throw std::runtime_error("chunk failed");
+    };
+
+    ASSERT_ANY_THROW(samediff::Threads::parallel_tad(func, 0, 64, 1, 4));
+}
+
+TEST_F(ThreadsTests, numa_topology_1) {
+    samediff::NumaTopology topology(2, 8);
+
+    ASSERT_EQ(2, topology.numberOfNodes());
+    ASSERT_TRUE(topology.isNumaAware());
+    ASSERT_FALSE(topology.isDetected());
+    ASSERT_EQ(std::vector<int>({0, 1, 2, 3}), topology.cpusOfNode(0));
+    ASSERT_EQ(std::vector<int>({4, 5, 6, 7}), topology.cpusOfNode(1));
+    ASSERT_EQ(1, topology.nodeOfCpu(5));
+
+    // every chunk belongs to the node whose block contains it
+    for (int64_t numChunks = 1; numChunks < 17; numChunks++) {
+        ASSERT_EQ(0, topology.firstChunk(0, numChunks));
+        ASSERT_EQ(numChunks, topology.firstChunk(2, numChunks));
+
+        for (int64_t c = 0; c < numChunks; c++) {
+            auto node = topology.nodeOfChunk(c, numChunks);
+            ASSERT_TRUE(c >= topology.firstChunk(node, numChunks));
+            ASSERT_TRUE(c < topology.firstChunk(node + 1, numChunks));
+        }
+    }
+}
+
+TEST_F(ThreadsTests, numa_first_touch_1) {
+    std::vector<int8_t> buffer(8 * 1024 * 1024 + 3, 1);
+
+    samediff::NumaTopology::firstTouch(buffer.data(), buffer.size());
+
+    for (auto v : buffer)
+        ASSERT_EQ(0, v);
+}
+
 /*
 TEST_F(ThreadsTests, basic_test_1) {
     if (!Environment::getInstance()->isCPU())
@@ -26,6 +26,10 @@
 #include <Workspace.h>
 #include <MemoryRegistrator.h>
 #include <MmulHelper.h>
+#include <memory/WorkspaceArena.h>
+#include <algorithm>
+#include <cstring>
+#include <thread>
 
 using namespace nd4j;
 using namespace nd4j::memory;
@@ -277,6 +281,125 @@ TEST_F(WorkspaceTests, Test_Externalized_1) {
     ASSERT_NEAR(2.0f, m, 1e-5);
 }
 
+TEST_F(WorkspaceTests, Test_Alignment_1) {
+    if (!Environment::getInstance()->isCPU())
+        return;
+
+    Workspace ws(65536);
+    ASSERT_EQ(WORKSPACE_ALIGNMENT, ws.getAlignment());
+
+    auto p0 = reinterpret_cast<Nd4jLong>(ws.allocateBytes(12));
+    auto p1 = reinterpret_cast<Nd4jLong>(ws.allocateBytes(100));
+    auto p2 = reinterpret_cast<Nd4jLong>(ws.allocateBytes(65536));
+
+    ASSERT_EQ(0, p0 % 64);
+    ASSERT_EQ(64, p1 - p0);
+    ASSERT_EQ(0, p2 % 64);
+    ASSERT_EQ(1, ws.getNumberOfSpills());
+
+    ws.setAlignment(128);
+    auto p3 = reinterpret_cast<Nd4jLong>(ws.allocateBytes(8));
+    ASSERT_EQ(0, p3 % 128);
+    ASSERT_EQ(256, p3 - p0);
+
+    ASSERT_ANY_THROW(ws.setAlignment(48));
+}
+
+TEST_F(WorkspaceTests, Test_Concurrent_Allocations_1) {
+    if (!Environment::getInstance()->isCPU())
+        return;
+
+    const int numThreads = 8;
+    const int numAllocations = 1000;
+    Workspace ws(numThreads * numAllocations * 64);
+
+    std::vector<std::vector<Nd4jLong>> pointers(numThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; t++) {
+        threads.emplace_back([&, t] {
+            for (int e = 0; e < numAllocations; e++) {
+                auto p = ws.allocateBytes(1 + (e % 64));
+                memset(p, t, 1 + (e % 64));
+                pointers[t].emplace_back(reinterpret_cast<Nd4jLong>(p));
+            }
+        });
+    }
+
+    for (auto &t : threads)
+        t.join();
+
+    // every allocation got its own aligned slot within the arena
+    std::vector<Nd4jLong> all;
+    for (auto &v : pointers)
+        all.insert(all.end(), v.begin(), v.end());
+
+    std::sort(all.begin(), all.end());
+    for (size_t e = 0; e < all.size(); e++) {
+        ASSERT_EQ(0, all[e] % 64);
+        if (e > 0)
+            ASSERT_TRUE(all[e] - all[e - 1] >= 64);
+    }
+
+    ASSERT_EQ(0, ws.getSpilledSize());
+    ASSERT_EQ(numThreads * numAllocations, ws.getNumberOfAllocations());
+    ASSERT_TRUE(ws.getPeakUsage() > (numThreads * numAllocations - 1) * 64);
+    ASSERT_TRUE(ws.getPeakUsage() <= numThreads * numAllocations * 64);
+}
+
+TEST_F(WorkspaceTests, Test_Spills_Recycling_1) {
+    if (!Environment::getInstance()->isCPU())
+        return;
+
+    Workspace ws(1024);
+    ws.scopeOut();
+
+    ws.scopeIn();
+    auto p0 = ws.allocateBytes(1000);
+    auto p1 = ws.allocateBytes(5000);
+    ASSERT_EQ(5000, ws.getSpilledSize());
+    ASSERT_EQ(1, ws.getNumberOfSpills());
+    ASSERT_EQ(0, ws.getNumberOfRecycledSpills());
+    ws.scopeOut();
+
+    // arena is grown to what previous cycle used, spill memory goes to the pool
+    ws.scopeIn();
+    ASSERT_EQ(0, ws.getSpilledSize());
+    ASSERT_TRUE(ws.getCurrentSize() >= 6000);
+
+    ws.allocateBytes(ws.getCurrentSize());
+    auto p2 = ws.allocateBytes(4500);
+    ASSERT_EQ(p1, p2);
+    ASSERT_EQ(1, ws.getNumberOfRecycledSpills());
+    ws.scopeOut();
+}
+
+TEST_F(WorkspaceTests, Test_Arena_1) {
+    if (!Environment::getInstance()->isCPU())
+        return;
+
+    Workspace ws(65536);
+    WorkspaceArena arena(&ws, 4096);
+
+    auto p0 = reinterpret_cast<Nd4jLong>(arena.allocateBytes(10));
+    auto p1 = reinterpret_cast<Nd4jLong>(arena.allocateBytes(10));
+    ASSERT_EQ(64, p1 - p0);
+
+    // single block taken from workspace so far
+    ASSERT_EQ(4096, ws.getCurrentOffset());
+
+    // big allocation goes to the workspace directly
+    arena.allocateBytes(5000);
+    ASSERT_EQ(4096 + 5000, ws.getCurrentOffset());
+
+    // while current block is still used for small ones
+    auto p2 = reinterpret_cast<Nd4jLong>(arena.allocateBytes(10));
+    ASSERT_EQ(128, p2 - p0);
+
+    WorkspaceArena heap(nullptr, 4096);
+    auto p3 = reinterpret_cast<Nd4jLong>(heap.allocateBytes(10));
+    ASSERT_EQ(0, p3 % 64);
+}
+
 // TODO: uncomment this test once long shapes are introduced
 /*
 TEST_F(WorkspaceTests, Test_Big_Allocation_1) {